@@ -26,15 +26,53 @@ const Cap::Config kCapConfig = {
     .min_valid_volt = 16.0f,      ///< 最小有效放电电压，小于此值之后不允许开启超电，单位：V
     .auto_disable_power = 20.0f,  ///< 自动关闭能量阈值，单位：%，当剩余能量低于此值时，自动关闭超电，[0, 100)
     .min_enable_power = 40.0f,    ///< 最小开启能量阈值，单位：%，当剩余能量高于此值时，才能开启超电，[0, 100)
+                                  ///< 底盘不向电容板下发开关指令，电容板是否放电只由以上两个阈值决定；
+                                  ///< CapEstimator 的 enable_energy / disable_energy 只决定底盘是否把功率上限放开到超电档
     .pwr_filter_beta = 0.7f,      ///< 剩余能量的低通滤波系数，[0, 1]，为 0 时即不滤波
 };
 
+const robot::CapChargePlanner::Params kCapChargePlannerParams = {
+    .period_ticks = 10,         ///< 规划周期，单位 ms
+    .max_charge_pwr = 150.0f,   ///< 电容板最大充电功率，单位 W
+    .idle_margin = 3.0f,        ///< 静止或自瞄时保留的功率余量，单位 W
+    .move_margin = 10.0f,       ///< 机动时保留的功率余量，单位 W
+    .idle_demand_thres = 15.0f, ///< 静止判定的需求功率阈值，单位 W
+    .demand_fall_beta = 0.02f,  ///< 需求功率下降时的低通滤波系数
+    .buffer_target = 50.0f,     ///< 缓冲能量目标值，单位 J
+    .buffer_kp = 2.0f,          ///< 缓冲能量不足时每焦耳减小的充电功率，单位 W/J
+    .taper_start_pct = 90.0f,   ///< 开始减小充电功率的剩余能量百分比，单位 %
+};
+
+// 新电容组满电可用能量约 1100 J，开启/关闭阈值约为其 40% / 20%，与电容板的 min_enable_power / auto_disable_power 对应
+const robot::CapEstimator::Params kCapEstimatorParams = {
+    .c_nominal = 6.0f,          ///< 标称容量，单位 F
+    .r_nominal = 0.1f,          ///< 标称内阻，单位 Ohm
+    .c_min = 2.0f,              ///< 容量估计值下限，单位 F
+    .c_max = 12.0f,             ///< 容量估计值上限，单位 F
+    .r_min = 0.01f,             ///< 内阻估计值下限，单位 Ohm
+    .r_max = 0.5f,              ///< 内阻估计值上限，单位 Ohm
+    .v_max = 26.0f,             ///< 最大充电电压，单位 V
+    .v_min = 16.0f,             ///< 最小有效放电电压，单位 V
+    .i_peak = 15.0f,            ///< 峰值放电电流，单位 A
+    .esr_step_thres = 3.0f,     ///< 用于内阻估计的最小电流阶跃，单位 A
+    .esr_beta = 0.1f,           ///< 内阻估计的低通滤波系数
+    .cap_window_ticks = 500,    ///< 容量估计的积分窗口，单位 ms
+    .cap_min_dq = 1.0f,         ///< 容量估计所需的最小电荷变化量，单位 C
+    .cap_beta = 0.05f,          ///< 容量估计的低通滤波系数
+    .enable_energy = 440.0f,    ///< 允许开启超电的可用能量，单位 J
+    .disable_energy = 220.0f,   ///< 关闭超电的可用能量，单位 J
+};
+
 /* Private variables ---------------------------------------------------------*/
 static Cap unique_cap = Cap(100, kCapConfig, Cap::Version::kVer2024);
+static robot::CapChargePlanner unique_cap_charge_planner = robot::CapChargePlanner(kCapChargePlannerParams);
+static robot::CapEstimator unique_cap_estimator = robot::CapEstimator(kCapEstimatorParams);
 /* External variables --------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
 /* Exported function definitions ---------------------------------------------*/
 
 Cap* CreateCap(void) { return &unique_cap; };
+robot::CapChargePlanner* CreateCapChargePlanner(void) { return &unique_cap_charge_planner; };
+robot::CapEstimator* CreateCapEstimator(void) { return &unique_cap_estimator; };
 
 /* Private function definitions ----------------------------------------------*/
@@ -16,9 +16,9 @@
 #include "ins_chassis_iksolver.hpp"
 /* Private constants ---------------------------------------------------------*/
 
-const float kWheelRadius = 77.86 * 0.001 ;  ///< 轮子半径 [m]
+constexpr float kWheelRadius = 77.86 * 0.001 ;  ///< 轮子半径 [m]
 
-const float kWheel2Center = 216.91 * 0.001;  ///< 轮子中心距旋转中心的距离 [m]
+constexpr float kWheel2Center = 216.91 * 0.001;  ///< 轮子中心距旋转中心的距离 [m]
 
 const float kWheelBase = kWheel2Center * sqrt(2.0f);  ///< 左右轮距 [m]
 
@@ -32,6 +32,12 @@ const hw_chassis_iksolver::PosVec kCenterPos = hw_chassis_iksolver::PosVec(0, 0)
 
 hw_chassis_iksolver::ChassisIkSolver unique_chassis_iksolver = hw_chassis_iksolver::ChassisIkSolver(kCenterPos);
 bool is_chassis_iksolver_init = false;
+
+/** X 型全向轮专用解算核，雅可比矩阵在编译期计算 */
+constexpr robot::OmniIkKernel unique_omni_ik_kernel = robot::OmniIkKernel({
+    .wheel_radius = kWheelRadius,
+    .wheel2center = kWheel2Center,
+});
 /* External variables --------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
 
@@ -73,4 +79,6 @@ hw_chassis_iksolver::ChassisIkSolver* CreateChassisIkSolver(void)
   }
   return &unique_chassis_iksolver;
 };
+
+const robot::OmniIkKernel* CreateOmniIkKernel(void) { return &unique_omni_ik_kernel; };
 /* Private function definitions ----------------------------------------------*/
@@ -0,0 +1,35 @@
+/** 
+ *******************************************************************************
+ * @file      :ins_chassis_planner.cpp
+ * @brief     : 
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "ins_chassis_planner.hpp"
+/* Private constants ---------------------------------------------------------*/
+
+// 制动功率系数按 60 W 时约 25 rad/s^2 的实测减速度折算
+static const robot::Gyro2FollowPlanner::Params kGyro2FollowPlannerParams = {
+    .max_decel = 30.0f,        ///< 最大角减速度，单位 rad/s^2
+    .brake_pwr_coeff = 0.1f,   ///< 制动功率系数，单位 W/(rad/s^2)^2
+    .handoff_ang = 0.3f,       ///< 交给跟随 PID 的剩余角度，单位 rad
+    .handoff_spd = 2.0f,       ///< 不做规划的转速阈值，单位 rad/s
+};
+/* Private macro -------------------------------------------------------------*/
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+
+robot::Gyro2FollowPlanner unique_gyro2follow_planner = robot::Gyro2FollowPlanner(kGyro2FollowPlannerParams);
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported function definitions ---------------------------------------------*/
+robot::Gyro2FollowPlanner* CreateGyro2FollowPlanner(void) { return &unique_gyro2follow_planner; };
+/* Private function definitions ----------------------------------------------*/
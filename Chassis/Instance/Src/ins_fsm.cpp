@@ -21,6 +21,18 @@ const robot::Chassis::Config kChassisConfig = {
     .max_trans_vel = 5.0f,      ///< 最大平移速度
     .max_rot_spd = 15,      ///< 最大旋转速度
     .cmd_smooth_factor = 0.8f,  ///< 运动指令平滑系数, 值域[0,1], 启用超电时默认为1
+    .follow_ffd_latency = 0.004f,    ///< 云台运动数据从采样到底盘执行的固定时延，单位 s
+    .follow_ffd_ref_weight = 0.5f,   ///< 前馈中云台期望角速度所占权重
+    .follow_pid_min_scale = 0.4f,    ///< 跟随误差为 0 时跟随 PID 输出的缩放系数
+    .follow_pid_full_err = 0.35f,    ///< 跟随 PID 输出不缩放所需的跟随误差，单位 rad
+    // 发送到生效约 1.5 ms，加指令保持一个控制周期的平均 0.5 ms、YAW 反馈的 CAN 时延与读取前的平均等待约 0.7 ms，
+    // 见 tools/host/theta_pred_sim.cpp
+    .theta_pred_latency = 0.0027f,   ///< 除 YAW 反馈到达后经过的周期外，theta_i2r 预测的固定时延，单位 s
+    .gyro_headroom_low = 0.15f,      ///< 云台力矩余量低于该值时降低小陀螺转速
+    .gyro_headroom_high = 0.3f,      ///< 云台力矩余量高于该值时恢复小陀螺转速
+    .gyro_spd_scale_min = 0.5f,      ///< 小陀螺转速缩放系数的下限
+    .gyro_spd_scale_down = 0.5f,     ///< 小陀螺转速缩放系数的下降速率，单位 1/s
+    .gyro_spd_scale_up = 0.05f,      ///< 小陀螺转速缩放系数的恢复速率，单位 1/s
 };
 const float robotmass = 19.0f;
 /* Private macro -------------------------------------------------------------*/
@@ -44,6 +56,7 @@ robot::Chassis* CreateChassis()
     // * 1. 无通信功能的组件指针
     // * - 底盘逆解
     unique_chassis.registerIkSolver(CreateChassisIkSolver());
+    unique_chassis.registerOmniIkKernel(CreateOmniIkKernel());
     // * - pid
     // 轮组 pid
     unique_chassis.registerWheelPid(CreatePidMotorWheelLeftFront(), robot::Chassis::kWheelPidIdxLeftFront);
@@ -52,8 +65,21 @@ robot::Chassis* CreateChassis()
     unique_chassis.registerWheelPid(CreatePidMotorWheelRightFront(), robot::Chassis::kWheelPidIdxRightFront);
     // 随动速度
     unique_chassis.registerFollowOmegaPid(CreatePidFollowOmega());
+    // 轮速前馈
+    unique_chassis.registerWheelFfd(CreateWheelFfd());
     // * - 功率限制
     unique_chassis.registerPwrLimiter(CreatePwrLimiter());
+    unique_chassis.registerCurrentPwrLimiter(CreateCurrentPwrLimiter());
+    // * - 小陀螺切跟随规划
+    unique_chassis.registerGyro2FollowPlanner(CreateGyro2FollowPlanner());
+    // * - 牵引力控制
+    unique_chassis.registerTractionCtrl(CreateTractionCtrl());
+    // * - 轮电机热模型
+    unique_chassis.registerWheelThermal(CreateWheelThermal());
+    // * - 超电充电功率规划
+    unique_chassis.registerCapChargePlanner(CreateCapChargePlanner());
+    // * - 超电容量与内阻估计
+    unique_chassis.registerCapEstimator(CreateCapEstimator());
 
     unique_chassis.registerImu(CreateImu());
     // * 2. 只接收数据的组件指针
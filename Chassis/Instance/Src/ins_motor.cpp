@@ -98,6 +98,19 @@ const hw_motor::OptionalParams kMotorParamsFeed = {
     .angle_offset = 0,
 };
 
+// 轮电机（M3508）绕组热模型参数
+const robot::WheelThermal::Params kWheelThermalParams = {
+    .r_winding = 0.194f,       ///< 绕组电阻，单位 Ohm
+    .c_th = 120.0f,            ///< 绕组热容，单位 J/℃
+    .r_th = 1.5f,              ///< 绕组到环境的热阻，单位 ℃/W
+    .t_amb = 30.0f,            ///< 环境温度，单位 ℃
+    .k_obs = 0.2f,             ///< 反馈温度修正增益
+    .t_derate_start = 90.0f,   ///< 开始降额的温度，单位 ℃
+    .t_derate_end = 120.0f,    ///< 降额到最小系数的温度，单位 ℃
+    .min_scale = 0.3f,         ///< 最小电流限幅系数
+    .t_warn = 100.0f,          ///< 触发过温警告的温度，单位 ℃
+};
+
 // TODO: 这里的 MotorId 需要按照实际情况修改
 enum MotorID
 {
@@ -120,6 +133,8 @@ hw_motor::DM_J4310 unique_motor_yaw_1 = hw_motor::DM_J4310(kMotorIdYaw, kMotorPa
 hw_motor::DM_J4310 unique_motor_yaw_2 = hw_motor::DM_J4310(kMotorIdYaw, kMotorParamsYaw_2);
 
 hw_motor::M3508 unique_motor_feed = hw_motor::M3508(kMotorIdFeed, kMotorParamsFeed);
+
+robot::WheelThermal unique_wheel_thermal = robot::WheelThermal(kWheelThermalParams);
 /* External variables --------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
 /* Exported function definitions ---------------------------------------------*/
@@ -141,5 +156,6 @@ hw_motor::Motor *CreateMotorYaw() { return &unique_motor_yaw_1; };
 //     }
 // }
 hw_motor::Motor *CreateMotorFeed() { return &unique_motor_feed; };
+robot::WheelThermal *CreateWheelThermal() { return &unique_wheel_thermal; };
 
 /* Private function definitions ----------------------------------------------*/
@@ -71,6 +71,21 @@ const hw_pid::MultiNodesPid::ParamsList kPidParamsFollowOmega_2 = {
     },
 };
 
+// 轮速 PID 前馈参数，由轮速阶跃响应日志辨识
+const robot::WheelFfd::Params kWheelFfdParams = {
+    .k_tau = 0.3f,             ///< M3508 轮端转矩常数，单位 N*m/A
+    .mass = 19.0f,             ///< 整车质量，单位 kg
+    .inertia_z = 0.6f,         ///< 整车绕 Z 轴转动惯量，单位 kg*m^2
+    .rotor_inertia = 0.004f,   ///< 折算到轮端的转子与轮子转动惯量，单位 kg*m^2
+    .visc = 0.01f,             ///< 粘滞摩擦电流系数，单位 A/(rad/s)
+    .coulomb = 0.3f,           ///< 库仑摩擦电流，单位 A
+    .coulomb_spd_band = 2.0f,  ///< 库仑摩擦线性过渡的转速范围，单位 rad/s
+    .acc_filter = 0.2f,        ///< 角加速度低通滤波系数
+    .max_ffd = 10.0f,          ///< 前馈电流限幅，单位 A
+    // 沿用场上取值；按上面的质量、转矩常数与 77.86 mm 轮半径算得理论值约 1.9，重新整定时以此为起点
+    .gravity_curr_per_spd = 2.3f,  ///< 坡道重力补偿电流与重力分量逆解轮速之比，单位 A/(rad/s)
+};
+
 const hw_pid::MultiNodesPid::Type kPidTypeCascade = hw_pid::MultiNodesPid::Type::kCascade;
 /* Private macro -------------------------------------------------------------*/
 /* Private types -------------------------------------------------------------*/
@@ -88,6 +103,8 @@ hw_pid::MultiNodesPid unique_pid_wheel_right_front_2(kPidTypeCascade, kOutLimitW
 hw_pid::MultiNodesPid unique_pid_wheel_right_rear_2(kPidTypeCascade, kOutLimitWheel, kPidParamsWheel_2);
 hw_pid::MultiNodesPid unique_pid_follow_omega_2(kPidTypeCascade, kOutLimitFollowOmega, kPidParamsFollowOmega_2);
 
+robot::WheelFfd unique_wheel_ffd = robot::WheelFfd(kWheelFfdParams);
+
 /* External variables --------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
 /* Exported function definitions ---------------------------------------------*/
@@ -96,6 +113,7 @@ hw_pid::MultiNodesPid *CreatePidMotorWheelLeftRear() { return &unique_pid_wheel_
 hw_pid::MultiNodesPid *CreatePidMotorWheelRightFront() { return &unique_pid_wheel_right_front_1; };
 hw_pid::MultiNodesPid *CreatePidMotorWheelRightRear() { return &unique_pid_wheel_right_rear_1; };
 hw_pid::MultiNodesPid *CreatePidFollowOmega() { return &unique_pid_follow_omega_1; };
+robot::WheelFfd *CreateWheelFfd() { return &unique_wheel_ffd; };
 
 // hw_pid::MultiNodesPid* CreatePidMotorWheelLeftFront()
 // {
@@ -26,10 +26,22 @@ static const hw_pwr_limiter::PowerLimiter::StaticParams kMotorStaticParamsList_2
     .p_steering_ratio = 0.0f, ///< 舵轮功率比例
 };
 
+// 电流域功率模型沿用速度域限制器的辨识结果
+static const robot::CurrentPwrLimiter::Params kCurrentPwrLimiterParams = {
+    .k_t = 0.285f,      ///< 输出功率系数
+    .k_r = 0.11f,       ///< 铜损系数
+    .k_w = 0.15f,       ///< 转速损耗系数
+    .p_bias = 2.6f,     ///< 底盘静息功率
+    .out_limit = 20.0f, ///< 输出限幅，单位：A
+};
+
 hw_pwr_limiter::PowerLimiter unique_pwr_limiter_1 = hw_pwr_limiter::PowerLimiter(kMotorStaticParamsList_1);
 hw_pwr_limiter::PowerLimiter unique_pwr_limiter_2 = hw_pwr_limiter::PowerLimiter(kMotorStaticParamsList_2);
 
+robot::CurrentPwrLimiter unique_current_pwr_limiter = robot::CurrentPwrLimiter(kCurrentPwrLimiterParams);
+
 hw_pwr_limiter::PowerLimiter *CreatePwrLimiter() { return &unique_pwr_limiter_1; }
+robot::CurrentPwrLimiter *CreateCurrentPwrLimiter() { return &unique_current_pwr_limiter; }
 // hw_pwr_limiter::PowerLimiter* CreatePwrLimiter()
 // {
 //     if (car_version == 0)
@@ -0,0 +1,39 @@
+/** 
+ *******************************************************************************
+ * @file      :ins_traction_ctrl.cpp
+ * @brief     : 
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "ins_traction_ctrl.hpp"
+/* Private constants ---------------------------------------------------------*/
+
+// 轮速反馈按 1 rpm 量化，1 ms 差分的噪声约 5 rad/s^2，阈值需远大于该值
+static const robot::TractionCtrl::Params kTractionCtrlParams = {
+    .imu_pos_x = 0.0f,           ///< IMU 相对底盘旋转中心的 x 坐标，单位 m
+    .imu_pos_y = 0.0f,           ///< IMU 相对底盘旋转中心的 y 坐标，单位 m
+    .residual_filter = 0.05f,    ///< 残差低通滤波系数
+    .slip_enter_thres = 60.0f,   ///< 判定为打滑的残差阈值，单位 rad/s^2
+    .slip_exit_thres = 25.0f,    ///< 判定为恢复抓地的残差阈值，单位 rad/s^2
+    .slip_hold_ticks = 50,       ///< 恢复抓地后继续按打滑处理的周期数
+    .slip_weight = 0.3f,         ///< 打滑轮在电流分配中的权重
+    .slip_cur_limit = 4.0f,      ///< 打滑轮的电流上限，单位 A
+};
+/* Private macro -------------------------------------------------------------*/
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+
+robot::TractionCtrl unique_traction_ctrl = robot::TractionCtrl(kTractionCtrlParams);
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported function definitions ---------------------------------------------*/
+robot::TractionCtrl* CreateTractionCtrl(void) { return &unique_traction_ctrl; };
+/* Private function definitions ----------------------------------------------*/
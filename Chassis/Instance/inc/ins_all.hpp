@@ -21,6 +21,7 @@
 #include "ins_cap.hpp"
 #include "ins_chassis_gimbal_comm.hpp"
 #include "ins_chassis_iksolver.hpp"
+#include "ins_chassis_planner.hpp"
 #include "ins_comm.hpp"
 #include "ins_fsm.hpp"
 #include "ins_imu.hpp"
@@ -29,6 +30,7 @@
 #include "ins_pwr_limiter.hpp"
 #include "ins_rc.hpp"
 #include "ins_rfr.hpp"
+#include "ins_traction_ctrl.hpp"
 
 /* Exported macro ------------------------------------------------------------*/
 /* Exported constants --------------------------------------------------------*/
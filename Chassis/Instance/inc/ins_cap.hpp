@@ -17,6 +17,8 @@
 #define INSTANCE_INS_CAP_HPP_
 
 /* Includes ------------------------------------------------------------------*/
+#include "cap_charge_planner.hpp"
+#include "cap_estimator.hpp"
 #include "super_cap.hpp"
 /* Exported macro ------------------------------------------------------------*/
 /* Exported constants --------------------------------------------------------*/
@@ -24,6 +26,8 @@
 /* Exported variables --------------------------------------------------------*/
 
 hello_world::cap::SuperCap* CreateCap(void);
+robot::CapChargePlanner* CreateCapChargePlanner(void);
+robot::CapEstimator* CreateCapEstimator(void);
 /* Exported function prototypes ----------------------------------------------*/
 
 #endif /* INSTANCE_INS_CAP_HPP_ */
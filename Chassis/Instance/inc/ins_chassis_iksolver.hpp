@@ -18,6 +18,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "chassis_iksolver.hpp"
+#include "omni_ik_kernel.hpp"
 
 namespace hw_chassis_iksolver = hello_world::chassis_ik_solver;
 /* Exported macro ------------------------------------------------------------*/
@@ -26,5 +27,6 @@ namespace hw_chassis_iksolver = hello_world::chassis_ik_solver;
 /* Exported variables --------------------------------------------------------*/
 /* Exported function prototypes ----------------------------------------------*/
 hw_chassis_iksolver::ChassisIkSolver* CreateChassisIkSolver(void);
+const robot::OmniIkKernel* CreateOmniIkKernel(void);
 
 #endif /* INSTANCE_INS_CHASSIS_IKSOLVER_HPP_ */
@@ -18,6 +18,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "motor.hpp"
+#include "wheel_thermal.hpp"
 
 namespace hw_motor = hello_world::motor;
 /* Exported macro ------------------------------------------------------------*/
@@ -31,5 +32,6 @@ hw_motor::Motor* CreateMotorWheelRightRear();
 hw_motor::Motor* CreateMotorWheelRightFront();
 hw_motor::Motor* CreateMotorYaw();
 hw_motor::Motor* CreateMotorFeed();
+robot::WheelThermal* CreateWheelThermal();
 
 #endif /* INSTANCE_INS_MOTOR_HPP_ */
@@ -18,6 +18,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "pid.hpp"
+#include "wheel_ffd.hpp"
 
 namespace hw_pid = hello_world::pid;
 /* Exported macro ------------------------------------------------------------*/
@@ -30,4 +31,5 @@ hw_pid::MultiNodesPid* CreatePidMotorWheelLeftRear();
 hw_pid::MultiNodesPid* CreatePidMotorWheelRightRear();
 hw_pid::MultiNodesPid* CreatePidMotorWheelRightFront();
 hw_pid::MultiNodesPid* CreatePidFollowOmega();
+robot::WheelFfd* CreateWheelFfd();
 #endif /* INSTANCE_INS_PID_HPP_ */
@@ -1,8 +1,10 @@
 #ifndef HERO_INS_PWR_LIMITER_HPP_
 #define HERO_INS_PWR_LIMITER_HPP_
+#include "current_pwr_limiter.hpp"
 #include "power_limiter.hpp"
 
 namespace hw_pwr_limiter = hello_world::power_limiter;
 
 hw_pwr_limiter::PowerLimiter* CreatePwrLimiter();
+robot::CurrentPwrLimiter* CreateCurrentPwrLimiter();
 #endif
\ No newline at end of file
@@ -0,0 +1,29 @@
+/** 
+ *******************************************************************************
+ * @file      : ins_traction_ctrl.hpp
+ * @brief     : 
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INSTANCE_INS_TRACTION_CTRL_HPP_
+#define INSTANCE_INS_TRACTION_CTRL_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+#include "traction_ctrl.hpp"
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+robot::TractionCtrl* CreateTractionCtrl(void);
+
+#endif /* INSTANCE_INS_TRACTION_CTRL_HPP_ */
@@ -0,0 +1,80 @@
+/**
+ *******************************************************************************
+ * @file      :cap_charge_planner.hpp
+ * @brief     : 超级电容充电功率规划
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 充电功率 = 裁判系统功率上限 - 底盘需求功率预测 - 余量 - 缓冲能量补偿，
+ *     通过 SuperCap::setRequestedPower 下发给电容板
+ *  2. 需求功率上升时立即跟随、下降时缓慢滤波，机动过程中使用更大的余量，
+ *     保证充电不与底盘驱动争抢功率；静止或自瞄且没有机动时余量小，尽量快速充满，
+ *     自瞄时小陀螺等稳定的转动需求已计入需求功率预测，不视为机动
+ *  3. 缓冲能量低于目标值时减小充电功率，让底盘把缓冲能量补回来，
+ *     充电只使用功率上限内的富余部分，不消耗缓冲能量
+ *  4. 剩余能量接近满电时线性减小充电功率；电容放电时不充电
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ROBOT_MODULES_CAP_CHARGE_PLANNER_HPP_
+#define ROBOT_MODULES_CAP_CHARGE_PLANNER_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstdint>
+
+/* Exported macro ------------------------------------------------------------*/
+
+namespace robot
+{
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+struct CapChargePlannerParams {
+  uint32_t period_ticks;    ///< 规划周期，单位 ms
+  float max_charge_pwr;     ///< 电容板最大充电功率，单位 W
+  float idle_margin;        ///< 静止或自瞄时保留的功率余量，单位 W
+  float move_margin;        ///< 机动时保留的功率余量，单位 W
+  float idle_demand_thres;  ///< 需求功率低于该值且无运动指令时视为静止，单位 W
+  float demand_fall_beta;   ///< 需求功率下降时的低通滤波系数，新值所占权重，值域 (0, 1]
+  float buffer_target;      ///< 缓冲能量目标值，单位 J
+  float buffer_kp;          ///< 缓冲能量不足时每焦耳减小的充电功率，单位 W/J
+  float taper_start_pct;    ///< 开始减小充电功率的剩余能量百分比，单位 %
+};
+
+class CapChargePlanner
+{
+ public:
+  typedef CapChargePlannerParams Params;
+
+  CapChargePlanner(const Params &params) : params_(params) {};
+  ~CapChargePlanner() {};
+
+  float calc(uint32_t tick, float pwr_limit, float pwr_buffer, float pwr_demand, float cap_pct, bool is_moving,
+             bool is_aiming, bool is_discharging);
+  void reset();
+
+  float getReqPwr() const { return req_pwr_; }
+  float getDemandPred() const { return demand_pred_; }
+  bool isIdle() const { return is_idle_; }
+  /** 是否使用静止时的功率余量，静止或自瞄且没有机动时为 true */
+  bool isLowMargin() const { return is_low_margin_; }
+
+ private:
+  Params params_;
+
+  bool is_inited_ = false;     ///< 是否已完成第一次规划
+  uint32_t last_tick_ = 0;     ///< 上一次规划的时间戳，单位 ms
+  float demand_pred_ = 0.0f;   ///< 底盘需求功率预测，单位 W
+  float req_pwr_ = 0.0f;       ///< 下发给电容板的充电功率，单位 W
+  bool is_idle_ = false;       ///< 底盘是否处于静止状态
+  bool is_low_margin_ = false; ///< 是否使用静止时的功率余量
+};
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+}  // namespace robot
+#endif /* ROBOT_MODULES_CAP_CHARGE_PLANNER_HPP_ */
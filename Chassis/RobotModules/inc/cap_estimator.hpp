@@ -0,0 +1,98 @@
+/**
+ *******************************************************************************
+ * @file      :cap_estimator.hpp
+ * @brief     : 超级电容容量与内阻在线估计
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 电容组等效为理想电容 C 串联内阻 R，端电压 v = v_oc - i * R，
+ *     电流以放电为正
+ *  2. 电流阶跃（充放电切换）时由端电压跳变估计内阻：R = -dv / di
+ *  3. 以内阻修正得到开路电压，按固定窗口累计电荷量，由 C = -dq / dv_oc 估计容量
+ *  4. 可用能量 = 0.5 * C * (v_oc^2 - v_floor^2)，其中 v_floor 为峰值放电电流下
+ *     端电压恰好降到最小有效电压时对应的开路电压，百分比以新电容组的可用能量为满量程
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ROBOT_MODULES_CAP_ESTIMATOR_HPP_
+#define ROBOT_MODULES_CAP_ESTIMATOR_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstdint>
+
+/* Exported macro ------------------------------------------------------------*/
+
+namespace robot
+{
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+struct CapEstimatorParams {
+  float c_nominal;         ///< 标称容量，单位 F
+  float r_nominal;         ///< 标称内阻，单位 Ohm
+  float c_min;             ///< 容量估计值下限，单位 F
+  float c_max;             ///< 容量估计值上限，单位 F
+  float r_min;             ///< 内阻估计值下限，单位 Ohm
+  float r_max;             ///< 内阻估计值上限，单位 Ohm
+  float v_max;             ///< 最大充电电压，单位 V
+  float v_min;             ///< 最小有效放电电压，单位 V
+  float i_peak;            ///< 计算可用能量时假设的峰值放电电流，单位 A
+  float esr_step_thres;    ///< 用于内阻估计的最小电流阶跃，单位 A
+  float esr_beta;          ///< 内阻估计的低通滤波系数，新值所占权重，值域 (0, 1]
+  uint32_t cap_window_ticks;  ///< 容量估计的积分窗口，单位 ms
+  float cap_min_dq;        ///< 容量估计所需的最小电荷变化量，单位 C
+  float cap_beta;          ///< 容量估计的低通滤波系数，新值所占权重，值域 (0, 1]
+  float enable_energy;     ///< 可用能量高于该值时才允许开启超电，单位 J
+  float disable_energy;    ///< 可用能量低于该值时关闭超电，单位 J
+};
+
+class CapEstimator
+{
+ public:
+  typedef CapEstimatorParams Params;
+
+  CapEstimator(const Params &params) : params_(params) { reset(); };
+  ~CapEstimator() {};
+
+  void update(float volt, float curr, float dt);
+  void reset();
+
+  float getCapacitance() const { return c_est_; }
+  float getEsr() const { return r_est_; }
+  float getOpenCircuitVolt() const { return v_oc_; }
+  /** 当前可用能量，单位 J */
+  float getUsableEnergy() const { return usable_energy_; }
+  /** 可用能量占新电容组可用能量的百分比，单位 %，值域 [0, 100] */
+  float getUsablePct() const { return usable_pct_; }
+  /** 可用能量是否足以开启超电，带迟滞 */
+  bool isEnergyEnough() const { return is_energy_enough_; }
+
+ private:
+  void updateEnergy();
+
+  Params params_;
+
+  bool is_inited_ = false;         ///< 是否已有上一次采样
+  float last_volt_ = 0.0f;         ///< 上一次采样的端电压，单位 V
+  float last_curr_ = 0.0f;         ///< 上一次采样的电流，单位 A
+  float c_est_ = 0.0f;             ///< 容量估计值，单位 F
+  float r_est_ = 0.0f;             ///< 内阻估计值，单位 Ohm
+  float v_oc_ = 0.0f;              ///< 开路电压估计值，单位 V
+
+  float win_v_oc_start_ = 0.0f;    ///< 容量估计窗口起点的开路电压，单位 V
+  float win_dq_ = 0.0f;            ///< 容量估计窗口内累计放出的电荷量，单位 C
+  float win_time_ = 0.0f;          ///< 容量估计窗口已持续的时间，单位 s
+
+  float usable_energy_ = 0.0f;     ///< 可用能量，单位 J
+  float usable_pct_ = 0.0f;        ///< 可用能量百分比，单位 %
+  bool is_energy_enough_ = false;  ///< 可用能量是否足以开启超电
+};
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+}  // namespace robot
+#endif /* ROBOT_MODULES_CAP_ESTIMATOR_HPP_ */
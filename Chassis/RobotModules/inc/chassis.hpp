@@ -20,13 +20,21 @@
 #include <cmath>
 
 #include "allocator.hpp"
+#include "cap_charge_planner.hpp"
+#include "cap_estimator.hpp"
 #include "chassis_iksolver.hpp"
+#include "current_pwr_limiter.hpp"
 #include "gimbal_chassis_comm.hpp"
+#include "gyro2follow_planner.hpp"
 #include "module_fsm_private.hpp"
 #include "motor.hpp"
+#include "omni_ik_kernel.hpp"
 #include "pid.hpp"
 #include "power_limiter.hpp"
 #include "super_cap.hpp"
+#include "traction_ctrl.hpp"
+#include "wheel_ffd.hpp"
+#include "wheel_thermal.hpp"
 #include "imu.hpp"
 /* Exported macro ------------------------------------------------------------*/
 // namespace hw_rfr = hello_world::referee;
@@ -97,6 +105,19 @@ struct ChassisConfig {
   float max_trans_vel;     ///< 最大平移速度
   float max_rot_spd;       ///< 最大旋转速度
   float cmd_smooth_factor;  ///< 运动指令平滑系数, 值域[0,1], 启用超电时默认为1
+  /* 跟随模式云台运动前馈 */
+  float follow_ffd_latency;     ///< 云台运动数据从采样到底盘执行的固定时延，单位 s
+  float follow_ffd_ref_weight;  ///< 前馈中云台期望角速度所占权重，值域[0,1]，其余为云台实际角速度
+  float follow_pid_min_scale;   ///< 跟随误差为 0 时跟随 PID 输出的缩放系数，值域[0,1]
+  float follow_pid_full_err;    ///< 跟随 PID 输出不缩放所需的跟随误差，单位 rad
+  /* 旋转平移相位滞后补偿 */
+  float theta_pred_latency;     ///< 除 YAW 反馈到达后经过的周期外，theta_i2r 预测的固定时延，单位 s
+  /* 小陀螺转速按云台力矩余量自适应 */
+  float gyro_headroom_low;      ///< 云台力矩余量低于该值时降低小陀螺转速，值域 [0, 1]
+  float gyro_headroom_high;     ///< 云台力矩余量高于该值时恢复小陀螺转速，值域 [0, 1]
+  float gyro_spd_scale_min;     ///< 小陀螺转速缩放系数的下限，值域 (0, 1]
+  float gyro_spd_scale_down;    ///< 小陀螺转速缩放系数的下降速率，单位 1/s
+  float gyro_spd_scale_up;      ///< 小陀螺转速缩放系数的恢复速率，单位 1/s
 };
 
 class Chassis : public Fsm
@@ -105,8 +126,17 @@ class Chassis : public Fsm
   typedef hello_world::motor::Motor Motor;
   typedef hello_world::pid::MultiNodesPid MultiNodesPid;
   typedef hello_world::chassis_ik_solver::ChassisIkSolver ChassisIkSolver;
+  typedef robot::OmniIkKernel OmniIkKernel;
   typedef hello_world::cap::SuperCap Cap;
   typedef hello_world::power_limiter::PowerLimiter PwrLimiter;
+  typedef hello_world::power_limiter::PowerLimiterRuntimeParams PwrLimiterRuntimeParams;
+  typedef robot::CurrentPwrLimiter CurrentPwrLimiter;
+  typedef robot::Gyro2FollowPlanner Gyro2FollowPlanner;
+  typedef robot::TractionCtrl TractionCtrl;
+  typedef robot::WheelFfd WheelFfd;
+  typedef robot::WheelThermal WheelThermal;
+  typedef robot::CapChargePlanner CapChargePlanner;
+  typedef robot::CapEstimator CapEstimator;
 
   typedef robot::GimbalChassisComm GimbalChassisComm;
   typedef ChassisWorkingMode WorkingMode;
@@ -131,6 +161,12 @@ class Chassis : public Fsm
     AntiClockwise = 1,  ///< 逆时针
   };
 
+  /** 功率限制所处的控制域 */
+  enum class PwrLimitDomain : uint8_t {
+    kSpeed,    ///< 在 PID 之前限制期望轮速
+    kCurrent,  ///< 在 PID 之后缩放期望电流
+  };
+
   enum WheelMotorIdx : uint8_t {
     kWheelMotorIdxLeftFront,   ///< 左前轮电机下标
     kWheelMotorIdxLeftRear,    ///< 左后轮电机下标
@@ -161,6 +197,12 @@ class Chassis : public Fsm
   void setNormCmd(const Cmd &cmd) { norm_cmd_ = cmd; }
   void setRfrData(const RfrData &data) { rfr_data_ = data; }
   float getThetaI2r(bool actual_head_dir = true) const;
+  /** 底盘期望偏航角速度，单位 rad/s */
+  float getYawSpdRef() const { return cmd_.w; }
+  /** 底盘期望偏航角速度的变化率，单位 rad/s^2 */
+  float getYawAccRef() const { return yaw_acc_ref_; }
+  /** 底盘当前偏航角速度（IMU），单位 rad/s */
+  float getYawSpdFdb() const;
   void revHead()
   {
     if (work_tick_ - last_rev_head_tick_ > 200) {
@@ -171,13 +213,24 @@ class Chassis : public Fsm
   void setGyroDir(GyroDir dir);
   void setUseCapFlag(bool flag) { use_cap_flag_ = flag; }
   void setnavigateFlag(bool flag) { navigate_flag_ = flag; }
+  void setAimingFlag(bool flag) { aiming_flag_ = flag; }
   bool getUseCapFlag() const { return use_cap_flag_; }
   void setGyroVariation(bool flag){variation_flag_ = flag; }
   void setDangerEnergy(bool flag ){energy_danger_flag = flag;}
   bool getDangerEnergy() const {return energy_danger_flag;};
   
   bool getGyroVariation() const {return variation_flag_; }
+  void setPwrLimitDomain(PwrLimitDomain domain) { pwr_limit_domain_ = domain; }
+  PwrLimitDomain getPwrLimitDomain() const { return pwr_limit_domain_; }
+  /** 是否处于三轮降级模式，即恰有一个轮电机离线 */
+  bool isDegraded() const { return dead_wheel_idx_ >= 0; }
+  int8_t getDeadWheelIdx() const { return dead_wheel_idx_; }
+  /** 超电可用能量百分比，由在线估计的容量与内阻得到，单位 % */
+  float getCapRemainingEnergy() const { return cap_remaining_energy_; }
+  /** 是否有轮电机估计温度超过警告阈值 */
+  bool isWheelOverheat() const { return wheel_thermal_ptr_ != nullptr && wheel_thermal_ptr_->isWarning(); }
   void registerIkSolver(ChassisIkSolver *ptr);
+  void registerOmniIkKernel(const OmniIkKernel *ptr);
   void registerWheelMotor(Motor *ptr, int idx);
   void registerYawMotor(Motor *ptr);
   void registerWheelPid(MultiNodesPid *ptr, int idx);
@@ -185,6 +238,13 @@ class Chassis : public Fsm
   void registerCap(Cap *ptr);
   void registerGimbalChassisComm(GimbalChassisComm *ptr);
   void registerPwrLimiter(PwrLimiter *ptr);
+  void registerCurrentPwrLimiter(CurrentPwrLimiter *ptr);
+  void registerGyro2FollowPlanner(Gyro2FollowPlanner *ptr);
+  void registerTractionCtrl(TractionCtrl *ptr);
+  void registerWheelFfd(WheelFfd *ptr);
+  void registerWheelThermal(WheelThermal *ptr);
+  void registerCapChargePlanner(CapChargePlanner *ptr);
+  void registerCapEstimator(CapEstimator *ptr);
   void registerImu(Imu *ptr);
 
  private:
@@ -192,6 +252,7 @@ class Chassis : public Fsm
   void updateData();
   void updateGimbalBoard();
   void updateMotor();
+  void updateThetaI2rPred();
   void updateCap();
   void updateIsPowerOn();
   void updatePwrState();
@@ -203,13 +264,19 @@ class Chassis : public Fsm
   // 工作状态下，获取控制指令的函数
   float variable_gyro();
   void revNormCmd();
+  float calcFollowFfd() const;
+  float calcGyroSpdScale();
+  float calcPwrAvail() const;
   void calcWheelSpeedRef();
   void updateSlopeAng();
   void calcwheelfeedbackRef();
+  void updatePwrLimiterRuntimeParams();
   void calcWheelLimitedSpeedRef();
   void calcPwrLimitedCurrentRef();
   void calcWheelCurrentRef();
+  void calcTractionCurrentRef();
   void calcWheelCurrentLimited();
+  float calcCapChargePwr(bool working_flag);
   void calcWheelRawInput();
 
   // 重置数据函数
@@ -245,10 +312,11 @@ class Chassis : public Fsm
 
   // 由 robot 设置的数据
   bool use_cap_flag_ = false;              ///< 是否使用超级电容
-  bool is_gyro2follow_handled_ = false;    ///< 小陀螺切跟随是否已经处理
   bool navigate_flag_ = false;             ///< 是否导航模式
+  bool aiming_flag_ = false;               ///< 云台是否处于自瞄
   bool variation_flag_ = false;            ///< 是否变速模式
   bool energy_danger_flag = false;
+  PwrLimitDomain pwr_limit_domain_ = PwrLimitDomain::kSpeed;  ///< 功率限制所处的控制域
   GyroDir gyro_dir_ = GyroDir::Unspecified;  ///< 小陀螺方向，正为绕 Z 轴逆时针，负为顺时针，
   GyroDir last_gyro_dir_ = GyroDir::Unspecified;  ///< 上一次小陀螺方向
   Cmd norm_cmd_ = {0};                     ///< 原始控制指令，基于图传坐标系
@@ -263,9 +331,18 @@ class Chassis : public Fsm
   uint32_t resurrection_time_ = 0;  ///< 底盘复活时间，单位为 ms
   // 在 runOnWorking 函数中更新的数据
   Cmd cmd_ = {0}, last_cmd_ = {0};          ///< 控制指令，基于图传坐标系
+  float yaw_acc_ref_ = 0.0f;                ///< 期望偏航角速度的变化率，供云台前馈做时延补偿，单位 rad/s^2
   float wheel_speed_ref_[4] = {0};          ///< 轮电机的速度参考值 单位 rad/s
   float wheel_speed_ref_limited_[4] = {0};  ///< 轮电机的速度参考值(限幅后) 单位 rad/s
   float wheel_current_ref_[4] = {0};        ///< 轮电机的电流参考值 单位 A [-20, 20]
+  float wheel_speed_gravity_[4] = {0};      ///< 重力分量逆解得到的轮速，单位 rad/s
+  float wheel_gravity_current_ffd_[4] = {0};  ///< 坡道重力补偿电流，由重力分量逆解轮速换算得到，单位 A
+  float wheel_current_ffd_[4] = {0};        ///< 惯性与摩擦前馈电流，单位 A
+  float wheel_pid_ffd_[4] = {0};            ///< 轮速 PID 的输出前馈（坡道重力补偿电流 + 惯性与摩擦前馈电流），单位 A
+  float wheel_current_ref_limited_[4] = {0};  ///< 轮电机的电流参考值(功率限制及限幅后) 单位 A
+  float wheel_raw_input_[4] = {0};          ///< 轮电机的最终输入量，单位与电机输入类型一致
+  float wheel_current_scale_ = 1.0f;        ///< 电流域功率限制得到的电流缩放系数，值域 [0, 1]
+  PwrLimiterRuntimeParams pwr_limiter_runtime_params_ = {0};  ///< 功率限制运行时参数，速度域与电流域共用
   bool rev_head_flag_ = false;              ///< 转向后退标志
   float last_rev_head_angle_ = 0.0f;         ///< 上一次转向后退的标志
   uint32_t last_rev_head_tick_ = 0;         ///< 上一次转向后退的时间戳
@@ -277,24 +354,48 @@ class Chassis : public Fsm
 
   // gimbal board fdb data  在 update 函数中更新
   bool is_gimbal_imu_ready_ = false;  ///< 云台主控板的IMU是否准备完毕
+  float gimbal_yaw_spd_ = 0.0f;       ///< 云台偏航角速度（期望与反馈加权），世界坐标系，单位 rad/s
+  float gimbal_yaw_acc_ = 0.0f;       ///< 云台偏航角加速度估计，单位 rad/s^2
+  uint8_t gimbal_motion_seq_ = 0;     ///< 最近一次收到的云台运动数据序号
+  uint32_t gimbal_motion_tick_ = 0;   ///< 最近一次收到云台运动数据的时间戳，单位 ms
+  float gimbal_yaw_tor_headroom_ = 1.0f;  ///< 云台偏航电机的力矩余量，值域 [0, 1]
+  float gyro_spd_scale_ = 1.0f;           ///< 小陀螺转速缩放系数，按云台力矩余量自适应
 
   // motor fdb data 在 update 函数中更新
   bool is_all_wheel_online_ = false;  ///< 所有轮电机是否都处于就绪状态
   bool is_any_wheel_online_ = false;  ///< 任意电机是否处于就绪状态
+  int8_t dead_wheel_idx_ = -1;        ///< 三轮降级模式下离线的轮电机下标，-1 表示未降级
   float wheel_speed_fdb_[4] = {0};    ///< 轮速反馈数据
   float wheel_current_fdb_[4] = {0};  ///< 轮电流反馈数据
+  float wheel_temp_fdb_[4] = {0};     ///< 轮电机温度反馈数据，单位 ℃
+  Cmd chassis_vel_fdb_ = {0};         ///< 轮速正解得到的底盘运动向量，基于底盘坐标系，单位 m/s, rad/s
   float theta_i2r_ = 0.0f;            ///< 图传坐标系绕 Z 轴到底盘坐标系的旋转角度，右手定则判定正反向，单位 rad
+  float theta_i2r_spd_ = 0.0f;        ///< theta_i2r 的变化率，由 YAW 电机反馈差分得到，单位 rad/s
+  float theta_i2r_pred_ = 0.0f;       ///< 预测的轮电机指令生效时刻的 theta_i2r，单位 rad
+  float theta_pred_latency_ = 0.0f;   ///< 预测使用的总时延，单位 s
+  float last_yaw_fdb_ang_ = 0.0f;     ///< 上一次 YAW 电机反馈角度，用于判断反馈是否更新，单位 rad
+  uint32_t yaw_fdb_tick_ = 0;         ///< 最近一次 YAW 电机反馈更新的时间戳，单位 ms
 
   // cap fdb data 在 update 函数中更新
   bool is_high_spd_enabled_ = false;   ///< 是否开启了高速模式 （开启意味着从电容取电）
-  float cap_remaining_energy_ = 0.0f;  ///< 剩余电容能量百分比，单位 %
+  float cap_remaining_energy_ = 0.0f;  ///< 超电可用能量百分比（CapEstimator），单位 %
+  float cap_board_energy_ = 0.0f;      ///< 电容板按电压换算的剩余能量百分比，功率限制器的收敛参数按此标定，单位 %
+  bool is_cap_energy_enough_ = false;  ///< 超电可用能量是否足以开启超电
 
   // 各组件指针
   // 无通信功能的组件指针
   ChassisIkSolver *ik_solver_ptr_ = nullptr;                ///< 逆解算器指针
+  const OmniIkKernel *omni_ik_kernel_ptr_ = nullptr;        ///< X 型全向轮解算核指针
   MultiNodesPid *wheel_pid_ptr_[kWheelPidNum] = {nullptr};  ///< PID 指针
   MultiNodesPid *follow_omega_pid_ptr_ = nullptr;           ///< 跟随模式下角速度 PID 指针
-  PwrLimiter *pwr_limiter_ptr_ = nullptr;
+  PwrLimiter *pwr_limiter_ptr_ = nullptr;                  ///< 速度域功率限制器指针
+  CurrentPwrLimiter *cur_pwr_limiter_ptr_ = nullptr;       ///< 电流域功率限制器指针
+  Gyro2FollowPlanner *gyro2follow_planner_ptr_ = nullptr;  ///< 小陀螺切跟随规划器指针
+  TractionCtrl *traction_ctrl_ptr_ = nullptr;              ///< 牵引力控制器指针
+  WheelFfd *wheel_ffd_ptr_ = nullptr;                      ///< 轮速 PID 惯性与摩擦前馈指针
+  WheelThermal *wheel_thermal_ptr_ = nullptr;              ///< 轮电机热模型指针
+  CapChargePlanner *cap_charge_planner_ptr_ = nullptr;     ///< 超电充电功率规划器指针
+  CapEstimator *cap_estimator_ptr_ = nullptr;              ///< 超电容量与内阻估计器指针
   // 只接收数据的组件指针
   GimbalChassisComm *gc_comm_ptr_ = nullptr;  ///< 云台底盘通信器指针 只接收数据
   Motor *yaw_motor_ptr_ = nullptr;            ///< 云台电机指针 接收、发送数据
@@ -0,0 +1,81 @@
+/**
+ *******************************************************************************
+ * @file      :current_pwr_limiter.hpp
+ * @brief     : 电流域功率限制器
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 在轮电机 PID 之后运行，直接对期望电流进行缩放，PID 的瞬态输出也受功率约束
+ *  2. 单电机功率模型：P_i = k_t * I_i * w_i + k_r * I_i^2 + k_w * |w_i|
+ *     所有电机共用一个缩放系数 s，总功率为 s 的二次函数，取满足预算的最大 s
+ *  3. 功率预算与速度域限制器共用同一组 PowerLimiterRuntimeParams
+ *  4. 与速度域限制器的急加速对比见 tools/host/pwr_limiter_sim.cpp：轮速 PID 与速度域模型一致时两者相当，
+ *     PID 输出偏离模型（如增益调整后未同步模型）时只有电流域能守住预算；电流滞后一周期生效，
+ *     按当前轮速预测的功率会略低于实际，超出预算的峰值为数瓦
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ROBOT_MODULES_CURRENT_PWR_LIMITER_HPP_
+#define ROBOT_MODULES_CURRENT_PWR_LIMITER_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstddef>
+
+#include "power_limiter.hpp"
+
+/* Exported macro ------------------------------------------------------------*/
+
+namespace robot
+{
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+struct CurrentPwrLimiterParams {
+  float k_t;        ///< 输出功率系数，单位 W/(A*rad/s)
+  float k_r;        ///< 铜损系数，单位 W/A^2
+  float k_w;        ///< 转速损耗系数，单位 W/(rad/s)
+  float p_bias;     ///< 底盘静息功率，单位 W
+  float out_limit;  ///< 单电机电流限幅，单位 A
+};
+
+class CurrentPwrLimiter
+{
+ public:
+  typedef hello_world::power_limiter::PowerLimiterRuntimeParams RuntimeParams;
+  typedef CurrentPwrLimiterParams Params;
+
+  CurrentPwrLimiter(const Params &params) : params_(params) {};
+  ~CurrentPwrLimiter() {};
+
+  float calc(const RuntimeParams &runtime_params, const float *cur_ref, const float *spd_fdb, size_t n);
+  float calcPwrBudget(const RuntimeParams &runtime_params) const;
+  float predictPwr(const float *cur_ref, const float *spd_fdb, size_t n, float scale = 1.0f) const;
+
+  float getScale() const { return scale_; }
+  float getPwrBudget() const { return p_budget_; }
+  float getPwrEstimated() const { return p_est_; }
+  float getOutLimit() const { return params_.out_limit; }
+
+  void reset()
+  {
+    scale_ = 1.0f;
+    p_budget_ = 0.0f;
+    p_est_ = 0.0f;
+  };
+
+ private:
+  Params params_;
+
+  float scale_ = 1.0f;     ///< 最近一次计算得到的电流缩放系数，值域 [0, 1]
+  float p_budget_ = 0.0f;  ///< 最近一次计算得到的功率预算，单位 W
+  float p_est_ = 0.0f;     ///< 缩放后的预测功率，单位 W
+};
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+}  // namespace robot
+#endif /* ROBOT_MODULES_CURRENT_PWR_LIMITER_HPP_ */
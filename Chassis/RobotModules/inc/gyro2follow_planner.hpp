@@ -0,0 +1,73 @@
+/**
+ *******************************************************************************
+ * @file      :gyro2follow_planner.hpp
+ * @brief     : 小陀螺切跟随的减速规划器
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 退出小陀螺时，在旋转方向上选取最近的、能以允许减速度停下的等效朝向
+ *     (车头或车尾对准云台)，然后按匀减速曲线给出底盘角速度期望，保证停下时恰好对准
+ *  2. 允许减速度取附着限制与功率限制中的较小值，制动功率按 P = k * alpha^2 估计
+ *  3. 匀减速曲线在剩余角度为 handoff_ang 时恰好降到 handoff_spd，剩余角度足够小且转速足够低时
+ *     结束规划，交由跟随 PID 处理
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ROBOT_MODULES_GYRO2FOLLOW_PLANNER_HPP_
+#define ROBOT_MODULES_GYRO2FOLLOW_PLANNER_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstdint>
+
+/* Exported macro ------------------------------------------------------------*/
+
+namespace robot
+{
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+struct Gyro2FollowPlannerParams {
+  float max_decel;        ///< 轮地附着允许的最大角减速度，单位 rad/s^2
+  float brake_pwr_coeff;  ///< 制动功率系数 k，P = k * alpha^2，单位 W/(rad/s^2)^2
+  float handoff_ang;      ///< 剩余角度小于该值且转速降到 handoff_spd 时交给跟随 PID，单位 rad
+  float handoff_spd;      ///< 交给跟随 PID 时的转速，开始时转速小于该值则不做规划，单位 rad/s
+};
+
+class Gyro2FollowPlanner
+{
+ public:
+  typedef Gyro2FollowPlannerParams Params;
+
+  Gyro2FollowPlanner(const Params &params) : params_(params) {};
+  ~Gyro2FollowPlanner() {};
+
+  void start(float theta_i2r, float spin_spd, float p_avail);
+  float calc(float theta_i2r, float spin_spd, float p_avail);
+  void reset();
+
+  bool isActive() const { return is_active_; }
+  /** 规划的目标朝向是否为车尾对准云台 */
+  bool isTgtRevHead() const { return is_tgt_rev_head_; }
+  float getRemainingAng() const { return remaining_ang_; }
+
+ private:
+  float calcMaxDecel(float p_avail) const;
+
+  Params params_;
+
+  bool is_active_ = false;        ///< 是否正在规划
+  bool is_tgt_rev_head_ = false;  ///< 目标朝向是否为车尾
+  float dir_ = 0.0f;              ///< 旋转方向，1 为逆时针，-1 为顺时针
+  float decel_ = 0.0f;            ///< 规划的角减速度，单位 rad/s^2
+  float remaining_ang_ = 0.0f;    ///< 沿旋转方向到目标朝向的剩余角度，单位 rad
+  float last_theta_ = 0.0f;       ///< 上一次的 theta_i2r，用于累计连续角度，单位 rad
+};
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+}  // namespace robot
+#endif /* ROBOT_MODULES_GYRO2FOLLOW_PLANNER_HPP_ */
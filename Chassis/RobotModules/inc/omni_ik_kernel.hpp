@@ -0,0 +1,144 @@
+/**
+ *******************************************************************************
+ * @file      :omni_ik_kernel.hpp
+ * @brief     : X 型四全向轮底盘专用运动学解算核
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 雅可比矩阵及其伪逆在构造时由轮组几何参数计算，声明为 constexpr 对象时
+ *     在编译期完成，运行时只剩一次 sin/cos 与若干次 4x3 乘加
+ *  2. 轮子顺序与 Chassis::WheelMotorIdx 一致：左前，左后，右后，右前
+ *  3. 旋转约定与 ChassisIkSolver 保持一致：v_r = R(-theta_i2r) * v_i
+ *  4. 轮上驱动力与电流成正比，底盘广义力 (F_x, F_y, M_z) 正比于 J^T * I
+ *  5. 与通用逆解的主机端容差比对见 tools/host/ik_kernel_check.cpp
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ROBOT_MODULES_OMNI_IK_KERNEL_HPP_
+#define ROBOT_MODULES_OMNI_IK_KERNEL_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstddef>
+#include <cstdint>
+
+/* Exported macro ------------------------------------------------------------*/
+
+namespace robot
+{
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+struct OmniIkKernelParams {
+  float wheel_radius;  ///< 轮子半径 [m]
+  float wheel2center;  ///< 轮子中心距旋转中心的距离 [m]
+};
+
+class OmniIkKernel
+{
+ public:
+  static constexpr size_t kWheelNum = 4;  ///< 轮子数量
+  static constexpr size_t kDof = 3;       ///< 底盘自由度 (v_x, v_y, w)
+
+  /** 解算任务的输入坐标系 */
+  enum class Frame : uint8_t {
+    kImage,  ///< 图传坐标系，解算前需要旋转 theta_i2r
+    kRobot,  ///< 底盘坐标系，直接解算
+  };
+
+  /** 批量逆解中的单个任务 */
+  struct IkJob {
+    const float *twist;  ///< 输入的底盘运动向量 {v_x, v_y, w}，单位 m/s, rad/s
+    Frame frame;         ///< 输入运动向量所处的坐标系
+    float *rot_spds;     ///< 输出的轮子转速，长度为 kWheelNum，单位 rad/s
+  };
+
+  constexpr OmniIkKernel(const OmniIkKernelParams &params)
+  {
+    // X 型布局下，轮子速度方向与位置都落在 45° 斜线上
+    constexpr float kSqrt2_2 = 0.70710678f;
+    // 左前，左后，右后，右前 轮子速度方向 (cos(theta_vel_fdb), sin(theta_vel_fdb))
+    const float dirs[kWheelNum][2] = {
+        {kSqrt2_2, -kSqrt2_2},
+        {kSqrt2_2, kSqrt2_2},
+        {-kSqrt2_2, kSqrt2_2},
+        {-kSqrt2_2, -kSqrt2_2},
+    };
+    // 轮子位置符号，x 为前方，y 为左方
+    const float pos_signs[kWheelNum][2] = {
+        {1.0f, 1.0f},
+        {-1.0f, 1.0f},
+        {-1.0f, -1.0f},
+        {1.0f, -1.0f},
+    };
+    const float half_span = params.wheel2center * kSqrt2_2;
+    const float inv_r = 1.0f / params.wheel_radius;
+
+    for (size_t i = 0; i < kWheelNum; i++) {
+      float px = pos_signs[i][0] * half_span;
+      float py = pos_signs[i][1] * half_span;
+      jac_[i][0] = dirs[i][0] * inv_r;
+      jac_[i][1] = dirs[i][1] * inv_r;
+      jac_[i][2] = (px * dirs[i][1] - py * dirs[i][0]) * inv_r;
+    }
+
+    // 正解使用最小二乘伪逆 (J^T J)^-1 J^T
+    float jtj[kDof][kDof] = {{0}};
+    for (size_t r = 0; r < kDof; r++) {
+      for (size_t c = 0; c < kDof; c++) {
+        for (size_t i = 0; i < kWheelNum; i++) {
+          jtj[r][c] += jac_[i][r] * jac_[i][c];
+        }
+      }
+    }
+    float inv[kDof][kDof] = {{0}};
+    Inv3x3(jtj, inv);
+    for (size_t r = 0; r < kDof; r++) {
+      for (size_t i = 0; i < kWheelNum; i++) {
+        fk_[r][i] = 0.0f;
+        for (size_t c = 0; c < kDof; c++) {
+          fk_[r][i] += inv[r][c] * jac_[i][c];
+        }
+      }
+    }
+  };
+
+  void solve(IkJob *jobs, size_t n, float theta_i2r) const;
+  void solveInRobotFrame(const float twist_r[kDof], float rot_spds[kWheelNum]) const;
+  void fkSolve(const float rot_spds[kWheelNum], float twist_r[kDof]) const;
+  void fkSolveWls(const float rot_spds[kWheelNum], const float weights[kWheelNum], float twist_r[kDof]) const;
+  void wrenchToWheel(const float wrench[kDof], float out[kWheelNum]) const;
+  void allocateWls(const float cur_in[kWheelNum], const float weights[kWheelNum], float cur_out[kWheelNum]) const;
+
+  constexpr const float (&jacobian() const)[kWheelNum][kDof] { return jac_; }
+
+ private:
+  static constexpr void Inv3x3(const float m[kDof][kDof], float inv[kDof][kDof])
+  {
+    float c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+    float c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+    float c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+    float det = m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02;
+    float inv_det = 1.0f / det;
+    inv[0][0] = c00 * inv_det;
+    inv[1][0] = c01 * inv_det;
+    inv[2][0] = c02 * inv_det;
+    inv[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * inv_det;
+    inv[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * inv_det;
+    inv[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * inv_det;
+    inv[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * inv_det;
+    inv[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * inv_det;
+    inv[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * inv_det;
+  };
+
+  float jac_[kWheelNum][kDof] = {{0}};  ///< 逆解雅可比矩阵，轮速 = J * v_r
+  float fk_[kDof][kWheelNum] = {{0}};   ///< 正解矩阵，v_r = J^+ * 轮速
+};
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+}  // namespace robot
+#endif /* ROBOT_MODULES_OMNI_IK_KERNEL_HPP_ */
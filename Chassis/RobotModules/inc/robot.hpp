@@ -184,6 +184,7 @@ class Robot : public Fsm
 
   uint32_t last_rev_work_tick_ = 0;
   uint32_t last_rev_chassis_tick_ = 0;
+  bool last_pwr_domain_key_pressed_ = false;  ///< 上一周期功率限制域切换键是否按下
 
   uint8_t buff_mode_ = false;  ///< buff 模式
   uint8_t last_buff_mode_ = false;  ///< 上一个 buff 模式
@@ -0,0 +1,88 @@
+/**
+ *******************************************************************************
+ * @file      :traction_ctrl.hpp
+ * @brief     : 全向轮底盘打滑检测与牵引力控制
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 由 IMU 加速度与角速度推算底盘中心的加速度，经雅可比矩阵得到各轮的期望角加速度，
+ *     与轮速差分得到的实际角加速度之差作为运动学一致性残差，残差过大视为打滑
+ *  2. 有轮子打滑时，按加权最小二乘将底盘广义力重新分配到其余轮子，打滑轮超出电流上限时
+ *     所有轮子等比例缩小，保持广义力的方向；无打滑时不改变 PID 输出
+ *  3. IMU 坐标轴需与底盘坐标系对齐，加速度输入需已扣除重力分量
+ *  4. 不可用（离线）的轮子不参与打滑判定，分配权重为 0
+ *  5. Chassis 以 Imu::acc_x()/acc_y() 加 9.8 倍重力分量作为加速度输入，即假设其为加速度计比力
+ *     （含重力，单位 m/s^2，坐标轴与底盘一致）；HW-Components 不在本仓库，该假设未经核实，
+ *     需在实车上倾斜静置底盘确认输入接近 0，否则需改正符号或单位
+ *  6. 随机摩擦下有无电流重分配的路径偏差与单位功率加速度见 tools/host/traction_sim.cpp
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ROBOT_MODULES_TRACTION_CTRL_HPP_
+#define ROBOT_MODULES_TRACTION_CTRL_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstddef>
+#include <cstdint>
+
+#include "omni_ik_kernel.hpp"
+
+/* Exported macro ------------------------------------------------------------*/
+
+namespace robot
+{
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+struct TractionCtrlParams {
+  float imu_pos_x;          ///< IMU 相对底盘旋转中心的 x 坐标，单位 m
+  float imu_pos_y;          ///< IMU 相对底盘旋转中心的 y 坐标，单位 m
+  float residual_filter;    ///< 残差低通滤波系数，新值所占权重，值域 (0, 1]
+  float slip_enter_thres;   ///< 判定为打滑的残差阈值，单位 rad/s^2
+  float slip_exit_thres;    ///< 判定为恢复抓地的残差阈值，单位 rad/s^2
+  uint32_t slip_hold_ticks;  ///< 恢复抓地后继续按打滑处理的周期数
+  float slip_weight;        ///< 打滑轮在电流分配中的权重，值域 (0, 1]
+  float slip_cur_limit;     ///< 打滑轮的电流上限，单位 A
+};
+
+class TractionCtrl
+{
+ public:
+  typedef TractionCtrlParams Params;
+  static constexpr size_t kWheelNum = OmniIkKernel::kWheelNum;
+
+  TractionCtrl(const Params &params) : params_(params) { reset(); };
+  ~TractionCtrl() {};
+
+  void update(const OmniIkKernel &kernel, const float spd_fdb[kWheelNum], const float twist_fdb[OmniIkKernel::kDof],
+              const float imu_acc[2], float imu_gyro_z, float dt);
+  void allocate(const OmniIkKernel &kernel, float cur[kWheelNum]) const;
+  void reset();
+
+  void setWheelAvailable(size_t idx, bool is_available) { is_available_[idx] = is_available; }
+  bool isSlipping(size_t idx) const { return slip_hold_cnt_[idx] > 0; }
+  bool isAnySlipping() const;
+  float getResidual(size_t idx) const { return residual_[idx]; }
+  const float *getWeights() const { return weights_; }
+
+ private:
+  Params params_;
+
+  bool is_inited_ = false;               ///< 是否已有上一周期数据
+  float last_spd_fdb_[kWheelNum] = {0};  ///< 上一周期的轮速，单位 rad/s
+  float last_gyro_z_ = 0.0f;             ///< 上一周期的底盘角速度，单位 rad/s
+  float residual_[kWheelNum] = {0};      ///< 滤波后的运动学一致性残差，单位 rad/s^2
+  bool is_slipping_[kWheelNum] = {0};    ///< 残差判定的打滑状态
+  uint32_t slip_hold_cnt_[kWheelNum] = {0};  ///< 打滑保持计数
+  float weights_[kWheelNum] = {0};       ///< 电流分配权重
+  bool is_available_[kWheelNum] = {0};   ///< 轮子是否可用
+};
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+}  // namespace robot
+#endif /* ROBOT_MODULES_TRACTION_CTRL_HPP_ */
@@ -57,11 +57,12 @@ class UiDrawer
   enum DynamicUiIdx {
     kDuiChassisContent,
     kDuiGimbalContent,
-    kDuiPkgGroup1,  ///< 云台 pitch yaw 角度反馈，拨盘角度反馈，摩擦轮转速反馈，超电，底盘朝向(2)
+    kDuiPkgGroup1,  ///< 云台 pitch yaw 角度反馈，拨盘角度反馈，摩擦轮转速反馈，超电，底盘朝向(2)，离线轮子
     kDuiPkgGroup2,  ///< 云台 pitch yaw 角度期望，拨盘角度期望，摩擦轮转速期望，小云台预设值，小云台当前俯仰角度
     kDuiPkgGroup3,
     kDuiPkgGroup4,
     kDuiPkgGroup5,
+    kDuiPkgGroup6,  ///< 轮电机过热警告
     kDuiPkgNum,
   };
 
@@ -109,6 +110,8 @@ class UiDrawer
     }
   }
   void setChassisHeadDir(float theta_i2r) { theta_i2r_ = theta_i2r; }
+  void setChassisDeadWheelIdx(int8_t idx) { chassis_dead_wheel_idx_ = idx; }
+  void setChassisWheelOverheat(bool flag) { is_wheel_overheat_ = flag; }
 
   void setGimbalWorkState(FsmWorkState state)
   {
@@ -201,11 +204,13 @@ class UiDrawer
   bool encodeDynaUiPkgGroup3(uint8_t* data_ptr, size_t& data_len, GraphicOperation opt);
   bool encodeDynaUiPkgGroup4(uint8_t* data_ptr, size_t& data_len, GraphicOperation opt);
   bool encodeDynaUiPkgGroup5(uint8_t* data_ptr, size_t& data_len, GraphicOperation opt);
+  bool encodeDynaUiPkgGroup6(uint8_t* data_ptr, size_t& data_len, GraphicOperation opt);
 
   void genChassisStatus(hello_world::referee::Arc& g_head, hello_world::referee::Arc& g_other);
   void genChassisPassLineLeft(hello_world::referee::StraightLine& g);
   void genChassisPassLineRight(hello_world::referee::StraightLine& g);
   void genArmorHit(hello_world::referee::Arc &g_hit);
+  void genChassisDeadWheel(hello_world::referee::Arc &g);
 
   void genPassSafe(hello_world::referee::Circle& g, bool is_safe);
 
@@ -233,6 +238,8 @@ class UiDrawer
   ChassisWorkingMode chassis_working_mode_ = ChassisWorkingMode::Depart;
   ChassisWorkingMode last_chassis_working_mode_ = ChassisWorkingMode::Depart;
   float theta_i2r_ = 0.0f;
+  int8_t chassis_dead_wheel_idx_ = -1;  ///< 三轮降级模式下离线的轮电机下标，-1 表示未降级
+  bool is_wheel_overheat_ = false;      ///< 轮电机估计温度是否超过警告阈值
 
   // var for gimbal
   FsmWorkState gimbal_work_state_ = FsmWorkState::Dead;
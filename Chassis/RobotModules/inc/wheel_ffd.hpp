@@ -0,0 +1,77 @@
+/**
+ *******************************************************************************
+ * @file      :wheel_ffd.hpp
+ * @brief     : 轮电机惯性与摩擦电流前馈
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 对整形后的期望轮速差分得到期望角加速度，前馈电流由四部分组成：
+ *     转子与轮子惯性、整车质量与转动惯量、粘滞摩擦、库仑摩擦
+ *  2. 整车惯性项在底盘坐标系下计算广义力，需计入旋转坐标系的 w x v 项，
+ *     再按最小范数分配到各轮，小陀螺平移时不会产生多余的前馈
+ *  3. 输出单位为 A，作为轮速 PID 的前馈，与 PID 输出一并进入功率限制
+ *  4. 坡道重力补偿由 Chassis 将重力分量（单位 g）当作平移速度逆解为轮速，再乘 gravity_curr_per_spd 换算为电流；
+ *     按最小范数分配时理论值为 mass * 9.81 * r^2 / (2 * k_tau)，r 为轮子半径
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ROBOT_MODULES_WHEEL_FFD_HPP_
+#define ROBOT_MODULES_WHEEL_FFD_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstddef>
+
+#include "omni_ik_kernel.hpp"
+
+/* Exported macro ------------------------------------------------------------*/
+
+namespace robot
+{
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+struct WheelFfdParams {
+  float k_tau;             ///< 轮端转矩常数，单位 N*m/A
+  float mass;              ///< 整车质量，单位 kg
+  float inertia_z;         ///< 整车绕 Z 轴转动惯量，单位 kg*m^2
+  float rotor_inertia;     ///< 折算到轮端的转子与轮子转动惯量，单位 kg*m^2
+  float visc;              ///< 粘滞摩擦电流系数，单位 A/(rad/s)
+  float coulomb;           ///< 库仑摩擦电流，单位 A
+  float coulomb_spd_band;  ///< 库仑摩擦在该转速内线性过渡，避免零速附近抖动，单位 rad/s
+  float acc_filter;        ///< 角加速度低通滤波系数，新值所占权重，值域 (0, 1]
+  float max_ffd;           ///< 前馈电流限幅，单位 A
+  float gravity_curr_per_spd;  ///< 坡道重力补偿电流与重力分量逆解轮速之比，单位 A/(rad/s)
+};
+
+class WheelFfd
+{
+ public:
+  typedef WheelFfdParams Params;
+  static constexpr size_t kWheelNum = OmniIkKernel::kWheelNum;
+
+  WheelFfd(const Params &params) : params_(params) {};
+  ~WheelFfd() {};
+
+  void calc(const OmniIkKernel &kernel, const float spd_ref[kWheelNum], float dt, float ffd[kWheelNum]);
+  void reset();
+
+  const float *getAccRef() const { return acc_ref_; }
+  /** 坡道重力补偿电流与重力分量逆解轮速之比，单位 A/(rad/s) */
+  float getGravityCurrPerSpd() const { return params_.gravity_curr_per_spd; }
+
+ private:
+  Params params_;
+
+  bool is_inited_ = false;               ///< 是否已有上一周期数据
+  float last_spd_ref_[kWheelNum] = {0};  ///< 上一周期的期望轮速，单位 rad/s
+  float acc_ref_[kWheelNum] = {0};       ///< 滤波后的期望轮角加速度，单位 rad/s^2
+};
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+}  // namespace robot
+#endif /* ROBOT_MODULES_WHEEL_FFD_HPP_ */
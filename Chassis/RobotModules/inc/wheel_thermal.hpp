@@ -0,0 +1,76 @@
+/**
+ *******************************************************************************
+ * @file      :wheel_thermal.hpp
+ * @brief     : 轮电机热模型与预测性降额
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 每个电机使用一阶绕组温度模型：C * dT/dt = I^2 * R - (T - T_amb) / R_th，
+ *     电机反馈的温度更新时，以一定增益将估计值拉向反馈值，且估计值不低于反馈值
+ *  2. 温度在 [t_derate_start, t_derate_end] 之间时，按平滑曲线将电流限幅系数
+ *     从 1 降至 min_scale，避免驱动器过温保护时力矩突然消失
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ROBOT_MODULES_WHEEL_THERMAL_HPP_
+#define ROBOT_MODULES_WHEEL_THERMAL_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstddef>
+
+/* Exported macro ------------------------------------------------------------*/
+
+namespace robot
+{
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+struct WheelThermalParams {
+  float r_winding;       ///< 绕组电阻，单位 Ohm
+  float c_th;            ///< 绕组热容，单位 J/℃
+  float r_th;            ///< 绕组到环境的热阻，单位 ℃/W
+  float t_amb;           ///< 环境温度，单位 ℃
+  float k_obs;           ///< 反馈温度修正增益，每次反馈更新时的修正比例，值域 [0, 1]
+  float t_derate_start;  ///< 开始降额的温度，单位 ℃
+  float t_derate_end;    ///< 降额到最小系数的温度，单位 ℃
+  float min_scale;       ///< 最小电流限幅系数，值域 (0, 1]
+  float t_warn;          ///< 触发过温警告的温度，单位 ℃
+};
+
+class WheelThermal
+{
+ public:
+  typedef WheelThermalParams Params;
+  static constexpr size_t kMotorNum = 4;
+
+  WheelThermal(const Params &params) : params_(params) { reset(); };
+  ~WheelThermal() {};
+
+  void update(const float cur[kMotorNum], const float temp_fdb[kMotorNum], const bool is_online[kMotorNum], float dt);
+  void reset();
+
+  float getTempEst(size_t idx) const { return t_est_[idx]; }
+  float getMaxTempEst() const;
+  /** 电流限幅系数，值域 [min_scale, 1] */
+  float getScale(size_t idx) const { return scale_[idx]; }
+  float getMinScale() const;
+  bool isWarning() const { return getMaxTempEst() > params_.t_warn; }
+
+ private:
+  float calcScale(float temp) const;
+
+  Params params_;
+
+  float t_est_[kMotorNum] = {0};          ///< 绕组温度估计值，单位 ℃
+  float last_temp_fdb_[kMotorNum] = {0};  ///< 上一次的反馈温度，用于判断反馈是否更新，单位 ℃
+  float scale_[kMotorNum] = {0};          ///< 电流限幅系数
+};
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+}  // namespace robot
+#endif /* ROBOT_MODULES_WHEEL_THERMAL_HPP_ */
@@ -0,0 +1,95 @@
+/**
+ *******************************************************************************
+ * @file      :cap_charge_planner.cpp
+ * @brief     : 超级电容充电功率规划
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "cap_charge_planner.hpp"
+/* Private macro -------------------------------------------------------------*/
+
+namespace robot
+{
+/* Private constants ---------------------------------------------------------*/
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported function definitions ---------------------------------------------*/
+
+/**
+ * @brief       规划电容充电功率
+ * @param        tick: 当前时间戳，单位 ms
+ * @param        pwr_limit: 裁判系统底盘功率上限，单位 W
+ * @param        pwr_buffer: 裁判系统缓冲能量，单位 J
+ * @param        pwr_demand: 本周期底盘需求功率预测，单位 W
+ * @param        cap_pct: 电容剩余能量百分比，单位 %
+ * @param        is_moving: 是否处于机动（有平移指令，或非自瞄时有旋转或小陀螺指令）
+ * @param        is_aiming: 云台是否处于自瞄
+ * @param        is_discharging: 电容是否正在放电
+ * @retval      充电功率，单位 W
+ * @note        每个控制周期调用，需求功率每周期更新，充电功率按规划周期更新
+ */
+float CapChargePlanner::calc(uint32_t tick, float pwr_limit, float pwr_buffer, float pwr_demand, float cap_pct,
+                             bool is_moving, bool is_aiming, bool is_discharging)
+{
+  // 需求上升时立即跟随，下降时缓慢回落，避免机动间隙里抢走驱动功率
+  if (!is_inited_ || pwr_demand > demand_pred_) {
+    demand_pred_ = pwr_demand;
+  } else {
+    demand_pred_ += params_.demand_fall_beta * (pwr_demand - demand_pred_);
+  }
+
+  if (is_inited_ && tick - last_tick_ < params_.period_ticks) {
+    return req_pwr_;
+  }
+  is_inited_ = true;
+  last_tick_ = tick;
+
+  is_idle_ = !is_moving && demand_pred_ < params_.idle_demand_thres;
+  is_low_margin_ = is_idle_ || (is_aiming && !is_moving);
+
+  if (is_discharging) {
+    req_pwr_ = 0.0f;
+    return req_pwr_;
+  }
+
+  float margin = is_low_margin_ ? params_.idle_margin : params_.move_margin;
+  float pwr = pwr_limit - demand_pred_ - margin;
+  if (pwr_buffer < params_.buffer_target) {
+    pwr -= params_.buffer_kp * (params_.buffer_target - pwr_buffer);
+  }
+
+  if (cap_pct > params_.taper_start_pct) {
+    float ratio = (100.0f - cap_pct) / (100.0f - params_.taper_start_pct);
+    pwr *= ratio > 0.0f ? ratio : 0.0f;
+  }
+
+  if (pwr > params_.max_charge_pwr) {
+    pwr = params_.max_charge_pwr;
+  } else if (pwr < 0.0f) {
+    pwr = 0.0f;
+  }
+  req_pwr_ = pwr;
+  return req_pwr_;
+};
+
+void CapChargePlanner::reset()
+{
+  is_inited_ = false;
+  last_tick_ = 0;
+  demand_pred_ = 0.0f;
+  req_pwr_ = 0.0f;
+  is_idle_ = false;
+  is_low_margin_ = false;
+};
+/* Private function definitions ----------------------------------------------*/
+}  // namespace robot
@@ -0,0 +1,123 @@
+/**
+ *******************************************************************************
+ * @file      :cap_estimator.cpp
+ * @brief     : 超级电容容量与内阻在线估计
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "cap_estimator.hpp"
+
+#include <cmath>
+/* Private macro -------------------------------------------------------------*/
+
+namespace robot
+{
+/* Private constants ---------------------------------------------------------*/
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported function definitions ---------------------------------------------*/
+
+/**
+ * @brief       更新容量、内阻与可用能量估计
+ * @param        volt: 电容组端电压，单位 V
+ * @param        curr: 电容组电流，放电为正，单位 A
+ * @param        dt: 更新周期，单位 s
+ * @note        电容板反馈频率低于控制频率，只在反馈变化时估计内阻，电荷量按零阶保持积分
+ */
+void CapEstimator::update(float volt, float curr, float dt)
+{
+  if (!is_inited_) {
+    last_volt_ = volt;
+    last_curr_ = curr;
+    v_oc_ = volt + curr * r_est_;
+    win_v_oc_start_ = v_oc_;
+    win_dq_ = 0.0f;
+    win_time_ = 0.0f;
+    is_inited_ = true;
+  }
+
+  // 内阻：电流阶跃瞬间电容电压来不及变化，端电压的跳变全部来自内阻
+  bool is_updated = (volt != last_volt_) || (curr != last_curr_);
+  if (is_updated) {
+    float di = curr - last_curr_;
+    if (fabsf(di) > params_.esr_step_thres) {
+      float r_meas = -(volt - last_volt_) / di;
+      if (r_meas > params_.r_min && r_meas < params_.r_max) {
+        r_est_ += params_.esr_beta * (r_meas - r_est_);
+      }
+    }
+    last_volt_ = volt;
+    last_curr_ = curr;
+  }
+
+  v_oc_ = volt + curr * r_est_;
+
+  // 容量：窗口内放出的电荷量与开路电压下降量之比
+  win_dq_ += curr * dt;
+  win_time_ += dt;
+  if (win_time_ * 1000.0f >= params_.cap_window_ticks) {
+    float dv_oc = v_oc_ - win_v_oc_start_;
+    if (fabsf(win_dq_) > params_.cap_min_dq && fabsf(dv_oc) > 1e-3f) {
+      float c_meas = -win_dq_ / dv_oc;
+      if (c_meas > params_.c_min && c_meas < params_.c_max) {
+        c_est_ += params_.cap_beta * (c_meas - c_est_);
+      }
+    }
+    win_v_oc_start_ = v_oc_;
+    win_dq_ = 0.0f;
+    win_time_ = 0.0f;
+  }
+
+  updateEnergy();
+};
+
+void CapEstimator::reset()
+{
+  is_inited_ = false;
+  last_volt_ = 0.0f;
+  last_curr_ = 0.0f;
+  c_est_ = params_.c_nominal;
+  r_est_ = params_.r_nominal;
+  v_oc_ = 0.0f;
+  win_v_oc_start_ = 0.0f;
+  win_dq_ = 0.0f;
+  win_time_ = 0.0f;
+  usable_energy_ = 0.0f;
+  usable_pct_ = 0.0f;
+  is_energy_enough_ = false;
+};
+/* Private function definitions ----------------------------------------------*/
+
+void CapEstimator::updateEnergy()
+{
+  // 峰值电流下端电压不低于最小有效电压所需的开路电压
+  float v_floor = params_.v_min + params_.i_peak * r_est_;
+  if (v_oc_ > v_floor) {
+    usable_energy_ = 0.5f * c_est_ * (v_oc_ * v_oc_ - v_floor * v_floor);
+  } else {
+    usable_energy_ = 0.0f;
+  }
+
+  float v_floor_nominal = params_.v_min + params_.i_peak * params_.r_nominal;
+  float full_energy = 0.5f * params_.c_nominal *
+                      (params_.v_max * params_.v_max - v_floor_nominal * v_floor_nominal);
+  float pct = full_energy > 0.0f ? 100.0f * usable_energy_ / full_energy : 0.0f;
+  usable_pct_ = pct < 100.0f ? pct : 100.0f;
+
+  if (usable_energy_ > params_.enable_energy) {
+    is_energy_enough_ = true;
+  } else if (usable_energy_ < params_.disable_energy) {
+    is_energy_enough_ = false;
+  }
+};
+}  // namespace robot
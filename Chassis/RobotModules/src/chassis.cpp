@@ -19,6 +19,12 @@
 float wheel_speed_fdb_debug = 0;
 float wheel_speed_ref_debug = 0;
 
+// 置 1 时每周期额外调用通用逆解器，与解算核的结果做比对，最大误差记录在 ik_kernel_err_debug 中
+#define CHASSIS_IK_KERNEL_CROSS_CHECK 0
+#if CHASSIS_IK_KERNEL_CROSS_CHECK
+float ik_kernel_err_debug = 0;
+#endif
+
 // TODO: norm_cmd_和cmd_好像没有关联起来，非常奇怪
 // Robot的runOnWorking里产生各个模块的norm_cmd_
 namespace robot
@@ -119,10 +125,32 @@ namespace robot
     if (gc_comm_ptr_->isOffline())
     {
       is_gimbal_imu_ready_ = true;
+      gimbal_yaw_spd_ = 0.0f;
+      gimbal_yaw_acc_ = 0.0f;
+      gimbal_yaw_tor_headroom_ = 1.0f;
     }
     else
     {
       is_gimbal_imu_ready_ = gc_comm_ptr_->main_board_data().gp.is_gimbal_imu_ready;
+
+      // 云台运动数据更新时，记录接收时刻并差分估计角加速度，用于时延补偿
+      const GimbalChassisComm::GimbalData::GimbalPart &gimbal_data = gc_comm_ptr_->gimbal_data().gp;
+      gimbal_yaw_tor_headroom_ = gimbal_data.yaw_tor_headroom;
+      if (gimbal_data.motion_seq != gimbal_motion_seq_)
+      {
+        float ref_weight = cfg_.follow_ffd_ref_weight;
+        float yaw_spd = ref_weight * gimbal_data.yaw_spd_ref + (1.0f - ref_weight) * gimbal_data.yaw_spd_fdb;
+        uint32_t dt_ms = work_tick_ - gimbal_motion_tick_;
+        float yaw_acc = 0.0f;
+        if (dt_ms > 0 && dt_ms < 20)
+        {
+          yaw_acc = (yaw_spd - gimbal_yaw_spd_) * 1000.0f / dt_ms;
+        }
+        gimbal_yaw_acc_ = 0.7f * gimbal_yaw_acc_ + 0.3f * yaw_acc;
+        gimbal_yaw_spd_ = yaw_spd;
+        gimbal_motion_seq_ = gimbal_data.motion_seq;
+        gimbal_motion_tick_ = work_tick_;
+      }
     }
   };
 
@@ -138,6 +166,8 @@ namespace robot
     };
     bool is_all_wheel_online = true;
     bool is_any_wheel_online = false;
+    int8_t dead_wheel_idx = -1;
+    size_t offline_cnt = 0;
     for (size_t i = 0; i < 4; i++)
     {
       WheelMotorIdx wmi = wmis[i];
@@ -148,18 +178,46 @@ namespace robot
         offline_tick[i]++;
         wheel_speed_fdb_[wmi] = 0.0;
         wheel_current_fdb_[wmi] = 0.0;
+        wheel_temp_fdb_[wmi] = 0.0;
         is_all_wheel_online = false;
+        dead_wheel_idx = wmi;
+        offline_cnt++;
       }
       else
       {
         is_any_wheel_online = true;
         wheel_speed_fdb_[wmi] = motor_ptr->vel();
         wheel_current_fdb_[wmi] = motor_ptr->curr();
+        wheel_temp_fdb_[wmi] = motor_ptr->temp();
       }
     }
 
     is_all_wheel_online_ = is_all_wheel_online;
     is_any_wheel_online_ = is_any_wheel_online;
+    // X 型布局任意三个轮子仍可控制平面内三个自由度，仅一个轮电机离线时进入三轮降级模式
+    dead_wheel_idx_ = (offline_cnt == 1) ? dead_wheel_idx : -1;
+
+    // 绕组温度估计在任何状态下都持续更新，死亡期间电机仍在散热
+    HW_ASSERT(wheel_thermal_ptr_ != nullptr, "pointer to WheelThermal is nullptr", wheel_thermal_ptr_);
+    bool is_wheel_online[4] = {false};
+    for (size_t i = 0; i < 4; i++)
+    {
+      is_wheel_online[i] = !wheel_motor_ptr_[i]->isOffline();
+    }
+    wheel_thermal_ptr_->update(wheel_current_fdb_, wheel_temp_fdb_, is_wheel_online, interval_ticks_ * 0.001f);
+
+    // 由轮速正解底盘运动向量，降级模式下剔除离线轮子
+    HW_ASSERT(omni_ik_kernel_ptr_ != nullptr, "pointer to IK kernel is nullptr", omni_ik_kernel_ptr_);
+    if (isDegraded())
+    {
+      float weights[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+      weights[dead_wheel_idx_] = 0.0f;
+      omni_ik_kernel_ptr_->fkSolveWls(wheel_speed_fdb_, weights, chassis_vel_fdb_.data);
+    }
+    else
+    {
+      omni_ik_kernel_ptr_->fkSolve(wheel_speed_fdb_, chassis_vel_fdb_.data);
+    }
 
     HW_ASSERT(yaw_motor_ptr_ != nullptr, "pointer to Yaw motor is nullptr", yaw_motor_ptr_);
     if (yaw_motor_ptr_->isOffline())
@@ -170,20 +228,69 @@ namespace robot
     {
       theta_i2r_ = -yaw_motor_ptr_->angle();
     }
+    updateThetaI2rPred();
+  };
+
+  /**
+   * @brief       预测轮电机指令生效时刻的 theta_i2r
+   * @note        总时延 = YAW 电机反馈到达后经过的时间 + 固定时延 theta_pred_latency（指令发送到生效、
+   *              指令保持半个周期、反馈的 CAN 时延与读取等待），
+   *              YAW 电机反馈以角度变化判断是否更新，超过 kYawFdbTimeout 未变化视为静止，
+   *              因此总时延实际不超过 kYawFdbTimeout + theta_pred_latency，20 ms 上限仅作保护
+   */
+  void Chassis::updateThetaI2rPred()
+  {
+    const uint32_t kYawFdbTimeout = 3; ///< 单位 ms
+    if (yaw_motor_ptr_->isOffline())
+    {
+      theta_i2r_spd_ = 0.0f;
+      theta_i2r_pred_ = theta_i2r_;
+      theta_pred_latency_ = 0.0f;
+      yaw_fdb_tick_ = work_tick_;
+      return;
+    }
+
+    uint32_t dt_tick = work_tick_ - yaw_fdb_tick_;
+    if (theta_i2r_ != last_yaw_fdb_ang_ || dt_tick > kYawFdbTimeout)
+    {
+      if (dt_tick > 0 && dt_tick <= 10)
+      {
+        float spd = hello_world::AngleNormRad(theta_i2r_ - last_yaw_fdb_ang_) / (dt_tick * 0.001f);
+        theta_i2r_spd_ = 0.5f * theta_i2r_spd_ + 0.5f * spd;
+      }
+      else
+      {
+        theta_i2r_spd_ = 0.0f;
+      }
+      last_yaw_fdb_ang_ = theta_i2r_;
+      yaw_fdb_tick_ = work_tick_;
+    }
+
+    float latency = (work_tick_ - yaw_fdb_tick_) * 0.001f + cfg_.theta_pred_latency;
+    theta_pred_latency_ = hello_world::Bound(latency, 0.0f, 0.02f);
+    theta_i2r_pred_ = hello_world::AngleNormRad(theta_i2r_ + theta_i2r_spd_ * theta_pred_latency_);
   };
 
   void Chassis::updateCap()
   {
     HW_ASSERT(cap_ptr_ != nullptr, "pointer to Capacitor is nullptr", cap_ptr_);
+    HW_ASSERT(cap_estimator_ptr_ != nullptr, "pointer to CapEstimator is nullptr", cap_estimator_ptr_);
     if (cap_ptr_->isOffline())
     {
       is_high_spd_enabled_ = false;
       cap_remaining_energy_ = 0.0f;
+      cap_board_energy_ = 0.0f;
+      is_cap_energy_enough_ = false;
+      cap_estimator_ptr_->reset();
     }
     else
     {
+      // 剩余能量不再直接由电压换算，而是使用在线估计的容量与内阻计算可用能量
+      cap_estimator_ptr_->update(cap_ptr_->getCapVolt(), cap_ptr_->getCapCurr(), interval_ticks_ * 0.001f);
       is_high_spd_enabled_ = cap_ptr_->isUsingSuperCap();
-      cap_remaining_energy_ = cap_ptr_->getRemainingPower();
+      cap_remaining_energy_ = cap_estimator_ptr_->getUsablePct();
+      cap_board_energy_ = cap_ptr_->getRemainingPower();
+      is_cap_energy_enough_ = cap_estimator_ptr_->isEnergyEnough();
     }
   };
 
@@ -237,8 +344,13 @@ namespace robot
     updateSlopeAng();
     calcWheelSpeedRef();
     calcwheelfeedbackRef();
+    updatePwrLimiterRuntimeParams();
     calcWheelLimitedSpeedRef();
     calcWheelCurrentRef();
+    calcTractionCurrentRef();
+    calcPwrLimitedCurrentRef();
+    calcWheelCurrentLimited();
+    calcWheelRawInput();
     setCommData(true);
   };
 
@@ -296,21 +408,6 @@ namespace robot
     WorkingMode act_working_mode = working_mode_; // 实际执行的工作模式
     bool move_flag = false;
 
-    // 当小陀螺模式切换到跟随模式时，保证底盘不会反转，否则会大大消耗功率
-    if (!is_gyro2follow_handled_)
-    {
-      float theta_i2r = getThetaI2r(false);
-      if (!(working_mode_ == WorkingMode::Follow && last_working_mode_ == WorkingMode::Gyro) ||
-          (gyro_dir_ == GyroDir::AntiClockwise && (theta_i2r < 0 && theta_i2r > -(5.0f / 6.0f * PI))) ||
-          (gyro_dir_ == GyroDir::Clockwise && (theta_i2r > 0 && theta_i2r < (5.0f / 6.0f * PI))))
-      {
-        is_gyro2follow_handled_ = true;
-      }
-      else
-      {
-        act_working_mode = WorkingMode::Gyro;
-      }
-    }
     cnt[3]++;
     switch (act_working_mode)
     {
@@ -347,6 +444,8 @@ namespace robot
       }
       // 是否需要根据底盘速度调整小陀螺速度
       cmd.w += move_flag * getGyroVariation() * variable_gyro();
+      // 云台偏航电机力矩不足时降低转速，保证云台仍能稳住目标
+      cmd.w *= calcGyroSpdScale();
       break;
     }
     case WorkingMode::Depart:
@@ -358,18 +457,31 @@ namespace robot
     case WorkingMode::Follow:
     {
       gyro_dir_ = GyroDir::Unspecified;
+      // 小陀螺切跟随时，按规划的减速曲线转到目标朝向，结束后再交给跟随 PID
+      if (gyro2follow_planner_ptr_->isActive())
+      {
+        float w_ref = gyro2follow_planner_ptr_->calc(theta_i2r_, chassis_vel_fdb_.w, calcPwrAvail());
+        if (gyro2follow_planner_ptr_->isActive())
+        {
+          cmd.w = w_ref / cfg_.normal_rot_spd;
+          break;
+        }
+      }
       // 在转头过程中，底盘不响应跟随转动指令
       if (work_tick_ - last_rev_head_tick_ < 800)
       {
         break;
       }
       // 跟随模式下，更新跟随目标
+      // 如果车尾对准云台，以车尾为车头计算跟随误差，避免在 ±PI 处跳变
       float theta_ref[1] = {0.0f};
-      float theta_fdb[1] = {theta_i2r_};
-      // 如果云台反转，期望值是PI
-      // theta_ref[0] = PI * static_cast<float>(rev_head_flag_);
-      theta_ref[0] = {0.0f};
+      float theta_fdb[1] = {getThetaI2r(false)};
       follow_omega_pid_ptr_->calc(theta_ref, theta_fdb, nullptr, &cmd.w);
+      // 跟随误差小时削弱 PID 的作用，主要依靠云台运动前馈跟随，减小抖动和功率消耗
+      float follow_err = fabsf(hello_world::AngleNormRad(theta_ref[0] - theta_fdb[0]));
+      float pid_scale = cfg_.follow_pid_min_scale +
+                        (1.0f - cfg_.follow_pid_min_scale) * hello_world::Bound(follow_err / cfg_.follow_pid_full_err, 0.0f, 1.0f);
+      cmd.w = hello_world::Bound(cmd.w, -1.0f, 1.0f) * pid_scale + calcFollowFfd();
       cmd.w = hello_world::Bound(cmd.w, -1.0f, 1.0f);
       static auto data = follow_omega_pid_ptr_->getDatasAt(0);
       data = follow_omega_pid_ptr_->getDatasAt(0);
@@ -396,17 +508,97 @@ namespace robot
       cmd *= 1.0f; // todo
     }
 
+    float last_w = last_cmd_.w;
     setCmdSmoothly(cmd, smooth_factor);
+    yaw_acc_ref_ = interval_ticks_ > 0 ? (cmd_.w - last_w) * 1000.0f / interval_ticks_ : 0.0f;
+  };
+  /**
+   * @brief       按云台偏航电机的力矩余量调整小陀螺转速缩放系数
+   * @retval      小陀螺转速缩放系数，值域 [gyro_spd_scale_min, 1]
+   * @note        余量不足时较快下降，余量充足时缓慢回升，中间为死区，
+   *              最终停在云台刚好能稳住的最高转速附近
+   */
+  float Chassis::calcGyroSpdScale()
+  {
+    float dt = interval_ticks_ * 0.001f;
+    if (gimbal_yaw_tor_headroom_ < cfg_.gyro_headroom_low)
+    {
+      gyro_spd_scale_ -= cfg_.gyro_spd_scale_down * dt;
+    }
+    else if (gimbal_yaw_tor_headroom_ > cfg_.gyro_headroom_high)
+    {
+      gyro_spd_scale_ += cfg_.gyro_spd_scale_up * dt;
+    }
+    gyro_spd_scale_ = hello_world::Bound(gyro_spd_scale_, cfg_.gyro_spd_scale_min, 1.0f);
+    return gyro_spd_scale_;
+  };
+  /**
+   * @brief       计算底盘当前可用功率
+   * @retval      可用功率，单位 W
+   * @note        与电流域功率限制器使用同一预算，运行时参数为上一控制周期的值
+   */
+  float Chassis::calcPwrAvail() const
+  {
+    return cur_pwr_limiter_ptr_->calcPwrBudget(pwr_limiter_runtime_params_);
+  };
+  /**
+   * @brief       计算跟随模式下的云台运动前馈
+   * @retval      归一化的底盘旋转指令前馈量
+   * @note        云台偏航角速度经 CAN 传输存在时延，按数据年龄与固定时延外推到执行时刻
+   */
+  float Chassis::calcFollowFfd() const
+  {
+    if (gc_comm_ptr_->isOffline())
+    {
+      return 0.0f;
+    }
+    float latency = (work_tick_ - gimbal_motion_tick_) * 0.001f + cfg_.follow_ffd_latency;
+    // 数据过旧时不再外推
+    latency = hello_world::Bound(latency, 0.0f, 0.05f);
+    float yaw_spd = gimbal_yaw_spd_ + gimbal_yaw_acc_ * latency;
+    return yaw_spd / cfg_.normal_rot_spd;
   };
   void Chassis::calcWheelSpeedRef()
   {
     // 底盘坐标系下，x轴正方向为底盘正前方，y轴正方向为底盘正左方，z轴正方向为底盘正上方
     // 轮子顺序按照象限顺序进行编号：左前，左后，右后，右前
+    // 控制指令（图传坐标系）与重力分量（底盘坐标系）共用一次旋转，一并解算
+    // 旋转角度使用指令生效时刻的预测值，避免小陀螺平移时因时延产生螺旋漂移
+    HW_ASSERT(omni_ik_kernel_ptr_ != nullptr, "pointer to IK kernel is nullptr", omni_ik_kernel_ptr_);
+    // 坡面相对世界静止，指令生效时在底盘坐标系下已转过 -w * latency
+    float sin_phi, cos_phi;
+    arm_sin_cos_f32(hello_world::Rad2Deg(-chassis_vel_fdb_.w * cfg_.theta_pred_latency), &sin_phi, &cos_phi);
+    float gravity_vec[3] = {
+        cos_phi * getGx() - sin_phi * getGy(),
+        sin_phi * getGx() + cos_phi * getGy(),
+        0.0f,
+    };
+    OmniIkKernel::IkJob jobs[2] = {
+        {cmd_.data, OmniIkKernel::Frame::kImage, wheel_speed_ref_},
+        {gravity_vec, OmniIkKernel::Frame::kRobot, wheel_speed_gravity_},
+    };
+    omni_ik_kernel_ptr_->solve(jobs, 2, theta_i2r_pred_);
+    // 降级模式下离线轮子不参与控制，其期望置零后两种功率模型都只计入三个电机
+    if (isDegraded())
+    {
+      wheel_speed_ref_[dead_wheel_idx_] = 0.0f;
+      wheel_speed_gravity_[dead_wheel_idx_] = 0.0f;
+    }
+
+#if CHASSIS_IK_KERNEL_CROSS_CHECK
     HW_ASSERT(ik_solver_ptr_ != nullptr, "pointer to IK solver is nullptr", ik_solver_ptr_);
-    hello_world::chassis_ik_solver::MoveVec move_vec(cmd_.v_x, cmd_.v_y, cmd_.w);
-    float theta_i2r = theta_i2r_;
-    ik_solver_ptr_->solve(move_vec, theta_i2r, nullptr);
-    ik_solver_ptr_->getRotSpdAll(wheel_speed_ref_);
+    float wheel_speed_ref_chk[4] = {0};
+    ik_solver_ptr_->solve(hello_world::chassis_ik_solver::MoveVec(cmd_.v_x, cmd_.v_y, cmd_.w), theta_i2r_pred_, nullptr);
+    ik_solver_ptr_->getRotSpdAll(wheel_speed_ref_chk);
+    for (size_t i = 0; i < 4; i++)
+    {
+      float err = fabsf(wheel_speed_ref_chk[i] - wheel_speed_ref_[i]);
+      if (err > ik_kernel_err_debug)
+      {
+        ik_kernel_err_debug = err;
+      }
+    }
+#endif
   };
   void Chassis::updateSlopeAng()
   {
@@ -418,34 +610,45 @@ namespace robot
     g_y_ = cos_pitch * sin_roll;
   }
 
-  float feedbackspeed[4] = {0};
   void Chassis::calcwheelfeedbackRef()
   {
+    HW_ASSERT(wheel_ffd_ptr_ != nullptr, "pointer to WheelFfd is nullptr", wheel_ffd_ptr_);
+    // 重力分量的逆解已在 calcWheelSpeedRef 中与控制指令一并完成，此处由轮速换算为电流
     if (slope_ang_ > 0.2 && slope_ang_ < 0.5)
     {
-      hello_world::chassis_ik_solver::MoveVec move_vec(getGx(), getGy(), 0);
-      ik_solver_ptr_->solve(move_vec, 0, nullptr);
-      ik_solver_ptr_->getRotSpdAll(feedbackspeed);
+      float gravity_curr_per_spd = wheel_ffd_ptr_->getGravityCurrPerSpd();
       for (size_t i = 0; i < 4; i++)
       {
-        feedbackspeed[i] = feedbackspeed[i] * 2.3; // todo
+        wheel_gravity_current_ffd_[i] = wheel_speed_gravity_[i] * gravity_curr_per_spd;
       }
     }
     else
     {
       for (size_t i = 0; i < 4; i++)
       {
-        feedbackspeed[i] = 0;
+        wheel_gravity_current_ffd_[i] = 0;
       }
     }
+
+    // 惯性与摩擦前馈，补偿指令变化时 PID 的跟踪滞后
+    wheel_ffd_ptr_->calc(*omni_ik_kernel_ptr_, wheel_speed_ref_, interval_ticks_ * 0.001f, wheel_current_ffd_);
+    if (isDegraded())
+    {
+      wheel_current_ffd_[dead_wheel_idx_] = 0.0f;
+    }
+    // 两部分前馈均为电流，求和后作为轮速 PID 的输出前馈
+    for (size_t i = 0; i < 4; i++)
+    {
+      wheel_pid_ffd_[i] = wheel_gravity_current_ffd_[i] + wheel_current_ffd_[i];
+    }
   };
-  void Chassis::calcWheelLimitedSpeedRef()
+  void Chassis::updatePwrLimiterRuntimeParams()
   {
     float p_max_change;
     float p_slope_;
     float up_ref = 100.0f;
 
-    if (use_cap_flag_ == true)
+    if (use_cap_flag_ == true && is_cap_energy_enough_)
     {
       p_max_change = 480.0f;
       p_slope_ = 8.0f;
@@ -494,14 +697,16 @@ namespace robot
 
     if (!cap_ptr_->isOffline())
     {
-      if (use_cap_flag_ == true)
+      // energy_converge 按电容板的剩余能量百分比标定，这里仍使用电容板的值；
+      // 估计的可用能量只决定是否允许超功率（is_cap_energy_enough_）
+      if (use_cap_flag_ == true && is_cap_energy_enough_)
       {
-        runtime_params.remaining_energy = cap_ptr_->getRemainingPower();
+        runtime_params.remaining_energy = cap_board_energy_;
         runtime_params.energy_converge = 30.0f;
       }
       else
       {
-        runtime_params.remaining_energy = cap_ptr_->getRemainingPower();
+        runtime_params.remaining_energy = cap_board_energy_;
         runtime_params.energy_converge = 50.0f;
       }
     }
@@ -511,11 +716,41 @@ namespace robot
       runtime_params.energy_converge = 10.0f;
     }
 
+    // 轮电机过热时收窄超出裁判系统功率上限的部分，减少绕组发热
+    float thermal_scale = wheel_thermal_ptr_->getMinScale();
+    runtime_params.p_ref_max = runtime_params.p_referee_max +
+                               (runtime_params.p_ref_max - runtime_params.p_referee_max) * thermal_scale;
+    if (runtime_params.p_ref_max < runtime_params.p_ref_min)
+    {
+      runtime_params.p_ref_max = runtime_params.p_ref_min;
+    }
+
+    pwr_limiter_runtime_params_ = runtime_params;
+  };
+  void Chassis::calcWheelLimitedSpeedRef()
+  {
+    if (pwr_limit_domain_ == PwrLimitDomain::kCurrent)
+    {
+      // 电流域限制在 PID 之后进行，此处不对期望轮速做限制
+      memcpy(wheel_speed_ref_limited_, wheel_speed_ref_, sizeof(wheel_speed_ref_limited_));
+      return;
+    }
+    HW_ASSERT(pwr_limiter_ptr_ != nullptr, "pointer to PwrLimiter is nullptr", pwr_limiter_ptr_);
     pwr_limiter_ptr_->updateWheelModel(wheel_speed_ref_, wheel_speed_fdb_,
-                                       feedbackspeed, nullptr);
-    pwr_limiter_ptr_->calc(runtime_params, wheel_speed_ref_limited_, nullptr); // 更新运行时参数
+                                       wheel_pid_ffd_, nullptr);
+    pwr_limiter_ptr_->calc(pwr_limiter_runtime_params_, wheel_speed_ref_limited_, nullptr); // 更新运行时参数
+  };
+  void Chassis::calcPwrLimitedCurrentRef()
+  {
+    if (pwr_limit_domain_ != PwrLimitDomain::kCurrent)
+    {
+      wheel_current_scale_ = 1.0f;
+      return;
+    }
+    // 求解所有轮电机共用的最大电流缩放系数，使预测功率不超过预算
+    HW_ASSERT(cur_pwr_limiter_ptr_ != nullptr, "pointer to CurrentPwrLimiter is nullptr", cur_pwr_limiter_ptr_);
+    wheel_current_scale_ = cur_pwr_limiter_ptr_->calc(pwr_limiter_runtime_params_, wheel_current_ref_, wheel_speed_fdb_, kWheelMotorNum);
   };
-  void Chassis::calcPwrLimitedCurrentRef() {};
   void Chassis::calcWheelCurrentRef()
   {
     // 计算每个轮子的期望转速
@@ -531,16 +766,74 @@ namespace robot
     {
       pid_ptr = wheel_pid_ptr_[wpis[i]];
       HW_ASSERT(pid_ptr != nullptr, "pointer to PID %d is nullptr", wpis[i]);
-      pid_ptr->calc(&wheel_speed_ref_limited_[i], &wheel_speed_fdb_[i], &feedbackspeed[i], &wheel_current_ref_[i]);
-      // pid_ptr->calc(&wheel_speed_ref_[i], &wheel_speed_fdb_[i], &feedbackspeed[i], &wheel_current_ref_[i]);
+      if ((int8_t)i == dead_wheel_idx_)
+      {
+        // 离线轮子的 PID 没有有效反馈，保持复位，防止积分饱和
+        pid_ptr->reset();
+        wheel_current_ref_[i] = 0.0f;
+        continue;
+      }
+      pid_ptr->calc(&wheel_speed_ref_limited_[i], &wheel_speed_fdb_[i], &wheel_pid_ffd_[i], &wheel_current_ref_[i]);
+      // pid_ptr->calc(&wheel_speed_ref_[i], &wheel_speed_fdb_[i], &wheel_pid_ffd_[i], &wheel_current_ref_[i]);
       // pid_ptr->calc(&wheel_speed_ref_[i], &wheel_speed_fdb_[i], nullptr, &wheel_current_ref_[i]);
     }
   };
-  void Chassis::calcWheelCurrentLimited() {
-
+  void Chassis::calcTractionCurrentRef()
+  {
+    // 由 IMU 与轮速的运动学一致性检测打滑，有轮子打滑时重新分配电流
+    HW_ASSERT(traction_ctrl_ptr_ != nullptr, "pointer to TractionCtrl is nullptr", traction_ctrl_ptr_);
+    // 假设 acc_x/acc_y 为含重力的比力，单位 m/s^2，加上重力分量得到线加速度，见 traction_ctrl.hpp
+    const float kGravity = 9.8f;
+    float imu_acc[2] = {
+        imu_ptr_->acc_x() + kGravity * getGx(),
+        imu_ptr_->acc_y() + kGravity * getGy(),
+    };
+    for (size_t i = 0; i < kWheelMotorNum; i++)
+    {
+      traction_ctrl_ptr_->setWheelAvailable(i, (int8_t)i != dead_wheel_idx_);
+    }
+    traction_ctrl_ptr_->update(*omni_ik_kernel_ptr_, wheel_speed_fdb_, chassis_vel_fdb_.data, imu_acc,
+                               imu_ptr_->gyro_yaw(), interval_ticks_ * 0.001f);
+    traction_ctrl_ptr_->allocate(*omni_ik_kernel_ptr_, wheel_current_ref_);
   };
-  void Chassis::calcWheelRawInput() {
-
+  void Chassis::calcWheelCurrentLimited()
+  {
+    float out_limit = cur_pwr_limiter_ptr_->getOutLimit();
+    for (size_t i = 0; i < kWheelMotorNum; i++)
+    {
+      // 按绕组温度对各轮电流限幅降额
+      float limit = out_limit * wheel_thermal_ptr_->getScale(i);
+      wheel_current_ref_limited_[i] = hello_world::Bound(wheel_current_ref_[i] * wheel_current_scale_, -limit, limit);
+    }
+  };
+  float Chassis::calcCapChargePwr(bool working_flag)
+  {
+    // 以本周期下发的轮电机电流预测底盘需求功率，非工作状态下电流为 0，只剩静息功率
+    HW_ASSERT(cap_charge_planner_ptr_ != nullptr, "pointer to CapChargePlanner is nullptr", cap_charge_planner_ptr_);
+    float pwr_demand = cur_pwr_limiter_ptr_->predictPwr(wheel_current_ref_limited_, wheel_speed_fdb_, kWheelMotorNum);
+    // 自瞄时的小陀螺与跟随转动是稳定的需求，已计入需求功率预测，只有平移指令才算机动
+    bool is_translating = fabsf(cmd_.v_x) > 0.01f || fabsf(cmd_.v_y) > 0.01f;
+    bool is_rotating = working_mode_ == WorkingMode::Gyro || fabsf(cmd_.w) > 0.01f;
+    bool is_aiming = working_flag && aiming_flag_;
+    bool is_moving = working_flag && (is_translating || (!is_aiming && is_rotating));
+    bool is_discharging = use_cap_flag_ && is_high_spd_enabled_;
+    return cap_charge_planner_ptr_->calc(work_tick_, rfr_data_.pwr_limit, rfr_data_.pwr_buffer, pwr_demand,
+                                         cap_remaining_energy_, is_moving, is_aiming, is_discharging);
+  };
+  void Chassis::calcWheelRawInput()
+  {
+    // 轮电机输入类型为电流，离线电机输入置零
+    for (size_t i = 0; i < kWheelMotorNum; i++)
+    {
+      if (wheel_motor_ptr_[i]->isOffline())
+      {
+        wheel_raw_input_[i] = 0.0f;
+      }
+      else
+      {
+        wheel_raw_input_[i] = wheel_current_ref_limited_[i];
+      }
+    }
   };
 #pragma endregion
 
@@ -567,10 +860,18 @@ namespace robot
     // 在 runOnWorking 函数中更新的数据
     cmd_.reset();      ///< 控制指令，基于图传坐标系
     last_cmd_.reset(); ///< 上一控制周期的控制指令，基于图传坐标系
+    yaw_acc_ref_ = 0.0f; ///< 期望偏航角速度的变化率
 
     memset(wheel_speed_ref_, 0, sizeof(wheel_speed_ref_));
     memset(wheel_speed_ref_limited_, 0, sizeof(wheel_speed_ref_limited_));
     memset(wheel_current_ref_, 0, sizeof(wheel_current_ref_));
+    memset(wheel_speed_gravity_, 0, sizeof(wheel_speed_gravity_));
+    memset(wheel_gravity_current_ffd_, 0, sizeof(wheel_gravity_current_ffd_));
+    memset(wheel_pid_ffd_, 0, sizeof(wheel_pid_ffd_));
+    memset(wheel_current_ffd_, 0, sizeof(wheel_current_ffd_));
+    memset(wheel_current_ref_limited_, 0, sizeof(wheel_current_ref_limited_));
+    memset(wheel_raw_input_, 0, sizeof(wheel_raw_input_));
+    wheel_current_scale_ = 1.0f;
     rev_head_flag_ = false;
     // last_rev_head_tick_ = 0;         ///< 上一次转向后退的时间戳
 
@@ -580,15 +881,25 @@ namespace robot
     // motor fdb data 在 update 函数中更新
     is_all_wheel_online_ = false; ///< 所有轮电机是否都处于就绪状态
     is_any_wheel_online_ = false; ///< 任意电机是否处于就绪状态
+    dead_wheel_idx_ = -1;         ///< 三轮降级模式下离线的轮电机下标
 
     memset(wheel_speed_fdb_, 0, sizeof(wheel_speed_fdb_));     ///< 轮速反馈数据
     memset(wheel_current_fdb_, 0, sizeof(wheel_current_fdb_)); ///< 轮电流反馈数据
+    memset(wheel_temp_fdb_, 0, sizeof(wheel_temp_fdb_));       ///< 轮电机温度反馈数据
+    chassis_vel_fdb_.reset();                                  ///< 轮速正解得到的底盘运动向量
 
     theta_i2r_ = 0.0f; ///< 图传坐标系绕 Z 轴到底盘坐标系的旋转角度，右手定则判定正反向，单位 rad
+    theta_i2r_spd_ = 0.0f;      ///< theta_i2r 的变化率，单位 rad/s
+    theta_i2r_pred_ = 0.0f;     ///< 预测的轮电机指令生效时刻的 theta_i2r，单位 rad
+    theta_pred_latency_ = 0.0f; ///< 预测使用的总时延，单位 s
+    gimbal_yaw_tor_headroom_ = 1.0f; ///< 云台偏航电机的力矩余量
+    gyro_spd_scale_ = 1.0f;          ///< 小陀螺转速缩放系数
 
     // cap fdb data 在 update 函数中更新
     is_high_spd_enabled_ = false; ///< 是否开启了高速模式 （开启意味着从电容取电）
-    cap_remaining_energy_ = 0.0f; ///< 剩余电容能量百分比，单位 %
+    cap_remaining_energy_ = 0.0f; ///< 超电可用能量百分比，单位 %
+    cap_board_energy_ = 0.0f; ///< 电容板按电压换算的剩余能量百分比，单位 %
+    is_cap_energy_enough_ = false; ///< 超电可用能量是否足以开启超电
 
     resetPids(); ///< 重置 PID 控制器参数
   };
@@ -599,10 +910,18 @@ namespace robot
     // 在 runOnWorking 函数中更新的数据
     cmd_.reset();      ///< 控制指令，基于图传坐标系
     last_cmd_.reset(); ///< 上一控制周期的控制指令，基于图传坐标系
+    yaw_acc_ref_ = 0.0f; ///< 期望偏航角速度的变化率
 
     memset(wheel_speed_ref_, 0, sizeof(wheel_speed_ref_));
     memset(wheel_speed_ref_limited_, 0, sizeof(wheel_speed_ref_limited_));
     memset(wheel_current_ref_, 0, sizeof(wheel_current_ref_));
+    memset(wheel_speed_gravity_, 0, sizeof(wheel_speed_gravity_));
+    memset(wheel_gravity_current_ffd_, 0, sizeof(wheel_gravity_current_ffd_));
+    memset(wheel_pid_ffd_, 0, sizeof(wheel_pid_ffd_));
+    memset(wheel_current_ffd_, 0, sizeof(wheel_current_ffd_));
+    memset(wheel_current_ref_limited_, 0, sizeof(wheel_current_ref_limited_));
+    memset(wheel_raw_input_, 0, sizeof(wheel_raw_input_));
+    wheel_current_scale_ = 1.0f;
     rev_head_flag_ = false;
     // last_rev_head_tick_ = 0;         ///< 上一次转向后退的时间戳
     // gimbal board fdb data  在 update 函数中更新
@@ -617,10 +936,18 @@ namespace robot
     // 在 runOnWorking 函数中更新的数据
     cmd_.reset();      ///< 控制指令，基于图传坐标系
     last_cmd_.reset(); ///< 上一控制周期的控制指令，基于图传坐标系
+    yaw_acc_ref_ = 0.0f; ///< 期望偏航角速度的变化率
 
     memset(wheel_speed_ref_, 0, sizeof(wheel_speed_ref_));
     memset(wheel_speed_ref_limited_, 0, sizeof(wheel_speed_ref_limited_));
     memset(wheel_current_ref_, 0, sizeof(wheel_current_ref_));
+    memset(wheel_speed_gravity_, 0, sizeof(wheel_speed_gravity_));
+    memset(wheel_gravity_current_ffd_, 0, sizeof(wheel_gravity_current_ffd_));
+    memset(wheel_pid_ffd_, 0, sizeof(wheel_pid_ffd_));
+    memset(wheel_current_ffd_, 0, sizeof(wheel_current_ffd_));
+    memset(wheel_current_ref_limited_, 0, sizeof(wheel_current_ref_limited_));
+    memset(wheel_raw_input_, 0, sizeof(wheel_raw_input_));
+    wheel_current_scale_ = 1.0f;
     rev_head_flag_ = false;
     // last_rev_head_tick_ = 0;         ///< 上一次转向后退的时间戳
     // gimbal board fdb data  在 update 函数中更新
@@ -636,11 +963,19 @@ namespace robot
     // 在 runOnWorking 函数中更新的数据
     cmd_.reset();      ///< 控制指令，基于图传坐标系
     last_cmd_.reset(); ///< 上一控制周期的控制指令，基于图传坐标系
+    yaw_acc_ref_ = 0.0f; ///< 期望偏航角速度的变化率
 
     setPwrState(PwrState::Dead); ///< 电源状态
     memset(wheel_speed_ref_, 0, sizeof(wheel_speed_ref_));
     memset(wheel_speed_ref_limited_, 0, sizeof(wheel_speed_ref_limited_));
     memset(wheel_current_ref_, 0, sizeof(wheel_current_ref_));
+    memset(wheel_speed_gravity_, 0, sizeof(wheel_speed_gravity_));
+    memset(wheel_gravity_current_ffd_, 0, sizeof(wheel_gravity_current_ffd_));
+    memset(wheel_pid_ffd_, 0, sizeof(wheel_pid_ffd_));
+    memset(wheel_current_ffd_, 0, sizeof(wheel_current_ffd_));
+    memset(wheel_current_ref_limited_, 0, sizeof(wheel_current_ref_limited_));
+    memset(wheel_raw_input_, 0, sizeof(wheel_raw_input_));
+    wheel_current_scale_ = 1.0f;
     rev_head_flag_ = false;
     // last_rev_head_tick_ = 0;         ///< 上一次转向后退的时间戳
     // gimbal board fdb data  在 update 函数中更新
@@ -655,6 +990,10 @@ namespace robot
       wheel_pid_ptr_[i]->reset();
     }
     follow_omega_pid_ptr_->reset();
+    cur_pwr_limiter_ptr_->reset();
+    gyro2follow_planner_ptr_->reset();
+    traction_ctrl_ptr_->reset();
+    wheel_ffd_ptr_->reset();
   };
 #pragma endregion
 
@@ -693,7 +1032,7 @@ namespace robot
       }
       else
       {
-        motor_ptr->setInput(wheel_current_ref_[wmi]);
+        motor_ptr->setInput(wheel_raw_input_[wmi]);
       }
     }
   };
@@ -710,6 +1049,7 @@ namespace robot
     {
       cap_ptr_->setRfrData(rfr_data_.pwr_buffer, rfr_data_.pwr_limit, 0);
     }
+    cap_ptr_->setRequestedPower(calcCapChargePwr(working_flag));
   };
 
 #pragma endregion
@@ -722,6 +1062,12 @@ namespace robot
     ik_solver_ptr_ = ptr;
   };
 
+  void Chassis::registerOmniIkKernel(const OmniIkKernel *ptr)
+  {
+    HW_ASSERT(ptr != nullptr, "pointer to IK kernel is nullptr", ptr);
+    omni_ik_kernel_ptr_ = ptr;
+  };
+
   void Chassis::registerWheelMotor(Motor *ptr, int idx)
   {
     HW_ASSERT(ptr != nullptr, "pointer to motor %d is nullptr", idx);
@@ -754,6 +1100,48 @@ namespace robot
     pwr_limiter_ptr_ = ptr;
   };
 
+  void Chassis::registerCurrentPwrLimiter(CurrentPwrLimiter *ptr)
+  {
+    HW_ASSERT(ptr != nullptr, "pointer to CurrentPwrLimiter is nullptr", ptr);
+    cur_pwr_limiter_ptr_ = ptr;
+  };
+
+  void Chassis::registerGyro2FollowPlanner(Gyro2FollowPlanner *ptr)
+  {
+    HW_ASSERT(ptr != nullptr, "pointer to Gyro2FollowPlanner is nullptr", ptr);
+    gyro2follow_planner_ptr_ = ptr;
+  };
+
+  void Chassis::registerTractionCtrl(TractionCtrl *ptr)
+  {
+    HW_ASSERT(ptr != nullptr, "pointer to TractionCtrl is nullptr", ptr);
+    traction_ctrl_ptr_ = ptr;
+  };
+
+  void Chassis::registerWheelFfd(WheelFfd *ptr)
+  {
+    HW_ASSERT(ptr != nullptr, "pointer to WheelFfd is nullptr", ptr);
+    wheel_ffd_ptr_ = ptr;
+  };
+
+  void Chassis::registerWheelThermal(WheelThermal *ptr)
+  {
+    HW_ASSERT(ptr != nullptr, "pointer to WheelThermal is nullptr", ptr);
+    wheel_thermal_ptr_ = ptr;
+  };
+
+  void Chassis::registerCapChargePlanner(CapChargePlanner *ptr)
+  {
+    HW_ASSERT(ptr != nullptr, "pointer to CapChargePlanner is nullptr", ptr);
+    cap_charge_planner_ptr_ = ptr;
+  };
+
+  void Chassis::registerCapEstimator(CapEstimator *ptr)
+  {
+    HW_ASSERT(ptr != nullptr, "pointer to CapEstimator is nullptr", ptr);
+    cap_estimator_ptr_ = ptr;
+  };
+
   void Chassis::registerCap(Cap *ptr)
   {
     HW_ASSERT(ptr != nullptr, "pointer to Capacitor is nullptr", ptr);
@@ -776,10 +1164,15 @@ namespace robot
 #pragma region 特殊接口
   void Chassis::setWorkingMode(WorkingMode mode)
   {
-    // 防止小陀螺切跟随模式时反转，大大消耗功率
+    // 小陀螺切跟随时，沿旋转方向减速到最近的可达朝向，防止反转大大消耗功率
     if (mode == WorkingMode::Follow && working_mode_ == WorkingMode::Gyro)
     {
-      is_gyro2follow_handled_ = false;
+      gyro2follow_planner_ptr_->start(theta_i2r_, chassis_vel_fdb_.w, calcPwrAvail());
+      rev_head_flag_ = gyro2follow_planner_ptr_->isTgtRevHead();
+    }
+    else if (mode != WorkingMode::Follow)
+    {
+      gyro2follow_planner_ptr_->reset();
     }
     if (working_mode_ != mode)
     {
@@ -812,6 +1205,16 @@ namespace robot
     }
   }
 
+  float Chassis::getYawSpdFdb() const
+  {
+    // IMU 不受轮子打滑影响，优先使用；IMU 未注册时退回轮速正解结果
+    if (imu_ptr_ == nullptr)
+    {
+      return chassis_vel_fdb_.w;
+    }
+    return imu_ptr_->gyro_yaw();
+  }
+
   /**
    * @brief       设置旋转方向，要求旋转方向必须有定义
    * @param        dir: 旋转方向，GyroDir
@@ -0,0 +1,125 @@
+/**
+ *******************************************************************************
+ * @file      :current_pwr_limiter.cpp
+ * @brief     : 电流域功率限制器
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "current_pwr_limiter.hpp"
+
+#include <cmath>
+/* Private macro -------------------------------------------------------------*/
+
+namespace robot
+{
+/* Private constants ---------------------------------------------------------*/
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported function definitions ---------------------------------------------*/
+
+/**
+ * @brief       计算满足功率预算的最大公共电流缩放系数
+ * @param        runtime_params: 运行时参数，与速度域限制器一致
+ * @param        cur_ref: PID 输出的期望电流，单位 A
+ * @param        spd_fdb: 轮速反馈，单位 rad/s
+ * @param        n: 电机数量
+ * @retval      电流缩放系数，值域 [0, 1]
+ * @note        总功率 P(s) = a * s^2 + b * s + c，其中
+ *              a = sum(k_r * I^2), b = sum(k_t * I * w), c = sum(k_w * |w|) + p_bias
+ */
+float CurrentPwrLimiter::calc(const RuntimeParams &runtime_params, const float *cur_ref, const float *spd_fdb, size_t n)
+{
+  p_budget_ = calcPwrBudget(runtime_params);
+
+  float a = 0.0f, b = 0.0f, c = params_.p_bias;
+  for (size_t i = 0; i < n; i++) {
+    // 超出限幅的部分本身就不会输出，按限幅后的电流计算
+    float cur = cur_ref[i];
+    if (cur > params_.out_limit) {
+      cur = params_.out_limit;
+    } else if (cur < -params_.out_limit) {
+      cur = -params_.out_limit;
+    }
+    a += params_.k_r * cur * cur;
+    b += params_.k_t * cur * spd_fdb[i];
+    c += params_.k_w * fabsf(spd_fdb[i]);
+  }
+
+  float scale = 1.0f;
+  if (a + b + c <= p_budget_) {
+    // 不缩放也满足预算
+    scale = 1.0f;
+  } else if (c >= p_budget_) {
+    // 仅空载损耗就已超出预算，电流全部置零
+    scale = 0.0f;
+  } else if (a < 1e-6f) {
+    // 此时 b > 0，P(s) 为关于 s 的一次函数
+    scale = (p_budget_ - c) / b;
+  } else {
+    // c < p_budget_，方程 a * s^2 + b * s + (c - p_budget_) = 0 必有一正根
+    float delta = b * b - 4.0f * a * (c - p_budget_);
+    scale = (-b + sqrtf(delta)) / (2.0f * a);
+  }
+
+  if (scale > 1.0f) {
+    scale = 1.0f;
+  } else if (scale < 0.0f) {
+    scale = 0.0f;
+  }
+  scale_ = scale;
+  p_est_ = a * scale * scale + b * scale + c;
+  return scale_;
+};
+
+/**
+ * @brief       由运行时参数计算功率预算
+ * @param        runtime_params: 运行时参数
+ * @retval      功率预算，单位 W
+ * @note        以缓冲能量相对收敛值的偏差线性调整预算，
+ *              能量低于危险值时直接取最小预算
+ */
+float CurrentPwrLimiter::calcPwrBudget(const RuntimeParams &runtime_params) const
+{
+  if (runtime_params.remaining_energy < runtime_params.danger_energy) {
+    return runtime_params.p_ref_min;
+  }
+
+  float p_budget = runtime_params.p_referee_max +
+                   (runtime_params.remaining_energy - runtime_params.energy_converge) * runtime_params.p_slope;
+  if (p_budget > runtime_params.p_ref_max) {
+    p_budget = runtime_params.p_ref_max;
+  } else if (p_budget < runtime_params.p_ref_min) {
+    p_budget = runtime_params.p_ref_min;
+  }
+  return p_budget;
+};
+
+/**
+ * @brief       按功率模型预测给定电流下的底盘功率
+ * @param        cur_ref: 期望电流，单位 A
+ * @param        spd_fdb: 轮速反馈，单位 rad/s
+ * @param        n: 电机数量
+ * @param        scale: 电流缩放系数
+ * @retval      预测功率，单位 W
+ */
+float CurrentPwrLimiter::predictPwr(const float *cur_ref, const float *spd_fdb, size_t n, float scale) const
+{
+  float p = params_.p_bias;
+  for (size_t i = 0; i < n; i++) {
+    float cur = cur_ref[i] * scale;
+    p += params_.k_t * cur * spd_fdb[i] + params_.k_r * cur * cur + params_.k_w * fabsf(spd_fdb[i]);
+  }
+  return p;
+};
+/* Private function definitions ----------------------------------------------*/
+}  // namespace robot
@@ -0,0 +1,128 @@
+/**
+ *******************************************************************************
+ * @file      :gyro2follow_planner.cpp
+ * @brief     : 小陀螺切跟随的减速规划器
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "gyro2follow_planner.hpp"
+
+#include <cmath>
+
+#include "base.hpp"
+/* Private macro -------------------------------------------------------------*/
+
+namespace robot
+{
+/* Private constants ---------------------------------------------------------*/
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported function definitions ---------------------------------------------*/
+
+/**
+ * @brief       开始规划
+ * @param        theta_i2r: 图传坐标系绕 Z 轴到底盘坐标系的旋转角度，单位 rad
+ * @param        spin_spd: 底盘当前角速度，逆时针为正，单位 rad/s
+ * @param        p_avail: 当前可用功率，单位 W
+ * @note        车头与车尾对准云台分别对应 theta_i2r 为 0 和 PI，即等效朝向间隔为 PI
+ */
+void Gyro2FollowPlanner::start(float theta_i2r, float spin_spd, float p_avail)
+{
+  reset();
+  last_theta_ = theta_i2r;
+
+  if (fabsf(spin_spd) < params_.handoff_spd) {
+    // 转速很低，直接选择最近的等效朝向交给跟随 PID
+    is_tgt_rev_head_ = fabsf(theta_i2r) > PI / 2.0f;
+    return;
+  }
+
+  dir_ = spin_spd > 0 ? 1.0f : -1.0f;
+  float decel_max = calcMaxDecel(p_avail);
+  // 减速到 handoff_spd 时剩余角度恰为 handoff_ang，交接时跟随 PID 面对的转速与角度误差都足够小
+  float spd_sq_diff = spin_spd * spin_spd - params_.handoff_spd * params_.handoff_spd;
+  float stop_ang = spd_sq_diff / (2.0f * decel_max) + params_.handoff_ang;
+
+  // 沿旋转方向到下一个等效朝向的角度，[0, PI)
+  float theta_in_dir = dir_ * theta_i2r;
+  float ang_to_next = fmodf(PI - fmodf(theta_in_dir + 2.0f * PI, PI), PI);
+  // 选取第一个能以最大减速度停下的等效朝向，此时所需减速度最小，即时间最短且制动能量最少
+  int n_skip = 0;
+  while (ang_to_next + n_skip * PI < stop_ang) {
+    n_skip++;
+  }
+  remaining_ang_ = ang_to_next + n_skip * PI;
+  decel_ = spd_sq_diff / (2.0f * (remaining_ang_ - params_.handoff_ang) + 1e-6f);
+
+  // 目标朝向对应的 theta_i2r 为 0 还是 PI
+  float tgt_theta = hello_world::AngleNormRad(theta_i2r + dir_ * remaining_ang_);
+  is_tgt_rev_head_ = fabsf(tgt_theta) > PI / 2.0f;
+  is_active_ = remaining_ang_ > params_.handoff_ang;
+};
+
+/**
+ * @brief       计算底盘角速度期望
+ * @param        theta_i2r: 图传坐标系绕 Z 轴到底盘坐标系的旋转角度，单位 rad
+ * @param        spin_spd: 底盘当前角速度，逆时针为正，单位 rad/s
+ * @param        p_avail: 当前可用功率，单位 W
+ * @retval      底盘角速度期望，逆时针为正，单位 rad/s
+ * @note        每周期根据剩余角度重新计算匀减速曲线上的速度，闭环修正执行误差；
+ *              曲线在剩余角度为 handoff_ang 时降到 handoff_spd，此后交给跟随 PID
+ */
+float Gyro2FollowPlanner::calc(float theta_i2r, float spin_spd, float p_avail)
+{
+  if (!is_active_) {
+    return 0.0f;
+  }
+
+  remaining_ang_ -= dir_ * hello_world::AngleNormRad(theta_i2r - last_theta_);
+  last_theta_ = theta_i2r;
+
+  if (remaining_ang_ <= 0.0f ||
+      (remaining_ang_ < params_.handoff_ang && fabsf(spin_spd) <= params_.handoff_spd)) {
+    is_active_ = false;
+    return 0.0f;
+  }
+
+  if (remaining_ang_ < params_.handoff_ang) {
+    // 实际转速还没降下来，继续按剩余角度线性减小期望转速
+    return dir_ * params_.handoff_spd * remaining_ang_ / params_.handoff_ang;
+  }
+  // 功率下降时放缓减速，剩余角度不够时由跟随 PID 兜底
+  float decel = fminf(decel_, calcMaxDecel(p_avail));
+  return dir_ * sqrtf(params_.handoff_spd * params_.handoff_spd +
+                      2.0f * decel * (remaining_ang_ - params_.handoff_ang));
+};
+
+void Gyro2FollowPlanner::reset()
+{
+  is_active_ = false;
+  is_tgt_rev_head_ = false;
+  dir_ = 0.0f;
+  decel_ = 0.0f;
+  remaining_ang_ = 0.0f;
+};
+
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief       计算当前允许的最大角减速度
+ * @param        p_avail: 当前可用功率，单位 W
+ * @retval      允许的最大角减速度，单位 rad/s^2
+ */
+float Gyro2FollowPlanner::calcMaxDecel(float p_avail) const
+{
+  float decel_pwr = sqrtf(fmaxf(p_avail, 0.0f) / params_.brake_pwr_coeff);
+  return fmaxf(fminf(params_.max_decel, decel_pwr), 1.0f);
+};
+}  // namespace robot
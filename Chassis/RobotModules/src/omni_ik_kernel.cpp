@@ -0,0 +1,160 @@
+/**
+ *******************************************************************************
+ * @file      :omni_ik_kernel.cpp
+ * @brief     : X 型四全向轮底盘专用运动学解算核
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "omni_ik_kernel.hpp"
+
+#include "arm_math.h"
+/* Private macro -------------------------------------------------------------*/
+
+namespace robot
+{
+/* Private constants ---------------------------------------------------------*/
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported function definitions ---------------------------------------------*/
+
+/**
+ * @brief       批量逆解
+ * @param        jobs: 解算任务数组
+ * @param        n: 任务数量
+ * @param        theta_i2r: 图传坐标系绕 Z 轴到底盘坐标系的旋转角度，单位 rad
+ * @note        同一控制周期内所有图传坐标系下的任务共用一次 sin/cos
+ */
+void OmniIkKernel::solve(IkJob *jobs, size_t n, float theta_i2r) const
+{
+  float sin_theta = 0.0f, cos_theta = 1.0f;
+  bool is_rot_calced = false;
+  float twist_r[kDof] = {0};
+
+  for (size_t k = 0; k < n; k++) {
+    const float *twist = jobs[k].twist;
+    if (jobs[k].frame == Frame::kImage) {
+      if (!is_rot_calced) {
+        // arm_sin_cos_f32 的输入单位为度
+        arm_sin_cos_f32(theta_i2r * 180.0f / PI, &sin_theta, &cos_theta);
+        is_rot_calced = true;
+      }
+      twist_r[0] = cos_theta * twist[0] + sin_theta * twist[1];
+      twist_r[1] = -sin_theta * twist[0] + cos_theta * twist[1];
+      twist_r[2] = twist[2];
+      solveInRobotFrame(twist_r, jobs[k].rot_spds);
+    } else {
+      solveInRobotFrame(twist, jobs[k].rot_spds);
+    }
+  }
+};
+
+/**
+ * @brief       底盘坐标系下的逆解
+ * @param        twist_r: 底盘坐标系下的运动向量 {v_x, v_y, w}
+ * @param        rot_spds: 输出的轮子转速，单位 rad/s
+ */
+void OmniIkKernel::solveInRobotFrame(const float twist_r[kDof], float rot_spds[kWheelNum]) const
+{
+  for (size_t i = 0; i < kWheelNum; i++) {
+    rot_spds[i] = jac_[i][0] * twist_r[0] + jac_[i][1] * twist_r[1] + jac_[i][2] * twist_r[2];
+  }
+};
+
+/**
+ * @brief       正解，由轮速估计底盘坐标系下的运动向量
+ * @param        rot_spds: 轮子转速，单位 rad/s
+ * @param        twist_r: 输出的底盘坐标系下运动向量 {v_x, v_y, w}
+ * @note        四轮三自由度，结果为最小二乘意义下的估计
+ */
+void OmniIkKernel::fkSolve(const float rot_spds[kWheelNum], float twist_r[kDof]) const
+{
+  for (size_t r = 0; r < kDof; r++) {
+    twist_r[r] = fk_[r][0] * rot_spds[0] + fk_[r][1] * rot_spds[1] + fk_[r][2] * rot_spds[2] + fk_[r][3] * rot_spds[3];
+  }
+};
+
+/**
+ * @brief       加权最小二乘正解
+ * @param        rot_spds: 轮子转速，单位 rad/s
+ * @param        weights: 各轮权重，置零即剔除该轮，至少保留三个非零权重
+ * @param        twist_r: 输出的底盘坐标系下运动向量 {v_x, v_y, w}
+ * @note        v_r = (J^T * D * J)^-1 * J^T * D * 轮速，D = diag(weights)，
+ *              X 型布局任意三个轮子的雅可比矩阵均满秩
+ */
+void OmniIkKernel::fkSolveWls(const float rot_spds[kWheelNum], const float weights[kWheelNum], float twist_r[kDof]) const
+{
+  float jtdw[kDof] = {0};
+  float jtdj[kDof][kDof] = {{0}};
+  for (size_t i = 0; i < kWheelNum; i++) {
+    for (size_t r = 0; r < kDof; r++) {
+      jtdw[r] += jac_[i][r] * weights[i] * rot_spds[i];
+      for (size_t c = 0; c < kDof; c++) {
+        jtdj[r][c] += jac_[i][r] * weights[i] * jac_[i][c];
+      }
+    }
+  }
+
+  float inv[kDof][kDof] = {{0}};
+  Inv3x3(jtdj, inv);
+  for (size_t r = 0; r < kDof; r++) {
+    twist_r[r] = inv[r][0] * jtdw[0] + inv[r][1] * jtdw[1] + inv[r][2] * jtdw[2];
+  }
+};
+
+/**
+ * @brief       将底盘广义力按最小范数分配到各轮
+ * @param        wrench: 底盘坐标系下的广义力 {F_x, F_y, M_z}，单位 N, N*m
+ * @param        out: 各轮轮端转矩，单位 N*m
+ * @note        out = J * (J^T * J)^-1 * wrench，即正解矩阵的转置
+ */
+void OmniIkKernel::wrenchToWheel(const float wrench[kDof], float out[kWheelNum]) const
+{
+  for (size_t i = 0; i < kWheelNum; i++) {
+    out[i] = fk_[0][i] * wrench[0] + fk_[1][i] * wrench[1] + fk_[2][i] * wrench[2];
+  }
+};
+
+/**
+ * @brief       加权最小二乘电流分配
+ * @param        cur_in: 各轮期望电流，单位 A
+ * @param        weights: 各轮权重，权重越小分得的电流越少，要求大于 0
+ * @param        cur_out: 重新分配后的电流，单位 A，可与 cur_in 为同一数组
+ * @note        保持底盘广义力 J^T * I 不变，最小化 sum(I_i^2 / w_i)，
+ *              解为 I = D * J * (J^T * D * J)^-1 * J^T * I_in，D = diag(weights)
+ */
+void OmniIkKernel::allocateWls(const float cur_in[kWheelNum], const float weights[kWheelNum], float cur_out[kWheelNum]) const
+{
+  float wrench[kDof] = {0};
+  float jtdj[kDof][kDof] = {{0}};
+  for (size_t i = 0; i < kWheelNum; i++) {
+    for (size_t r = 0; r < kDof; r++) {
+      wrench[r] += jac_[i][r] * cur_in[i];
+      for (size_t c = 0; c < kDof; c++) {
+        jtdj[r][c] += jac_[i][r] * weights[i] * jac_[i][c];
+      }
+    }
+  }
+
+  float inv[kDof][kDof] = {{0}};
+  Inv3x3(jtdj, inv);
+  float lambda[kDof] = {0};
+  for (size_t r = 0; r < kDof; r++) {
+    lambda[r] = inv[r][0] * wrench[0] + inv[r][1] * wrench[1] + inv[r][2] * wrench[2];
+  }
+
+  for (size_t i = 0; i < kWheelNum; i++) {
+    cur_out[i] = weights[i] * (jac_[i][0] * lambda[0] + jac_[i][1] * lambda[1] + jac_[i][2] * lambda[2]);
+  }
+};
+/* Private function definitions ----------------------------------------------*/
+}  // namespace robot
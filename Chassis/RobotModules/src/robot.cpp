@@ -441,6 +441,7 @@ namespace robot
     chassis_ptr_->setNormCmd(chassis_cmd);
 
     gimbal_ptr_->setCtrlMode(gimbal_ctrl_mode);
+    chassis_ptr_->setAimingFlag(gimbal_ctrl_mode == CtrlMode::Auto);
     gimbal_ptr_->setWorkingMode(gimbal_working_mode);
 
     GimbalCmd gimbal_cmd;
@@ -594,6 +595,7 @@ namespace robot
     gimbal_cmd.yaw = hello_world::Bound(-0.01 * rc_ptr_->mouse_x(), -1, 1);
     gimbal_ptr_->setNormCmdDelta(gimbal_cmd);
     gimbal_ptr_->setCtrlMode(gimbal_ctrl_mode);
+    chassis_ptr_->setAimingFlag(gimbal_ctrl_mode == CtrlMode::Auto);
     gimbal_ptr_->setWorkingMode(gimbal_working_mode);
     gimbal_ptr_->setRevHeadFlag(rev_head_flag);
     gimbal_ptr_->setnavigateFlag(navigate_flag);
@@ -606,6 +608,21 @@ namespace robot
     chassis_ptr_->setWorkingMode(chassis_working_mode);
     chassis_ptr_->setUseCapFlag(rc_ptr_->key_SHIFT());
     chassis_ptr_->setGyroVariation(variable_gyro_flag);
+
+    // CTRL + V 切换功率限制所处的控制域（速度域/电流域），按下沿触发
+    bool is_pwr_domain_key_pressed = rc_ptr_->key_CTRL() && rc_ptr_->key_V();
+    if (is_pwr_domain_key_pressed && !last_pwr_domain_key_pressed_)
+    {
+      if (chassis_ptr_->getPwrLimitDomain() == Chassis::PwrLimitDomain::kSpeed)
+      {
+        chassis_ptr_->setPwrLimitDomain(Chassis::PwrLimitDomain::kCurrent);
+      }
+      else
+      {
+        chassis_ptr_->setPwrLimitDomain(Chassis::PwrLimitDomain::kSpeed);
+      }
+    }
+    last_pwr_domain_key_pressed_ = is_pwr_domain_key_pressed;
     // if (rev_chassis_flag)
       // chassis_ptr_->revHead();
 
@@ -655,6 +672,7 @@ namespace robot
     HW_ASSERT(gc_comm_ptr_ != nullptr, "GimbalChassisComm pointer is null", gc_comm_ptr_);
     HW_ASSERT(gimbal_ptr_ != nullptr, "Gimbal pointer is null", gimbal_ptr_);
     HW_ASSERT(shooter_ptr_ != nullptr, "Shooter pointer is null", shooter_ptr_);
+    HW_ASSERT(chassis_ptr_ != nullptr, "Chassis pointer is null", chassis_ptr_);
 
     // main board
 
@@ -667,6 +685,10 @@ namespace robot
     gimbal_data.ctrl_mode = gimbal_ptr_->getCtrlMode();
     gimbal_data.working_mode = gimbal_ptr_->getWorkingMode();
     gimbal_data.navigation_flag = gimbal_ptr_->getnavigateFlag();
+    // 小陀螺时云台偏航电机摩擦前馈所需的底盘运动数据
+    gimbal_data.chassis_yaw_spd_ref = chassis_ptr_->getYawSpdRef();
+    gimbal_data.chassis_yaw_spd_fdb = chassis_ptr_->getYawSpdFdb();
+    gimbal_data.chassis_yaw_acc_ref = chassis_ptr_->getYawAccRef();
 
     // shooter
     GimbalChassisComm::ShooterData::ChassisPart &shooter_data = gc_comm_ptr_->shooter_data().cp;
@@ -685,6 +707,8 @@ namespace robot
     // ui_drawer_.setChassisCtrlMode(chassis_ptr_->);
     ui_drawer_.setChassisWorkingMode(chassis_ptr_->getWorkingMode());
     ui_drawer_.setChassisHeadDir(chassis_ptr_->getThetaI2r());
+    ui_drawer_.setChassisDeadWheelIdx(chassis_ptr_->getDeadWheelIdx());
+    ui_drawer_.setChassisWheelOverheat(chassis_ptr_->isWheelOverheat());
 
     // Gimbal
     HW_ASSERT(gimbal_ptr_ != nullptr, "Gimbal FSM pointer is null", gimbal_ptr_);
@@ -730,7 +754,7 @@ namespace robot
 
     // Cap
     HW_ASSERT(cap_ptr_ != nullptr, "Cap pointer is null", cap_ptr_);
-    ui_drawer_.setCapPwrPercent(cap_ptr_->getRemainingPower());
+    ui_drawer_.setCapPwrPercent(chassis_ptr_->getCapRemainingEnergy());
 
     // vision
     HW_ASSERT(gc_comm_ptr_ != nullptr, "GimbalChassisComm pointer is null", gc_comm_ptr_);
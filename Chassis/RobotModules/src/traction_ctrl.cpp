@@ -0,0 +1,148 @@
+/**
+ *******************************************************************************
+ * @file      :traction_ctrl.cpp
+ * @brief     : 全向轮底盘打滑检测与牵引力控制
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "traction_ctrl.hpp"
+
+#include <cmath>
+/* Private macro -------------------------------------------------------------*/
+
+namespace robot
+{
+/* Private constants ---------------------------------------------------------*/
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported function definitions ---------------------------------------------*/
+
+/**
+ * @brief       更新各轮的打滑状态
+ * @param        kernel: 底盘运动学解算核
+ * @param        spd_fdb: 轮速反馈，单位 rad/s
+ * @param        twist_fdb: 轮速正解得到的底盘运动向量 {v_x, v_y, w}，单位 m/s, rad/s
+ * @param        imu_acc: IMU 测得的加速度 {a_x, a_y}（已扣除重力），底盘坐标系，单位 m/s^2
+ * @param        imu_gyro_z: IMU 测得的底盘角速度，逆时针为正，单位 rad/s
+ * @param        dt: 控制周期，单位 s
+ * @note        IMU 不在旋转中心时，a_c = a_imu - alpha x p + w^2 * p；
+ *              底盘坐标系是旋转坐标系，速度分量的导数还需扣除 w x v
+ */
+void TractionCtrl::update(const OmniIkKernel &kernel, const float spd_fdb[kWheelNum],
+                          const float twist_fdb[OmniIkKernel::kDof], const float imu_acc[2], float imu_gyro_z,
+                          float dt)
+{
+  if (!is_inited_ || dt <= 0.0f) {
+    for (size_t i = 0; i < kWheelNum; i++) {
+      last_spd_fdb_[i] = spd_fdb[i];
+    }
+    last_gyro_z_ = imu_gyro_z;
+    is_inited_ = true;
+    return;
+  }
+
+  float w = imu_gyro_z;
+  float alpha = (imu_gyro_z - last_gyro_z_) / dt;
+  float acc_c_x = imu_acc[0] + alpha * params_.imu_pos_y + w * w * params_.imu_pos_x;
+  float acc_c_y = imu_acc[1] - alpha * params_.imu_pos_x + w * w * params_.imu_pos_y;
+  // 底盘坐标系下速度分量的导数
+  float twist_dot[OmniIkKernel::kDof] = {
+      acc_c_x + w * twist_fdb[1],
+      acc_c_y - w * twist_fdb[0],
+      alpha,
+  };
+  float wheel_acc_exp[kWheelNum] = {0};
+  kernel.solveInRobotFrame(twist_dot, wheel_acc_exp);
+
+  for (size_t i = 0; i < kWheelNum; i++) {
+    float wheel_acc = (spd_fdb[i] - last_spd_fdb_[i]) / dt;
+    last_spd_fdb_[i] = spd_fdb[i];
+    if (!is_available_[i]) {
+      residual_[i] = 0.0f;
+      is_slipping_[i] = false;
+      slip_hold_cnt_[i] = 0;
+      weights_[i] = 0.0f;
+      continue;
+    }
+
+    float err = wheel_acc - wheel_acc_exp[i];
+    residual_[i] += params_.residual_filter * (err - residual_[i]);
+
+    // 迟滞判定，恢复抓地后保持一段时间，避免频繁切换
+    float abs_res = fabsf(residual_[i]);
+    if (abs_res > params_.slip_enter_thres) {
+      is_slipping_[i] = true;
+    } else if (abs_res < params_.slip_exit_thres) {
+      is_slipping_[i] = false;
+    }
+    if (is_slipping_[i]) {
+      slip_hold_cnt_[i] = params_.slip_hold_ticks;
+    } else if (slip_hold_cnt_[i] > 0) {
+      slip_hold_cnt_[i]--;
+    }
+    weights_[i] = isSlipping(i) ? params_.slip_weight : 1.0f;
+  }
+  last_gyro_z_ = imu_gyro_z;
+};
+
+/**
+ * @brief       按打滑状态重新分配轮电机电流
+ * @param        kernel: 底盘运动学解算核
+ * @param        cur: 各轮期望电流，单位 A，原地修改
+ * @note        无打滑时直接返回，不改变 PID 输出；打滑轮超出电流上限时等比例缩小所有轮子的电流，
+ *              逐轮限幅会改变广义力的方向，使路径偏转
+ */
+void TractionCtrl::allocate(const OmniIkKernel &kernel, float cur[kWheelNum]) const
+{
+  if (!isAnySlipping()) {
+    return;
+  }
+
+  kernel.allocateWls(cur, weights_, cur);
+  float scale = 1.0f;
+  for (size_t i = 0; i < kWheelNum; i++) {
+    float abs_cur = fabsf(cur[i]);
+    if (isSlipping(i) && abs_cur * scale > params_.slip_cur_limit) {
+      scale = params_.slip_cur_limit / abs_cur;
+    }
+  }
+  for (size_t i = 0; i < kWheelNum; i++) {
+    cur[i] *= scale;
+  }
+};
+
+bool TractionCtrl::isAnySlipping() const
+{
+  for (size_t i = 0; i < kWheelNum; i++) {
+    if (isSlipping(i)) {
+      return true;
+    }
+  }
+  return false;
+};
+
+void TractionCtrl::reset()
+{
+  is_inited_ = false;
+  last_gyro_z_ = 0.0f;
+  for (size_t i = 0; i < kWheelNum; i++) {
+    last_spd_fdb_[i] = 0.0f;
+    residual_[i] = 0.0f;
+    is_slipping_[i] = false;
+    slip_hold_cnt_[i] = 0;
+    weights_[i] = 1.0f;
+    is_available_[i] = true;
+  }
+};
+/* Private function definitions ----------------------------------------------*/
+}  // namespace robot
@@ -70,6 +70,8 @@ const uint8_t kUiNamePassSafe[3] = {0x00, 0x00, 0x0A}; ///< 底盘通行线中
 const uint8_t kUiBulletnum[3] = {0x00, 0x00, 0x0B};  ///< 发弹数量
 const uint8_t kUiNameNavigateTitle[3] = {0x00, 0x00, 0x0C};    ///< 底盘工作状态标题颜色
 const uint8_t kUiNameHurtModuleid[3] = {0x00, 0x00, 0x0D};  ///< 底盘工作状态内容颜色
+const uint8_t kUiNameChassisDeadWheel[3] = {0x00, 0x00, 0x0E};  ///< 三轮降级模式下离线的轮子
+const uint8_t kUiNameWheelOverheat[3] = {0x00, 0x00, 0x0F};     ///< 轮电机过热警告
 // gimbal
 const uint16_t kPixelCenterXVisionBox = 967;  //todo 云台视觉状态位置
 const uint16_t kPixelCenterYVisionBox =450;
@@ -210,6 +212,9 @@ bool UiDrawer::encodeDynamicUi(uint8_t* data_ptr, size_t& data_len, GraphicOpera
     case kDuiPkgGroup5:
       res = encodeDynaUiPkgGroup5(data_ptr, data_len, opt);
       break;
+    case kDuiPkgGroup6:
+      res = encodeDynaUiPkgGroup6(data_ptr, data_len, opt);
+      break;
     default:
       break;
   }
@@ -252,11 +257,16 @@ bool UiDrawer::encodeDynaUiPkgGroup1(uint8_t* data_ptr, size_t& data_len, Graphi
   genArmorHit(g_armor_hit);
   g_armor_hit.setOperation(opt);
 
+  hello_world::referee::Arc g_dead_wheel;
+  genChassisDeadWheel(g_dead_wheel);
+  g_dead_wheel.setOperation(opt);
+
   hello_world::referee::InterGraphic5Package pkg;
   pkg.setSenderId(static_cast<uint16_t>(sender_id_));
   pkg.setArcAt(g_chassis_status_head, 0);
   pkg.setArcAt(g_chassis_status_other, 1);
   pkg.setArcAt(g_armor_hit, 2);
+  pkg.setArcAt(g_dead_wheel, 3);
 
   return encodePkg(data_ptr, data_len, opt, pkg);
 };
@@ -367,6 +377,18 @@ bool UiDrawer::encodeDynaUiPkgGroup5(uint8_t* data_ptr, size_t& data_len, Graphi
 
   return encodeString(data_ptr, data_len, opt, Base_Attack_flag, str);
 
+}
+bool UiDrawer::encodeDynaUiPkgGroup6(uint8_t* data_ptr, size_t& data_len, GraphicOperation opt)
+{
+  std::string str = "WHEEL HOT";
+  hello_world::referee::Pixel linewidth = is_wheel_overheat_ ? 4 : 0;
+
+  hello_world::referee::String wheel_overheat_flag = hello_world::referee::String(kUiNameWheelOverheat, opt, kDynamicUiLayer,
+                                                  hello_world::referee::GraphicColor::kOrange,
+                                                   kUiModuleStateAreaX2, kUiModuleStateAreaY2 + kUiModuleStateAreaYDelta,
+                                                    20, str.length(), linewidth);
+
+  return encodeString(data_ptr, data_len, opt, wheel_overheat_flag, str);
 }
   #pragma endregion
 
@@ -436,6 +458,26 @@ void UiDrawer::genChassisStatus(hello_world::referee::Arc& g_head, hello_world::
   g_other.setLineWidth(3);
   g_head.setLayer(kDynamicUiLayer);
 };
+/** 
+ * @brief 三轮降级模式下，在底盘朝向示意外侧标出离线轮子的位置
+ */
+void UiDrawer::genChassisDeadWheel(hello_world::referee::Arc& g)
+{
+  // 轮子在底盘坐标系下的方位角（逆时针）：左前 45°，左后 135°，右后 225°，右前 315°
+  float wheel_ang = 45.0f + 90.0f * (chassis_dead_wheel_idx_ < 0 ? 0 : chassis_dead_wheel_idx_);
+  float now_wheel_ang = -theta_i2r_ * 180 / M_PI - wheel_ang;
+  float start_ang = hello_world::NormPeriodData(0, 360, now_wheel_ang - 15);
+  float end_ang = hello_world::NormPeriodData(0, 360, now_wheel_ang + 15);
+
+  float radius = 70;
+  g.setColor(hello_world::referee::Arc::Color::kPurple);
+  g.setAng(start_ang, end_ang);
+  g.setCenterPos(kUiChassisDirCircleX, kUiChassisDirCircleY);
+  g.setRadius(radius, radius);
+  g.setName(kUiNameChassisDeadWheel);
+  g.setLineWidth(chassis_dead_wheel_idx_ < 0 ? 0 : 8);
+  g.setLayer(kDynamicUiLayer);
+};
 void UiDrawer::genBulletNum(hello_world::referee::FloatingNumber& g)
 {
   g.setName(kUiBulletnum);
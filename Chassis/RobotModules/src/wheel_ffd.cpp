@@ -0,0 +1,97 @@
+/**
+ *******************************************************************************
+ * @file      :wheel_ffd.cpp
+ * @brief     : 轮电机惯性与摩擦电流前馈
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "wheel_ffd.hpp"
+
+#include <cmath>
+/* Private macro -------------------------------------------------------------*/
+
+namespace robot
+{
+/* Private constants ---------------------------------------------------------*/
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported function definitions ---------------------------------------------*/
+
+/**
+ * @brief       计算各轮前馈电流
+ * @param        kernel: 底盘运动学解算核
+ * @param        spd_ref: 整形后的期望轮速，单位 rad/s
+ * @param        dt: 控制周期，单位 s
+ * @param        ffd: 输出的前馈电流，单位 A
+ */
+void WheelFfd::calc(const OmniIkKernel &kernel, const float spd_ref[kWheelNum], float dt, float ffd[kWheelNum])
+{
+  if (!is_inited_ || dt <= 0.0f) {
+    for (size_t i = 0; i < kWheelNum; i++) {
+      last_spd_ref_[i] = spd_ref[i];
+      acc_ref_[i] = 0.0f;
+    }
+    is_inited_ = true;
+  }
+
+  for (size_t i = 0; i < kWheelNum; i++) {
+    float acc = dt > 0.0f ? (spd_ref[i] - last_spd_ref_[i]) / dt : 0.0f;
+    acc_ref_[i] += params_.acc_filter * (acc - acc_ref_[i]);
+    last_spd_ref_[i] = spd_ref[i];
+  }
+
+  // 整车惯性：底盘坐标系下的期望运动向量及其导数
+  float twist_ref[OmniIkKernel::kDof] = {0};
+  float twist_acc[OmniIkKernel::kDof] = {0};
+  kernel.fkSolve(spd_ref, twist_ref);
+  kernel.fkSolve(acc_ref_, twist_acc);
+  // 世界坐标系下的加速度 = 底盘坐标系下速度分量的导数 + w x v
+  float wrench[OmniIkKernel::kDof] = {
+      params_.mass * (twist_acc[0] - twist_ref[2] * twist_ref[1]),
+      params_.mass * (twist_acc[1] + twist_ref[2] * twist_ref[0]),
+      params_.inertia_z * twist_acc[2],
+  };
+  float body_tau[kWheelNum] = {0};
+  kernel.wrenchToWheel(wrench, body_tau);
+
+  for (size_t i = 0; i < kWheelNum; i++) {
+    float tau = body_tau[i] + params_.rotor_inertia * acc_ref_[i];
+    float cur = tau / params_.k_tau + params_.visc * spd_ref[i];
+
+    float coulomb_ratio = spd_ref[i] / params_.coulomb_spd_band;
+    if (coulomb_ratio > 1.0f) {
+      coulomb_ratio = 1.0f;
+    } else if (coulomb_ratio < -1.0f) {
+      coulomb_ratio = -1.0f;
+    }
+    cur += params_.coulomb * coulomb_ratio;
+
+    if (cur > params_.max_ffd) {
+      cur = params_.max_ffd;
+    } else if (cur < -params_.max_ffd) {
+      cur = -params_.max_ffd;
+    }
+    ffd[i] = cur;
+  }
+};
+
+void WheelFfd::reset()
+{
+  is_inited_ = false;
+  for (size_t i = 0; i < kWheelNum; i++) {
+    last_spd_ref_[i] = 0.0f;
+    acc_ref_[i] = 0.0f;
+  }
+};
+/* Private function definitions ----------------------------------------------*/
+}  // namespace robot
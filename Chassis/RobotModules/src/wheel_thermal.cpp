@@ -0,0 +1,104 @@
+/**
+ *******************************************************************************
+ * @file      :wheel_thermal.cpp
+ * @brief     : 轮电机热模型与预测性降额
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "wheel_thermal.hpp"
+
+#include <cmath>
+/* Private macro -------------------------------------------------------------*/
+
+namespace robot
+{
+/* Private constants ---------------------------------------------------------*/
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported function definitions ---------------------------------------------*/
+
+/**
+ * @brief       更新各电机的绕组温度估计与电流限幅系数
+ * @param        cur: 电机电流反馈，单位 A
+ * @param        temp_fdb: 电机反馈温度，单位 ℃
+ * @param        is_online: 电机是否在线，离线电机只做散热计算
+ * @param        dt: 更新周期，单位 s
+ * @note        反馈温度为整数且更新较慢，只在其变化时做修正
+ */
+void WheelThermal::update(const float cur[kMotorNum], const float temp_fdb[kMotorNum], const bool is_online[kMotorNum],
+                          float dt)
+{
+  for (size_t i = 0; i < kMotorNum; i++) {
+    float p_loss = is_online[i] ? cur[i] * cur[i] * params_.r_winding : 0.0f;
+    float p_dissipate = (t_est_[i] - params_.t_amb) / params_.r_th;
+    t_est_[i] += (p_loss - p_dissipate) / params_.c_th * dt;
+
+    if (is_online[i] && temp_fdb[i] != last_temp_fdb_[i]) {
+      t_est_[i] += params_.k_obs * (temp_fdb[i] - t_est_[i]);
+      last_temp_fdb_[i] = temp_fdb[i];
+    }
+    // 绕组是热源，温度不低于电机反馈温度
+    if (is_online[i] && t_est_[i] < temp_fdb[i]) {
+      t_est_[i] = temp_fdb[i];
+    }
+
+    scale_[i] = calcScale(t_est_[i]);
+  }
+};
+
+void WheelThermal::reset()
+{
+  for (size_t i = 0; i < kMotorNum; i++) {
+    t_est_[i] = params_.t_amb;
+    last_temp_fdb_[i] = params_.t_amb;
+    scale_[i] = 1.0f;
+  }
+};
+
+float WheelThermal::getMaxTempEst() const
+{
+  float t_max = t_est_[0];
+  for (size_t i = 1; i < kMotorNum; i++) {
+    t_max = fmaxf(t_max, t_est_[i]);
+  }
+  return t_max;
+};
+
+float WheelThermal::getMinScale() const
+{
+  float s_min = scale_[0];
+  for (size_t i = 1; i < kMotorNum; i++) {
+    s_min = fminf(s_min, scale_[i]);
+  }
+  return s_min;
+};
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief       由温度计算电流限幅系数
+ * @param        temp: 绕组温度，单位 ℃
+ * @retval      电流限幅系数，值域 [min_scale, 1]
+ * @note        降额区间内使用 smoothstep 曲线，两端导数为 0，限幅变化平滑
+ */
+float WheelThermal::calcScale(float temp) const
+{
+  float x = (temp - params_.t_derate_start) / (params_.t_derate_end - params_.t_derate_start);
+  if (x <= 0.0f) {
+    return 1.0f;
+  } else if (x >= 1.0f) {
+    return params_.min_scale;
+  }
+  float s = x * x * (3.0f - 2.0f * x);
+  return 1.0f - (1.0f - params_.min_scale) * s;
+};
+}  // namespace robot
@@ -0,0 +1,29 @@
+/** 
+ *******************************************************************************
+ * @file      : ins_adrc.hpp
+ * @brief     : 
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INSTANCE_INS_ADRC_HPP_
+#define INSTANCE_INS_ADRC_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+#include "ladrc.hpp"
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+robot::Ladrc* CreateAdrcYaw();
+robot::Ladrc* CreateAdrcPitch();
+#endif /* INSTANCE_INS_ADRC_HPP_ */
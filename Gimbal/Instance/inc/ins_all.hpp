@@ -17,6 +17,7 @@
 #define INSTANCE_INS_ALL_HPP_
 
 /* Includes ------------------------------------------------------------------*/
+#include "ins_adrc.hpp"
 #include "ins_buzzer.hpp"
 #include "ins_chassis_gimbal_comm.hpp"
 #include "ins_comm.hpp"
@@ -27,6 +28,7 @@
 #include "ins_pid.hpp"
 #include "ins_vision.hpp"
 #include "ins_feed.hpp"
+#include "ins_fric.hpp"
 #include "ins_laser.hpp"
 
 /* Exported macro ------------------------------------------------------------*/
@@ -18,6 +18,9 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "feed.hpp"
+#include "fire_ctrl.hpp"
+#include "heat_sched.hpp"
+#include "feed_profile.hpp"
 
 /* Exported macro ------------------------------------------------------------*/
 /* Exported constants --------------------------------------------------------*/
@@ -25,4 +28,7 @@
 /* Exported variables --------------------------------------------------------*/
 /* Exported function prototypes ----------------------------------------------*/
 hello_world::module::feed_impl::Feed* CreateFeed();
+robot::FireCtrl* CreateFireCtrl();
+robot::HeatSched* CreateHeatSched();
+robot::FeedProfile* CreateFeedProfile();
 #endif /* INSTANCE_INS_FEED_HPP_ */
@@ -19,6 +19,9 @@
 /* Includes ------------------------------------------------------------------*/
 #include "base.hpp"
 #include "filter.hpp"
+#include "joint_fdb_fusion.hpp"
+#include "pitch_ffd_ident.hpp"
+#include "time_optimal_traj.hpp"
 
 namespace hw_filter = hello_world::filter;
 /* Exported macro ------------------------------------------------------------*/
@@ -28,4 +31,11 @@ namespace hw_filter = hello_world::filter;
 /* Exported function prototypes ----------------------------------------------*/
 hw_filter::Td *CreateTdYaw(void);
 hw_filter::Td *CreateTdPitch(void);
+hw_filter::Td *CreateTdRefYaw(void);
+hw_filter::Td *CreateTdRefPitch(void);
+robot::PitchFfdIdent *CreatePitchFfdIdent(void);
+robot::JointFdbFusion *CreateFusionYaw(void);
+robot::JointFdbFusion *CreateFusionPitch(void);
+robot::TimeOptimalTraj *CreateTrajYaw(void);
+robot::TimeOptimalTraj *CreateTrajPitch(void);
 #endif /* INSTANCE_INS_FILTER_HPP_ */
@@ -18,6 +18,8 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "fric_2motor.hpp"
+#include "fric_shot_ffd.hpp"
+#include "shot_detector.hpp"
 namespace hw_module = hello_world::module;
 typedef hw_module::Fric Fric;
 /* Exported macro ------------------------------------------------------------*/
@@ -26,4 +28,6 @@ typedef hw_module::Fric Fric;
 /* Exported variables --------------------------------------------------------*/
 /* Exported function prototypes ----------------------------------------------*/
 Fric *CreateFric();
+robot::FricShotFfd *CreateFricShotFfd();
+robot::ShotDetector *CreateShotDetector();
 #endif /* INSTANCE_INS_FRIC_HPP_ */
@@ -17,13 +17,16 @@
 #define INSTANCE_INS_VISION_HPP_
 
 /* Includes ------------------------------------------------------------------*/
-#include "vision.hpp"
-namespace hw_vision = hello_world::vision;
+#include "vision_tracker.hpp"
+#include "vision_link.hpp"
+#include "pose_history.hpp"
 /* Exported macro ------------------------------------------------------------*/
 /* Exported constants --------------------------------------------------------*/
 /* Exported types ------------------------------------------------------------*/
 /* Exported variables --------------------------------------------------------*/
 /* Exported function prototypes ----------------------------------------------*/
-hw_vision::Vision* CreateVision();
+robot::VisionTracker* CreateVisionTracker();
+robot::VisionLink* CreateVisionLink();
+robot::PoseHistory* CreatePoseHistory();
 
 #endif /* INSTANCE_INS_VISION_HPP_ */
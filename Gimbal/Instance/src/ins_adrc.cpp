@@ -0,0 +1,43 @@
+/** 
+ *******************************************************************************
+ * @file      : ins_adrc.cpp
+ * @brief     : 
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "ins_adrc.hpp"
+#include "base.hpp"
+/* Private constants ---------------------------------------------------------*/
+const robot::Ladrc::Params kAdrcParamsYaw = {
+    .b0 = 20.0f,       ///< 控制量增益，yaw 轴转动惯量约 0.05 kg·m^2
+    .wc = 30.0f,       ///< 控制器带宽，单位 rad/s
+    .wo = 120.0f,      ///< 观测器带宽，单位 rad/s
+    .out_max = 6.9f,   ///< 输出力矩限幅，与 yaw PID 输出限幅一致，单位 N·m
+    .period = 2 * PI,  ///< 角度周期，单位 rad
+};
+const robot::Ladrc::Params kAdrcParamsPitch = {
+    .b0 = 50.0f,       ///< 控制量增益，pitch 轴转动惯量约 0.02 kg·m^2
+    .wc = 30.0f,       ///< 控制器带宽，单位 rad/s
+    .wo = 120.0f,      ///< 观测器带宽，单位 rad/s
+    .out_max = 6.9f,   ///< 输出力矩限幅，与 pitch PID 输出限幅一致，单位 N·m
+    .period = 2 * PI,  ///< 角度周期，单位 rad
+};
+/* Private macro -------------------------------------------------------------*/
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+robot::Ladrc unique_adrc_yaw = robot::Ladrc(kAdrcParamsYaw);
+robot::Ladrc unique_adrc_pitch = robot::Ladrc(kAdrcParamsPitch);
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported function definitions ---------------------------------------------*/
+robot::Ladrc* CreateAdrcYaw() { return &unique_adrc_yaw; };
+robot::Ladrc* CreateAdrcPitch() { return &unique_adrc_pitch; };
+/* Private function definitions ----------------------------------------------*/
@@ -18,6 +18,7 @@
 #include "DT7.hpp"
 #include "can.h"
 #include "usart.h"
+#include "vision_link.hpp"
 
 /* Private macro -------------------------------------------------------------*/
 
@@ -31,8 +32,9 @@ typedef hello_world::comm::UartTxMgr UartTxMgr;
 
 /* Private constants ---------------------------------------------------------*/
 
-const size_t kRxvisionBufferSize = 14;
-const size_t kTxvisionBufferSize = 13;
+// USART1 只承载视觉 v2 协议（921600 baud），按字节流解码，接收缓冲区只需容纳一次 IDLE 前的数据
+const size_t kRxvisionBufferSize = 64;
+const size_t kTxvisionBufferSize = robot::VisionLink::kMaxEncLen;
 
 /* Private variables ---------------------------------------------------------*/
 
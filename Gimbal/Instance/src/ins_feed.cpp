@@ -13,7 +13,7 @@
  *******************************************************************************
  */
 /* Includes ------------------------------------------------------------------*/
-#include "feed.hpp"
+#include "ins_feed.hpp"
 #include "ins_pid.hpp"
 #include "ins_motor.hpp"
 
@@ -21,7 +21,51 @@
 
 /* Private types -------------------------------------------------------------*/
 /* Private constants ---------------------------------------------------------*/
+const robot::FireCtrl::Params kFireCtrlParams = {
+    .feed_delay = 0.03f,      ///< 拨盘开始拨弹到弹丸出膛的时延，单位 s
+    .disp_std = 0.004f,       ///< 弹道散布的角度标准差，约 4 mrad，单位 rad
+    .tgt_spd_std = 0.05f,     ///< 目标角速度预测误差的标准差，4 m 处约 8 mrad，单位 rad/s
+    .armor_half_w = 0.065f,   ///< 小装甲板有效半宽，单位 m
+    .armor_half_h = 0.055f,   ///< 小装甲板有效半高，单位 m
+    .default_dist = 4.0f,     ///< 视觉未给出距离时使用的目标距离，单位 m
+    .min_blt_spd = 15.0f,     ///< 弹速下限，单位 m/s
+    .p_min = 0.3f,            ///< 允许射击的最低命中概率
+    .p_good = 0.7f,           ///< 命中概率高于该值时立即射击
+    .look_ahead = 0.01f,      ///< 比较射击时机时推迟的时间，单位 s
+    .max_wait = 60,           ///< 命中概率达标后最长等待 60 ms
+};
+const robot::HeatSched::Params kHeatSchedParams = {
+    .heat_per_blt = 10.0f,  ///< 每发热量，与拨盘配置一致
+    .safe_blt = 3.0f,       ///< 热量余量，覆盖裁判系统发弹事件的时延，单位 发
+    .reserve_blt = 3.0f,    ///< 平时为高价值目标保留 3 发的热量
+    .min_interval = 50,     ///< 拨弹机构允许的最短拨弹间隔，单位 ms
+    .max_interval = 500,    ///< 最长拨弹间隔，单位 ms
+};
+const robot::FeedProfile::Params kFeedProfileParams = {
+    .step_ang = PI / 5.0f,   ///< 每发弹丸的拨盘转角，与拨盘配置一致，单位 rad
+    .inertia = 0.03f,        ///< 折算到输出轴的转动惯量（含 36:1 减速后的转子惯量），单位 kg·m^2
+    .kt = 4.5f,              ///< 2006 力矩常数 0.18 N·m/A，经 36:1 减速与约 70% 效率折算，单位 N·m/A
+    .curr_max = 10.0f,       ///< 电机最大电流，单位 A
+    .acc_ratio = 0.7f,       ///< 留 30% 力矩给摩擦与弹丸阻力
+    .jerk_max = 2e5f,        ///< 最大角加加速度，单位 rad/s^3
+    .spd_max = 20.0f,        ///< 与拨盘角度环输出限幅一致，单位 rad/s
+    .kp = 60.0f,             ///< 角度误差反馈系数，单位 A/rad
+    .kd = 2.0f,              ///< 角速度误差反馈系数，单位 A/(rad/s)
+    .idle_spd = 3.0f,        ///< 角速度低于该值认为拨盘静止，单位 rad/s
+    .settle_err = 0.03f,     ///< 到位误差，单位 rad
+    .settle_time = 20,       ///< 轨迹结束后最长等待到位 20 ms
+    .handback_curr = 1.0f,   ///< Feed 与轨迹的电流相差 1 A 以内再交还
+    .jam_err = 0.08f,        ///< 跟踪滞后超过 0.08 rad
+    .jam_curr = 8.0f,        ///< 且电流超过 8 A
+    .jam_time = 6,           ///< 持续 6 ms 认为开始卡弹
+    .rev_curr = 6.0f,        ///< 反转松开弹丸的电流，单位 A
+    .rev_time = 8,           ///< 反转 8 ms
+    .max_retry = 2,          ///< 单发最多重试 2 次，之后交给 Feed 的堵转处理
+};
 /* Private variables ---------------------------------------------------------*/
+robot::FireCtrl unique_fire_ctrl = robot::FireCtrl(kFireCtrlParams);
+robot::HeatSched unique_heat_sched = robot::HeatSched(kHeatSchedParams);
+robot::FeedProfile unique_feed_profile = robot::FeedProfile(kFeedProfileParams);
 /* External variables --------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
 /* Exported function definitions ---------------------------------------------*/
@@ -57,3 +101,6 @@ hello_world::module::Feed* CreateFeed()
   }
   return &unique_feed;
 };
+robot::FireCtrl* CreateFireCtrl() { return &unique_fire_ctrl; };
+robot::HeatSched* CreateHeatSched() { return &unique_heat_sched; };
+robot::FeedProfile* CreateFeedProfile() { return &unique_feed_profile; };
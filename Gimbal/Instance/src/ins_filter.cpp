@@ -15,14 +15,69 @@
 /* Includes ------------------------------------------------------------------*/
 #include "ins_filter.hpp"
 /* Private constants ---------------------------------------------------------*/
+const robot::PitchFfdIdent::Params kPitchFfdIdentParams = {
+    .lambda = 0.9995f,        ///< 遗忘因子
+    .p0 = 100.0f,             ///< 协方差矩阵初值
+    .p_max_trace = 400.0f,    ///< 协方差矩阵迹的上限，超过后停止遗忘
+    .valid_trace = 0.2f,      ///< 协方差矩阵迹低于该值时认为辨识结果可用
+    .min_samples = 2000,      ///< 认为辨识结果可用所需的最少样本数
+    .spd_min = 0.1f,          ///< 参与辨识的最小转速，单位 rad/s
+    .acc_max = 2.0f,          ///< 参与辨识的最大角加速度，单位 rad/s^2
+    .tor_max = 6.0f,          ///< 参与辨识的最大力矩，单位 N·m
+    .sweep_spd_min = 0.2f,    ///< 扫描时第一次往返的俯仰角速度，单位 rad/s
+    .sweep_spd_max = 0.8f,    ///< 扫描时最后一次往返的俯仰角速度，单位 rad/s
+    .sweep_margin = 0.05f,    ///< 扫描范围距离限位的余量，单位 rad
+    .sweep_cycles = 4,        ///< 扫描往返次数
+};
+const robot::JointFdbFusion::Params kFusionParamsYaw = {
+    .ang_tau = 0.5f,   ///< 角度偏差的收敛时间常数，单位 s
+    .spd_tau = 0.0f,   ///< 角速度残差的低通滤波时间常数，陀螺仪噪声低于编码器差分，取 0 即直接使用陀螺仪，单位 s
+    .period = 2 * PI,  ///< 角度周期，单位 rad
+    .scale_tau = 5.0f,        ///< 底盘陀螺仪刻度系数估计的遗忘时间常数，单位 s
+    .scale_min_spd = 3.0f,    ///< 估计刻度系数所需的最小底盘角速度，小陀螺时满足，单位 rad/s
+    .scale_max_err = 0.1f,    ///< 刻度系数相对 1 的最大偏差
+};
+const robot::JointFdbFusion::Params kFusionParamsPitch = {
+    .ang_tau = 1.0f,   ///< 角度偏差的收敛时间常数，底盘俯仰姿态变化慢，取较大值，单位 s
+    .spd_tau = 0.0f,   ///< 角速度残差的低通滤波时间常数，陀螺仪噪声低于编码器差分，取 0 即直接使用陀螺仪，单位 s
+    .period = 2 * PI,  ///< 角度周期，单位 rad
+    .scale_tau = 0.0f,        ///< 基座角速度取 0，不估计刻度系数
+    .scale_min_spd = 0.0f,
+    .scale_max_err = 0.0f,
+};
+// DM_J4310 峰值力矩约 7 N·m，扣除重力与摩擦前馈后按 5 N·m 计算加速度上限
+const robot::TimeOptimalTraj::Params kTrajParamsYaw = {
+    .acc_max = 100.0f,  ///< 最大角加速度，yaw 轴转动惯量约 0.05 kg·m^2，单位 rad/s^2
+    .spd_max = 15.0f,   ///< 最大角速度，低于 DM_J4310 空载转速，单位 rad/s
+    .period = 2 * PI,   ///< 角度周期，单位 rad
+};
+const robot::TimeOptimalTraj::Params kTrajParamsPitch = {
+    .acc_max = 150.0f,  ///< 最大角加速度，pitch 轴转动惯量约 0.02 kg·m^2，单位 rad/s^2
+    .spd_max = 10.0f,   ///< 最大角速度，单位 rad/s
+    .period = 2 * PI,   ///< 角度周期，单位 rad
+};
 /* Private macro -------------------------------------------------------------*/
 /* Private types -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 hw_filter::Td unique_td_yaw = hw_filter::Td(25, 0.001, 2 * PI, 1);
 hw_filter::Td unique_td_pitch = hw_filter::Td(25, 0.001, 2 * PI, 1);
+hw_filter::Td unique_td_ref_yaw = hw_filter::Td(25, 0.001, 2 * PI, 1);
+hw_filter::Td unique_td_ref_pitch = hw_filter::Td(25, 0.001, 2 * PI, 1);
+robot::JointFdbFusion unique_fusion_yaw = robot::JointFdbFusion(kFusionParamsYaw);
+robot::JointFdbFusion unique_fusion_pitch = robot::JointFdbFusion(kFusionParamsPitch);
+robot::TimeOptimalTraj unique_traj_yaw = robot::TimeOptimalTraj(kTrajParamsYaw);
+robot::TimeOptimalTraj unique_traj_pitch = robot::TimeOptimalTraj(kTrajParamsPitch);
+robot::PitchFfdIdent unique_pitch_ffd_ident = robot::PitchFfdIdent(kPitchFfdIdentParams);
 /* External variables --------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
 /* Exported function definitions ---------------------------------------------*/
 hw_filter::Td *CreateTdYaw(void) { return &unique_td_yaw; };
 hw_filter::Td *CreateTdPitch(void) { return &unique_td_pitch; };
+hw_filter::Td *CreateTdRefYaw(void) { return &unique_td_ref_yaw; };
+hw_filter::Td *CreateTdRefPitch(void) { return &unique_td_ref_pitch; };
+robot::PitchFfdIdent *CreatePitchFfdIdent(void) { return &unique_pitch_ffd_ident; };
+robot::JointFdbFusion *CreateFusionYaw(void) { return &unique_fusion_yaw; };
+robot::JointFdbFusion *CreateFusionPitch(void) { return &unique_fusion_pitch; };
+robot::TimeOptimalTraj *CreateTrajYaw(void) { return &unique_traj_yaw; };
+robot::TimeOptimalTraj *CreateTrajPitch(void) { return &unique_traj_pitch; };
 /* Private function definitions ----------------------------------------------*/
@@ -36,7 +36,46 @@ hello_world::module::Fric::Config kFricConfig = {
         .spd_gradient = 0.5f   //1.0f
     }    
 };
+/**
+ * 脉冲形状，峰值为 1，1 ms 一个点；目前为按典型速度环响应给出的占位初值，未经实测，
+ * 实测方法见 fric_shot_ffd.hpp（Robot 中置 debug_fric_shot_capture 后读取 debug_fric_shot_shape）
+ */
+const float kFricShotShape[] = {
+    0.35f, 0.80f, 1.00f, 0.95f, 0.80f, 0.62f, 0.46f, 0.33f, 0.22f, 0.14f, 0.08f, 0.04f,
+};
+const robot::FricShotFfd::Params kFricShotFfdParams = {
+    .shape = kFricShotShape,
+    .shape_len = sizeof(kFricShotShape) / sizeof(kFricShotShape[0]),
+    .delay = 22,              ///< 按估计的弹丸接触时刻 25 ms 对齐脉冲峰值，实测后按峰值所在周期修正，单位 ms
+    .amp_init = 3000.0f,      ///< 脉冲幅值初值，单位 电机原始输入
+    .amp_max = 10000.0f,      ///< 脉冲幅值上限，单位 电机原始输入
+    .adapt_gain = 800.0f,     ///< 约为掉速 1 rad/s 所需幅值的一半，单位 电机原始输入/(rad/s)
+    .kp = 201.50f,            ///< 与摩擦轮速度环 kp 一致
+    .raw_per_curr = 819.2f,   ///< 3508 电调 16384 对应 20 A
+    .out_max = 16384.0f,      ///< 与摩擦轮速度环输出限幅一致
+    .base_lpf = 0.05f,        ///< 稳态值低通滤波系数
+    .min_spd = 300.0f,        ///< 摩擦轮转速低于该值不进行补偿，单位 rad/s
+    .obs_time = 25,           ///< 脉冲开始后测量掉速的时长，单位 ms
+    .confirm_time = 40,       ///< 发弹由本地检测确认，覆盖弹丸接触摩擦轮与检测的时延，单位 ms
+    .capture_on_start = true,  ///< kFricShotShape 为占位值，上电即实测、不注入脉冲；填入实测值后改为 false
+};
+const robot::ShotDetector::Params kShotDetectorParams = {
+    .inertia_per_kt = 0.0128f,  ///< 摩擦轮转动惯量约 2e-4 kg·m^2，3508 去减速箱力矩常数约 0.0156 N·m/A
+    .window = 5,                ///< 弹丸与摩擦轮接触约 2 ms，单位 ms
+    .imp_thres = 0.02f,         ///< 单发负载冲量约 0.045 A·s，取一半以下，单位 A·s
+    .base_lpf = 0.02f,          ///< 稳态值低通滤波系数
+    .min_spd = 300.0f,          ///< 摩擦轮转速低于该值不进行本地检测，单位 rad/s
+    .min_gap = 20,              ///< 两发之间的最短间隔，单位 ms
+    .match_time = 150,          ///< 覆盖裁判系统发弹数据经底盘转发的时延，单位 ms
+    .late_time = 350,           ///< 底盘转发偶尔堵塞时裁判系统数据最迟 500 ms 到达，单位 ms
+    .spd_ratio_init = 0.0366f,  ///< 摩擦轮 650 rad/s 时弹速约 23.8 m/s
+    .spd_ratio_lpf = 0.05f,     ///< 弹速与转速之比的修正系数
+    .min_blt_spd = 20.0f,       ///< 与弹速闭环的合理弹速范围一致，单位 m/s
+    .max_blt_spd = 28.0f,       ///< 与弹速闭环的合理弹速范围一致，单位 m/s
+};
 Fric unique_fric = Fric(kFricConfig);
+robot::FricShotFfd unique_fric_shot_ffd = robot::FricShotFfd(kFricShotFfdParams);
+robot::ShotDetector unique_shot_detector = robot::ShotDetector(kShotDetectorParams);
 Fric *CreateFric()
 {
   static bool is_fric_created = false;
@@ -51,6 +90,8 @@ Fric *CreateFric()
   return &unique_fric;
 
 }
+robot::FricShotFfd *CreateFricShotFfd() { return &unique_fric_shot_ffd; };
+robot::ShotDetector *CreateShotDetector() { return &unique_shot_detector; };
 /* Private types -------------------------------------------------------------*/
 /* Private constants ---------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
@@ -26,6 +26,18 @@ const robot::Gimbal::Config kGimbalConfig = {
     .pitch_center_offset = 0.31f, //0.31f                           ///??< 云台水平时，重心和pitch轴的连线与水平轴的夹角，单位 rad
     .resist_ffd_torq = 0.0f,                                ///< 云台摩擦力矩，单位 N·m.
     .allowed_ang_err = 0.0f,                               ///< 云台角度误差允许范围，单位 rad
+    .spin_visc_torq = 0.01f,         ///< yaw 电机粘滞摩擦与反电动势阻力系数，单位 N·m/(rad/s)
+    .spin_coulomb_torq = 0.08f,      ///< yaw 电机库仑摩擦力矩，单位 N·m
+    .spin_coulomb_spd_band = 0.5f,   ///< 库仑摩擦线性过渡的相对转速范围，单位 rad/s
+    .spin_ref_weight = 0.3f,         ///< 底盘角速度中期望值所占权重
+    .spin_latency = 0.003f,          ///< 底盘运动数据的固定时延，单位 s
+    .yaw_max_torq = 6.9f,            ///< yaw 电机可用的最大力矩，与 yaw PID 输出限幅一致，单位 N·m
+    .headroom_attack = 0.2f,         ///< 力矩占用率上升时的低通滤波系数
+    .headroom_release = 0.005f,      ///< 力矩占用率下降时的低通滤波系数
+    .joint_ctrl_type = {robot::Gimbal::JointCtrlType::Pid, robot::Gimbal::JointCtrlType::Pid},  ///< pitch、yaw 使用的控制器
+    .joint_inertia = {0.02f, 0.05f},        ///< pitch、yaw 关节转动惯量，单位 kg·m^2
+    .traj_spd_ffd_gain = {1.35f, 1.86f},    ///< pitch、yaw PID 速度环比例系数，单位 N·m/(rad/s)
+    .use_fused_fdb = true,           ///< 使用编码器与 IMU 融合的关节反馈
   };
 
 /* const robot::Feed::Config kFeedConfig = {
@@ -68,6 +80,17 @@ robot::Gimbal* CreateGimbal()
 
     unique_gimbal.registerTd(CreateTdYaw(), robot::Gimbal::kJointYaw);
     unique_gimbal.registerTd(CreateTdPitch(), robot::Gimbal::kJointPitch);
+    unique_gimbal.registerPitchIdent(CreatePitchFfdIdent());
+
+    unique_gimbal.registerAdrc(CreateAdrcYaw(), robot::Gimbal::kJointYaw);
+    unique_gimbal.registerAdrc(CreateAdrcPitch(), robot::Gimbal::kJointPitch);
+    unique_gimbal.registerRefTd(CreateTdRefYaw(), robot::Gimbal::kJointYaw);
+    unique_gimbal.registerRefTd(CreateTdRefPitch(), robot::Gimbal::kJointPitch);
+    unique_gimbal.registerVisionTracker(CreateVisionTracker());
+    unique_gimbal.registerFusion(CreateFusionYaw(), robot::Gimbal::kJointYaw);
+    unique_gimbal.registerFusion(CreateFusionPitch(), robot::Gimbal::kJointPitch);
+    unique_gimbal.registerTraj(CreateTrajYaw(), robot::Gimbal::kJointYaw);
+    unique_gimbal.registerTraj(CreateTrajPitch(), robot::Gimbal::kJointPitch);
 
     // 只接收数据的组件指针
     unique_gimbal.registerImu(CreateImu());
@@ -143,7 +166,13 @@ robot::Robot* CreateRobot()
     unique_robot.registerFeedMotor(CreateMotorFeed());
     unique_robot.registerGimbalMotor(CreateMotorPitch(), robot::Gimbal::kJointPitch);
 
-    unique_robot.registerVision(CreateVision());
+    unique_robot.registerVisionLink(CreateVisionLink());
+    unique_robot.registerPoseHistory(CreatePoseHistory());
+    unique_robot.registerFireCtrl(CreateFireCtrl());
+    unique_robot.registerHeatSched(CreateHeatSched());
+    unique_robot.registerFeedProfile(CreateFeedProfile(), CreatePidMotorFeed());
+    unique_robot.registerFricShotFfd(CreateFricShotFfd());
+    unique_robot.registerShotDetector(CreateShotDetector());
 
     is_robot_created = true;
   }
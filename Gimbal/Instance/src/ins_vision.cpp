@@ -15,17 +15,37 @@
 /* Includes ------------------------------------------------------------------*/
 #include "ins_vision.hpp"
 /* Private constants ---------------------------------------------------------*/
+const robot::VisionTracker::Params kVisionTrackerParams = {
+    .q_acc = 10.0f,        ///< 目标角加速度白噪声的功率谱密度，单位 (rad/s^2)^2·s
+    .r_ang = 2.5e-5f,      ///< 视觉角度测量噪声的方差，约 5 mrad 标准差，单位 rad^2
+    .vis_latency = 0.014f, ///< 视觉从拍摄到数据到达云台的时延，单位 s
+    .ctrl_lead = 0.0f,     ///< 控制时延补偿，轨迹已带角速度前馈，取 0，单位 s
+    .max_extrap = 0.1f,    ///< 最长外推时间，单位 s
+    .reset_thres = 0.2f,   ///< 新息超过该值时认为切换了目标，单位 rad
+    .spd_max = 6.0f,       ///< 目标角速度估计的上限，单位 rad/s
+};
+const robot::VisionLink::Config kVisionLinkConfig = {
+    .sync = {
+        .rtt_max = 3000,     ///< 有效样本的最大往返时延，单位 us
+        .timeout = 1000000,  ///< 1 s 未收到有效样本时认为失步，单位 us
+    },
+    .sync_interval = 20,  ///< 每 20 帧（100 ms）附带一次同步请求
+    .hfov = 0.785f,       ///< 相机水平视场角，单位 rad
+    .vfov = 0.6183f,      ///< 相机垂直视场角，单位 rad
+};
+const robot::PoseHistory::Params kPoseHistoryParams = {
+    .max_extrap = 2000,  ///< 拍摄时刻晚于最新位姿时最多沿用 2 个周期，单位 us
+};
 /* Private macro -------------------------------------------------------------*/
 /* Private types -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
-hw_vision::Vision::Config kvisionConfig= {
-    .default_blt_spd = 23.7f,
-    .hfov = 0.785,
-    .vfov = 0.6183,
-};
-hw_vision::Vision unique_vision = hw_vision::Vision(kvisionConfig);
+robot::VisionTracker unique_vision_tracker = robot::VisionTracker(kVisionTrackerParams);
+robot::VisionLink unique_vision_link = robot::VisionLink(kVisionLinkConfig);
+robot::PoseHistory unique_pose_history = robot::PoseHistory(kPoseHistoryParams);
 /* External variables --------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
 /* Exported function definitions ---------------------------------------------*/
-hw_vision::Vision* CreateVision() { return &unique_vision; };
+robot::VisionTracker* CreateVisionTracker() { return &unique_vision_tracker; };
+robot::VisionLink* CreateVisionLink() { return &unique_vision_link; };
+robot::PoseHistory* CreatePoseHistory() { return &unique_pose_history; };
 /* Private function definitions ----------------------------------------------*/
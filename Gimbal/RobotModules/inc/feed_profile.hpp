@@ -0,0 +1,136 @@
+/**
+ *******************************************************************************
+ * @file      :feed_profile.hpp
+ * @brief     : 拨盘单发拨弹的加加速度受限轨迹与卡弹早期处理
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 拨弹时机、热量限制与卡弹后的回退仍由 Feed 模块决定，Feed 每次拨弹时期望角度阶跃 ang_per_blt，
+ *     角度环 PID 的输出会立即饱和；本模块每周期读取 Feed 角度环的期望角度，期望角度前移超过半发时
+ *     以其为目标按轨迹接管电机电流，目标始终与 Feed 的期望角度一致：
+ *     - 接管期间 Feed 的期望角度继续前移（下一发）时，本发到位后从当前位置接着规划到新的期望角度
+ *     - Feed 的期望角度后退（Feed 的堵转回退）时立即交还，不与 Feed 的回退争夺拨盘
+ *     - Feed 的角度环与速度环均为纯比例，没有积分等隐藏状态，其输出只取决于期望角度与拨盘状态；
+ *       到位后等到 Feed 的输出电流与本模块相差小于 handback_curr 再交还，交接时电流不跳变，
+ *       超过 settle_time 仍未满足时强制交还
+ *  2. 轨迹为起止速度为 0 的七段式 S 曲线，加加速度、加速度、角速度分别受限，
+ *     加速度上限由电机最大电流对应的力矩与拨盘转动惯量确定，并按 acc_ratio 留出摩擦与弹丸阻力的余量；
+ *     电流为惯量加速度前馈与角度、角速度误差反馈之和
+ *  3. 卡弹早期检测：电流接近饱和且轨迹跟踪滞后超过 jam_err 持续 jam_time 时认为开始卡弹，
+ *     先以 rev_curr 反转 rev_time 松开弹丸，再从当前位置重新规划到原目标角度，
+ *     重试 max_retry 次仍卡弹时交还给 Feed 的堵转处理
+ *  4. 拨盘角度为输出轴角度，在本模块内展开为连续角度
+ *  5. 交接与卡弹回退的主机端仿真见 tools/host/feed_handback_sim.cpp
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ROBOT_MODULES_FEED_PROFILE_HPP_
+#define ROBOT_MODULES_FEED_PROFILE_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstddef>
+#include <cstdint>
+
+/* Exported macro ------------------------------------------------------------*/
+
+namespace robot
+{
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+struct FeedProfileParams {
+  float step_ang;         ///< 每发弹丸的拨盘转角，与 Feed 配置一致，单位 rad
+  float inertia;          ///< 折算到输出轴的拨盘转动惯量，单位 kg·m^2
+  float kt;               ///< 折算到输出轴的电机力矩常数，单位 N·m/A
+  float curr_max;         ///< 电机最大电流，单位 A
+  float acc_ratio;        ///< 规划加速度占最大电流对应加速度的比例，值域 (0, 1]
+  float jerk_max;         ///< 最大角加加速度，单位 rad/s^3
+  float spd_max;          ///< 最大角速度，单位 rad/s
+  float kp;               ///< 角度误差反馈系数，单位 A/rad
+  float kd;               ///< 角速度误差反馈系数，单位 A/(rad/s)
+  float idle_spd;         ///< 角速度低于该值认为拨盘静止，单位 rad/s
+  float settle_err;       ///< 轨迹结束后角度误差小于该值认为到位，单位 rad
+  uint32_t settle_time;   ///< 轨迹结束后最长等待到位的时间，单位 ms
+  float handback_curr;    ///< 到位后 Feed 的输出电流与本模块之差小于该值才交还，单位 A
+  float jam_err;          ///< 卡弹检测的轨迹跟踪滞后阈值，单位 rad
+  float jam_curr;         ///< 卡弹检测的电流阈值，单位 A
+  uint32_t jam_time;      ///< 卡弹检测的持续时间，单位 ms
+  float rev_curr;         ///< 松开弹丸时的反转电流，单位 A
+  uint32_t rev_time;      ///< 松开弹丸时的反转时间，单位 ms
+  uint8_t max_retry;      ///< 单发最多重试次数
+};
+
+class FeedProfile
+{
+ public:
+  typedef FeedProfileParams Params;
+
+  enum class State : uint8_t {
+    kIdle,     ///< 由 Feed 控制
+    kStep,     ///< 按轨迹拨弹
+    kRelease,  ///< 反转松开弹丸
+  };
+
+  FeedProfile(const Params &params);
+  ~FeedProfile() {};
+
+  bool update(uint32_t tick, float ang, float spd, float curr, float feed_ang_ref, float feed_curr_ref);
+  void reset();
+
+  /** 是否接管电机电流 */
+  bool isActive() const { return state_ != State::kIdle; }
+  /** 接管时的电机电流期望值，单位 A */
+  float getCurrRef() const { return curr_ref_; }
+  /** 最近一发是否重试后仍卡弹，交由 Feed 处理 */
+  bool isJammed() const { return is_jammed_; }
+  /** 本周期是否开始了新的一发（不含卡弹重试） */
+  bool isStepStarted() const { return is_step_started_; }
+  /** 单发轨迹时长，单位 s，可作为拨弹间隔的下限参考 */
+  float getStepDuration() const { return step_duration_; }
+  uint32_t getJamCnt() const { return jam_cnt_; }
+  State getState() const { return state_; }
+
+ private:
+  void plan(float dist);
+  void sample(float t, float *ang, float *spd, float *acc) const;
+  void startStep(uint32_t tick, float goal);
+
+  Params params_;
+  float acc_max_ = 0.0f;        ///< 规划用最大角加速度，单位 rad/s^2
+  float step_duration_ = 0.0f;  ///< 满步长轨迹时长，单位 s
+
+  State state_ = State::kIdle;
+  bool is_jammed_ = false;      ///< 最近一发是否重试后仍卡弹
+  bool is_step_started_ = false;  ///< 本周期是否开始了新的一发
+
+  // 角度展开
+  bool has_ang_ = false;        ///< 是否记录过角度
+  float last_raw_ang_ = 0.0f;   ///< 上一次的原始角度，单位 rad
+  float ang_ = 0.0f;            ///< 展开后的连续角度，单位 rad
+  float feed_goal_ = 0.0f;      ///< Feed 的期望角度，与 ang_ 在同一展开角度下，单位 rad
+
+  // 当前轨迹
+  float start_ang_ = 0.0f;      ///< 轨迹起点，单位 rad
+  float goal_ang_ = 0.0f;       ///< 本发目标角度，单位 rad
+  float dir_ = 1.0f;            ///< 轨迹方向
+  float phase_t_[7] = {0.0f};   ///< 各段时长，单位 s
+  float phase_j_[7] = {0.0f};   ///< 各段加加速度，单位 rad/s^3
+  float duration_ = 0.0f;       ///< 轨迹总时长，单位 s
+  uint32_t start_tick_ = 0;     ///< 当前阶段开始的时间戳，单位 ms
+
+  uint32_t jam_ms_ = 0;         ///< 满足卡弹条件的持续时间，单位 ms
+  uint8_t retry_cnt_ = 0;       ///< 本发已重试次数
+  uint32_t jam_cnt_ = 0;        ///< 累计检测到的卡弹次数
+  uint32_t last_tick_ = 0;      ///< 上一次更新的时间戳，单位 ms
+
+  float curr_ref_ = 0.0f;       ///< 电机电流期望值，单位 A
+};
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+}  // namespace robot
+#endif /* ROBOT_MODULES_FEED_PROFILE_HPP_ */
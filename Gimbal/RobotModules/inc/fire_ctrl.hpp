@@ -0,0 +1,97 @@
+/**
+ *******************************************************************************
+ * @file      :fire_ctrl.hpp
+ * @brief     : 自瞄射击决策，由预测瞄准误差与弹丸飞行时间估计命中概率并选择拨弹时机
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 视觉的射击指令只给出允许射击的时间窗口，是否在当前控制周期拨弹由本模块决定
+ *  2. 瞄准误差为目标方向（视觉跟踪器外推结果）减去云台方向，按两者角速度之差线性外推到
+ *     弹丸出膛时刻（当前时刻加拨弹时延），pitch、yaw 各轴独立计算
+ *  3. 各轴命中概率为正态分布的误差落在装甲板半角尺寸内的概率，半角尺寸由装甲板尺寸与目标距离
+ *     换算；误差方差为弹道散布与弹丸飞行期间目标运动预测误差（随飞行时间增长）之和
+ *  4. 命中概率低于 p_min 时不射击；高于 p_min 时，若推迟 look_ahead 后命中概率更高则继续等待，
+ *     直到命中概率不再上升、超过 p_good 或等待超过 max_wait
+ *  5. 瞄准晃动时的命中率对比见 tools/host/fire_ctrl_sim.cpp
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ROBOT_MODULES_FIRE_CTRL_HPP_
+#define ROBOT_MODULES_FIRE_CTRL_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstddef>
+#include <cstdint>
+
+/* Exported macro ------------------------------------------------------------*/
+
+namespace robot
+{
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+struct FireCtrlParams {
+  float feed_delay;     ///< 拨盘开始拨弹到弹丸出膛的时延，单位 s
+  float disp_std;       ///< 弹道散布（含弹速波动）的角度标准差，单位 rad
+  float tgt_spd_std;    ///< 目标角速度预测误差的标准差，乘以飞行时间为飞行期间的方向误差，单位 rad/s
+  float armor_half_w;   ///< 装甲板有效半宽，单位 m
+  float armor_half_h;   ///< 装甲板有效半高，单位 m
+  float default_dist;   ///< 视觉未给出距离时使用的目标距离，单位 m
+  float min_blt_spd;    ///< 弹速下限，弹速反馈低于该值时按该值计算飞行时间，单位 m/s
+  float p_min;          ///< 允许射击的最低命中概率
+  float p_good;         ///< 命中概率高于该值时立即射击，不再等待更优时机
+  float look_ahead;     ///< 比较射击时机时推迟的时间，单位 s
+  uint32_t max_wait;    ///< 命中概率达标后最长等待时间，单位 ms
+};
+
+class FireCtrl
+{
+ public:
+  typedef FireCtrlParams Params;
+
+  enum AxisIdx : uint8_t {
+    kAxisPitch = 0u,
+    kAxisYaw = 1u,
+    kAxisNum = 2u,
+  };
+
+  struct Input {
+    bool is_permitted = false;            ///< 视觉是否允许射击
+    float aim_err[kAxisNum] = {0.0f};     ///< 目标方向减去云台方向，单位 rad
+    float err_spd[kAxisNum] = {0.0f};     ///< 目标方向角速度减去云台角速度，单位 rad/s
+    float dist = 0.0f;                    ///< 目标距离，单位 m，不大于 0 时使用 default_dist
+    float blt_spd = 0.0f;                 ///< 弹速，单位 m/s
+  };
+
+  FireCtrl(const Params &params) : params_(params) {};
+  ~FireCtrl() {};
+
+  bool update(uint32_t tick, const Input &input);
+  void reset();
+
+  /** 当前周期拨弹时的命中概率 */
+  float getHitProb() const { return hit_prob_; }
+  /** 弹丸飞行时间，单位 s */
+  float getFlightTime() const { return flight_time_; }
+  bool isFireAllowed() const { return is_fire_allowed_; }
+
+ private:
+  float calcHitProb(const Input &input, float dist, float delay) const;
+
+  Params params_;
+
+  bool is_waiting_ = false;       ///< 命中概率已达标，是否在等待更优时机
+  uint32_t wait_start_tick_ = 0;  ///< 开始等待的时间戳，单位 ms
+  bool is_fire_allowed_ = false;  ///< 当前周期是否允许拨弹
+  float hit_prob_ = 0.0f;         ///< 当前周期拨弹时的命中概率
+  float flight_time_ = 0.0f;      ///< 弹丸飞行时间，单位 s
+};
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+}  // namespace robot
+#endif /* ROBOT_MODULES_FIRE_CTRL_HPP_ */
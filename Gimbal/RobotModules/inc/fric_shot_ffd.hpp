@@ -0,0 +1,151 @@
+/**
+ *******************************************************************************
+ * @file      :fric_shot_ffd.hpp
+ * @brief     : 摩擦轮单发掉速的电流前馈补偿
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 弹丸经过摩擦轮时摩擦轮掉速，仅靠速度环反馈恢复会使连发中各发弹速不一致；本模块在拨盘开始拨弹后
+ *     延时 delay，在两个摩擦轮电机上叠加一段电流前馈脉冲，脉冲形状 shape 由单发后摩擦轮速度环的电流响应
+ *     离线辨识、归一化得到，每个控制周期取一个点
+ *  2. Fric 模块写入电机的电流期望值无法读回，脉冲期间本模块接管电机输入：
+ *     输入 = 拨弹前的稳态电流 + 脉冲 + kp ×（拨弹前的稳态转速 - 当前转速），
+ *     kp 与摩擦轮速度环一致，稳态电流与稳态转速在脉冲之外由反馈低通滤波得到；脉冲结束后交还给 Fric
+ *  3. 脉冲开始后 obs_time 内记录每个摩擦轮相对稳态转速的最大掉速与最大超调，
+ *     确认确实发射了弹丸后按（掉速 - 超调）修正该摩擦轮的脉冲幅值，未确认的测量在 confirm_time 后丢弃，
+ *     避免空拨时脉冲引起的超调把幅值拉低
+ *  4. 摩擦轮转速低于 min_spd 时（未开启或在减速）不进行补偿
+ *  5. 实测脉冲形状：setCapture(true) 后本模块不再注入脉冲、不修正幅值，只记录拨弹后 kCaptureLen 个
+ *     控制周期内两个摩擦轮相对稳态电流的平均电流响应（即 Fric 速度环对单发的响应），确认发射的各发累加平均；
+ *     getCapture 给出按峰值归一化的响应与峰值所在周期，截取峰值前后的点作为 shape，末端几个点衰减到 0
+ *     （速度环响应衰减慢，截断处仍接近峰值，不衰减会在交还时跳变），
+ *     delay 取峰值所在周期减去 shape 中峰值的下标；shape 尚未实测时 capture_on_start 置 true，
+ *     上电即处于实测状态，摩擦轮完全由 Fric 控制
+ *  6. 注入脉冲期间的反馈只有与摩擦轮速度环一致的比例项，不含 Fric 的同速环，启用注入前需在实车上
+ *     确认交还时电机输入无跳变
+ *  7. 实测与注入在摩擦轮模型上的主机端仿真见 tools/host/fric_shot_capture_sim.cpp
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ROBOT_MODULES_FRIC_SHOT_FFD_HPP_
+#define ROBOT_MODULES_FRIC_SHOT_FFD_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstddef>
+#include <cstdint>
+
+/* Exported macro ------------------------------------------------------------*/
+
+namespace robot
+{
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+struct FricShotFfdParams {
+  const float *shape;      ///< 归一化的脉冲形状，峰值为 1，每个控制周期一个点
+  size_t shape_len;        ///< 脉冲形状的点数
+  uint32_t delay;          ///< 拨盘开始拨弹到脉冲开始的时延，单位 ms
+  float amp_init;          ///< 脉冲幅值初值，单位 电机原始输入
+  float amp_max;           ///< 脉冲幅值上限，单位 电机原始输入
+  float adapt_gain;        ///< 幅值修正系数，单位 电机原始输入/(rad/s)
+  float kp;                ///< 脉冲期间的转速误差反馈系数，与摩擦轮速度环一致，单位 电机原始输入/(rad/s)
+  float raw_per_curr;      ///< 电机原始输入与电流反馈的比例，单位 1/A
+  float out_max;           ///< 电机原始输入上限
+  float base_lpf;          ///< 稳态电流与稳态转速的低通滤波系数，值域 (0, 1]
+  float min_spd;           ///< 进行补偿的最低摩擦轮转速，单位 rad/s
+  uint32_t obs_time;       ///< 脉冲开始后测量掉速的时长，单位 ms
+  uint32_t confirm_time;   ///< 拨弹后等待发弹确认的最长时间，单位 ms
+  bool capture_on_start;   ///< 上电后即实测脉冲形状、不注入脉冲，shape 尚未实测时置 true
+};
+
+class FricShotFfd
+{
+ public:
+  typedef FricShotFfdParams Params;
+
+  enum FricIdx : uint8_t {
+    kFricFirst = 0u,
+    kFricSecond = 1u,
+    kFricNum = 2u,
+  };
+
+  static const size_t kCaptureLen = 48;  ///< 实测脉冲形状时每发记录的点数，覆盖 delay + obs_time
+
+  FricShotFfd(const Params &params);
+  ~FricShotFfd() {};
+
+  void trigger(uint32_t tick);
+  void onShotConfirmed();
+  bool update(uint32_t tick, const float spd[kFricNum], const float curr[kFricNum]);
+  void reset();
+
+  void setCapture(bool is_capture);
+  size_t getCapture(float shape[kCaptureLen]) const;
+  /** 是否在实测脉冲形状 */
+  bool isCapturing() const { return is_capture_; }
+  /** 实测脉冲形状已累加的发数 */
+  uint32_t getCaptureCnt() const { return capture_cnt_; }
+
+  /** 是否接管摩擦轮电机输入 */
+  bool isActive() const { return is_active_; }
+  /** 接管时的电机原始输入 */
+  float getInput(FricIdx idx) const { return input_[idx]; }
+  /** 当前的脉冲幅值，单位 电机原始输入 */
+  float getAmp(FricIdx idx) const { return amp_[idx]; }
+  /** 最近一次测得的掉速减超调，单位 rad/s */
+  float getLastDip(FricIdx idx) const { return last_dip_[idx]; }
+
+ private:
+  static const size_t kMaxPending = 4;  ///< 等待发弹确认的测量数量上限
+
+  struct Measure {
+    uint32_t trig_tick = 0;             ///< 拨弹时间戳，单位 ms
+    float dip[kFricNum] = {0.0f};       ///< 掉速减超调，单位 rad/s
+    bool has_capture = false;           ///< 是否记录了完整的电流响应
+    float curr[kCaptureLen] = {0.0f};   ///< 相对稳态电流的电流响应，单位 电机原始输入
+  };
+
+  void finishObserve();
+  void confirm(const Measure &measure);
+  void adapt(const float dip[kFricNum]);
+
+  Params params_;
+
+  float amp_[kFricNum] = {0.0f};        ///< 脉冲幅值，单位 电机原始输入
+  float last_dip_[kFricNum] = {0.0f};   ///< 最近一次测得的掉速减超调，单位 rad/s
+
+  // 稳态
+  bool has_base_ = false;               ///< 是否已有稳态值
+  float dir_[kFricNum] = {0.0f};        ///< 摩擦轮转向
+  float base_spd_[kFricNum] = {0.0f};   ///< 稳态转速（沿转向为正），单位 rad/s
+  float base_curr_[kFricNum] = {0.0f};  ///< 稳态电流（沿转向为正），单位 电机原始输入
+
+  // 当前一发
+  bool is_triggered_ = false;           ///< 是否在本发的脉冲或测量期间
+  uint32_t trig_tick_ = 0;              ///< 拨弹时间戳，单位 ms
+  float min_dev_[kFricNum] = {0.0f};    ///< 相对稳态转速的最大掉速，单位 rad/s，非正
+  float max_dev_[kFricNum] = {0.0f};    ///< 相对稳态转速的最大超调，单位 rad/s，非负
+
+  Measure pending_[kMaxPending];        ///< 等待发弹确认的测量，按时间先后排列
+  size_t pending_num_ = 0;              ///< 等待发弹确认的测量数量
+  bool is_confirmed_ = false;           ///< 当前一发是否已确认发射
+
+  // 实测脉冲形状
+  bool is_capture_ = false;             ///< 是否在实测脉冲形状
+  float capture_[kCaptureLen] = {0.0f};      ///< 当前一发的电流响应，单位 电机原始输入
+  size_t capture_len_ = 0;                   ///< 当前一发已记录的点数
+  float capture_sum_[kCaptureLen] = {0.0f};  ///< 确认发射的各发电流响应之和，单位 电机原始输入
+  uint32_t capture_cnt_ = 0;                 ///< 已累加的发数
+
+  bool is_active_ = false;              ///< 是否接管电机输入
+  float input_[kFricNum] = {0.0f};      ///< 电机原始输入
+};
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+}  // namespace robot
+#endif /* ROBOT_MODULES_FRIC_SHOT_FFD_HPP_ */
@@ -24,6 +24,11 @@
 #include "imu.hpp"
 #include "feed.hpp"
 #include "laser.hpp"
+#include "joint_fdb_fusion.hpp"
+#include "ladrc.hpp"
+#include "time_optimal_traj.hpp"
+#include "vision_tracker.hpp"
+#include "pitch_ffd_ident.hpp"
 
 /* Exported macro ------------------------------------------------------------*/
 
@@ -67,6 +72,11 @@ union GimbalCmd {
 
   friend GimbalCmd operator*(float scalar, const GimbalCmd &cmd);
 };
+
+enum class GimbalJointCtrlType : uint8_t {
+  Pid,   ///< 角度-速度串级 PID
+  Adrc,  ///< 线性自抗扰控制
+};
 class Gimbal : public Fsm
 {
  public:
@@ -77,6 +87,12 @@ class Gimbal : public Fsm
 
   typedef hello_world::imu::Imu Imu;
   typedef hello_world::laser::Laser Laser;
+  typedef PitchFfdIdent PitchIdent;
+  typedef Ladrc Adrc;
+  typedef TimeOptimalTraj Traj;
+  typedef JointFdbFusion Fusion;
+  typedef VisionTracker Tracker;
+  typedef GimbalJointCtrlType JointCtrlType;
   typedef GimbalWorkingMode WorkingMode;
   typedef GimbalCmd Cmd;
 
@@ -91,11 +107,29 @@ class Gimbal : public Fsm
     /* 电机阻力前馈 */
     float resist_ffd_torq[2];  ///< 云台电机阻力前馈力矩，单位 N·m
     float allowed_ang_err[2];  ///< 云台角度的允许误差（用于分段计算阻力前馈力矩）
+    /* 底盘旋转前馈 */
+    float spin_visc_torq;         ///< yaw 电机粘滞摩擦与反电动势阻力系数，单位 N·m/(rad/s)
+    float spin_coulomb_torq;      ///< yaw 电机库仑摩擦力矩，单位 N·m
+    float spin_coulomb_spd_band;  ///< 库仑摩擦在该相对转速内线性过渡，单位 rad/s
+    float spin_ref_weight;        ///< 底盘角速度中期望值所占权重，其余为反馈值，值域 [0, 1]
+    float spin_latency;           ///< 底盘运动数据从采样到力矩生效的固定时延，单位 s
+    /* yaw 电机力矩余量 */
+    float yaw_max_torq;           ///< yaw 电机可用的最大力矩，单位 N·m
+    float headroom_attack;        ///< 力矩占用率上升时的低通滤波系数，值域 (0, 1]
+    float headroom_release;       ///< 力矩占用率下降时的低通滤波系数，值域 (0, 1]
+    /* 关节控制器 */
+    JointCtrlType joint_ctrl_type[2];  ///< 各关节使用的控制器，顺序为 pitch、yaw
+    /* 关节轨迹前馈，顺序为 pitch、yaw */
+    float joint_inertia[2];       ///< 关节转动惯量，用于轨迹加速度前馈，单位 kg·m^2
+    float traj_spd_ffd_gain[2];   ///< PID 速度环比例系数，用于把轨迹角速度折算为力矩前馈，单位 N·m/(rad/s)
+    /* 关节反馈 */
+    bool use_fused_fdb;           ///< 是否使用编码器与 IMU 融合的关节反馈，不再随控制模式切换反馈来源
   };
 
   struct VisionData {
     Cmd cmd = {0.0f, 0.0f};
     bool is_target_detected = true;
+    float latency = -1.0f;  ///< 视觉指令从拍摄到当前时刻的时延，单位 s，小于 0 时由跟踪器取固定时延
   };
 
   enum JointIdx : uint8_t {
@@ -107,6 +141,7 @@ class Gimbal : public Fsm
   enum class CtrlAngBased : uint8_t {
     Imu,    ///< 基于IMU的角度控制
     Motor,  ///< 基于关节角度的角度控制
+    Fused,  ///< 基于编码器与 IMU 融合角度的角度控制
   };
 
   Gimbal(Config config) { cfg_ = config; };
@@ -138,6 +173,7 @@ class Gimbal : public Fsm
   uint8_t getBuffMode() const { return buff_mode_; }
   
   void setVisionTargetDetected(bool flag) { vis_data_.is_target_detected = flag; }
+  void setChassisYawMotion(float spd_ref, float spd_fdb, float acc_ref, uint8_t seq, bool is_valid);
   void updateIsRfrPwrOn(bool flag) { is_rfr_pwr_on_ = flag; }
 
   void setNormCmdDelta(const Cmd &cmd) { norm_cmd_delta_ = cmd; }
@@ -148,15 +184,27 @@ class Gimbal : public Fsm
   }
   const Cmd &getNormCmdDelta() const { return norm_cmd_delta_; }
 
-  void setVisionCmd(const Cmd &cmd) { vis_data_.cmd = cmd; }
-  void setVisionCmd(float yaw, float pitch)
+  void setVisionCmd(const Cmd &cmd) { setVisionCmd(cmd.yaw, cmd.pitch); }
+  void setVisionCmd(float yaw, float pitch, float latency = -1.0f)
   {
     vis_data_.cmd.yaw = yaw;
     vis_data_.cmd.pitch = pitch;
+    vis_data_.latency = latency;
   }
 
   float getJointYawAngFdb() const { return joint_ang_fdb_[kJointYaw]; }
   float getJointPitchAngFdb() const { return joint_ang_fdb_[kJointPitch]; }
+  float getJointYawSpdFdb() const { return joint_spd_fdb_[kJointYaw]; }
+  float getJointYawSpdRef() const { return joint_spd_ref_[kJointYaw]; }
+  float getJointPitchSpdFdb() const { return joint_spd_fdb_[kJointPitch]; }
+  /** 跟踪器外推后的视觉目标方向，未注册跟踪器或未跟踪时为视觉原始指令，单位 rad */
+  const Cmd &getVisionRef() const { return vis_ref_; }
+  /** 视觉目标方向的角速度估计，未跟踪时为 0，单位 rad/s */
+  float getVisionRefSpd(JointIdx idx) const;
+  /** yaw 电机的力矩余量，值域 [0, 1]，1 表示完全未使用 */
+  float getYawTorHeadroom() const { return 1.0f - yaw_tor_usage_; }
+  /** IMU 与编码器的角度偏差估计，包含安装误差与底盘姿态，单位 rad */
+  float getImuJointOffset(JointIdx idx) const { return fused_ang_fdb_[idx] - motor_ang_fdb_[idx]; }
   float getJointRollAngFdb() const
   {
     HW_ASSERT(imu_ptr_ != nullptr, "IMU pointer is nullptr", imu_ptr_);
@@ -166,19 +214,29 @@ class Gimbal : public Fsm
   void setCtrlMode(CtrlMode mode) { ctrl_mode_ = mode; }
   CtrlMode getCtrlMode() const { return ctrl_mode_; }
 
+  void setJointCtrlType(JointIdx idx, JointCtrlType type) { cfg_.joint_ctrl_type[idx] = type; }
+  JointCtrlType getJointCtrlType(JointIdx idx) const { return cfg_.joint_ctrl_type[idx]; }
+
   void setWorkingMode(WorkingMode mode) { working_mode_ = mode; }
   WorkingMode getWorkingMode() const { return working_mode_; }
   // 注册组件指针
   void registerMotor(Motor *ptr, JointIdx idx);
   void registerPid(Pid *ptr, JointIdx idx);
   void registerTd(Td *ptr, size_t idx);
+  void registerAdrc(Adrc *ptr, JointIdx idx);
+  void registerRefTd(Td *ptr, JointIdx idx);
+  void registerTraj(Traj *ptr, JointIdx idx);
+  void registerFusion(Fusion *ptr, JointIdx idx);
+  void registerVisionTracker(Tracker *ptr);
   void registerImu(Imu *ptr);
+  void registerPitchIdent(PitchIdent *ptr);
 
  private:
   //  数据更新
   void updateData();
   void updateMotorData();
   void updateImuData();
+  void updateFusedData();
   void updateIsPwrOn();
   void updatePwrState();
 
@@ -189,13 +247,22 @@ class Gimbal : public Fsm
 
   void calcCtrlAngBased();
   void adjustJointFdb();
+  float calcMotorToCtrlAngDelta(JointIdx idx) const;
   void calcCruiseMode(Cmd &tmp_ang_ref);
   float normalize_angle(float angle);
   void get_shortest_angle_diff(float from, float to);
   void adjustLastJointAngRef();
+  void updateVisionTracker();
   void calcJointAngRef();
+  void calcJointAngTraj();
+  void resetJointAngTraj();
   void calcJointTorRef();
-  float calcJointFfdResistance(JointIdx idx);
+  void calcJointSpdRefTd(JointIdx idx);
+  void updatePitchIdent();
+  float calcJointFfdPitch();
+  float calcJointFfdResistance(JointIdx idx, float resist_torq);
+  float calcJointFfdSpin();
+  void calcYawTorHeadroom();
 
   // 数据重置
   void resetDataOnDead();
@@ -217,6 +284,7 @@ class Gimbal : public Fsm
 
   Cmd norm_cmd_delta_ = {0.0, 0.0};  ///< 控制指令的增量
   VisionData vis_data_;
+  Cmd vis_ref_ = {0.0f, 0.0f};  ///< 跟踪器外推后的视觉期望角度，无跟踪器时等于视觉原始指令
 
   float diff;
 
@@ -240,10 +308,28 @@ class Gimbal : public Fsm
   float last_joint_ang_ref_[kJointNum] = {0.0f};  ///< 上一控制周期的关节角度期望值
   float joint_ang_ref_[kJointNum] = {0.0f};       ///< 关节角度期望值
   float joint_ang_fdb_[kJointNum] = {0.0f};       ///< 关节角度反馈值
+  float joint_ang_ref_prev_[kJointNum] = {0.0f};  ///< 上一次 calcJointAngRef 输出的关节角度期望值
+  float joint_spd_ref_[kJointNum] = {0.0f};       ///< 关节角度期望值的变化率，单位 rad/s
   float joint_spd_fdb_[kJointNum] = {0.0f};       ///< 关节角速度反馈值
   float joint_tor_ref_[kJointNum] = {0.0f};       ///< 关节扭矩期望值
   float joint_tor_ffd_[kJointNum] = {0.0f};       ///< 关节扭矩前馈值
   float pitch_spd_ref_ = 0.0;
+  bool is_traj_inited_ = false;                   ///< 轨迹是否已从反馈值初始化
+  float joint_ang_traj_[kJointNum] = {0.0f};      ///< 轨迹角度，控制器的实际期望角度，单位 rad
+  float joint_spd_traj_[kJointNum] = {0.0f};      ///< 轨迹角速度，单位 rad/s
+  float joint_acc_traj_[kJointNum] = {0.0f};      ///< 轨迹角加速度，单位 rad/s^2
+  float joint_spd_ref_td_[kJointNum] = {0.0f};    ///< Td 对期望角度微分得到的期望角速度，单位 rad/s
+  JointCtrlType last_joint_ctrl_type_[kJointNum] = {JointCtrlType::Pid, JointCtrlType::Pid};  ///< 上一控制周期的控制器
+
+  // 由底盘传来的底盘运动数据，用于小陀螺时的 yaw 电机摩擦前馈
+  bool is_chassis_motion_valid_ = false;  ///< 底盘运动数据是否有效
+  float chassis_yaw_spd_ = 0.0f;          ///< 底盘偏航角速度（期望与反馈加权），单位 rad/s
+  float chassis_yaw_spd_fdb_ = 0.0f;      ///< 底盘偏航角速度反馈值，单位 rad/s
+  float chassis_yaw_acc_ = 0.0f;          ///< 底盘期望偏航角速度的变化率，单位 rad/s^2
+  uint8_t chassis_motion_seq_ = 0;        ///< 最近一次收到的底盘运动数据序号
+  uint32_t chassis_motion_tick_ = 0;      ///< 最近一次收到底盘运动数据的时间戳，单位 ms
+  float yaw_spin_spd_rel_ = 0.0f;         ///< 预测的 yaw 电机相对底盘的转速，单位 rad/s
+  float yaw_tor_usage_ = 0.0f;            ///< 滤波后的 yaw 电机力矩占用率，值域 [0, 1]
 
   // 从电机中拿到的数据
   bool is_any_motor_pwron_ = false;  ///< 是否有电机上电
@@ -256,10 +342,20 @@ class Gimbal : public Fsm
   float imu_ang_fdb_[kJointNum] = {0.0f};  ///< IMU 角度反馈值
   float imu_spd_fdb_[kJointNum] = {0.0f};  ///< IMU 角速度反馈值
 
+  // 编码器与 IMU 融合的数据
+  float fused_ang_fdb_[kJointNum] = {0.0f};  ///< 融合角度反馈值，IMU 坐标系
+  float fused_spd_fdb_[kJointNum] = {0.0f};  ///< 融合角速度反馈值，IMU 坐标系
+
   // 各组件指针
   // 无通信功能的组件指针
   Pid *pid_ptr_[kJointNum] = {nullptr};          ///< PID 指针
   Td *motor_spd_td_ptr_[kJointNum] = {nullptr};  ///< 电机速度滤波器指针
+  Adrc *adrc_ptr_[kJointNum] = {nullptr};        ///< 自抗扰控制器指针，未注册的关节只能使用 PID
+  Tracker *vis_tracker_ptr_ = nullptr;           ///< 视觉目标跟踪器指针，未注册时直接使用视觉原始指令
+  Fusion *fusion_ptr_[kJointNum] = {nullptr};    ///< 关节反馈融合器指针
+  Traj *traj_ptr_[kJointNum] = {nullptr};        ///< 时间最优轨迹生成器指针，未注册的关节直接使用期望角度
+  Td *ref_td_ptr_[kJointNum] = {nullptr};        ///< 期望角度微分器指针，为自抗扰控制器提供期望角速度
+  PitchIdent *pitch_ident_ptr_ = nullptr;        ///< pitch 前馈参数辨识器指针，未注册时使用配置参数
 
   // 只接收数据的组件指针
   Imu *imu_ptr_ = nullptr;  ///< IMU 指针 只接收数据
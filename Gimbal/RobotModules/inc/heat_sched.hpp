@@ -0,0 +1,84 @@
+/**
+ *******************************************************************************
+ * @file      :heat_sched.hpp
+ * @brief     : 枪管热量预测与拨弹节奏调度
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 裁判系统热量数据经底盘转发，滞后且更新频率低，本模块在本地按冷却速度与发弹事件预测当前热量：
+ *     每个控制周期按冷却速度扣减，每发弹丸增加 heat_per_blt，收到新的裁判系统热量时取两者较大值
+ *  2. 热量低于上限减去热量余量与保留热量时，以拨弹机构允许的最短间隔连发；
+ *     余量不足一发时以冷却速度对应的间隔持续射击（每发热量等于间隔内的冷却量），热量保持不变；
+ *     已占用余量时以最长间隔等待冷却
+ *  3. 平时保留 reserve_blt 发的热量，视觉给出高价值目标时释放保留热量用于连发
+ *  4. 裁判系统离线或数据无效时不进行调度，由使用方回退到固定的拨弹限制
+ *  5. 裁判系统数据滞后时与固定拨弹限制的对比见 tools/host/heat_sched_sim.cpp
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ROBOT_MODULES_HEAT_SCHED_HPP_
+#define ROBOT_MODULES_HEAT_SCHED_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstddef>
+#include <cstdint>
+
+/* Exported macro ------------------------------------------------------------*/
+
+namespace robot
+{
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+struct HeatSchedParams {
+  float heat_per_blt;     ///< 每发弹丸的热量
+  float safe_blt;         ///< 热量余量，覆盖发弹事件与裁判系统数据的时延，单位 发
+  float reserve_blt;      ///< 平时为高价值目标保留的热量，单位 发
+  uint32_t min_interval;  ///< 拨弹机构允许的最短拨弹间隔，单位 ms
+  uint32_t max_interval;  ///< 最长拨弹间隔，单位 ms
+};
+
+class HeatSched
+{
+ public:
+  typedef HeatSchedParams Params;
+
+  HeatSched(const Params &params) : params_(params) {};
+  ~HeatSched() {};
+
+  void updateRfrData(bool is_rfr_on, float heat, float heat_limit, float cooling_ps);
+  void onShot() { heat_est_ += params_.heat_per_blt; }
+  void update(uint32_t tick, bool is_high_value);
+  void reset();
+
+  /** 裁判系统数据是否有效，无效时不应使用调度结果 */
+  bool isValid() const { return is_valid_; }
+  /** 预测的当前热量 */
+  float getHeat() const { return heat_est_; }
+  /** 拨弹间隔，单位 ms */
+  uint32_t getTriggerInterval() const { return trigger_interval_; }
+  /** 热量余量，单位 发 */
+  float getSafeNumBlt() const { return params_.safe_blt; }
+
+ private:
+  Params params_;
+
+  bool is_valid_ = false;        ///< 裁判系统数据是否有效
+  bool has_tick_ = false;        ///< 是否记录过时间戳
+  uint32_t last_tick_ = 0;       ///< 上一次更新的时间戳，单位 ms
+  float last_rfr_heat_ = 0.0f;   ///< 上一次收到的裁判系统热量
+  float heat_limit_ = 0.0f;      ///< 热量上限
+  float cooling_ps_ = 0.0f;      ///< 每秒冷却值
+  float heat_est_ = 0.0f;        ///< 预测的当前热量
+
+  uint32_t trigger_interval_ = 0;  ///< 拨弹间隔，单位 ms
+};
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+}  // namespace robot
+#endif /* ROBOT_MODULES_HEAT_SCHED_HPP_ */
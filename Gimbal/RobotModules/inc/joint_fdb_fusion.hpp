@@ -0,0 +1,90 @@
+/**
+ *******************************************************************************
+ * @file      :joint_fdb_fusion.hpp
+ * @brief     : 云台关节编码器与 IMU 互补融合
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 融合结果位于 IMU（世界）坐标系：ang = ang_motor + offset，
+ *     offset 为 IMU 角度与编码器角度之差，包含 IMU 安装误差与基座（底盘）姿态
+ *  2. offset 由基座角速度递推，再以时间常数 ang_tau 向 IMU 与编码器角度之差收敛：
+ *     高频部分来自编码器（低时延、无漂移），低频部分来自 IMU（惯性参考）
+ *  3. 角速度同理：spd = spd_motor + spd_base + LPF(spd_imu - spd_motor - spd_base)，
+ *     低通滤波时间常数为 spd_tau
+ *  4. yaw 轴的基座角速度为底盘偏航角速度（底盘 IMU 经通讯传来），pitch 轴的基座角速度取 0，
+ *     底盘俯仰姿态变化较慢，由 offset 的收敛吸收
+ *  5. 基座陀螺仪的刻度误差 k 使 offset 的递推在转速 w 下产生 k * w * ang_tau 的稳态偏差，
+ *     小陀螺时可达数十 mrad；基座转速超过 scale_min_spd 时，以 IMU 角速度与编码器角速度之差
+ *     （即云台测得的基座角速度）对基座角速度做最小二乘，在线估计刻度系数，限幅在 1 ± scale_max_err 内
+ *  6. 刻度误差下世界系 yaw 误差的主机端仿真见 tools/host/joint_fusion_sim.cpp
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ROBOT_MODULES_JOINT_FDB_FUSION_HPP_
+#define ROBOT_MODULES_JOINT_FDB_FUSION_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstdint>
+
+/* Exported macro ------------------------------------------------------------*/
+
+namespace robot
+{
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+struct JointFdbFusionParams {
+  float ang_tau;  ///< 角度偏差的收敛时间常数，单位 s
+  float spd_tau;  ///< 角速度残差的低通滤波时间常数，单位 s，为 0 时角速度直接取 IMU 角速度
+  float period;   ///< 角度周期，单位 rad，为 0 时不做周期处理
+  float scale_tau;      ///< 基座角速度刻度系数估计的遗忘时间常数，单位 s，为 0 时不估计
+  float scale_min_spd;  ///< 估计刻度系数所需的最小基座角速度，单位 rad/s
+  float scale_max_err;  ///< 刻度系数相对 1 的最大偏差
+};
+
+class JointFdbFusion
+{
+ public:
+  typedef JointFdbFusionParams Params;
+
+  JointFdbFusion(const Params &params) : params_(params) {};
+  ~JointFdbFusion() {};
+
+  void update(float motor_ang, float motor_spd, float imu_ang, float imu_spd, float base_spd, float dt);
+  void reset() { is_inited_ = false; }
+
+  bool isInited() const { return is_inited_; }
+  /** 融合后的关节角度，IMU 坐标系，单位 rad */
+  float getAng() const { return ang_; }
+  /** 融合后的关节角速度，IMU 坐标系，单位 rad/s */
+  float getSpd() const { return spd_; }
+  /** IMU 与编码器的角度偏差估计，单位 rad */
+  float getOffset() const { return offset_; }
+  /** 基座角速度刻度系数估计值 */
+  float getBaseScale() const { return base_scale_; }
+
+ private:
+  float wrap(float ang) const;
+
+  Params params_;
+
+  bool is_inited_ = false;    ///< 是否已初始化
+  float offset_ = 0.0f;       ///< IMU 与编码器的角度偏差估计，单位 rad
+  float spd_resid_ = 0.0f;    ///< 低通滤波后的角速度残差，单位 rad/s
+  float ang_ = 0.0f;          ///< 融合后的关节角度，单位 rad
+  float spd_ = 0.0f;          ///< 融合后的关节角速度，单位 rad/s
+
+  // 基座角速度刻度系数估计，复位融合时保留
+  float base_scale_ = 1.0f;   ///< 基座角速度刻度系数
+  float scale_sxy_ = 0.0f;    ///< 云台测得的基座角速度与基座角速度之积的滤波值，单位 (rad/s)^2
+  float scale_sxx_ = 0.0f;    ///< 基座角速度平方的滤波值，单位 (rad/s)^2
+};
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+}  // namespace robot
+#endif /* ROBOT_MODULES_JOINT_FDB_FUSION_HPP_ */
@@ -0,0 +1,78 @@
+/**
+ *******************************************************************************
+ * @file      :ladrc.hpp
+ * @brief     : 云台关节线性自抗扰控制器
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 关节模型 dd(ang) = b0 * u + f，f 为总扰动（小陀螺拖拽、射击后坐、线缆力矩、模型误差等）
+ *  2. 关节角速度有 IMU 直接测量，使用降阶线性扩张状态观测器：
+ *     z1 估计角速度，z2 估计总扰动，观测器极点均配置在 -wo
+ *  3. 控制律 u = (acc_ref + kp * (ang_ref - ang) + kd * (spd_ref - z1) - z2) / b0 + ffd，
+ *     kp = wc^2，kd = 2 * wc，期望角速度与角加速度由轨迹或 Td 给出
+ *  4. ffd 为已知扰动（重力、阻力、小陀螺拖拽等）的力矩补偿，观测器只使用扣除 ffd 后的力矩，
+ *     z2 估计的是补偿后的剩余扰动；若观测器使用含 ffd 的总力矩，z2 会把 ffd 抵消掉的扰动再补偿一次，
+ *     稳态误差为 -b0 * ffd / wc^2
+ *  5. 观测器使用限幅后实际下发的力矩，力矩饱和时不会积分饱和
+ *  6. 主机端阶跃与稳态误差测试：tools/host/run.sh ladrc_bench
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ROBOT_MODULES_LADRC_HPP_
+#define ROBOT_MODULES_LADRC_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstdint>
+
+/* Exported macro ------------------------------------------------------------*/
+
+namespace robot
+{
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+struct LadrcParams {
+  float b0;       ///< 控制量增益，即关节转动惯量的倒数，单位 (rad/s^2)/(N·m)
+  float wc;       ///< 控制器带宽，单位 rad/s
+  float wo;       ///< 观测器带宽，单位 rad/s，一般取 wc 的 3~5 倍，且 wo * dt 远小于 1
+  float out_max;  ///< 输出力矩限幅，单位 N·m
+  float period;   ///< 角度周期，单位 rad，为 0 时不做周期处理
+};
+
+class Ladrc
+{
+ public:
+  typedef LadrcParams Params;
+
+  Ladrc(const Params &params) : params_(params) {};
+  ~Ladrc() {};
+
+  float calc(float ang_ref, float spd_ref, float acc_ref, float ang_fdb, float spd_fdb, float ffd, float dt);
+  void reset();
+
+  /** 角速度估计值，单位 rad/s */
+  float getSpdEst() const { return z1_; }
+  /** 总扰动估计值折算的力矩，单位 N·m */
+  float getDistTorq() const { return z2_ / params_.b0; }
+  float getOut() const { return u_; }
+
+ private:
+  float calcAngErr(float ang_ref, float ang_fdb) const;
+
+  Params params_;
+
+  bool is_inited_ = false;  ///< 观测器是否已初始化
+  float z1_ = 0.0f;         ///< 角速度估计值，单位 rad/s
+  float z2_ = 0.0f;         ///< 总扰动估计值，单位 rad/s^2
+  float u_ = 0.0f;          ///< 上一周期下发的力矩，单位 N·m
+  float u_fb_ = 0.0f;       ///< 上一周期下发的力矩中扣除 ffd 后的部分，观测器的输入，单位 N·m
+};
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+}  // namespace robot
+#endif /* ROBOT_MODULES_LADRC_HPP_ */
@@ -0,0 +1,104 @@
+/**
+ *******************************************************************************
+ * @file      :pitch_ffd_ident.hpp
+ * @brief     : pitch 轴重力与摩擦前馈参数在线辨识
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 准静态下 pitch 电机力矩 tau = A * cos(ang) + B * sin(ang) + tau_c * sign(spd) + b * spd，
+ *     其中 A * cos(ang) + B * sin(ang) = M * cos(ang + offset)，M 为重力矩幅值，offset 为重心相位
+ *  2. 使用带遗忘因子的递推最小二乘估计 [A, B, tau_c, b]，只使用转速足够大
+ *     （摩擦方向确定）、角加速度足够小（惯性力矩可忽略）、力矩未饱和的样本
+ *  3. 激励不足时协方差矩阵会因遗忘而增大，其迹超过上限后停止遗忘
+ *  4. 扫描辨识：在限位范围内以逐次加快的速度往返匀速转动，
+ *     覆盖全部俯仰角与多个转速，用于换枪管、相机、配重后的快速重新辨识
+ *  5. 角度使用世界系俯仰角（IMU），重力矩只与其有关；转速使用电机相对转速，摩擦只与其有关
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ROBOT_MODULES_PITCH_FFD_IDENT_HPP_
+#define ROBOT_MODULES_PITCH_FFD_IDENT_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstddef>
+#include <cstdint>
+
+/* Exported macro ------------------------------------------------------------*/
+
+namespace robot
+{
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+struct PitchFfdIdentParams {
+  float lambda;           ///< 遗忘因子，值域 (0, 1]
+  float p0;               ///< 协方差矩阵初值（对角元素）
+  float p_max_trace;      ///< 协方差矩阵迹的上限，超过后停止遗忘
+  float valid_trace;      ///< 协方差矩阵迹低于该值时认为辨识结果可用
+  uint32_t min_samples;   ///< 认为辨识结果可用所需的最少样本数
+  float spd_min;          ///< 参与辨识的最小转速，单位 rad/s
+  float acc_max;          ///< 参与辨识的最大角加速度，单位 rad/s^2
+  float tor_max;          ///< 参与辨识的最大力矩，单位 N·m
+  float sweep_spd_min;    ///< 扫描时第一次往返的俯仰角速度，单位 rad/s
+  float sweep_spd_max;    ///< 扫描时最后一次往返的俯仰角速度，单位 rad/s
+  float sweep_margin;     ///< 扫描范围距离限位的余量，单位 rad
+  uint8_t sweep_cycles;   ///< 扫描往返次数
+};
+
+class PitchFfdIdent
+{
+ public:
+  typedef PitchFfdIdentParams Params;
+
+  static constexpr size_t kParamNum = 4;
+
+  PitchFfdIdent(const Params &params) : params_(params) { reset(); };
+  ~PitchFfdIdent() {};
+
+  void update(float ang, float spd, float torq, float dt);
+  void reset();
+
+  void startSweep(float ang_start, float ang_min, float ang_max);
+  void stopSweep() { is_sweeping_ = false; }
+  float calcSweepRef(float dt);
+  bool isSweeping() const { return is_sweeping_; }
+
+  /** 辨识结果是否可用于前馈 */
+  bool isValid() const { return is_valid_; }
+  /** 给定世界系俯仰角下的重力矩，单位 N·m */
+  float calcGravityTorq(float ang) const;
+  float getGravityAmp() const;
+  float getGravityOffset() const;
+  /** 库仑摩擦力矩，单位 N·m，不小于 0 */
+  float getCoulombTorq() const { return theta_[2] > 0.0f ? theta_[2] : 0.0f; }
+  /** 粘滞摩擦系数，单位 N·m/(rad/s)，不小于 0 */
+  float getViscCoef() const { return theta_[3] > 0.0f ? theta_[3] : 0.0f; }
+  uint32_t getSampleNum() const { return sample_num_; }
+
+ private:
+  Params params_;
+
+  float theta_[kParamNum] = {0.0f};           ///< 参数估计值 [A, B, tau_c, b]
+  float p_[kParamNum][kParamNum] = {{0.0f}};  ///< 协方差矩阵
+  uint32_t sample_num_ = 0;                   ///< 已使用的样本数
+  bool is_valid_ = false;                     ///< 辨识结果是否可用
+
+  bool is_spd_inited_ = false;  ///< 是否已有上一次转速
+  float last_spd_ = 0.0f;       ///< 上一次的转速，单位 rad/s
+
+  bool is_sweeping_ = false;    ///< 是否正在扫描
+  float sweep_ref_ = 0.0f;      ///< 扫描期望角度，单位 rad
+  float sweep_min_ = 0.0f;      ///< 扫描下限，单位 rad
+  float sweep_max_ = 0.0f;      ///< 扫描上限，单位 rad
+  float sweep_dir_ = 1.0f;      ///< 扫描方向
+  uint8_t sweep_half_cnt_ = 0;  ///< 已完成的单程数
+};
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+}  // namespace robot
+#endif /* ROBOT_MODULES_PITCH_FFD_IDENT_HPP_ */
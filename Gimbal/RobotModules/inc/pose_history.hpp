@@ -0,0 +1,74 @@
+/**
+ *******************************************************************************
+ * @file      :pose_history.hpp
+ * @brief     : 带时间戳的云台位姿历史缓存
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 每个控制周期（1 kHz）记录一次云台位姿，缓存最近 kLen 个周期，覆盖视觉从拍摄到数据到达的时延
+ *  2. 时间戳为 MCU 微秒时间，按 uint32_t 自然回绕，所有比较均使用差值，回绕后仍然有效
+ *  3. 查询时在相邻两帧之间线性插值，角度差按 [-PI, PI) 归一化后插值，跨越 ±PI 时不会跳变
+ *  4. 查询时间晚于最新记录但不超过 max_extrap 时返回最新位姿，早于最旧记录或超出上限时查询失败
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ROBOT_MODULES_POSE_HISTORY_HPP_
+#define ROBOT_MODULES_POSE_HISTORY_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstddef>
+#include <cstdint>
+
+/* Exported macro ------------------------------------------------------------*/
+
+namespace robot
+{
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+struct PoseHistoryParams {
+  uint32_t max_extrap;  ///< 查询时间晚于最新记录的最大允许值，单位 us
+};
+
+class PoseHistory
+{
+ public:
+  typedef PoseHistoryParams Params;
+
+  struct Pose {
+    float roll = 0.0f;   ///< 单位 rad
+    float pitch = 0.0f;  ///< 单位 rad
+    float yaw = 0.0f;    ///< 单位 rad
+  };
+
+  static const size_t kLen = 256u;  ///< 缓存长度，1 kHz 记录时约 256 ms
+
+  PoseHistory(const Params &params) : params_(params) {};
+  ~PoseHistory() {};
+
+  void push(uint32_t time_us, const Pose &pose);
+  bool lookup(uint32_t time_us, Pose *pose) const;
+  void reset() { cnt_ = 0; }
+
+  size_t size() const { return cnt_; }
+
+ private:
+  const Pose &at(size_t age) const { return pose_[(head_ + kLen - 1 - age) % kLen]; }
+  uint32_t stampAt(size_t age) const { return stamp_[(head_ + kLen - 1 - age) % kLen]; }
+
+  Params params_;
+
+  size_t head_ = 0;             ///< 下一次写入的位置
+  size_t cnt_ = 0;              ///< 有效记录数
+  uint32_t stamp_[kLen] = {0};  ///< 各记录的时间戳，单位 us
+  Pose pose_[kLen];             ///< 各记录的位姿
+};
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+}  // namespace robot
+#endif /* ROBOT_MODULES_POSE_HISTORY_HPP_ */
@@ -26,6 +26,7 @@
 #include "feed.hpp"
 #include "fric_2motor.hpp"
 #include "motor.hpp"
+#include "pid.hpp"
 #include "tick.hpp"
 #include "transmitter.hpp"
 #include "tx_mgr.hpp"
@@ -33,6 +34,13 @@
 #include "imu.hpp"
 #include "vision.hpp"
 #include "laser.hpp"
+#include "pose_history.hpp"
+#include "fire_ctrl.hpp"
+#include "heat_sched.hpp"
+#include "feed_profile.hpp"
+#include "fric_shot_ffd.hpp"
+#include "shot_detector.hpp"
+#include "vision_link.hpp"
 /* Exported macro ------------------------------------------------------------*/
 
 namespace robot
@@ -49,12 +57,20 @@ class Robot : public Fsm
   typedef hello_world::comm::CanTxMgr CanTxMgr;
   typedef hello_world::comm::UartTxMgr UartTxMgr;
   typedef hello_world::comm::TxMgr TxMgr;
-  typedef hello_world::vision::Vision Vision;
+  typedef hello_world::vision::Vision Vision;  ///< 只使用其枚举（工作模式、目标颜色、射击指令），VisionLink 沿用这些取值
   typedef hello_world::module::Feed Feed;
+  typedef hello_world::pid::MultiNodesPid Pid;
   typedef hello_world::module::Fric Fric;
   typedef hello_world::laser::Laser Laser;
 
   typedef robot::Gimbal Gimbal;
+  typedef robot::PoseHistory PoseHistory;
+  typedef robot::FireCtrl FireCtrl;
+  typedef robot::HeatSched HeatSched;
+  typedef robot::FeedProfile FeedProfile;
+  typedef robot::FricShotFfd FricShotFfd;
+  typedef robot::ShotDetector ShotDetector;
+  typedef robot::VisionLink VisionLink;
 
   typedef robot::GimbalChassisComm GimbalChassisComm;
   typedef hello_world::imu::Imu Imu;
@@ -84,8 +100,14 @@ class Robot : public Fsm
   void registerFricMotor(Motor *dev_ptr, uint8_t index);
   void registerGimbalMotor(Motor *dev_ptr, uint8_t index);
   void registerGimbalChassisComm(GimbalChassisComm *dev_ptr);
-  void registerVision(Vision *dev_ptr);
   void registerLaser(Laser *ptr);
+  void registerPoseHistory(PoseHistory *ptr);
+  void registerFireCtrl(FireCtrl *ptr);
+  void registerHeatSched(HeatSched *ptr);
+  void registerFeedProfile(FeedProfile *ptr, Pid *feed_pid_ptr);
+  void registerFricShotFfd(FricShotFfd *ptr);
+  void registerShotDetector(ShotDetector *ptr);
+  void registerVisionLink(VisionLink *dev_ptr);
 
  private:
   //  数据更新和工作状态更新，由 update 函数调用
@@ -93,6 +115,11 @@ class Robot : public Fsm
   void updateImuData();
   void updateGimbalChassisCommData();
   void updateVisionData();
+  bool isVisionTargetDetected();
+  bool isVisionTargetInView();
+  bool isVisionTargetHighValue();
+  ShootFlag getVisionShootFlag();
+  ShootFlag gateVisionShootFlag(ShootFlag flag);
 
   void updatePwrState();
 
@@ -102,7 +129,12 @@ class Robot : public Fsm
   void runOnWorking();
 
   void transmitFricStatus();
+  void detectShot();
+  void runFricShotFfd();
+  void runFeedProfile();
   void genModulesCmd();
+  bool calcStampedVisionCmd(float &yaw, float &pitch, float &latency) const;
+  void recordPose();
 
   // 设置通讯组件数据函数
   void setCommData();
@@ -116,7 +148,7 @@ class Robot : public Fsm
   void sendGimbalMotorData();
   void sendGimbalChassisCommData();
   void sendUsartData();
-  void sendVisionData();
+  void sendVisionLinkData();
 
   // 重置数据函数
   void resetDataOnDead();
@@ -138,6 +170,13 @@ class Robot : public Fsm
   Buzzer *buzzer_ptr_ = nullptr;  ///< 蜂鸣器指针
   Imu *imu_ptr_ = nullptr;        ///< IMU 指针
   Laser *laser_ptr_ = nullptr;    ///< 红点激光指针
+  PoseHistory *pose_history_ptr_ = nullptr;  ///< 云台位姿历史指针，未注册时不使用带时间戳的视觉数据
+  FireCtrl *fire_ctrl_ptr_ = nullptr;        ///< 射击决策指针，未注册时直接使用视觉的射击指令
+  HeatSched *heat_sched_ptr_ = nullptr;      ///< 热量调度指针，未注册时使用固定的拨弹限制
+  FeedProfile *feed_profile_ptr_ = nullptr;  ///< 拨弹轨迹指针，未注册时拨盘完全由 Feed 控制
+  Pid *feed_pid_ptr_ = nullptr;              ///< Feed 的拨盘 PID 指针，拨弹轨迹由其角度环期望角度确定目标
+  FricShotFfd *fric_shot_ffd_ptr_ = nullptr; ///< 摩擦轮掉速前馈指针，未注册时摩擦轮完全由 Fric 控制
+  ShotDetector *shot_detector_ptr_ = nullptr; ///< 本地发弹检测指针，未注册时发弹全部来自裁判系统
 
   // 电机指针
   Motor *feed_motor_ptr_ = nullptr;  ///< 电机指针
@@ -146,7 +185,7 @@ class Robot : public Fsm
 
   // 收发数据的组件指针
   GimbalChassisComm *gc_comm_ptr_ = nullptr;  ///< 云台底盘通信模块指针 收发数据
-  Vision *vision_ptr_ = nullptr;              ///< 视觉模块指针 收发数据
+  VisionLink *vision_link_ptr_ = nullptr;     ///< 视觉上位机通讯模块指针 收发数据
 
 };
 /* Exported variables --------------------------------------------------------*/
@@ -0,0 +1,141 @@
+/**
+ *******************************************************************************
+ * @file      :shot_detector.hpp
+ * @brief     : 由摩擦轮动态在本地检测发弹，并与裁判系统发弹数据互相校核
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 裁判系统的发弹数据经底盘转发，到达云台时已滞后数十毫秒；弹丸经过摩擦轮时两个摩擦轮同时受到
+ *     一个负载力矩冲量，表现为掉速与电流尖峰，本模块据此在本地检测发弹
+ *  2. 负载力矩（折算为电流）= 电流反馈 - (转动惯量 / 力矩常数) × 角加速度，与电机输入如何给出无关，
+ *     摩擦轮掉速前馈脉冲不会被误检，也不会掩盖发弹；在 window 内对负载力矩减去其稳态值积分，
+ *     角加速度的积分即窗口首尾的转速差，转速反馈的量化噪声不随窗口累积
+ *  3. 两个摩擦轮的负载冲量同时超过 imp_thres 时认为发弹，此后 min_gap 内不再检测
+ *  4. 本地检测到的发弹在 match_time 内等待裁判系统的发弹数据，按时间先后一一对应：
+ *     对应上的发弹用裁判系统弹速与发弹时的摩擦轮转速修正弹速与转速之比，此后每发在本地检测时即可给出
+ *     弹速估计；裁判系统发弹而本地未检测到时补报一发，本地检测到而裁判系统未发弹时计为误检
+ *  5. 本地检测到的发弹在检测时已交给使用方；裁判系统数据偶尔迟到超过 match_time 时，这一发先计为误检，
+ *     但在其后 late_time 内仍保留，迟到的裁判系统数据按时间先后优先与其对应并撤销误检，不再补报，
+ *     避免拨盘与热量预测把同一发计两次
+ *  6. 摩擦轮转速低于 min_spd 时不进行本地检测，发弹全部来自裁判系统
+ *  7. 摩擦轮模型上的主机端仿真见 tools/host/shot_detector_sim.cpp
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ROBOT_MODULES_SHOT_DETECTOR_HPP_
+#define ROBOT_MODULES_SHOT_DETECTOR_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstddef>
+#include <cstdint>
+
+/* Exported macro ------------------------------------------------------------*/
+
+namespace robot
+{
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+struct ShotDetectorParams {
+  float inertia_per_kt;     ///< 摩擦轮转动惯量与电机力矩常数之比，单位 A/(rad/s^2)
+  uint32_t window;          ///< 负载冲量的积分窗口，单位 ms，不大于 ShotDetector::kMaxWindow
+  float imp_thres;          ///< 判定发弹的负载冲量阈值，单位 A·s
+  float base_lpf;           ///< 稳态负载与稳态转速的低通滤波系数，值域 (0, 1]
+  float min_spd;            ///< 进行本地检测的最低摩擦轮转速，单位 rad/s
+  uint32_t min_gap;         ///< 两发之间的最短间隔，单位 ms
+  uint32_t match_time;      ///< 本地检测后等待裁判系统发弹数据的最长时间，单位 ms
+  uint32_t late_time;       ///< 超过 match_time 后仍可与迟到的裁判系统发弹数据对应的时长，单位 ms
+  float spd_ratio_init;     ///< 弹速与摩擦轮转速之比的初值，单位 m/rad
+  float spd_ratio_lpf;      ///< 弹速与摩擦轮转速之比的修正系数，值域 (0, 1]
+  float min_blt_spd;        ///< 用于修正的裁判系统弹速下限，单位 m/s
+  float max_blt_spd;        ///< 用于修正的裁判系统弹速上限，单位 m/s
+};
+
+class ShotDetector
+{
+ public:
+  typedef ShotDetectorParams Params;
+
+  static const size_t kMaxWindow = 16;  ///< 积分窗口上限，单位 ms
+
+  enum FricIdx : uint8_t {
+    kFricFirst = 0u,
+    kFricSecond = 1u,
+    kFricNum = 2u,
+  };
+
+  ShotDetector(const Params &params);
+  ~ShotDetector() {};
+
+  bool update(uint32_t tick, const float spd[kFricNum], const float curr[kFricNum]);
+  void onRfrShot(uint32_t tick, float blt_spd);
+  bool fetchShot();
+  void reset();
+
+  /** 最近一发的弹速估计，单位 m/s */
+  float getBltSpd() const { return blt_spd_; }
+  /** 弹速与摩擦轮转速之比是否已由裁判系统数据修正过 */
+  bool isCalibrated() const { return is_calibrated_; }
+  /** 最近一次检测时两个摩擦轮负载冲量的较小值，单位 A·s */
+  float getImpulse() const { return imp_; }
+  uint32_t getShotCnt() const { return shot_cnt_; }
+  uint32_t getMissCnt() const { return miss_cnt_; }
+  uint32_t getFalseCnt() const { return false_cnt_; }
+  uint32_t getLateCnt() const { return late_cnt_; }
+
+ private:
+  static const size_t kMaxPending = 8;  ///< 等待裁判系统数据的本地发弹数量上限
+
+  struct Shot {
+    uint32_t tick = 0;      ///< 检测到发弹的时间戳，单位 ms
+    float fric_spd = 0.0f;  ///< 发弹前的摩擦轮平均转速，单位 rad/s
+  };
+
+  void expirePending(uint32_t tick);
+  void popPending();
+  void popExpired();
+  void calibrate(float fric_spd, float blt_spd);
+
+  Params params_;
+
+  // 稳态
+  bool has_base_ = false;                  ///< 是否已有稳态值
+  uint32_t last_tick_ = 0;                 ///< 上一次更新的时间戳，单位 ms
+  float last_spd_[kFricNum] = {0.0f};      ///< 上一次的转速（沿转向为正），单位 rad/s
+  float base_spd_[kFricNum] = {0.0f};      ///< 稳态转速（沿转向为正），单位 rad/s
+  float base_load_[kFricNum] = {0.0f};     ///< 稳态负载，单位 A
+
+  // 积分窗口
+  float load_[kFricNum][kMaxWindow] = {{0.0f}};  ///< 窗口内各周期的负载冲量，单位 A·s
+  float imp_sum_[kFricNum] = {0.0f};       ///< 窗口内的负载冲量之和，单位 A·s
+  size_t win_idx_ = 0;                     ///< 窗口写入位置
+  size_t win_num_ = 0;                     ///< 窗口内的数据量
+
+  bool has_shot_ = false;                  ///< 是否检测到过发弹
+  uint32_t shot_tick_ = 0;                 ///< 最近一发的时间戳，单位 ms
+  float imp_ = 0.0f;                       ///< 最近一发的负载冲量，单位 A·s
+
+  Shot pending_[kMaxPending];              ///< 等待裁判系统数据的本地发弹，按时间先后排列
+  size_t pending_num_ = 0;                 ///< 等待裁判系统数据的本地发弹数量
+  Shot expired_[kMaxPending];              ///< 超过 match_time 计为误检、仍可与迟到数据对应的本地发弹
+  size_t expired_num_ = 0;                 ///< 超过 match_time 的本地发弹数量
+  uint32_t report_num_ = 0;                ///< 尚未交给使用方的发弹数量
+
+  bool is_calibrated_ = false;             ///< 弹速与转速之比是否已修正过
+  float spd_ratio_ = 0.0f;                 ///< 弹速与摩擦轮转速之比，单位 m/rad
+  float blt_spd_ = 0.0f;                   ///< 最近一发的弹速估计，单位 m/s
+
+  uint32_t shot_cnt_ = 0;                  ///< 本地检测到的发弹数
+  uint32_t miss_cnt_ = 0;                  ///< 本地漏检的发弹数
+  uint32_t false_cnt_ = 0;                 ///< 本地误检的发弹数
+  uint32_t late_cnt_ = 0;                  ///< 裁判系统数据迟到、撤销了误检的发弹数
+};
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+}  // namespace robot
+#endif /* ROBOT_MODULES_SHOT_DETECTOR_HPP_ */
@@ -0,0 +1,40 @@
+/**
+ *******************************************************************************
+ * @file      :sys_time.hpp
+ * @brief     : MCU 微秒时间
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 只有声明，板上的实现依赖 HAL，位于 Gimbal/Task/Src/sys_time.cpp；RobotModules 中的模块只经由
+ *     本接口取时间，主机端程序自行给出实现（如 tools/host/vision_link_host.cpp）
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ROBOT_MODULES_SYS_TIME_HPP_
+#define ROBOT_MODULES_SYS_TIME_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstdint>
+
+/* Exported macro ------------------------------------------------------------*/
+
+namespace robot
+{
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+
+/**
+ * @brief       获取 MCU 微秒时间
+ * @retval       由 HAL 毫秒计数与 SysTick 计数值合成的微秒时间，按 uint32_t 回绕
+ * @note        可在中断中调用
+ */
+uint32_t GetSysTimeUs(void);
+}  // namespace robot
+#endif /* ROBOT_MODULES_SYS_TIME_HPP_ */
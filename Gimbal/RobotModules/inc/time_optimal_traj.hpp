@@ -0,0 +1,70 @@
+/**
+ *******************************************************************************
+ * @file      :time_optimal_traj.hpp
+ * @brief     : 云台关节时间最优轨迹生成
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 在期望角度与控制器之间插入一个加速度、角速度受限的双积分器，
+ *     使用韩京清的离散最速控制综合函数 fhan 驱动其跟踪期望角度，
+ *     加速度为 bang-bang 形式，到达目标时无超调、无抖振
+ *  2. 每个控制周期以轨迹当前状态为起点重新规划，期望角度移动时自动重规划
+ *  3. 加速度上限由电机可用力矩与关节转动惯量确定，角速度上限由电机最高转速确定
+ *  4. 角度周期不为 0 时，按最短路径跟踪
+ *  5. 主机端 yaw 转头与换目标仿真：tools/host/run.sh gimbal_traj_sim
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ROBOT_MODULES_TIME_OPTIMAL_TRAJ_HPP_
+#define ROBOT_MODULES_TIME_OPTIMAL_TRAJ_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstdint>
+
+/* Exported macro ------------------------------------------------------------*/
+
+namespace robot
+{
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+struct TimeOptimalTrajParams {
+  float acc_max;  ///< 最大角加速度，单位 rad/s^2
+  float spd_max;  ///< 最大角速度，单位 rad/s
+  float period;   ///< 角度周期，单位 rad，为 0 时不做周期处理
+};
+
+class TimeOptimalTraj
+{
+ public:
+  typedef TimeOptimalTrajParams Params;
+
+  TimeOptimalTraj(const Params &params) : params_(params) {};
+  ~TimeOptimalTraj() {};
+
+  void calc(float goal_ang, float goal_spd, float dt);
+  void reset(float ang, float spd);
+
+  float getAng() const { return ang_; }
+  float getSpd() const { return spd_; }
+  float getAcc() const { return acc_; }
+
+ private:
+  float fhan(float x1, float x2, float h) const;
+  float wrap(float ang) const;
+
+  Params params_;
+
+  float ang_ = 0.0f;  ///< 轨迹角度，单位 rad
+  float spd_ = 0.0f;  ///< 轨迹角速度，单位 rad/s
+  float acc_ = 0.0f;  ///< 轨迹角加速度，单位 rad/s^2
+};
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+}  // namespace robot
+#endif /* ROBOT_MODULES_TIME_OPTIMAL_TRAJ_HPP_ */
@@ -0,0 +1,94 @@
+/**
+ *******************************************************************************
+ * @file      :time_sync.hpp
+ * @brief     : MCU 与视觉上位机的时钟同步
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 采用 NTP 式的一问一答：MCU 在 t1 发出请求，上位机在 t2 收到、t3 回复，MCU 在 t4 收到，
+ *     往返时延 rtt = (t4 - t1) - (t3 - t2)，MCU 时间 (t1 + t4) / 2 对应上位机时间 (t2 + t3) / 2
+ *  2. 串口收发时延不对称程度与 rtt 正相关，在最近 kWinLen 个样本中取 rtt 最小者作为参考点，
+ *     rtt 超过 rtt_max 的样本直接丢弃
+ *  3. 同步结果以参考点对 (mcu, pc) 表示，任意上位机时间按差值换算到 MCU 时间，两侧时间戳均为
+ *     uint32_t 微秒并自然回绕；同步周期远小于晶振漂移的累积时间，不估计时钟频差
+ *  4. 超过 timeout 未收到有效样本时认为失步，使用方应回退到不依赖时间戳的处理
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ROBOT_MODULES_TIME_SYNC_HPP_
+#define ROBOT_MODULES_TIME_SYNC_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstddef>
+#include <cstdint>
+
+/* Exported macro ------------------------------------------------------------*/
+
+namespace robot
+{
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+struct TimeSyncParams {
+  uint32_t rtt_max;  ///< 有效样本的最大往返时延，单位 us
+  uint32_t timeout;  ///< 超过该时间未收到有效样本时认为失步，单位 us
+};
+
+class TimeSync
+{
+ public:
+  typedef TimeSyncParams Params;
+
+  static const size_t kWinLen = 8u;  ///< 参与选优的最近样本数
+  static const size_t kReqNum = 4u;  ///< 同时等待回复的请求数
+
+  TimeSync(const Params &params) : params_(params) {};
+  ~TimeSync() {};
+
+  uint8_t genRequest(uint32_t mcu_tx_us);
+  bool onResponse(uint8_t seq, uint32_t pc_rx_us, uint32_t pc_tx_us, uint32_t mcu_rx_us);
+  void reset();
+
+  bool isSynced(uint32_t mcu_us) const;
+  uint32_t toMcuTime(uint32_t pc_us) const { return ref_mcu_ + (uint32_t)(int32_t)(pc_us - ref_pc_); }
+
+  /** 参考样本的往返时延，单位 us */
+  uint32_t getRtt() const { return ref_rtt_; }
+  /** 上位机时间减去 MCU 时间，单位 us */
+  int32_t getOffset() const { return (int32_t)(ref_pc_ - ref_mcu_); }
+  uint32_t getSampleCnt() const { return sample_cnt_; }
+
+ private:
+  struct Sample {
+    uint32_t mcu;  ///< 样本中点的 MCU 时间，单位 us
+    uint32_t pc;   ///< 样本中点的上位机时间，单位 us
+    uint32_t rtt;  ///< 往返时延，单位 us
+  };
+
+  Params params_;
+
+  uint8_t seq_ = 0;                       ///< 最近一次请求的序号
+  uint8_t req_seq_[kReqNum] = {0};        ///< 等待回复的请求序号
+  uint32_t req_t1_[kReqNum] = {0};        ///< 等待回复的请求发出时间，单位 us
+  bool req_pending_[kReqNum] = {false};   ///< 请求是否在等待回复
+
+  Sample win_[kWinLen];        ///< 最近的有效样本
+  size_t win_head_ = 0;        ///< 下一次写入的位置
+  size_t win_cnt_ = 0;         ///< 有效样本数
+  uint32_t sample_cnt_ = 0;    ///< 累计有效样本数
+
+  bool is_synced_ = false;     ///< 是否已有参考点
+  uint32_t last_sample_ = 0;   ///< 最近一次有效样本的 MCU 时间，单位 us
+  uint32_t ref_mcu_ = 0;       ///< 参考点的 MCU 时间，单位 us
+  uint32_t ref_pc_ = 0;        ///< 参考点的上位机时间，单位 us
+  uint32_t ref_rtt_ = 0;       ///< 参考点的往返时延，单位 us
+};
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+}  // namespace robot
+#endif /* ROBOT_MODULES_TIME_SYNC_HPP_ */
@@ -0,0 +1,190 @@
+/**
+ *******************************************************************************
+ * @file      :vision_link.hpp
+ * @brief     : 视觉上位机通讯协议 v2
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 帧格式：COBS(ver | seq | msg ... | crc16) | 0x00
+ *     - ver 为协议版本号（kVersion），版本不符的帧丢弃并计数
+ *     - seq 为发送方的帧序号，接收方由序号跳变统计丢帧数
+ *     - crc16 为 CRC-16/CCITT-FALSE（多项式 0x1021，初值 0xFFFF），覆盖 ver 至最后一条消息，小端
+ *     - COBS 编码后帧内不含 0x00，0x00 作为帧尾，接收方按字节流解码，一次 DMA 接收中的多帧、
+ *       跨两次接收的半帧都能正确处理
+ *  2. 一帧内可以打包多条消息，每条消息为 type(u8) | len(u8) | payload，接收方跳过未知类型，
+ *     新增消息类型或在消息末尾追加字段都不破坏已有的解析
+ *  3. MCU -> PC 的消息（每帧由一次 DMA 发出）：
+ *     - 0x01 同步请求：sync_seq(u8) t1(u32)
+ *     - 0x02 位姿序列：t0(u32) period(u16) n(u8) n * [qw qx qy qz](i16, 1/32767)，
+ *       自上一帧以来每个控制周期记录的云台姿态四元数，t0 为第一个样本的 MCU 时间
+ *     - 0x03 状态：work_state(u8) target_color(u8) blt_spd(u16, 0.01 m/s)
+ *     - 0x04 弹速历史：n(u8) n * blt_spd(u16, 0.01 m/s)，由旧到新，有新弹速时发送
+ *  4. PC -> MCU 的消息：
+ *     - 0x81 同步回复：sync_seq(u8) t2(u32) t3(u32)
+ *     - 0x82 目标：flags(u8) exposure(u32) yaw(i16) pitch(i16) [dist(u16) [vtm_x(u16) vtm_y(u16)]]，
+ *       flags bit0 为是否检测到目标，bit1~2 为射击指令，bit3 为高价值目标（由上位机按目标类型、血量等判断）；yaw、pitch 为目标相对拍摄时刻云台位姿的方向，单位 1e-4 rad；
+ *       dist 为目标距离，单位 mm，为后追加的字段，上位机不发送时视为未知；vtm_x、vtm_y 为目标在图传画面中的
+ *       像素坐标，转发给底盘绘制 UI，上位机不发送时为 0
+ *  5. 所有时间戳单位均为 us，MCU 时间由 GetSysTimeUs（sys_time.hpp）给出，同步逻辑见 TimeSync
+ *  6. 本模块不依赖 HAL，可在主机上与 tools/vision_pc_sim.py 经 pty 联调：tools/host/run.sh vision_link_host
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ROBOT_MODULES_VISION_LINK_HPP_
+#define ROBOT_MODULES_VISION_LINK_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstddef>
+#include <cstdint>
+
+#include "offline_checker.hpp"
+#include "receiver.hpp"
+#include "time_sync.hpp"
+#include "transmitter.hpp"
+
+/* Exported macro ------------------------------------------------------------*/
+
+namespace robot
+{
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+struct VisionLinkConfig {
+  TimeSync::Params sync;   ///< 时钟同步参数
+  uint32_t sync_interval;  ///< 每隔多少帧附带一次同步请求
+  float hfov;              ///< 相机水平视场角，单位 rad
+  float vfov;              ///< 相机垂直视场角，单位 rad
+};
+
+class VisionLink : public hello_world::comm::Receiver, public hello_world::comm::Transmitter
+{
+ public:
+  typedef VisionLinkConfig Config;
+  typedef hello_world::OfflineChecker OfflineChecker;
+
+  static const uint8_t kVersion = 2u;
+  static const size_t kMaxFrameLen = 128u;   ///< COBS 编码前单帧的最大长度
+  static const size_t kMaxEncLen = kMaxFrameLen + kMaxFrameLen / 254u + 2u;  ///< COBS 编码后含帧尾的最大长度
+  static const size_t kMaxPoseBatch = 8u;     ///< 单帧最多打包的位姿样本数
+  static const size_t kBulletSpdHistLen = 4u;  ///< 弹速历史长度
+
+  struct Target {
+    bool is_detected = false;                  ///< 是否检测到目标
+    uint8_t shoot_flag = 0;                    ///< 射击指令，取值同原有视觉协议
+    bool is_high_value = false;                ///< 是否为高价值目标
+    uint32_t exposure = 0;                     ///< 拍摄时刻的上位机时间，单位 us
+    float yaw = 0.0f;                          ///< 目标相对拍摄时刻云台位姿的 yaw，单位 rad
+    float pitch = 0.0f;                        ///< 目标相对拍摄时刻云台位姿的 pitch，单位 rad
+    float dist = 0.0f;                         ///< 目标距离，单位 m，为 0 时表示上位机未给出
+    uint16_t vtm_x = 0;                        ///< 目标在图传画面中的横坐标，单位像素，上位机未给出时为 0
+    uint16_t vtm_y = 0;                        ///< 目标在图传画面中的纵坐标，单位像素，上位机未给出时为 0
+  };
+
+  struct Status {
+    uint8_t work_state = 0;    ///< 视觉工作模式，取值同原有视觉协议
+    uint8_t target_color = 0;  ///< 目标颜色，取值同原有视觉协议
+    float blt_spd = 0.0f;      ///< 当前弹速，单位 m/s
+  };
+
+  struct LinkStats {
+    uint32_t rx_frame_cnt = 0;  ///< 正确接收的帧数
+    uint32_t rx_lost_cnt = 0;   ///< 由序号跳变统计的丢帧数
+    uint32_t rx_err_cnt = 0;    ///< COBS、CRC 或长度错误的帧数
+    uint32_t rx_ver_err_cnt = 0;  ///< 版本不符的帧数
+    uint32_t tx_frame_cnt = 0;  ///< 发出的帧数
+  };
+
+  VisionLink(const Config &config, uint32_t offline_threshold = 100)
+      : cfg_(config), time_sync_(config.sync), oc_(offline_threshold) {};
+  virtual ~VisionLink() = default;
+
+  virtual uint32_t rxId(void) const override { return rx_id_; };
+  virtual const RxIds &rxIds(void) const override { return rx_ids_; };
+  /**
+   * @brief       解码
+   * @param        len: 数据长度
+   * @param        data: 数据指针
+   * @param        rx_id: 接收 ID
+   * @retval       本次数据中至少解出一帧时返回true，否则返回false
+   * @note        在串口中断中调用，数据按字节流处理
+   */
+  virtual bool decode(size_t len, const uint8_t *data, uint32_t rx_id) override;
+
+  virtual uint32_t txId(void) const override { return tx_id_; };
+  /**
+   * @brief       编码一帧，打包自上一帧以来的位姿、状态、弹速历史与同步请求
+   * @param        len: 缓冲区长度，编码成功后修改为帧长度（含帧尾）
+   * @param        data: 缓冲区指针
+   * @retval       编码成功返回true，否则返回false
+   * @note        同步请求的 t1 在编码时记录，编码后立即由 DMA 发出
+   */
+  virtual bool encode(size_t &len, uint8_t *data) override;
+  void txSuccessCb(void) override { transmit_success_cnt_++; }
+
+  void addPose(uint32_t time_us, float roll, float pitch, float yaw);
+  void setStatus(const Status &status) { status_ = status; }
+  void addBulletSpd(float blt_spd);
+
+  bool isOffline() { return oc_.isOffline(); }
+  bool isSynced() const;
+  /**
+   * @brief       获取最新的目标数据
+   * @param        target: 目标数据
+   * @param        capture_us: 拍摄时刻对应的 MCU 时间，单位 us
+   * @retval       已同步且收到过目标数据时返回 true
+   */
+  bool getTarget(Target *target, uint32_t *capture_us) const;
+  /** 最新的目标数据，不要求已同步，用于 UI 等与拍摄时刻无关的场合 */
+  const Target &getLatestTarget() const { return target_; }
+  bool isTargetDetected() const { return has_target_ && target_.is_detected; }
+  bool isTargetHighValue() const { return isTargetDetected() && target_.is_high_value; }
+  /** 目标是否在视场内，由相对方向与视场角判断 */
+  bool isTargetInView() const;
+  /** 射击指令，取值同原有视觉协议，未收到目标数据时为 0（不射击） */
+  uint8_t getShootFlag() const { return has_target_ ? target_.shoot_flag : 0; }
+  const TimeSync &getTimeSync() const { return time_sync_; }
+  const LinkStats &getLinkStats() const { return stats_; }
+
+ private:
+  bool decodeFrame(const uint8_t *enc, size_t enc_len, uint32_t rx_us);
+  void decodeMsg(uint8_t type, const uint8_t *payload, size_t len, uint32_t rx_us);
+
+  Config cfg_;
+  TimeSync time_sync_;  ///< 时钟同步
+
+  // 解码相关
+  uint32_t rx_id_ = 0x00;                    ///< 串口接收不区分 ID
+  RxIds rx_ids_ = {rx_id_};
+  OfflineChecker oc_ = OfflineChecker(100);  ///< 离线检测器
+  uint8_t rx_buf_[kMaxEncLen] = {0};         ///< 未收到帧尾的 COBS 编码数据
+  size_t rx_len_ = 0;                        ///< 缓冲区中的字节数
+  bool is_rx_overflow_ = false;              ///< 当前帧是否超长
+  bool has_rx_seq_ = false;                  ///< 是否收到过序号
+  uint8_t last_rx_seq_ = 0;                  ///< 上一帧的序号
+  bool has_target_ = false;                  ///< 是否收到过目标数据
+  Target target_;                            ///< 最新的目标数据
+  LinkStats stats_;                          ///< 链路统计
+
+  // 编码相关
+  uint32_t tx_id_ = 0x00;              ///< 串口发送不区分 ID
+  uint32_t transmit_success_cnt_ = 0;  ///< 发送成功次数
+  uint8_t tx_seq_ = 0;                 ///< 帧序号
+  uint32_t tx_frame_since_sync_ = 0;   ///< 距离上次同步请求的帧数
+  Status status_;                      ///< 待发送的状态
+  uint32_t pose_t0_ = 0;               ///< 待发送位姿的第一个样本时间，单位 us
+  uint32_t pose_t1_ = 0;               ///< 待发送位姿的最后一个样本时间，单位 us
+  size_t pose_cnt_ = 0;                ///< 待发送的位姿样本数
+  int16_t pose_q_[kMaxPoseBatch][4] = {{0}};  ///< 待发送的姿态四元数
+  float blt_spd_hist_[kBulletSpdHistLen] = {0.0f};  ///< 弹速历史，由旧到新
+  size_t blt_spd_cnt_ = 0;             ///< 弹速历史中的有效数
+  bool is_blt_spd_updated_ = false;    ///< 是否有未发送的新弹速
+};
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+}  // namespace robot
+#endif /* ROBOT_MODULES_VISION_LINK_HPP_ */
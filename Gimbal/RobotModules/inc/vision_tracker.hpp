@@ -0,0 +1,96 @@
+/**
+ *******************************************************************************
+ * @file      :vision_tracker.hpp
+ * @brief     : 视觉目标世界系跟踪与帧间预测
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 视觉给出的期望 yaw、pitch 由拍摄时刻的云台位姿解算，是世界系下的目标方向，
+ *     每帧对应的拍摄时刻为收到该帧的时刻减去视觉时延；视觉与 MCU 完成时钟同步后，
+ *     由调用方给出按拍摄时间戳换算的实际时延，替代固定的 vis_latency
+ *  2. yaw、pitch 各用一个匀速模型卡尔曼滤波器 [ang, spd] 估计目标方向及其角速度，
+ *     过程噪声为白噪声角加速度，帧间隔不固定时按实际间隔预测
+ *  3. 每个控制周期由滤波结果外推到当前时刻（再加上控制时延补偿），
+ *     输出 1 ms 粒度的平滑期望角度，外推时间超过上限后保持，避免目标丢帧时飞出
+ *  4. 新息过大（切换目标）或目标丢失后重新初始化
+ *  5. 主机端合成运动目标命中率仿真：tools/host/run.sh vision_tracker_sim
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ROBOT_MODULES_VISION_TRACKER_HPP_
+#define ROBOT_MODULES_VISION_TRACKER_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+#include <cstddef>
+#include <cstdint>
+
+/* Exported macro ------------------------------------------------------------*/
+
+namespace robot
+{
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+struct VisionTrackerParams {
+  float q_acc;           ///< 目标角加速度白噪声的功率谱密度，单位 (rad/s^2)^2·s
+  float r_ang;           ///< 视觉角度测量噪声的方差，单位 rad^2
+  float vis_latency;     ///< 视觉从拍摄到数据到达云台的时延，单位 s
+  float ctrl_lead;       ///< 控制时延补偿，输出外推到当前时刻之后的时间，单位 s
+  float max_extrap;      ///< 最长外推时间，单位 s
+  float reset_thres;     ///< 新息超过该值时认为切换了目标并重新初始化，单位 rad
+  float spd_max;         ///< 目标角速度估计的上限，单位 rad/s
+};
+
+class VisionTracker
+{
+ public:
+  typedef VisionTrackerParams Params;
+
+  enum AxisIdx : uint8_t {
+    kAxisPitch = 0u,
+    kAxisYaw = 1u,
+    kAxisNum = 2u,
+  };
+
+  VisionTracker(const Params &params) : params_(params) {};
+  ~VisionTracker() {};
+
+  void update(uint32_t tick, float yaw, float pitch, bool is_detected, float latency = -1.0f);
+  void reset();
+
+  bool isTracking() const { return is_tracking_; }
+  /** 外推到当前时刻的目标方向，单位 rad */
+  float getAng(AxisIdx idx) const { return ang_out_[idx]; }
+  /** 目标方向的角速度估计，单位 rad/s */
+  float getSpd(AxisIdx idx) const { return spd_out_[idx]; }
+
+ private:
+  struct Axis {
+    float x[2];     ///< [ang, spd]
+    float p[2][2];  ///< 协方差矩阵
+  };
+
+  void initAxis(Axis &axis, float ang);
+  void predictAxis(Axis &axis, float dt);
+  void correctAxis(Axis &axis, float ang, bool is_periodic);
+  float calcInnov(const Axis &axis, float ang, bool is_periodic) const;
+
+  Params params_;
+
+  bool is_tracking_ = false;         ///< 是否正在跟踪目标
+  float last_meas_[kAxisNum] = {0.0f};  ///< 上一帧的视觉角度，用于判断是否收到新帧
+  uint32_t meas_tick_ = 0;           ///< 滤波状态对应的拍摄时刻，单位 ms
+  Axis axis_[kAxisNum];              ///< 各轴滤波器
+
+  float ang_out_[kAxisNum] = {0.0f};  ///< 外推后的目标方向，单位 rad
+  float spd_out_[kAxisNum] = {0.0f};  ///< 目标方向的角速度，单位 rad/s
+};
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+}  // namespace robot
+#endif /* ROBOT_MODULES_VISION_TRACKER_HPP_ */
@@ -0,0 +1,245 @@
+/**
+ *******************************************************************************
+ * @file      :feed_profile.cpp
+ * @brief     : 拨盘单发拨弹的加加速度受限轨迹与卡弹早期处理
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "feed_profile.hpp"
+
+#include <cmath>
+/* Private macro -------------------------------------------------------------*/
+
+namespace robot
+{
+/* Private constants ---------------------------------------------------------*/
+const float kPi = 3.14159265358979f;
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static float WrapPi(float ang)
+{
+  ang = fmodf(ang, 2.0f * kPi);
+  if (ang >= kPi) {
+    ang -= 2.0f * kPi;
+  } else if (ang < -kPi) {
+    ang += 2.0f * kPi;
+  }
+  return ang;
+}
+/* Exported function definitions ---------------------------------------------*/
+
+FeedProfile::FeedProfile(const Params &params) : params_(params)
+{
+  acc_max_ = params_.acc_ratio * params_.kt * params_.curr_max / params_.inertia;
+  plan(params_.step_ang);
+  step_duration_ = duration_;
+};
+
+/**
+ * @brief       更新轨迹并计算电机电流期望值
+ * @param        tick: 当前时间戳，单位 ms
+ * @param        ang: 拨盘输出轴角度，单位 rad
+ * @param        spd: 拨盘输出轴角速度，单位 rad/s
+ * @param        curr: 电机电流反馈，单位 A
+ * @param        feed_ang_ref: Feed 角度环的期望角度，与 ang 同一角度，单位 rad
+ * @param        feed_curr_ref: Feed 本周期输出的电流期望值，单位 A
+ * @retval       需要接管电机电流时返回 true，此时应以 getCurrRef 覆盖 Feed 的输出
+ * @note        每个控制周期在 Feed 计算之后调用一次
+ */
+bool FeedProfile::update(uint32_t tick, float ang, float spd, float curr, float feed_ang_ref, float feed_curr_ref)
+{
+  if (!has_ang_) {
+    has_ang_ = true;
+    last_raw_ang_ = ang;
+    ang_ = ang;
+    feed_goal_ = ang + WrapPi(feed_ang_ref - ang);
+    last_tick_ = tick;
+  }
+  ang_ += WrapPi(ang - last_raw_ang_);
+  last_raw_ang_ = ang;
+  // 与 Feed 角度环的周期误差处理一致，期望角度取离当前角度最近的一支
+  float last_feed_goal = feed_goal_;
+  feed_goal_ = ang_ + WrapPi(feed_ang_ref - ang);
+  uint32_t dt_ms = tick - last_tick_;
+  last_tick_ = tick;
+  is_step_started_ = false;
+
+  if (state_ == State::kIdle) {
+    curr_ref_ = 0.0f;
+    if (feed_goal_ - last_feed_goal > 0.5f * params_.step_ang) {
+      // Feed 的期望角度前移了一发，开始按轨迹拨弹
+      is_jammed_ = false;
+      is_step_started_ = true;
+      retry_cnt_ = 0;
+      startStep(tick, feed_goal_);
+    }
+  } else if (dir_ * (feed_goal_ - goal_ang_) < -0.5f * params_.step_ang) {
+    // Feed 的堵转回退，交还给 Feed
+    state_ = State::kIdle;
+    curr_ref_ = 0.0f;
+    return isActive();
+  } else if (state_ == State::kRelease) {
+    curr_ref_ = -dir_ * params_.rev_curr;
+    if (tick - start_tick_ >= params_.rev_time) {
+      startStep(tick, goal_ang_);
+    }
+  }
+
+  if (state_ != State::kStep) {
+    return isActive();
+  }
+
+  float t = (tick - start_tick_) * 0.001f;
+  float ang_ref = 0.0f, spd_ref = 0.0f, acc_ref = 0.0f;
+  sample(t, &ang_ref, &spd_ref, &acc_ref);
+
+  float curr_ref = params_.inertia * acc_ref / params_.kt + params_.kp * (ang_ref - ang_) +
+                   params_.kd * (spd_ref - spd);
+  if (curr_ref > params_.curr_max) {
+    curr_ref = params_.curr_max;
+  } else if (curr_ref < -params_.curr_max) {
+    curr_ref = -params_.curr_max;
+  }
+  curr_ref_ = curr_ref;
+
+  // 电流接近饱和而拨盘跟不上轨迹，认为弹丸开始卡住
+  if (dir_ * (ang_ref - ang_) > params_.jam_err && dir_ * curr >= params_.jam_curr) {
+    jam_ms_ += dt_ms;
+  } else {
+    jam_ms_ = 0;
+  }
+  if (jam_ms_ >= params_.jam_time) {
+    jam_ms_ = 0;
+    jam_cnt_++;
+    if (retry_cnt_ < params_.max_retry) {
+      retry_cnt_++;
+      state_ = State::kRelease;
+      start_tick_ = tick;
+      curr_ref_ = -dir_ * params_.rev_curr;
+    } else {
+      // 交还给 Feed 的堵转处理
+      is_jammed_ = true;
+      state_ = State::kIdle;
+      curr_ref_ = 0.0f;
+    }
+    return isActive();
+  }
+
+  if (t >= duration_) {
+    bool is_settled = fabsf(goal_ang_ - ang_) < params_.settle_err && fabsf(spd) < params_.idle_spd;
+    bool is_timeout = t >= duration_ + params_.settle_time * 0.001f;
+    if (feed_goal_ - goal_ang_ > 0.5f * params_.step_ang) {
+      if (is_settled || is_timeout) {
+        // 接管期间 Feed 又拨了一发，接着拨向 Feed 的期望角度
+        is_step_started_ = true;
+        retry_cnt_ = 0;
+        startStep(tick, feed_goal_);
+      }
+    } else if ((is_settled && fabsf(feed_curr_ref - curr_ref_) < params_.handback_curr) || is_timeout) {
+      state_ = State::kIdle;
+      curr_ref_ = 0.0f;
+    }
+  }
+  return isActive();
+};
+
+void FeedProfile::reset()
+{
+  state_ = State::kIdle;
+  is_jammed_ = false;
+  is_step_started_ = false;
+  has_ang_ = false;
+  jam_ms_ = 0;
+  curr_ref_ = 0.0f;
+};
+/* Private function definitions ----------------------------------------------*/
+
+void FeedProfile::startStep(uint32_t tick, float goal)
+{
+  goal_ang_ = goal;
+  start_ang_ = ang_;
+  start_tick_ = tick;
+  jam_ms_ = 0;
+  plan(goal_ang_ - start_ang_);
+  state_ = State::kStep;
+};
+
+/**
+ * @brief       规划起止速度为 0、行程为 dist 的七段式 S 曲线
+ * @param        dist: 行程，单位 rad，可为负
+ */
+void FeedProfile::plan(float dist)
+{
+  dir_ = dist >= 0.0f ? 1.0f : -1.0f;
+  float d = fabsf(dist);
+  float j = params_.jerk_max;
+  float a = acc_max_;
+  float v = params_.spd_max;
+
+  float tj = 0.0f, ta = 0.0f;
+  if (v * j >= a * a) {
+    tj = a / j;
+    ta = tj + v / a;
+  } else {
+    tj = sqrtf(v / j);
+    ta = 2.0f * tj;
+  }
+  float tv = d / v - ta;
+  if (tv < 0.0f) {
+    // 达不到最大角速度，加速段与减速段直接相接
+    tv = 0.0f;
+    tj = a / j;
+    ta = 0.5f * (tj + sqrtf(tj * tj + 4.0f * d / a));
+    if (ta < 2.0f * tj) {
+      // 达不到最大角加速度
+      tj = cbrtf(d / (2.0f * j));
+      ta = 2.0f * tj;
+    }
+  }
+
+  const float t[7] = {tj, ta - 2.0f * tj, tj, tv, tj, ta - 2.0f * tj, tj};
+  const float js[7] = {j, 0.0f, -j, 0.0f, -j, 0.0f, j};
+  duration_ = 0.0f;
+  for (size_t i = 0; i < 7; i++) {
+    phase_t_[i] = t[i];
+    phase_j_[i] = dir_ * js[i];
+    duration_ += t[i];
+  }
+};
+
+/**
+ * @brief       计算轨迹在 t 时刻的状态
+ * @param        t: 轨迹开始后的时间，单位 s
+ */
+void FeedProfile::sample(float t, float *ang, float *spd, float *acc) const
+{
+  float p = 0.0f, v = 0.0f, a = 0.0f;
+  for (size_t i = 0; i < 7 && t > 0.0f; i++) {
+    float h = t < phase_t_[i] ? t : phase_t_[i];
+    float j = phase_j_[i];
+    p += v * h + a * h * h * 0.5f + j * h * h * h / 6.0f;
+    v += a * h + j * h * h * 0.5f;
+    a += j * h;
+    t -= h;
+  }
+  if (t > 0.0f) {
+    // 轨迹已结束
+    p = goal_ang_ - start_ang_;
+    v = 0.0f;
+    a = 0.0f;
+  }
+  *ang = start_ang_ + p;
+  *spd = v;
+  *acc = a;
+};
+}  // namespace robot
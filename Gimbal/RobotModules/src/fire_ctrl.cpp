@@ -0,0 +1,116 @@
+/**
+ *******************************************************************************
+ * @file      :fire_ctrl.cpp
+ * @brief     : 自瞄射击决策，由预测瞄准误差与弹丸飞行时间估计命中概率并选择拨弹时机
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "fire_ctrl.hpp"
+
+#include <cmath>
+/* Private macro -------------------------------------------------------------*/
+
+namespace robot
+{
+/* Private constants ---------------------------------------------------------*/
+const float kInvSqrt2 = 0.70710678f;
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/**
+ * @brief       正态分布误差落在 [-half, half] 内的概率
+ * @param        mean: 误差均值
+ * @param        std: 误差标准差，须大于 0
+ * @param        half: 区间半宽
+ */
+static float CalcAxisProb(float mean, float std, float half)
+{
+  float k = kInvSqrt2 / std;
+  return 0.5f * (erff((half - mean) * k) - erff((-half - mean) * k));
+}
+/* Exported function definitions ---------------------------------------------*/
+
+/**
+ * @brief       更新射击决策
+ * @param        tick: 当前时间戳，单位 ms
+ * @param        input: 当前周期的瞄准状态
+ * @retval       当前周期允许拨弹时返回 true
+ * @note        每个控制周期调用一次
+ */
+bool FireCtrl::update(uint32_t tick, const Input &input)
+{
+  float dist = input.dist > 0.0f ? input.dist : params_.default_dist;
+  float blt_spd = input.blt_spd > params_.min_blt_spd ? input.blt_spd : params_.min_blt_spd;
+  flight_time_ = dist / blt_spd;
+
+  float hit_prob = calcHitProb(input, dist, params_.feed_delay);
+  hit_prob_ = hit_prob;
+
+  if (!input.is_permitted || hit_prob < params_.p_min) {
+    is_waiting_ = false;
+    is_fire_allowed_ = false;
+    return false;
+  }
+
+  bool is_fire = hit_prob >= params_.p_good;
+  if (!is_fire) {
+    if (!is_waiting_) {
+      is_waiting_ = true;
+      wait_start_tick_ = tick;
+    }
+    // 命中概率不再上升，或已等待足够长的时间
+    float next_prob = calcHitProb(input, dist, params_.feed_delay + params_.look_ahead);
+    is_fire = next_prob <= hit_prob || tick - wait_start_tick_ >= params_.max_wait;
+  }
+
+  if (is_fire) {
+    is_waiting_ = false;
+  }
+  is_fire_allowed_ = is_fire;
+  return is_fire;
+};
+
+void FireCtrl::reset()
+{
+  is_waiting_ = false;
+  is_fire_allowed_ = false;
+  hit_prob_ = 0.0f;
+};
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief       计算延迟 delay 后出膛的弹丸的命中概率
+ * @param        input: 当前周期的瞄准状态
+ * @param        dist: 目标距离，单位 m
+ * @param        delay: 当前时刻到弹丸出膛的时间，单位 s
+ * @note        需先更新 flight_time_
+ */
+float FireCtrl::calcHitProb(const Input &input, float dist, float delay) const
+{
+  float tgt_std = params_.tgt_spd_std * flight_time_;
+  float std = sqrtf(params_.disp_std * params_.disp_std + tgt_std * tgt_std);
+  if (std < 1e-6f) {
+    std = 1e-6f;
+  }
+
+  float half[kAxisNum] = {0.0f};
+  half[kAxisPitch] = params_.armor_half_h / dist;
+  half[kAxisYaw] = params_.armor_half_w / dist;
+
+  float prob = 1.0f;
+  for (size_t i = 0; i < kAxisNum; i++) {
+    float err = input.aim_err[i] + input.err_spd[i] * delay;
+    prob *= CalcAxisProb(err, std, half[i]);
+  }
+  return prob;
+};
+}  // namespace robot
@@ -0,0 +1,271 @@
+/**
+ *******************************************************************************
+ * @file      :fric_shot_ffd.cpp
+ * @brief     : 摩擦轮单发掉速的电流前馈补偿
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "fric_shot_ffd.hpp"
+
+#include <cmath>
+/* Private macro -------------------------------------------------------------*/
+
+namespace robot
+{
+/* Private constants ---------------------------------------------------------*/
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported function definitions ---------------------------------------------*/
+
+FricShotFfd::FricShotFfd(const Params &params) : params_(params)
+{
+  is_capture_ = params_.capture_on_start;
+  for (size_t i = 0; i < kFricNum; i++) {
+    amp_[i] = params_.amp_init;
+  }
+};
+
+/**
+ * @brief       拨盘开始拨弹，本发的脉冲在 delay 后开始
+ * @param        tick: 当前时间戳，单位 ms
+ */
+void FricShotFfd::trigger(uint32_t tick)
+{
+  if (!has_base_) {
+    return;
+  }
+  if (is_triggered_ && tick - trig_tick_ >= params_.delay) {
+    // 连发间隔短于测量时长，提前结束上一发的测量
+    finishObserve();
+  }
+  is_triggered_ = true;
+  is_confirmed_ = false;
+  trig_tick_ = tick;
+  capture_len_ = 0;
+  for (size_t i = 0; i < kCaptureLen; i++) {
+    capture_[i] = 0.0f;
+  }
+  for (size_t i = 0; i < kFricNum; i++) {
+    min_dev_[i] = 0.0f;
+    max_dev_[i] = 0.0f;
+  }
+};
+
+/**
+ * @brief       确认发射了一发弹丸
+ * @note        确认按时间先后对应到等待确认的测量，没有等待确认的测量时对应到当前一发
+ */
+void FricShotFfd::onShotConfirmed()
+{
+  if (pending_num_ > 0) {
+    confirm(pending_[0]);
+    for (size_t i = 1; i < pending_num_; i++) {
+      pending_[i - 1] = pending_[i];
+    }
+    pending_num_--;
+  } else if (is_triggered_) {
+    is_confirmed_ = true;
+  }
+};
+
+/**
+ * @brief       计算摩擦轮电机输入
+ * @param        tick: 当前时间戳，单位 ms
+ * @param        spd: 摩擦轮电机转速反馈，单位 rad/s
+ * @param        curr: 摩擦轮电机电流反馈，单位 A
+ * @retval       需要接管电机输入时返回 true，此时应以 getInput 覆盖 Fric 的输出
+ * @note        每个控制周期在 Fric 计算之后调用一次
+ */
+bool FricShotFfd::update(uint32_t tick, const float spd[kFricNum], const float curr[kFricNum])
+{
+  is_active_ = false;
+  while (pending_num_ > 0 && tick - pending_[0].trig_tick > params_.confirm_time) {
+    for (size_t i = 1; i < pending_num_; i++) {
+      pending_[i - 1] = pending_[i];
+    }
+    pending_num_--;
+  }
+
+  for (size_t i = 0; i < kFricNum; i++) {
+    if (fabsf(spd[i]) < params_.min_spd) {
+      has_base_ = false;
+      is_triggered_ = false;
+      return false;
+    }
+  }
+
+  uint32_t elapsed = tick - trig_tick_;
+  if (is_capture_ && is_triggered_ && elapsed < kCaptureLen) {
+    // 以拨弹前的稳态电流为基准，两个摩擦轮取平均
+    float dev = 0.0f;
+    for (size_t i = 0; i < kFricNum; i++) {
+      dev += (dir_[i] * curr[i] * params_.raw_per_curr - base_curr_[i]) / kFricNum;
+    }
+    capture_[elapsed] = dev;
+    capture_len_ = elapsed + 1;
+  }
+  if (!is_triggered_ || elapsed < params_.delay) {
+    // 弹丸到达摩擦轮之前更新稳态值
+    for (size_t i = 0; i < kFricNum; i++) {
+      float dir = spd[i] >= 0.0f ? 1.0f : -1.0f;
+      float w = dir * spd[i];
+      float c = dir * curr[i] * params_.raw_per_curr;
+      if (!has_base_ || dir != dir_[i]) {
+        dir_[i] = dir;
+        base_spd_[i] = w;
+        base_curr_[i] = c;
+      } else {
+        base_spd_[i] += params_.base_lpf * (w - base_spd_[i]);
+        base_curr_[i] += params_.base_lpf * (c - base_curr_[i]);
+      }
+    }
+    has_base_ = true;
+    return false;
+  }
+
+  size_t k = elapsed - params_.delay;
+  for (size_t i = 0; i < kFricNum; i++) {
+    float w = dir_[i] * spd[i];
+    float dev = w - base_spd_[i];
+    if (dev < min_dev_[i]) {
+      min_dev_[i] = dev;
+    } else if (dev > max_dev_[i]) {
+      max_dev_[i] = dev;
+    }
+
+    if (k < params_.shape_len && !is_capture_) {
+      float out = base_curr_[i] + amp_[i] * params_.shape[k] - params_.kp * dev;
+      if (out > params_.out_max) {
+        out = params_.out_max;
+      } else if (out < -params_.out_max) {
+        out = -params_.out_max;
+      }
+      input_[i] = dir_[i] * out;
+      is_active_ = true;
+    }
+  }
+
+  if (k + 1 >= params_.obs_time && (!is_capture_ || elapsed + 1 >= kCaptureLen)) {
+    finishObserve();
+  }
+  return is_active_;
+};
+
+void FricShotFfd::reset()
+{
+  has_base_ = false;
+  is_triggered_ = false;
+  is_confirmed_ = false;
+  is_active_ = false;
+  pending_num_ = 0;
+};
+
+/**
+ * @brief       开始或停止实测脉冲形状，开始时清空之前的记录
+ */
+void FricShotFfd::setCapture(bool is_capture)
+{
+  if (is_capture && !is_capture_) {
+    for (size_t i = 0; i < kCaptureLen; i++) {
+      capture_sum_[i] = 0.0f;
+    }
+    capture_cnt_ = 0;
+    capture_len_ = 0;
+  }
+  is_capture_ = is_capture;
+};
+
+/**
+ * @brief       获取实测的平均电流响应，按峰值归一化
+ * @param        shape: 电流响应，下标为拨弹后的控制周期数
+ * @retval       峰值所在的下标，尚未记录时返回 0 且 shape 全为 0
+ */
+size_t FricShotFfd::getCapture(float shape[kCaptureLen]) const
+{
+  size_t peak = 0;
+  for (size_t i = 1; i < kCaptureLen; i++) {
+    if (capture_sum_[i] > capture_sum_[peak]) {
+      peak = i;
+    }
+  }
+  float scale = capture_sum_[peak] > 0.0f ? 1.0f / capture_sum_[peak] : 0.0f;
+  for (size_t i = 0; i < kCaptureLen; i++) {
+    shape[i] = capture_sum_[i] * scale;
+  }
+  return scale > 0.0f ? peak : 0;
+};
+/* Private function definitions ----------------------------------------------*/
+
+void FricShotFfd::finishObserve()
+{
+  is_triggered_ = false;
+  Measure measure;
+  measure.trig_tick = trig_tick_;
+  for (size_t i = 0; i < kFricNum; i++) {
+    measure.dip[i] = -min_dev_[i] - max_dev_[i];
+    last_dip_[i] = measure.dip[i];
+  }
+  // 连发间隔短于 kCaptureLen 时记录不完整，不参与平均
+  measure.has_capture = is_capture_ && capture_len_ >= kCaptureLen;
+  if (measure.has_capture) {
+    for (size_t i = 0; i < kCaptureLen; i++) {
+      measure.curr[i] = capture_[i];
+    }
+  }
+
+  if (is_confirmed_) {
+    confirm(measure);
+    return;
+  }
+  if (pending_num_ >= kMaxPending) {
+    for (size_t i = 1; i < pending_num_; i++) {
+      pending_[i - 1] = pending_[i];
+    }
+    pending_num_--;
+  }
+  pending_[pending_num_++] = measure;
+};
+
+/**
+ * @brief       确认发射后，实测脉冲形状时累加电流响应，否则修正脉冲幅值
+ */
+void FricShotFfd::confirm(const Measure &measure)
+{
+  if (!is_capture_) {
+    adapt(measure.dip);
+    return;
+  }
+  if (measure.has_capture) {
+    for (size_t i = 0; i < kCaptureLen; i++) {
+      capture_sum_[i] += measure.curr[i];
+    }
+    capture_cnt_++;
+  }
+};
+
+/**
+ * @brief       按掉速减超调修正脉冲幅值，掉速偏大时增大幅值，超调偏大时减小幅值
+ */
+void FricShotFfd::adapt(const float dip[kFricNum])
+{
+  for (size_t i = 0; i < kFricNum; i++) {
+    float amp = amp_[i] + params_.adapt_gain * dip[i];
+    if (amp < 0.0f) {
+      amp = 0.0f;
+    } else if (amp > params_.amp_max) {
+      amp = params_.amp_max;
+    }
+    amp_[i] = amp;
+  }
+};
+}  // namespace robot
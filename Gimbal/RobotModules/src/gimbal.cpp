@@ -36,6 +36,7 @@ namespace robot
     updateWorkTick();
     updateMotorData();
     updateImuData();
+    updateFusedData();
     updateIsPwrOn();
   };
 
@@ -132,6 +133,35 @@ namespace robot
     imu_spd_fdb_[kJointPitch] = -imu_ptr_->gyro_pitch();
   };
 
+  /**
+   * @brief       融合编码器与 IMU 的关节反馈
+   * @note        yaw 轴需要底盘偏航角速度递推角度偏差，底盘数据无效时直接使用 IMU；
+   *              电机离线或融合器未注册时同样使用 IMU，恢复后从 IMU 值重新开始，无跳变
+   */
+  void Gimbal::updateFusedData()
+  {
+    float dt = interval_ticks_ * 0.001f;
+    for (size_t i = 0; i < kJointNum; i++)
+    {
+      Fusion *fusion_ptr = fusion_ptr_[i];
+      bool is_base_spd_valid = (i == kJointPitch) || is_chassis_motion_valid_;
+      if (fusion_ptr == nullptr || motor_ptr_[i]->isOffline() || !is_base_spd_valid)
+      {
+        if (fusion_ptr != nullptr)
+        {
+          fusion_ptr->reset();
+        }
+        fused_ang_fdb_[i] = imu_ang_fdb_[i];
+        fused_spd_fdb_[i] = imu_spd_fdb_[i];
+        continue;
+      }
+      float base_spd = (i == kJointYaw) ? chassis_yaw_spd_fdb_ : 0.0f;
+      fusion_ptr->update(motor_ang_fdb_[i], motor_spd_fdb_[i], imu_ang_fdb_[i], imu_spd_fdb_[i], base_spd, dt);
+      fused_ang_fdb_[i] = fusion_ptr->getAng();
+      fused_spd_fdb_[i] = fusion_ptr->getSpd();
+    }
+  };
+
 #pragma endregion
 
 #pragma region 任务执行
@@ -189,6 +219,10 @@ namespace robot
       {
         JointIdx joint_idx = joint_idxs[i];
         pid_ptr_[joint_idx]->reset();
+        if (adrc_ptr_[joint_idx] != nullptr)
+        {
+          adrc_ptr_[joint_idx]->reset();
+        }
         motor_ptr_[joint_idx]->disable();
       }
     }
@@ -197,7 +231,10 @@ namespace robot
       calcCtrlAngBased();
       adjustJointFdb();
       adjustLastJointAngRef();
+      updateVisionTracker();
       calcJointAngRef();
+      calcJointAngTraj();
+      updatePitchIdent();
       calcJointTorRef();
       setCommData(true);
     }
@@ -209,6 +246,7 @@ namespace robot
     adjustJointFdb();
     adjustLastJointAngRef();
     calcJointAngRef();
+    resetJointAngTraj();
 
     setCommData(false);
   };
@@ -228,6 +266,18 @@ namespace robot
       ctrl_ang_based_[kJointYaw] = CtrlAngBased::Imu;
       ctrl_ang_based_[kJointPitch] = CtrlAngBased::Imu;
     }
+
+    // 使用融合反馈时，手动与自动模式共用同一反馈，切换模式时期望值无需修正
+    if (cfg_.use_fused_fdb)
+    {
+      for (size_t i = 0; i < kJointNum; i++)
+      {
+        if (fusion_ptr_[i] != nullptr)
+        {
+          ctrl_ang_based_[i] = CtrlAngBased::Fused;
+        }
+      }
+    }
   };
 
   void Gimbal::adjustJointFdb()
@@ -239,15 +289,39 @@ namespace robot
       if (ctrl_ang_based_[joint_idx] == CtrlAngBased::Motor)
       {
         joint_ang_fdb_[joint_idx] = motor_ang_fdb_[joint_idx];
+        joint_spd_fdb_[joint_idx] = imu_spd_fdb_[joint_idx];
+      }
+      else if (ctrl_ang_based_[joint_idx] == CtrlAngBased::Fused)
+      {
+        joint_ang_fdb_[joint_idx] = fused_ang_fdb_[joint_idx];
+        joint_spd_fdb_[joint_idx] = fused_spd_fdb_[joint_idx];
       }
       else
       {
         joint_ang_fdb_[joint_idx] = imu_ang_fdb_[joint_idx];
+        joint_spd_fdb_[joint_idx] = imu_spd_fdb_[joint_idx];
       }
-      joint_spd_fdb_[joint_idx] = imu_spd_fdb_[joint_idx];
     }
   }
 
+  /**
+   * @brief       计算控制所用角度与编码器角度之差，用于把基于编码器的限位、扫描角度换算到控制坐标系
+   * @param        idx: 关节索引
+   * @retval      角度差，单位 rad
+   */
+  float Gimbal::calcMotorToCtrlAngDelta(JointIdx idx) const
+  {
+    if (ctrl_ang_based_[idx] == CtrlAngBased::Imu)
+    {
+      return imu_ang_fdb_[idx] - motor_ang_fdb_[idx];
+    }
+    else if (ctrl_ang_based_[idx] == CtrlAngBased::Fused)
+    {
+      return fused_ang_fdb_[idx] - motor_ang_fdb_[idx];
+    }
+    return 0.0f;
+  }
+
   void Gimbal::adjustLastJointAngRef()
   {
     // 判断工作模式是否发生变化
@@ -269,6 +343,10 @@ namespace robot
       {
         last_joint_ang_ref_[joint_idx] = imu_ang_fdb_[joint_idx];
       }
+      else if (ctrl_ang_based_[joint_idx] == CtrlAngBased::Fused)
+      {
+        last_joint_ang_ref_[joint_idx] = fused_ang_fdb_[joint_idx];
+      }
       else
       {
         HW_ASSERT(false, "unknown ctrl_ang_based_[joint_idx] %d", ctrl_ang_based_[joint_idx]);
@@ -320,23 +398,57 @@ namespace robot
       diff += 2 * M_PI;
   }
 
+  /**
+   * @brief       由视觉指令更新目标跟踪器，得到每个控制周期平滑外推的视觉期望角度
+   * @note        视觉指令为拍摄时刻云台位姿下解算的世界系目标方向，跟踪器在帧间按匀速模型外推
+   */
+  void Gimbal::updateVisionTracker()
+  {
+    if (vis_tracker_ptr_ == nullptr)
+    {
+      vis_ref_ = vis_data_.cmd;
+      return;
+    }
+    bool is_valid = ctrl_mode_ == CtrlMode::Auto && vis_data_.is_target_detected;
+    vis_tracker_ptr_->update(work_tick_, vis_data_.cmd.yaw, vis_data_.cmd.pitch, is_valid, vis_data_.latency);
+    if (vis_tracker_ptr_->isTracking())
+    {
+      vis_ref_.yaw = vis_tracker_ptr_->getAng(Tracker::kAxisYaw);
+      vis_ref_.pitch = vis_tracker_ptr_->getAng(Tracker::kAxisPitch);
+    }
+    else
+    {
+      vis_ref_ = vis_data_.cmd;
+    }
+  }
+
+  float Gimbal::getVisionRefSpd(JointIdx idx) const
+  {
+    if (vis_tracker_ptr_ == nullptr || !vis_tracker_ptr_->isTracking())
+    {
+      return 0.0f;
+    }
+    return vis_tracker_ptr_->getSpd(idx == kJointYaw ? Tracker::kAxisYaw : Tracker::kAxisPitch);
+  };
+
   bool debug_enemydetected;
   float debug_pitch = 0.0f;
   float debug_yaw = 0.0f;
   bool rad_debug = false;
   float debug_diff = 0.0f;
+  bool debug_pitch_ident_sweep = false;  ///< 置 true 后开始一次 pitch 前馈辨识扫描
   void Gimbal::calcJointAngRef()
   {
     float delta_yaw_angle = 0.0f;
     debug_enemydetected = vis_data_.is_target_detected;
     // 如果控制模式是自动，且视觉模块没有离线、视觉模块检测到有效目标，且视觉反馈角度与当前角度相差不大
     Cmd tmp_ang_ref = {0.0f};
-    debug_diff = hello_world::AngleNormRad(vis_data_.cmd.yaw - joint_ang_fdb_[kJointYaw]);
+    debug_diff = hello_world::AngleNormRad(vis_ref_.yaw - joint_ang_fdb_[kJointYaw]);
     if (ctrl_mode_ == CtrlMode::Auto &&
-        fabsf(hello_world::AngleNormRad(joint_ang_fdb_[kJointYaw] - vis_data_.cmd.yaw)) < 0.3927f &&
-        fabsf(joint_ang_fdb_[kJointPitch] - vis_data_.cmd.pitch) < 0.30543f)
+        fabsf(hello_world::AngleNormRad(joint_ang_fdb_[kJointYaw] - vis_ref_.yaw)) < 0.3927f &&
+        fabsf(joint_ang_fdb_[kJointPitch] - vis_ref_.pitch) < 0.30543f)
     {
-      tmp_ang_ref = vis_data_.cmd;
+      tmp_ang_ref = vis_ref_;
     }
     else
     {
@@ -381,6 +493,19 @@ namespace robot
         }
       }
     }
+    // pitch 前馈辨识扫描，扫描期间覆盖 pitch 指令，扫描角度基于电机角度
+    if (pitch_ident_ptr_ != nullptr)
+    {
+      if (debug_pitch_ident_sweep)
+      {
+        debug_pitch_ident_sweep = false;
+        pitch_ident_ptr_->startSweep(motor_ang_fdb_[kJointPitch], cfg_.min_pitch_ang, cfg_.max_pitch_ang);
+      }
+      if (pitch_ident_ptr_->isSweeping())
+      {
+        tmp_ang_ref.pitch = pitch_ident_ptr_->calcSweepRef(interval_ticks_ * 0.001f) + calcMotorToCtrlAngDelta(kJointPitch);
+      }
+    }
     // 角度归一化到[-pi, pi)
     tmp_ang_ref.yaw = hello_world::AngleNormRad(tmp_ang_ref.yaw);
     tmp_ang_ref.pitch = hello_world::AngleNormRad(tmp_ang_ref.pitch);
@@ -390,11 +515,11 @@ namespace robot
     {
       tmp_ang_ref.pitch = hello_world::Bound(tmp_ang_ref.pitch, cfg_.min_pitch_ang, cfg_.max_pitch_ang);
     }
-    else if (ctrl_ang_based_[kJointPitch] == CtrlAngBased::Imu)
+    else if (ctrl_ang_based_[kJointPitch] == CtrlAngBased::Imu || ctrl_ang_based_[kJointPitch] == CtrlAngBased::Fused)
     {
       // {fdb}_{imu} - {lim}_{imu} = {fdb}_{motor} - {lim}_{motor}
       // {lim}_{imu} = {lim}_{motor} + {fdb}_{imu} - {fdb}_{motor}
-      float motor_imu_delta = imu_ang_fdb_[kJointPitch] - motor_ang_fdb_[kJointPitch];
+      float motor_imu_delta = calcMotorToCtrlAngDelta(kJointPitch);
       tmp_ang_ref.pitch = hello_world::Bound(tmp_ang_ref.pitch, cfg_.min_pitch_ang + motor_imu_delta, cfg_.max_pitch_ang + motor_imu_delta);
     }
     else
@@ -410,40 +535,221 @@ namespace robot
     {
       is_rotating_ = false;
     }
+
+    // 期望角度的变化率，供底盘跟随前馈使用；转头、切换控制方式时期望值跳变，不计入
+    for (size_t i = 0; i < kJointNum; i++)
+    {
+      if (is_rotating_ || last_ctrl_ang_based_[i] != ctrl_ang_based_[i])
+      {
+        joint_spd_ref_[i] = 0.0f;
+      }
+      else
+      {
+        joint_spd_ref_[i] = hello_world::AngleNormRad(joint_ang_ref_[i] - joint_ang_ref_prev_[i]) * 1000.0f;
+      }
+      joint_ang_ref_prev_[i] = joint_ang_ref_[i];
+    }
   };
 
+  /**
+   * @brief       生成时间最优轨迹，作为控制器的实际期望角度
+   * @note        转头、视觉大幅重定位、巡航等期望角度跳变时，轨迹以电机力矩与转速限制下的最短时间平滑到达；
+   *              切换控制方式时角度坐标系改变，轨迹从反馈值重新开始
+   */
+  void Gimbal::calcJointAngTraj()
+  {
+    float dt = interval_ticks_ * 0.001f;
+    for (size_t i = 0; i < kJointNum; i++)
+    {
+      Traj *traj_ptr = traj_ptr_[i];
+      if (traj_ptr == nullptr)
+      {
+        joint_ang_traj_[i] = joint_ang_ref_[i];
+        joint_spd_traj_[i] = joint_spd_ref_[i];
+        joint_acc_traj_[i] = 0.0f;
+        continue;
+      }
+      if (!is_traj_inited_ || last_ctrl_ang_based_[i] != ctrl_ang_based_[i])
+      {
+        traj_ptr->reset(joint_ang_fdb_[i], joint_spd_fdb_[i]);
+      }
+      traj_ptr->calc(joint_ang_ref_[i], joint_spd_ref_[i], dt);
+      joint_ang_traj_[i] = traj_ptr->getAng();
+      joint_spd_traj_[i] = traj_ptr->getSpd();
+      joint_acc_traj_[i] = traj_ptr->getAcc();
+    }
+    is_traj_inited_ = true;
+  }
+  /**
+   * @brief       轨迹跟随反馈值，不输出力矩时调用，恢复工作后从反馈值开始规划
+   */
+  void Gimbal::resetJointAngTraj()
+  {
+    for (size_t i = 0; i < kJointNum; i++)
+    {
+      if (traj_ptr_[i] != nullptr)
+      {
+        traj_ptr_[i]->reset(joint_ang_fdb_[i], joint_spd_fdb_[i]);
+      }
+      joint_ang_traj_[i] = joint_ang_fdb_[i];
+      joint_spd_traj_[i] = 0.0f;
+      joint_acc_traj_[i] = 0.0f;
+    }
+  }
   void Gimbal::calcJointTorRef()
   {
     JointIdx joint_idxs[kJointNum] = {kJointYaw, kJointPitch};
-    joint_tor_ffd_[kJointPitch] = calcJointFfdResistance(kJointPitch) +
-                                  cfg_.max_pitch_torq * arm_cos_f32(joint_ang_fdb_[kJointPitch] + cfg_.pitch_center_offset);
-    joint_tor_ffd_[kJointYaw] = calcJointFfdResistance(kJointYaw);
+    joint_tor_ffd_[kJointPitch] = calcJointFfdPitch();
+    joint_tor_ffd_[kJointYaw] = calcJointFfdResistance(kJointYaw, cfg_.resist_ffd_torq[kJointYaw]) + calcJointFfdSpin();
     for (uint8_t i = 0; i < kJointNum; i++)
     {
       JointIdx joint_idx = joint_idxs[i];
-      float ref[2] = {joint_ang_ref_[joint_idx], 0.0f};
-      float fdb[2] = {joint_ang_fdb_[joint_idx], imu_spd_fdb_[joint_idx]};
+      calcJointSpdRefTd(joint_idx);
+
+      JointCtrlType ctrl_type = cfg_.joint_ctrl_type[joint_idx];
       float ffd = joint_tor_ffd_[joint_idx];
-      Pid *pid_ptr = pid_ptr_[joint_idx];
-      HW_ASSERT(pid_ptr != nullptr, "pointer to PID %d is nullptr", joint_idx);
-      pid_ptr->calc(ref, fdb, &ffd, &joint_tor_ref_[joint_idx]);
+      if (ctrl_type == JointCtrlType::Adrc)
+      {
+        // 扰动前馈不进入观测器，轨迹加速度直接进入控制律，由 b0 折算为力矩
+        Adrc *adrc_ptr = adrc_ptr_[joint_idx];
+        HW_ASSERT(adrc_ptr != nullptr, "pointer to ADRC %d is nullptr", joint_idx);
+        if (last_joint_ctrl_type_[joint_idx] != ctrl_type)
+        {
+          adrc_ptr->reset();
+        }
+        float spd_ref = traj_ptr_[joint_idx] != nullptr ? joint_spd_traj_[joint_idx] : joint_spd_ref_td_[joint_idx];
+        joint_tor_ref_[joint_idx] = adrc_ptr->calc(joint_ang_traj_[joint_idx], spd_ref, joint_acc_traj_[joint_idx],
+                                                   joint_ang_fdb_[joint_idx], joint_spd_fdb_[joint_idx], ffd,
+                                                   interval_ticks_ * 0.001f);
+      }
+      else
+      {
+        // 轨迹加速度前馈
+        ffd += cfg_.joint_inertia[joint_idx] * joint_acc_traj_[joint_idx];
+        // 串级 PID 无法直接输入期望角速度，经速度环比例系数折算为力矩前馈
+        ffd += cfg_.traj_spd_ffd_gain[joint_idx] * joint_spd_traj_[joint_idx];
+        float ref[2] = {joint_ang_traj_[joint_idx], 0.0f};
+        float fdb[2] = {joint_ang_fdb_[joint_idx], joint_spd_fdb_[joint_idx]};
+        Pid *pid_ptr = pid_ptr_[joint_idx];
+        HW_ASSERT(pid_ptr != nullptr, "pointer to PID %d is nullptr", joint_idx);
+        if (last_joint_ctrl_type_[joint_idx] != ctrl_type)
+        {
+          pid_ptr->reset();
+        }
+        pid_ptr->calc(ref, fdb, &ffd, &joint_tor_ref_[joint_idx]);
+      }
+      last_joint_ctrl_type_[joint_idx] = ctrl_type;
     }
+    calcYawTorHeadroom();
   }
-  float Gimbal::calcJointFfdResistance(JointIdx idx)
+  /**
+   * @brief       使用 Td 对期望角度微分，得到自抗扰控制器的期望角速度
+   * @param        idx: 关节索引
+   * @note        Td 每个周期都更新以保持状态连续；转头、切换控制方式时期望角度跳变，期望角速度置 0
+   */
+  void Gimbal::calcJointSpdRefTd(JointIdx idx)
+  {
+    Td *td_ptr = ref_td_ptr_[idx];
+    if (td_ptr == nullptr)
+    {
+      joint_spd_ref_td_[idx] = 0.0f;
+      return;
+    }
+    float ang_ref = joint_ang_ref_[idx];
+    float spd_ref = 0.0f;
+    td_ptr->calc(&ang_ref, &spd_ref);
+    if (is_rotating_ || last_ctrl_ang_based_[idx] != ctrl_ang_based_[idx])
+    {
+      spd_ref = 0.0f;
+    }
+    joint_spd_ref_td_[idx] = spd_ref;
+  }
+  /**
+   * @brief       计算 yaw 电机的力矩占用率
+   * @note        快升慢降，小陀螺时的短时饱和也能被底盘感知到
+   */
+  void Gimbal::calcYawTorHeadroom()
+  {
+    float usage = hello_world::Bound(fabsf(joint_tor_ref_[kJointYaw]) / cfg_.yaw_max_torq, 0.0f, 1.0f);
+    float beta = usage > yaw_tor_usage_ ? cfg_.headroom_attack : cfg_.headroom_release;
+    yaw_tor_usage_ += beta * (usage - yaw_tor_usage_);
+  }
+  /**
+   * @brief       使用上一周期的力矩反馈更新 pitch 前馈参数辨识
+   * @note        转头过程中 yaw 加速度大，pitch 受到耦合力矩，不参与辨识
+   */
+  void Gimbal::updatePitchIdent()
   {
-    float err = joint_ang_ref_[idx] - joint_ang_fdb_[idx];
+    if (pitch_ident_ptr_ == nullptr || is_rotating_)
+    {
+      return;
+    }
+    Motor *motor_ptr = motor_ptr_[kJointPitch];
+    if (motor_ptr->isOffline())
+    {
+      return;
+    }
+    pitch_ident_ptr_->update(imu_ang_fdb_[kJointPitch], motor_spd_fdb_[kJointPitch], motor_ptr->torq(),
+                             interval_ticks_ * 0.001f);
+  }
+  /**
+   * @brief       计算 pitch 电机的重力与阻力前馈
+   * @retval      前馈力矩，单位 N·m
+   * @note        辨识结果可用时使用辨识得到的重力矩、库仑摩擦与粘滞摩擦，否则使用配置参数
+   */
+  float Gimbal::calcJointFfdPitch()
+  {
+    if (pitch_ident_ptr_ != nullptr && pitch_ident_ptr_->isValid())
+    {
+      return pitch_ident_ptr_->calcGravityTorq(imu_ang_fdb_[kJointPitch]) +
+             calcJointFfdResistance(kJointPitch, pitch_ident_ptr_->getCoulombTorq()) +
+             pitch_ident_ptr_->getViscCoef() * joint_spd_ref_[kJointPitch];
+    }
+    return calcJointFfdResistance(kJointPitch, cfg_.resist_ffd_torq[kJointPitch]) +
+           cfg_.max_pitch_torq * arm_cos_f32(joint_ang_fdb_[kJointPitch] + cfg_.pitch_center_offset);
+  }
+  float Gimbal::calcJointFfdResistance(JointIdx idx, float resist_torq)
+  {
+    float err = joint_ang_traj_[idx] - joint_ang_fdb_[idx];
     if (err > cfg_.allowed_ang_err[idx])
     {
-      return cfg_.resist_ffd_torq[idx];
+      return resist_torq;
     }
     else if (err < -cfg_.allowed_ang_err[idx])
     {
-      return -cfg_.resist_ffd_torq[idx];
+      return -resist_torq;
+    }
+    else
+    {
+      return err * resist_torq / cfg_.allowed_ang_err[idx];
+    }
+  }
+  /**
+   * @brief       计算底盘旋转引起的 yaw 电机阻力前馈
+   * @retval      前馈力矩，单位 N·m
+   * @note        云台保持世界系朝向时，yaw 电机相对底盘以 -w_chassis 转动，
+   *              粘滞摩擦、反电动势与库仑摩擦都与相对转速有关；
+   *              底盘角速度经 CAN 传输存在时延，按数据年龄与固定时延外推到力矩生效时刻
+   */
+  float Gimbal::calcJointFfdSpin()
+  {
+    float chassis_spd = 0.0f;
+    if (is_chassis_motion_valid_)
+    {
+      float latency = (work_tick_ - chassis_motion_tick_) * 0.001f + cfg_.spin_latency;
+      // 数据过旧时不再外推
+      latency = hello_world::Bound(latency, 0.0f, 0.05f);
+      chassis_spd = chassis_yaw_spd_ + chassis_yaw_acc_ * latency;
+      yaw_spin_spd_rel_ = joint_spd_ref_[kJointYaw] - chassis_spd;
     }
     else
     {
-      return err * cfg_.resist_ffd_torq[idx] / cfg_.allowed_ang_err[idx];
+      // 无底盘数据时，使用电机角度差分得到的相对转速
+      yaw_spin_spd_rel_ = motor_spd_fdb_[kJointYaw];
     }
+
+    float coulomb_ratio = hello_world::Bound(yaw_spin_spd_rel_ / cfg_.spin_coulomb_spd_band, -1.0f, 1.0f);
+    return cfg_.spin_visc_torq * yaw_spin_spd_rel_ + cfg_.spin_coulomb_torq * coulomb_ratio;
   }
 
 #pragma endregion
@@ -467,7 +773,15 @@ namespace robot
     memset(joint_ang_fdb_, 0, sizeof(joint_ang_fdb_));           ///< 云台关节角度反馈值
     memset(joint_spd_fdb_, 0, sizeof(joint_spd_fdb_));           ///< 云台关节速度反馈值
     memset(last_joint_ang_ref_, 0, sizeof(last_joint_ang_ref_)); ///< 上一次控制指令，基于关节空间
+    memset(joint_ang_ref_prev_, 0, sizeof(joint_ang_ref_prev_)); ///< 上一次输出的关节角度期望值
+    memset(joint_spd_ref_, 0, sizeof(joint_spd_ref_));           ///< 关节角度期望值的变化率
     memset(joint_tor_ref_, 0, sizeof(joint_tor_ref_));           ///< 控制指令，基于关节力矩
+    yaw_tor_usage_ = 0.0f;                                       ///< yaw 电机力矩占用率
+    is_traj_inited_ = false;                                     ///< 轨迹从反馈值重新开始
+    if (vis_tracker_ptr_ != nullptr)
+    {
+      vis_tracker_ptr_->reset();
+    }
 
     // 从电机中拿的数据
     is_any_motor_pwron_ = false; ///< 任意电机是否处于就绪状态
@@ -479,6 +793,13 @@ namespace robot
     // 从IMU中拿的数据
     memset(imu_ang_fdb_, 0, sizeof(imu_ang_fdb_)); ///< 云台关节角度反馈值【IMU】
     memset(imu_spd_fdb_, 0, sizeof(imu_spd_fdb_)); ///< 云台关节速度反馈值【IMU】
+    memset(fused_ang_fdb_, 0, sizeof(fused_ang_fdb_)); ///< 云台关节角度反馈值【融合】
+    memset(fused_spd_fdb_, 0, sizeof(fused_spd_fdb_)); ///< 云台关节速度反馈值【融合】
+
+    if (pitch_ident_ptr_ != nullptr)
+    {
+      pitch_ident_ptr_->reset();
+    }
 
     resetPids();
   };
@@ -495,7 +816,21 @@ namespace robot
     memset(joint_ang_fdb_, 0, sizeof(joint_ang_fdb_));           ///< 云台关节角度反馈值
     memset(joint_spd_fdb_, 0, sizeof(joint_spd_fdb_));           ///< 云台关节速度反馈值
     memset(last_joint_ang_ref_, 0, sizeof(last_joint_ang_ref_)); ///< 上一次控制指令，基于关节空间
+    memset(joint_ang_ref_prev_, 0, sizeof(joint_ang_ref_prev_)); ///< 上一次输出的关节角度期望值
+    memset(joint_spd_ref_, 0, sizeof(joint_spd_ref_));           ///< 关节角度期望值的变化率
     memset(joint_tor_ref_, 0, sizeof(joint_tor_ref_));           ///< 控制指令，基于关节力矩
+    yaw_tor_usage_ = 0.0f;                                       ///< yaw 电机力矩占用率
+    is_traj_inited_ = false;                                     ///< 轨迹从反馈值重新开始
+    if (vis_tracker_ptr_ != nullptr)
+    {
+      vis_tracker_ptr_->reset();
+    }
+
+    // 辨识结果保留，只停止扫描
+    if (pitch_ident_ptr_ != nullptr)
+    {
+      pitch_ident_ptr_->stopSweep();
+    }
 
     resetPids();
   }
@@ -512,7 +847,21 @@ namespace robot
     memset(joint_ang_fdb_, 0, sizeof(joint_ang_fdb_));           ///< 云台关节角度反馈值
     memset(joint_spd_fdb_, 0, sizeof(joint_spd_fdb_));           ///< 云台关节速度反馈值
     memset(last_joint_ang_ref_, 0, sizeof(last_joint_ang_ref_)); ///< 上一次控制指令，基于关节空间
+    memset(joint_ang_ref_prev_, 0, sizeof(joint_ang_ref_prev_)); ///< 上一次输出的关节角度期望值
+    memset(joint_spd_ref_, 0, sizeof(joint_spd_ref_));           ///< 关节角度期望值的变化率
     memset(joint_tor_ref_, 0, sizeof(joint_tor_ref_));           ///< 控制指令，基于关节力矩
+    yaw_tor_usage_ = 0.0f;                                       ///< yaw 电机力矩占用率
+    is_traj_inited_ = false;                                     ///< 轨迹从反馈值重新开始
+    if (vis_tracker_ptr_ != nullptr)
+    {
+      vis_tracker_ptr_->reset();
+    }
+
+    // 辨识结果保留，只停止扫描
+    if (pitch_ident_ptr_ != nullptr)
+    {
+      pitch_ident_ptr_->stopSweep();
+    }
 
     resetPids();
   }
@@ -523,6 +872,10 @@ namespace robot
     {
       HW_ASSERT(pid_ptr_[i] != nullptr, "pointer to PID %d is nullptr", i);
       pid_ptr_[i]->reset();
+      if (adrc_ptr_[i] != nullptr)
+      {
+        adrc_ptr_[i]->reset();
+      }
     }
   };
 #pragma endregion
@@ -551,6 +904,10 @@ namespace robot
       else
       {
         pid_ptr_[joint_idx]->reset();
+        if (adrc_ptr_[joint_idx] != nullptr)
+        {
+          adrc_ptr_[joint_idx]->reset();
+        }
         motor_ptr_[joint_idx]->disable();
       }
     }
@@ -559,6 +916,36 @@ namespace robot
 
 #pragma region 注册函数
 
+  /**
+   * @brief       设置底盘运动数据
+   * @param        spd_ref: 底盘期望偏航角速度，单位 rad/s
+   * @param        spd_fdb: 底盘当前偏航角速度，单位 rad/s
+   * @param        acc_ref: 底盘期望偏航角速度的变化率，单位 rad/s^2
+   * @param        seq: 底盘运动数据序号
+   * @param        is_valid: 底盘通讯是否在线
+   * @note        序号变化时记录接收时刻，用于计算数据年龄
+   */
+  void Gimbal::setChassisYawMotion(float spd_ref, float spd_fdb, float acc_ref, uint8_t seq, bool is_valid)
+  {
+    is_chassis_motion_valid_ = is_valid;
+    if (!is_valid)
+    {
+      chassis_yaw_spd_ = 0.0f;
+      chassis_yaw_spd_fdb_ = 0.0f;
+      chassis_yaw_acc_ = 0.0f;
+      return;
+    }
+    if (seq != chassis_motion_seq_)
+    {
+      float ref_weight = cfg_.spin_ref_weight;
+      chassis_yaw_spd_ = ref_weight * spd_ref + (1.0f - ref_weight) * spd_fdb;
+      chassis_yaw_acc_ = acc_ref;
+      chassis_yaw_spd_fdb_ = spd_fdb;
+      chassis_motion_seq_ = seq;
+      chassis_motion_tick_ = work_tick_;
+    }
+  };
+
   void Gimbal::registerMotor(Motor *ptr, JointIdx idx)
   {
     HW_ASSERT(ptr != nullptr, "pointer to motor %d is nullptr", idx);
@@ -576,6 +963,40 @@ namespace robot
     HW_ASSERT(ptr != nullptr, "pointer to imu is nullptr", ptr);
     imu_ptr_ = ptr;
   }
+  void Gimbal::registerAdrc(Adrc *ptr, JointIdx idx)
+  {
+    HW_ASSERT(ptr != nullptr, "pointer to ADRC %d is nullptr", idx);
+    HW_ASSERT(idx >= 0 && idx < kJointNum, "index of ADRC out of range", idx);
+    adrc_ptr_[idx] = ptr;
+  }
+  void Gimbal::registerVisionTracker(Tracker *ptr)
+  {
+    HW_ASSERT(ptr != nullptr, "pointer to VisionTracker is nullptr", ptr);
+    vis_tracker_ptr_ = ptr;
+  }
+  void Gimbal::registerFusion(Fusion *ptr, JointIdx idx)
+  {
+    HW_ASSERT(ptr != nullptr, "pointer to Fusion %d is nullptr", idx);
+    HW_ASSERT(idx >= 0 && idx < kJointNum, "index of Fusion out of range", idx);
+    fusion_ptr_[idx] = ptr;
+  }
+  void Gimbal::registerTraj(Traj *ptr, JointIdx idx)
+  {
+    HW_ASSERT(ptr != nullptr, "pointer to Traj %d is nullptr", idx);
+    HW_ASSERT(idx >= 0 && idx < kJointNum, "index of Traj out of range", idx);
+    traj_ptr_[idx] = ptr;
+  }
+  void Gimbal::registerRefTd(Td *ptr, JointIdx idx)
+  {
+    HW_ASSERT(ptr != nullptr, "pointer to Td is nullptr", ptr);
+    HW_ASSERT(idx >= 0 && idx < kJointNum, "index of Td out of range", idx);
+    ref_td_ptr_[idx] = ptr;
+  }
+  void Gimbal::registerPitchIdent(PitchIdent *ptr)
+  {
+    HW_ASSERT(ptr != nullptr, "pointer to PitchIdent is nullptr", ptr);
+    pitch_ident_ptr_ = ptr;
+  }
   void Gimbal::registerTd(Td *ptr, size_t idx)
   {
     HW_ASSERT(ptr != nullptr, "pointer to Td is nullptr", ptr);
@@ -0,0 +1,102 @@
+/**
+ *******************************************************************************
+ * @file      :heat_sched.cpp
+ * @brief     : 枪管热量预测与拨弹节奏调度
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "heat_sched.hpp"
+/* Private macro -------------------------------------------------------------*/
+
+namespace robot
+{
+/* Private constants ---------------------------------------------------------*/
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported function definitions ---------------------------------------------*/
+
+/**
+ * @brief       更新裁判系统热量数据
+ * @param        is_rfr_on: 裁判系统是否在线
+ * @param        heat: 裁判系统给出的当前热量
+ * @param        heat_limit: 热量上限
+ * @param        cooling_ps: 每秒冷却值
+ * @note        每个控制周期调用，热量值变化时视为收到新数据
+ */
+void HeatSched::updateRfrData(bool is_rfr_on, float heat, float heat_limit, float cooling_ps)
+{
+  is_valid_ = is_rfr_on && heat_limit > 0.0f && cooling_ps > 0.0f;
+  heat_limit_ = heat_limit;
+  cooling_ps_ = cooling_ps;
+  if (!is_valid_) {
+    return;
+  }
+
+  // 裁判系统数据滞后，只用于修正本地预测偏低的情况，偏高的部分随冷却自然消除
+  if (heat != last_rfr_heat_ && heat > heat_est_) {
+    heat_est_ = heat;
+  }
+  last_rfr_heat_ = heat;
+};
+
+/**
+ * @brief       预测热量并计算拨弹间隔
+ * @param        tick: 当前时间戳，单位 ms
+ * @param        is_high_value: 视觉是否给出高价值目标，是时释放保留热量
+ * @note        每个控制周期调用一次，须在 updateRfrData 与 onShot 之后调用
+ */
+void HeatSched::update(uint32_t tick, bool is_high_value)
+{
+  float dt = has_tick_ ? (tick - last_tick_) * 0.001f : 0.0f;
+  last_tick_ = tick;
+  has_tick_ = true;
+  if (!is_valid_) {
+    trigger_interval_ = params_.max_interval;
+    return;
+  }
+
+  heat_est_ -= cooling_ps_ * dt;
+  if (heat_est_ < 0.0f) {
+    heat_est_ = 0.0f;
+  }
+
+  float floor_blt = params_.safe_blt;
+  if (!is_high_value) {
+    floor_blt += params_.reserve_blt;
+  }
+  float headroom = heat_limit_ - heat_est_ - floor_blt * params_.heat_per_blt;
+
+  uint32_t interval = params_.min_interval;
+  if (headroom < 0.0f) {
+    // 已占用余量或保留热量，等待冷却
+    interval = params_.max_interval;
+  } else if (headroom < params_.heat_per_blt) {
+    // 每发热量等于拨弹间隔内的冷却量，热量保持不变
+    interval = (uint32_t)(params_.heat_per_blt / cooling_ps_ * 1000.0f);
+  }
+  if (interval < params_.min_interval) {
+    interval = params_.min_interval;
+  } else if (interval > params_.max_interval) {
+    interval = params_.max_interval;
+  }
+  trigger_interval_ = interval;
+};
+
+void HeatSched::reset()
+{
+  has_tick_ = false;
+  heat_est_ = 0.0f;
+  trigger_interval_ = params_.max_interval;
+};
+/* Private function definitions ----------------------------------------------*/
+}  // namespace robot
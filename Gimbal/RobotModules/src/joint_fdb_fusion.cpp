@@ -0,0 +1,86 @@
+/**
+ *******************************************************************************
+ * @file      :joint_fdb_fusion.cpp
+ * @brief     : 云台关节编码器与 IMU 互补融合
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "joint_fdb_fusion.hpp"
+
+#include <cmath>
+/* Private macro -------------------------------------------------------------*/
+
+namespace robot
+{
+/* Private constants ---------------------------------------------------------*/
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported function definitions ---------------------------------------------*/
+
+/**
+ * @brief       更新融合结果
+ * @param        motor_ang: 编码器角度，单位 rad
+ * @param        motor_spd: 编码器角速度，单位 rad/s
+ * @param        imu_ang: IMU 角度，单位 rad
+ * @param        imu_spd: IMU 角速度，单位 rad/s
+ * @param        base_spd: 基座角速度，单位 rad/s，使用前乘以刻度系数估计值
+ * @param        dt: 更新周期，单位 s
+ * @note        首次更新时偏差直接取 IMU 与编码器之差，融合结果与 IMU 一致，切换无跳变
+ */
+void JointFdbFusion::update(float motor_ang, float motor_spd, float imu_ang, float imu_spd, float base_spd,
+                            float dt)
+{
+  if (params_.scale_tau > 0.0f && dt > 0.0f && fabsf(base_spd) > params_.scale_min_spd) {
+    // 云台 IMU 角速度减去关节角速度即为基座角速度，与基座陀螺仪比较得到刻度系数
+    float k_scale = dt / (params_.scale_tau + dt);
+    scale_sxy_ += k_scale * ((imu_spd - motor_spd) * base_spd - scale_sxy_);
+    scale_sxx_ += k_scale * (base_spd * base_spd - scale_sxx_);
+    float scale = scale_sxy_ / scale_sxx_;
+    float scale_min = 1.0f - params_.scale_max_err, scale_max = 1.0f + params_.scale_max_err;
+    base_scale_ = scale < scale_min ? scale_min : (scale > scale_max ? scale_max : scale);
+  }
+  base_spd *= base_scale_;
+
+  if (!is_inited_) {
+    offset_ = wrap(imu_ang - motor_ang);
+    spd_resid_ = imu_spd - motor_spd - base_spd;
+    is_inited_ = true;
+  } else if (dt > 0.0f) {
+    float k_ang = dt / (params_.ang_tau + dt);
+    offset_ = wrap(offset_ + base_spd * dt);
+    offset_ = wrap(offset_ + k_ang * wrap(imu_ang - motor_ang - offset_));
+
+    float k_spd = dt / (params_.spd_tau + dt);
+    spd_resid_ += k_spd * (imu_spd - motor_spd - base_spd - spd_resid_);
+  }
+
+  ang_ = wrap(motor_ang + offset_);
+  spd_ = motor_spd + base_spd + spd_resid_;
+};
+/* Private function definitions ----------------------------------------------*/
+
+float JointFdbFusion::wrap(float ang) const
+{
+  float period = params_.period;
+  if (period <= 0.0f) {
+    return ang;
+  }
+  ang = fmodf(ang, period);
+  if (ang >= period * 0.5f) {
+    ang -= period;
+  } else if (ang < -period * 0.5f) {
+    ang += period;
+  }
+  return ang;
+};
+}  // namespace robot
@@ -0,0 +1,94 @@
+/**
+ *******************************************************************************
+ * @file      :ladrc.cpp
+ * @brief     : 云台关节线性自抗扰控制器
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "ladrc.hpp"
+
+#include <cmath>
+/* Private macro -------------------------------------------------------------*/
+
+namespace robot
+{
+/* Private constants ---------------------------------------------------------*/
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported function definitions ---------------------------------------------*/
+
+/**
+ * @brief       计算关节力矩
+ * @param        ang_ref: 期望角度，单位 rad
+ * @param        spd_ref: 期望角速度，单位 rad/s
+ * @param        acc_ref: 期望角加速度，单位 rad/s^2
+ * @param        ang_fdb: 角度反馈，单位 rad
+ * @param        spd_fdb: 角速度反馈，单位 rad/s
+ * @param        ffd: 已知扰动的力矩补偿，不进入观测器，单位 N·m
+ * @param        dt: 控制周期，单位 s
+ * @retval      关节力矩，单位 N·m
+ * @note        先用上一周期的力矩更新观测器，再计算本周期的力矩
+ */
+float Ladrc::calc(float ang_ref, float spd_ref, float acc_ref, float ang_fdb, float spd_fdb, float ffd, float dt)
+{
+  if (!is_inited_) {
+    z1_ = spd_fdb;
+    z2_ = 0.0f;
+    u_ = 0.0f;
+    u_fb_ = 0.0f;
+    is_inited_ = true;
+  }
+
+  float wo = params_.wo;
+  float e = spd_fdb - z1_;
+  z1_ += (z2_ + params_.b0 * u_fb_ + 2.0f * wo * e) * dt;
+  z2_ += wo * wo * e * dt;
+
+  float wc = params_.wc;
+  float u0 = acc_ref + wc * wc * calcAngErr(ang_ref, ang_fdb) + 2.0f * wc * (spd_ref - z1_);
+  float u = (u0 - z2_) / params_.b0 + ffd;
+  if (u > params_.out_max) {
+    u = params_.out_max;
+  } else if (u < -params_.out_max) {
+    u = -params_.out_max;
+  }
+  u_ = u;
+  u_fb_ = u - ffd;
+  return u_;
+};
+
+void Ladrc::reset()
+{
+  is_inited_ = false;
+  z1_ = 0.0f;
+  z2_ = 0.0f;
+  u_ = 0.0f;
+  u_fb_ = 0.0f;
+};
+/* Private function definitions ----------------------------------------------*/
+
+float Ladrc::calcAngErr(float ang_ref, float ang_fdb) const
+{
+  float err = ang_ref - ang_fdb;
+  float period = params_.period;
+  if (period > 0.0f) {
+    err = fmodf(err, period);
+    if (err > period * 0.5f) {
+      err -= period;
+    } else if (err < -period * 0.5f) {
+      err += period;
+    }
+  }
+  return err;
+};
+}  // namespace robot
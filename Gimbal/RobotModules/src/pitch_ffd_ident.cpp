@@ -0,0 +1,172 @@
+/**
+ *******************************************************************************
+ * @file      :pitch_ffd_ident.cpp
+ * @brief     : pitch 轴重力与摩擦前馈参数在线辨识
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "pitch_ffd_ident.hpp"
+
+#include <cmath>
+/* Private macro -------------------------------------------------------------*/
+
+namespace robot
+{
+/* Private constants ---------------------------------------------------------*/
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported function definitions ---------------------------------------------*/
+
+/**
+ * @brief       使用一组反馈数据更新参数估计
+ * @param        ang: 世界系俯仰角，单位 rad
+ * @param        spd: 电机转速，单位 rad/s
+ * @param        torq: 电机力矩反馈，单位 N·m
+ * @param        dt: 更新周期，单位 s
+ */
+void PitchFfdIdent::update(float ang, float spd, float torq, float dt)
+{
+  if (dt <= 0.0f) {
+    return;
+  }
+  float acc = is_spd_inited_ ? (spd - last_spd_) / dt : 0.0f;
+  last_spd_ = spd;
+  is_spd_inited_ = true;
+
+  if (fabsf(spd) < params_.spd_min || fabsf(acc) > params_.acc_max || fabsf(torq) > params_.tor_max) {
+    return;
+  }
+
+  float phi[kParamNum] = {cosf(ang), sinf(ang), spd > 0.0f ? 1.0f : -1.0f, spd};
+
+  // P * phi 与 phi' * P * phi
+  float p_phi[kParamNum] = {0.0f};
+  float denom = 0.0f;
+  for (size_t i = 0; i < kParamNum; i++) {
+    for (size_t j = 0; j < kParamNum; j++) {
+      p_phi[i] += p_[i][j] * phi[j];
+    }
+    denom += phi[i] * p_phi[i];
+  }
+
+  float trace = 0.0f;
+  for (size_t i = 0; i < kParamNum; i++) {
+    trace += p_[i][i];
+  }
+  float lambda = trace < params_.p_max_trace ? params_.lambda : 1.0f;
+  denom += lambda;
+
+  float err = torq;
+  for (size_t i = 0; i < kParamNum; i++) {
+    err -= phi[i] * theta_[i];
+  }
+
+  float gain[kParamNum];
+  for (size_t i = 0; i < kParamNum; i++) {
+    gain[i] = p_phi[i] / denom;
+    theta_[i] += gain[i] * err;
+  }
+  // P = (P - K * phi' * P) / lambda，P 对称，phi' * P = (P * phi)'，顺便保持对称
+  for (size_t i = 0; i < kParamNum; i++) {
+    for (size_t j = i; j < kParamNum; j++) {
+      float p_ij = (p_[i][j] - gain[i] * p_phi[j]) / lambda;
+      p_[i][j] = p_ij;
+      p_[j][i] = p_ij;
+    }
+  }
+
+  sample_num_++;
+  trace = 0.0f;
+  for (size_t i = 0; i < kParamNum; i++) {
+    trace += p_[i][i];
+  }
+  is_valid_ = sample_num_ >= params_.min_samples && trace < params_.valid_trace;
+};
+
+void PitchFfdIdent::reset()
+{
+  for (size_t i = 0; i < kParamNum; i++) {
+    theta_[i] = 0.0f;
+    for (size_t j = 0; j < kParamNum; j++) {
+      p_[i][j] = i == j ? params_.p0 : 0.0f;
+    }
+  }
+  sample_num_ = 0;
+  is_valid_ = false;
+  is_spd_inited_ = false;
+  last_spd_ = 0.0f;
+  is_sweeping_ = false;
+  sweep_half_cnt_ = 0;
+};
+
+/**
+ * @brief       开始扫描辨识
+ * @param        ang_start: 当前俯仰角，单位 rad
+ * @param        ang_min: 俯仰角下限，单位 rad
+ * @param        ang_max: 俯仰角上限，单位 rad
+ * @note        扫描期望角度与输入角度在同一坐标系下
+ */
+void PitchFfdIdent::startSweep(float ang_start, float ang_min, float ang_max)
+{
+  sweep_min_ = ang_min + params_.sweep_margin;
+  sweep_max_ = ang_max - params_.sweep_margin;
+  if (sweep_min_ >= sweep_max_ || params_.sweep_cycles == 0) {
+    return;
+  }
+  sweep_ref_ = ang_start < sweep_min_ ? sweep_min_ : (ang_start > sweep_max_ ? sweep_max_ : ang_start);
+  sweep_dir_ = 1.0f;
+  sweep_half_cnt_ = 0;
+  is_sweeping_ = true;
+};
+
+/**
+ * @brief       计算扫描期望角度
+ * @param        dt: 更新周期，单位 s
+ * @retval      扫描期望角度，单位 rad
+ * @note        每次往返的速度从 sweep_spd_min 线性增加到 sweep_spd_max，用于区分库仑摩擦与粘滞摩擦
+ */
+float PitchFfdIdent::calcSweepRef(float dt)
+{
+  if (!is_sweeping_) {
+    return sweep_ref_;
+  }
+  uint8_t cycle = sweep_half_cnt_ / 2;
+  float ratio = params_.sweep_cycles > 1 ? (float)cycle / (params_.sweep_cycles - 1) : 0.0f;
+  float spd = params_.sweep_spd_min + (params_.sweep_spd_max - params_.sweep_spd_min) * ratio;
+
+  sweep_ref_ += sweep_dir_ * spd * dt;
+  if (sweep_ref_ >= sweep_max_ && sweep_dir_ > 0.0f) {
+    sweep_ref_ = sweep_max_;
+    sweep_dir_ = -1.0f;
+    sweep_half_cnt_++;
+  } else if (sweep_ref_ <= sweep_min_ && sweep_dir_ < 0.0f) {
+    sweep_ref_ = sweep_min_;
+    sweep_dir_ = 1.0f;
+    sweep_half_cnt_++;
+  }
+  if (sweep_half_cnt_ >= 2 * params_.sweep_cycles) {
+    is_sweeping_ = false;
+  }
+  return sweep_ref_;
+};
+
+float PitchFfdIdent::calcGravityTorq(float ang) const
+{
+  return theta_[0] * cosf(ang) + theta_[1] * sinf(ang);
+};
+
+float PitchFfdIdent::getGravityAmp() const { return sqrtf(theta_[0] * theta_[0] + theta_[1] * theta_[1]); };
+
+float PitchFfdIdent::getGravityOffset() const { return atan2f(-theta_[1], theta_[0]); };
+/* Private function definitions ----------------------------------------------*/
+}  // namespace robot
@@ -0,0 +1,102 @@
+/**
+ *******************************************************************************
+ * @file      :pose_history.cpp
+ * @brief     : 带时间戳的云台位姿历史缓存
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "pose_history.hpp"
+
+#include <cmath>
+/* Private macro -------------------------------------------------------------*/
+
+namespace robot
+{
+/* Private constants ---------------------------------------------------------*/
+const float kPi = 3.14159265358979f;
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static float WrapPi(float ang)
+{
+  ang = fmodf(ang, 2.0f * kPi);
+  if (ang >= kPi) {
+    ang -= 2.0f * kPi;
+  } else if (ang < -kPi) {
+    ang += 2.0f * kPi;
+  }
+  return ang;
+}
+
+static float InterpAng(float ang0, float ang1, float k) { return WrapPi(ang0 + k * WrapPi(ang1 - ang0)); }
+/* Exported function definitions ---------------------------------------------*/
+
+/**
+ * @brief       记录一帧位姿
+ * @param        time_us: 位姿对应的 MCU 时间，单位 us
+ * @param        pose: 位姿
+ * @note        时间戳须单调递增，不递增时丢弃该帧
+ */
+void PoseHistory::push(uint32_t time_us, const Pose &pose)
+{
+  if (cnt_ > 0 && (int32_t)(time_us - stampAt(0)) <= 0) {
+    return;
+  }
+  stamp_[head_] = time_us;
+  pose_[head_] = pose;
+  head_ = (head_ + 1) % kLen;
+  if (cnt_ < kLen) {
+    cnt_++;
+  }
+};
+
+/**
+ * @brief       查询指定时刻的位姿
+ * @param        time_us: 查询的 MCU 时间，单位 us
+ * @param        pose: 查询结果
+ * @retval       查询成功返回 true，否则返回 false
+ * @note        由新到旧查找，视觉时延通常只有几十个周期
+ */
+bool PoseHistory::lookup(uint32_t time_us, Pose *pose) const
+{
+  if (pose == nullptr || cnt_ == 0) {
+    return false;
+  }
+
+  int32_t dt_newest = (int32_t)(time_us - stampAt(0));
+  if (dt_newest >= 0) {
+    if ((uint32_t)dt_newest > params_.max_extrap) {
+      return false;
+    }
+    *pose = at(0);
+    return true;
+  }
+
+  for (size_t age = 1; age < cnt_; age++) {
+    int32_t dt = (int32_t)(time_us - stampAt(age));
+    if (dt < 0) {
+      continue;
+    }
+    // time_us 位于 [age, age - 1) 之间
+    uint32_t span = stampAt(age - 1) - stampAt(age);
+    float k = (float)dt / (float)span;
+    const Pose &p0 = at(age);
+    const Pose &p1 = at(age - 1);
+    pose->roll = InterpAng(p0.roll, p1.roll, k);
+    pose->pitch = p0.pitch + k * (p1.pitch - p0.pitch);
+    pose->yaw = InterpAng(p0.yaw, p1.yaw, k);
+    return true;
+  }
+  return false;
+};
+/* Private function definitions ----------------------------------------------*/
+}  // namespace robot
@@ -16,11 +16,13 @@
 #include "robot.hpp"
 #include "can.h"
 #include "rfr_pkg/rfr_id.hpp"
+#include "sys_time.hpp"
 /* Private macro -------------------------------------------------------------*/
 
 namespace robot
 {
   /* Private constants ---------------------------------------------------------*/
+  const float kDefaultBltSpd = 23.7f;  ///< 裁判系统弹速无效时发给视觉的弹速，单位 m/s
   /* Private types -------------------------------------------------------------*/
   /* Private variables ---------------------------------------------------------*/
   /* External variables --------------------------------------------------------*/
@@ -66,15 +68,41 @@ namespace robot
     if (referee_data.is_new_bullet_shot != last_is_new_bullet_shot_){
       feed_rfr_input_data.is_new_bullet_shot = true;
       fric_rfr_input_data.is_new_bullet_shot = true;
+      if (vision_link_ptr_ != nullptr) {
+        vision_link_ptr_->addBulletSpd(referee_data.bullet_speed);
+      }
+      if (shot_detector_ptr_ != nullptr) {
+        shot_detector_ptr_->onRfrShot(work_tick_, referee_data.bullet_speed);
+      }
     } else {
       feed_rfr_input_data.is_new_bullet_shot = false;
       fric_rfr_input_data.is_new_bullet_shot = false;
     }
     last_is_new_bullet_shot_ = referee_data.is_new_bullet_shot;
+    if (shot_detector_ptr_ != nullptr)
+    {
+      // 拨盘与热量预测使用本地检测到的发弹，摩擦轮的弹速闭环仍使用裁判系统的发弹与弹速
+      feed_rfr_input_data.is_new_bullet_shot = shot_detector_ptr_->fetchShot();
+    }
     feed_rfr_input_data.heat_limit = referee_data.shooter_heat_limit;
     feed_rfr_input_data.heat = referee_data.shooter_heat;
     feed_rfr_input_data.heat_cooling_ps = referee_data.shooter_cooling;
     feed_ptr_->updateRfrData(feed_rfr_input_data);
+
+    if (heat_sched_ptr_ != nullptr)
+    {
+      heat_sched_ptr_->updateRfrData(referee_data.is_rfr_on, referee_data.shooter_heat,
+                                     referee_data.shooter_heat_limit, referee_data.shooter_cooling);
+      if (feed_rfr_input_data.is_new_bullet_shot)
+      {
+        heat_sched_ptr_->onShot();
+      }
+      heat_sched_ptr_->update(work_tick_, isVisionTargetHighValue());
+    }
+    if (fric_shot_ffd_ptr_ != nullptr && feed_rfr_input_data.is_new_bullet_shot)
+    {
+      fric_shot_ffd_ptr_->onShotConfirmed();
+    }
     
     fric_rfr_input_data.bullet_spd = referee_data.bullet_speed;
     fric_rfr_input_data.is_power_on = referee_data.is_rfr_shooter_power_on;
@@ -85,23 +113,95 @@ namespace robot
 
   void Robot::updateVisionData()
   {
-    if (vision_ptr_->isOffline())
+    HW_ASSERT(vision_link_ptr_ != nullptr, "VisionLink pointer is null", vision_link_ptr_);
+    if (vision_link_ptr_->isOffline())
     {
       gimbal_ptr_->setVisionTargetDetected(false);
       feed_ptr_->setVisionShootFlag(Vision::ShootFlag::kNoShoot);
+      if (fire_ctrl_ptr_ != nullptr)
+      {
+        fire_ctrl_ptr_->reset();
+      }
       return;
     }
     if (gimbal_ptr_->getCtrlMode() == CtrlMode::Auto && feed_ptr_->getCtrlMode() == hello_world::module::CtrlMode::kManual)
     {
-      gimbal_ptr_->setVisionTargetDetected(vision_ptr_->getIsEnemyDetected());
+      gimbal_ptr_->setVisionTargetDetected(isVisionTargetDetected());
     }
     else if (gimbal_ptr_->getCtrlMode() == CtrlMode::Auto && feed_ptr_->getCtrlMode() == hello_world::module::CtrlMode::kAuto)
     {
-      feed_ptr_->setVisionShootFlag(vision_ptr_->getShootFlag());
-      gimbal_ptr_->setVisionTargetDetected(vision_ptr_->getIsEnemyDetected());
+      feed_ptr_->setVisionShootFlag(gateVisionShootFlag(getVisionShootFlag()));
+      gimbal_ptr_->setVisionTargetDetected(isVisionTargetDetected());
     }
   }
 
+  bool Robot::isVisionTargetDetected()
+  {
+    return !vision_link_ptr_->isOffline() && vision_link_ptr_->isTargetDetected();
+  };
+
+  bool Robot::isVisionTargetInView()
+  {
+    return !vision_link_ptr_->isOffline() && vision_link_ptr_->isTargetInView();
+  };
+
+  /**
+   * @brief       视觉是否给出高价值目标，用于释放保留的热量连发
+   */
+  bool Robot::isVisionTargetHighValue()
+  {
+    return !vision_link_ptr_->isOffline() && vision_link_ptr_->isTargetHighValue();
+  };
+
+  Robot::ShootFlag Robot::getVisionShootFlag()
+  {
+    if (vision_link_ptr_->isOffline())
+    {
+      return ShootFlag::kNoShoot;
+    }
+    return static_cast<ShootFlag>(vision_link_ptr_->getShootFlag());
+  };
+
+  /**
+   * @brief       在视觉允许射击的窗口内，由射击决策选择拨弹时机
+   * @param        flag: 视觉的射击指令
+   * @retval       当前周期的射击指令
+   * @note        未注册射击决策或处于打符模式时直接使用视觉的射击指令
+   */
+  Robot::ShootFlag Robot::gateVisionShootFlag(ShootFlag flag)
+  {
+    if (fire_ctrl_ptr_ == nullptr || gimbal_ptr_->getBuffMode() != 0)
+    {
+      return flag;
+    }
+
+    FireCtrl::Input input;
+    input.is_permitted = flag != ShootFlag::kNoShoot;
+    const Gimbal::Cmd &vis_ref = gimbal_ptr_->getVisionRef();
+    input.aim_err[FireCtrl::kAxisYaw] = hello_world::AngleNormRad(vis_ref.yaw - gimbal_ptr_->getJointYawAngFdb());
+    input.aim_err[FireCtrl::kAxisPitch] = vis_ref.pitch - gimbal_ptr_->getJointPitchAngFdb();
+    input.err_spd[FireCtrl::kAxisYaw] = gimbal_ptr_->getVisionRefSpd(Gimbal::kJointYaw) - gimbal_ptr_->getJointYawSpdFdb();
+    input.err_spd[FireCtrl::kAxisPitch] = gimbal_ptr_->getVisionRefSpd(Gimbal::kJointPitch) - gimbal_ptr_->getJointPitchSpdFdb();
+
+    VisionLink::Target target;
+    uint32_t capture_us = 0;
+    if (!vision_link_ptr_->isOffline() && vision_link_ptr_->getTarget(&target, &capture_us))
+    {
+      input.dist = target.dist;
+    }
+    input.blt_spd = gc_comm_ptr_->referee_data().cp.bullet_speed;
+    if (shot_detector_ptr_ != nullptr && shot_detector_ptr_->isCalibrated())
+    {
+      input.blt_spd = shot_detector_ptr_->getBltSpd();
+    }
+
+    if (!fire_ctrl_ptr_->update(work_tick_, input))
+    {
+      return ShootFlag::kNoShoot;
+    }
+    return flag;
+  };
+
   void Robot::updatePwrState()
   {
     PwrState pre_state = pwr_state_;
@@ -152,6 +252,7 @@ namespace robot
     {
       runOnDead();
     }
+    recordPose();
     setCommData();
     sendCommData();
   };
@@ -182,12 +283,15 @@ namespace robot
     HW_ASSERT(fric_ptr_ != nullptr, "Fric FSM pointer is null", fric_ptr_);
     fric_ptr_->update();
     fric_ptr_->run();
+    detectShot();
+    runFricShotFfd();
 
     transmitFricStatus();
 
     HW_ASSERT(feed_ptr_ != nullptr, "Feed FSM pointer is null", feed_ptr_);
     feed_ptr_->update();
     feed_ptr_->run();
+    runFeedProfile();
   };
 
   void Robot::standby()
@@ -204,6 +308,18 @@ namespace robot
     HW_ASSERT(feed_ptr_ != nullptr, "Feed FSM pointer is null", feed_ptr_);
     feed_ptr_->update();
     feed_ptr_->standby();
+    if (feed_profile_ptr_ != nullptr)
+    {
+      feed_profile_ptr_->reset();
+    }
+    if (fric_shot_ffd_ptr_ != nullptr)
+    {
+      fric_shot_ffd_ptr_->reset();
+    }
+    if (shot_detector_ptr_ != nullptr)
+    {
+      shot_detector_ptr_->reset();
+    }
   }
 
   uint32_t mode_cnt[3] = {0};
@@ -218,8 +334,10 @@ namespace robot
 
     // gimbal
     CtrlMode gimbal_ctrl_mode = gimbal_data.ctrl_mode;
+    float vis_yaw = 0.0f, vis_pitch = 0.0f, vis_latency = -1.0f;
     if (gimbal_ctrl_mode == CtrlMode::Auto) {
-      if (!(vision_ptr_->isDetectedInView()) || !(vision_ptr_->getIsEnemyDetected())) {
+      // 时间戳目标无法还原（失步或拍摄时刻已不在位姿缓存中）时按手动控制
+      if (!isVisionTargetInView() || !calcStampedVisionCmd(vis_yaw, vis_pitch, vis_latency)) {
         gimbal_ctrl_mode = CtrlMode::Manual;
       }
     }
@@ -237,10 +355,13 @@ namespace robot
     {
       laser_ptr_->disable();
       gimbal_ptr_->setCtrlMode(CtrlMode::Auto);
-      gimbal_ptr_->setVisionCmd(vision_ptr_->getPoseRefYaw(), vision_ptr_->getPoseRefPitch());
+      gimbal_ptr_->setVisionCmd(vis_yaw, vis_pitch, vis_latency);
       // gimbal_ptr_->setNormCmdDelta(gimbal_data.yaw_delta, gimbal_data.pitch_delta);
     }
     gimbal_ptr_->setWorkingMode(gimbal_data.working_mode);
+    gimbal_ptr_->setChassisYawMotion(gimbal_data.chassis_yaw_spd_ref, gimbal_data.chassis_yaw_spd_fdb,
+                                     gimbal_data.chassis_yaw_acc_ref, gimbal_data.chassis_motion_seq,
+                                     !gc_comm_ptr_->isOffline());
 
     feed_ptr_->setManualShootFlag(shooter_data.shoot_flag(true));
 
@@ -266,6 +387,10 @@ namespace robot
     {
       feed_ptr_->setTriggerLimit(true, true, 3, 500);
     }
+    else if (heat_sched_ptr_ != nullptr && heat_sched_ptr_->isValid())
+    {
+      feed_ptr_->setTriggerLimit(true, true, heat_sched_ptr_->getSafeNumBlt(), heat_sched_ptr_->getTriggerInterval());
+    }
     else
     {
       feed_ptr_->setTriggerLimit(true, true, 3, 50);
@@ -273,10 +398,147 @@ namespace robot
      
   };
 
+  /**
+   * @brief       由带拍摄时间戳的视觉目标数据计算视觉指令
+   * @param        yaw: 世界系目标 yaw，单位 rad，计算失败时保持原值
+   * @param        pitch: 世界系目标 pitch，单位 rad，计算失败时保持原值
+   * @param        latency: 拍摄时刻到当前时刻的时延，单位 s，计算失败时保持原值
+   * @retval       计算成功返回 true
+   * @note        目标方向为相对拍摄时刻云台位姿的方向，叠加按拍摄时刻查询插值得到的云台位姿，
+   *              未同步、目标丢失或拍摄时刻超出位姿缓存范围时返回 false，由调用方按手动控制
+   */
+  bool Robot::calcStampedVisionCmd(float &yaw, float &pitch, float &latency) const
+  {
+    if (vision_link_ptr_ == nullptr || pose_history_ptr_ == nullptr)
+    {
+      return false;
+    }
+    VisionLink::Target target;
+    uint32_t capture_us = 0;
+    if (!vision_link_ptr_->getTarget(&target, &capture_us) || !target.is_detected)
+    {
+      return false;
+    }
+    PoseHistory::Pose pose;
+    if (!pose_history_ptr_->lookup(capture_us, &pose))
+    {
+      return false;
+    }
+    yaw = hello_world::AngleNormRad(pose.yaw + target.yaw);
+    pitch = pose.pitch + target.pitch;
+    latency = (int32_t)(GetSysTimeUs() - capture_us) * 1e-6f;
+    return true;
+  };
+
+  /**
+   * @brief       记录当前云台位姿，每个控制周期调用一次
+   */
+  void Robot::recordPose()
+  {
+    if (pose_history_ptr_ == nullptr)
+    {
+      return;
+    }
+    PoseHistory::Pose pose;
+    pose.roll = gimbal_ptr_->getJointRollAngFdb();
+    pose.pitch = gimbal_ptr_->getJointPitchAngFdb();
+    pose.yaw = gimbal_ptr_->getJointYawAngFdb();
+    uint32_t time_us = GetSysTimeUs();
+    pose_history_ptr_->push(time_us, pose);
+    if (vision_link_ptr_ != nullptr)
+    {
+      vision_link_ptr_->addPose(time_us, pose.roll, pose.pitch, pose.yaw);
+    }
+  };
+
   void Robot::transmitFricStatus()
   {
     feed_ptr_->setFricStatus(fric_ptr_->getStatus());
   };
+
+  /**
+   * @brief       由摩擦轮电机反馈在本地检测发弹
+   * @note        检测到的发弹在下一周期的 updateGimbalChassisCommData 中交给拨盘与热量预测
+   */
+  void Robot::detectShot()
+  {
+    if (shot_detector_ptr_ == nullptr)
+    {
+      return;
+    }
+    float spd[2], curr[2];
+    for (size_t i = 0; i < 2; i++)
+    {
+      HW_ASSERT(fric_motor_ptr_[i] != nullptr, "Motor pointer is null", fric_motor_ptr_[i]);
+      spd[i] = fric_motor_ptr_[i]->vel();
+      curr[i] = fric_motor_ptr_[i]->curr();
+    }
+    shot_detector_ptr_->update(work_tick_, spd, curr);
+  };
+
+  int8_t debug_fric_shot_capture = -1;   ///< 置 1 开始实测单发后摩擦轮的电流响应（停止补偿），置 0 停止实测，执行后复位为 -1
+  float debug_fric_shot_shape[FricShotFfd::kCaptureLen] = {0.0f};  ///< 实测的电流响应，按峰值归一化
+  size_t debug_fric_shot_peak = 0;       ///< 实测电流响应的峰值所在周期
+  uint32_t debug_fric_shot_cnt = 0;      ///< 实测已累加的发数
+  /**
+   * @brief       弹丸经过摩擦轮期间以前馈脉冲接管摩擦轮电机输入
+   * @note        须在 Fric 计算之后调用，覆盖 Fric 写入电机的输入
+   */
+  void Robot::runFricShotFfd()
+  {
+    if (fric_shot_ffd_ptr_ == nullptr)
+    {
+      return;
+    }
+    // 实测期间在调试器中读取 debug_fric_shot_shape，截取后填入 ins_fric.cpp 的 kFricShotShape
+    if (debug_fric_shot_capture >= 0)
+    {
+      fric_shot_ffd_ptr_->setCapture(debug_fric_shot_capture > 0);
+      debug_fric_shot_capture = -1;
+    }
+    if (fric_shot_ffd_ptr_->isCapturing() && fric_shot_ffd_ptr_->getCaptureCnt() != debug_fric_shot_cnt)
+    {
+      debug_fric_shot_cnt = fric_shot_ffd_ptr_->getCaptureCnt();
+      debug_fric_shot_peak = fric_shot_ffd_ptr_->getCapture(debug_fric_shot_shape);
+    }
+    float spd[2], curr[2];
+    for (size_t i = 0; i < 2; i++)
+    {
+      HW_ASSERT(fric_motor_ptr_[i] != nullptr, "Motor pointer is null", fric_motor_ptr_[i]);
+      spd[i] = fric_motor_ptr_[i]->vel();
+      curr[i] = fric_motor_ptr_[i]->curr();
+    }
+    if (fric_shot_ffd_ptr_->update(work_tick_, spd, curr))
+    {
+      fric_motor_ptr_[0]->setInput(fric_shot_ffd_ptr_->getInput(FricShotFfd::kFricFirst));
+      fric_motor_ptr_[1]->setInput(fric_shot_ffd_ptr_->getInput(FricShotFfd::kFricSecond));
+    }
+  };
+
+  /**
+   * @brief       Feed 开始拨弹后按拨弹轨迹接管拨盘电机电流
+   * @note        须在 Feed 计算之后调用，覆盖 Feed 写入电机的电流期望值
+   */
+  void Robot::runFeedProfile()
+  {
+    if (feed_profile_ptr_ == nullptr)
+    {
+      return;
+    }
+    HW_ASSERT(feed_motor_ptr_ != nullptr, "Motor pointer is null", feed_motor_ptr_);
+    // Feed 本周期已计算，角度环的期望角度即 Feed 当前要拨到的位置，速度环的输出即 Feed 的电流期望值
+    float feed_ang_ref = feed_pid_ptr_->getDatasAt(0).ref;
+    float feed_curr_ref = feed_pid_ptr_->getDatasAt(1).out;
+    if (feed_profile_ptr_->update(work_tick_, feed_motor_ptr_->angle(), feed_motor_ptr_->vel(), feed_motor_ptr_->curr(),
+                                  feed_ang_ref, feed_curr_ref))
+    {
+      feed_motor_ptr_->setInput(feed_profile_ptr_->getCurrRef());
+    }
+    if (fric_shot_ffd_ptr_ != nullptr && feed_profile_ptr_->isStepStarted())
+    {
+      fric_shot_ffd_ptr_->trigger(work_tick_);
+    }
+  };
 #pragma endregion
 
 #pragma region 数据重置函数
@@ -309,7 +571,7 @@ namespace robot
 
   void Robot::setVisionCommData()
   {
-    HW_ASSERT(vision_ptr_ != nullptr, "Vision pointer is null", vision_ptr_);
+    HW_ASSERT(vision_link_ptr_ != nullptr, "VisionLink pointer is null", vision_link_ptr_);
     HW_ASSERT(gimbal_ptr_ != nullptr, "Gimbal pointer is null", gimbal_ptr_);
 
     Vision::WorkState vision_work_State = Vision::WorkState::kStandby;
@@ -327,34 +589,31 @@ namespace robot
     }
 
     GimbalChassisComm::RefereeData::ChassisPart &referee_data = gc_comm_ptr_->referee_data().cp;
+    float blt_spd = referee_data.bullet_speed;
     if (referee_data.bullet_speed < 15)
     {
-      vision_ptr_->setBulletSpeed(vision_ptr_->getDefaultBulletSpeed());
-    }
-    else
-    {
-      vision_ptr_->setBulletSpeed(referee_data.bullet_speed);
+      blt_spd = kDefaultBltSpd;
     }
 
     hello_world::referee::ids::RobotId robot_id = gc_comm_ptr_->referee_data().cp.robot_id;
     hello_world::referee::RfrId rfr_id = static_cast<hello_world::referee::RfrId>(robot_id);
 
+    Vision::TargetColor target_color = Vision::TargetColor::kPurple;
     if (hello_world::referee::ids::GetTeamColor(rfr_id) == hello_world::referee::ids::TeamColor::kRed)
     {
-      vision_ptr_->setTargetColor(Vision::TargetColor::kBlue);
+      target_color = Vision::TargetColor::kBlue;
     }
     else if (hello_world::referee::ids::GetTeamColor(rfr_id) == hello_world::referee::ids::TeamColor::kBlue)
     {
-      vision_ptr_->setTargetColor(Vision::TargetColor::kRed);
-    }
-    else
-    {
-      vision_ptr_->setTargetColor(Vision::TargetColor::kPurple);
+      target_color = Vision::TargetColor::kRed;
     }
 
-    vision_ptr_->setPose(gimbal_ptr_->getJointRollAngFdb(), gimbal_ptr_->getJointPitchAngFdb(), gimbal_ptr_->getJointYawAngFdb());
-
-    vision_ptr_->setWorkState(vision_work_State);
+    // 云台位姿由 recordPose 每周期加入 VisionLink 的位姿序列
+    VisionLink::Status link_status;
+    link_status.work_state = static_cast<uint8_t>(vision_work_State);
+    link_status.target_color = static_cast<uint8_t>(target_color);
+    link_status.blt_spd = blt_spd;
+    vision_link_ptr_->setStatus(link_status);
   }
 
   void Robot::setGimbalChassisCommData()
@@ -371,14 +630,23 @@ namespace robot
 
     // gimbal
     GimbalChassisComm::GimbalData::GimbalPart &gimbal_data = gc_comm_ptr_->gimbal_data().gp;
-    gc_comm_ptr_->vision_data().gp.is_enemy_detected = vision_ptr_->getIsEnemyDetected();
-    gc_comm_ptr_->vision_data().gp.vtm_x = vision_ptr_->getVtmX();
-    gc_comm_ptr_->vision_data().gp.vtm_y = vision_ptr_->getVtmY();
+    VisionLink::Target vis_target = vision_link_ptr_->getLatestTarget();
+    gc_comm_ptr_->vision_data().gp.is_enemy_detected = isVisionTargetDetected();
+    gc_comm_ptr_->vision_data().gp.vtm_x = vis_target.vtm_x;
+    gc_comm_ptr_->vision_data().gp.vtm_y = vis_target.vtm_y;
     // gc_comm_ptr_->gimbal_data().gp.pitch_fdb = gimbal_ptr_->getJointPitchAngFdb();
     gc_comm_ptr_->gimbal_data().gp.pitch_fdb = gimbal_ptr_->getJointPitchAngFdb();
+    // 底盘跟随前馈所需的云台偏航运动数据
+    gimbal_data.yaw_spd_fdb = gimbal_ptr_->getJointYawSpdFdb();
+    gimbal_data.yaw_spd_ref = gimbal_ptr_->getJointYawSpdRef();
+    gimbal_data.yaw_tor_headroom = gimbal_ptr_->getYawTorHeadroom();
 
     // shooter
     GimbalChassisComm::ShooterData::GimbalPart &shooter_data = gc_comm_ptr_->shooter_data().gp;
+    if (feed_profile_ptr_ != nullptr)
+    {
+      shooter_data.feed_stuck_state = feed_profile_ptr_->isJammed() ? 1 : 0;
+    }
 
     //vision
 
@@ -424,14 +692,19 @@ namespace robot
   };
   void Robot::sendUsartData()
   {
+    // 每帧打包期间记录的位姿，同步请求由 VisionLink 按帧数附带
     if (work_tick_ % 5 == 0)
     {
-      sendVisionData();
+      sendVisionLinkData();
     }
   };
-  void Robot::sendVisionData()
+  void Robot::sendVisionLinkData()
   {
-    vision_ptr_->setNeedToTransmit();
+    if (vision_link_ptr_ == nullptr)
+    {
+      return;
+    }
+    vision_link_ptr_->setNeedToTransmit();
   };
 #pragma endregion
 
@@ -486,11 +759,6 @@ namespace robot
     gc_comm_ptr_ = dev_ptr;
   };
 
-  void Robot::registerVision(Vision *dev_ptr)
-  {
-    HW_ASSERT(dev_ptr != nullptr, "pointer to Vision is nullptr", dev_ptr);
-    vision_ptr_ = dev_ptr;
-  };
   void Robot::registerLaser(Laser *ptr)
   {
     HW_ASSERT(ptr != nullptr, "pointer to laser is nullptr", ptr);
@@ -499,6 +767,43 @@ namespace robot
     }
     laser_ptr_ = ptr;
   }
+  void Robot::registerPoseHistory(PoseHistory *ptr)
+  {
+    HW_ASSERT(ptr != nullptr, "pointer to PoseHistory is nullptr", ptr);
+    pose_history_ptr_ = ptr;
+  };
+  void Robot::registerFireCtrl(FireCtrl *ptr)
+  {
+    HW_ASSERT(ptr != nullptr, "pointer to FireCtrl is nullptr", ptr);
+    fire_ctrl_ptr_ = ptr;
+  };
+  void Robot::registerHeatSched(HeatSched *ptr)
+  {
+    HW_ASSERT(ptr != nullptr, "pointer to HeatSched is nullptr", ptr);
+    heat_sched_ptr_ = ptr;
+  };
+  void Robot::registerFeedProfile(FeedProfile *ptr, Pid *feed_pid_ptr)
+  {
+    HW_ASSERT(ptr != nullptr, "pointer to FeedProfile is nullptr", ptr);
+    HW_ASSERT(feed_pid_ptr != nullptr, "pointer to Feed PID is nullptr", feed_pid_ptr);
+    feed_profile_ptr_ = ptr;
+    feed_pid_ptr_ = feed_pid_ptr;
+  };
+  void Robot::registerFricShotFfd(FricShotFfd *ptr)
+  {
+    HW_ASSERT(ptr != nullptr, "pointer to FricShotFfd is nullptr", ptr);
+    fric_shot_ffd_ptr_ = ptr;
+  };
+  void Robot::registerShotDetector(ShotDetector *ptr)
+  {
+    HW_ASSERT(ptr != nullptr, "pointer to ShotDetector is nullptr", ptr);
+    shot_detector_ptr_ = ptr;
+  };
+  void Robot::registerVisionLink(VisionLink *dev_ptr)
+  {
+    HW_ASSERT(dev_ptr != nullptr, "pointer to VisionLink is nullptr", dev_ptr);
+    vision_link_ptr_ = dev_ptr;
+  };
 
 #pragma endregion
   /* Private function definitions ----------------------------------------------*/
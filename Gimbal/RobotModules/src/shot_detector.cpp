@@ -0,0 +1,239 @@
+/**
+ *******************************************************************************
+ * @file      :shot_detector.cpp
+ * @brief     : 由摩擦轮动态在本地检测发弹，并与裁判系统发弹数据互相校核
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "shot_detector.hpp"
+
+#include <cmath>
+/* Private macro -------------------------------------------------------------*/
+
+namespace robot
+{
+/* Private constants ---------------------------------------------------------*/
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported function definitions ---------------------------------------------*/
+
+ShotDetector::ShotDetector(const Params &params) : params_(params)
+{
+  if (params_.window > kMaxWindow) {
+    params_.window = kMaxWindow;
+  } else if (params_.window == 0) {
+    params_.window = 1;
+  }
+  spd_ratio_ = params_.spd_ratio_init;
+};
+
+/**
+ * @brief       由摩擦轮反馈检测发弹
+ * @param        tick: 当前时间戳，单位 ms
+ * @param        spd: 摩擦轮电机转速反馈，单位 rad/s
+ * @param        curr: 摩擦轮电机电流反馈，单位 A
+ * @retval       本周期检测到发弹时返回 true
+ * @note        每个控制周期调用一次
+ */
+bool ShotDetector::update(uint32_t tick, const float spd[kFricNum], const float curr[kFricNum])
+{
+  expirePending(tick);
+
+  for (size_t i = 0; i < kFricNum; i++) {
+    if (fabsf(spd[i]) < params_.min_spd) {
+      has_base_ = false;
+      return false;
+    }
+  }
+
+  float w[kFricNum], c[kFricNum];
+  for (size_t i = 0; i < kFricNum; i++) {
+    float dir = spd[i] >= 0.0f ? 1.0f : -1.0f;
+    w[i] = dir * spd[i];
+    c[i] = dir * curr[i];
+  }
+
+  if (!has_base_) {
+    has_base_ = true;
+    last_tick_ = tick;
+    win_idx_ = 0;
+    win_num_ = 0;
+    for (size_t i = 0; i < kFricNum; i++) {
+      last_spd_[i] = w[i];
+      base_spd_[i] = w[i];
+      base_load_[i] = c[i];
+    }
+    return false;
+  }
+  if (tick == last_tick_) {
+    return false;
+  }
+  float dt = (tick - last_tick_) * 0.001f;
+  last_tick_ = tick;
+
+  float load[kFricNum], imp_min = 0.0f;
+  for (size_t i = 0; i < kFricNum; i++) {
+    load[i] = c[i] - params_.inertia_per_kt * (w[i] - last_spd_[i]) / dt;
+    last_spd_[i] = w[i];
+    load_[i][win_idx_] = (load[i] - base_load_[i]) * dt;
+  }
+  win_idx_ = (win_idx_ + 1) % params_.window;
+  if (win_num_ < params_.window) {
+    win_num_++;
+  }
+  for (size_t i = 0; i < kFricNum; i++) {
+    float sum = 0.0f;
+    for (size_t k = 0; k < win_num_; k++) {
+      sum += load_[i][k];
+    }
+    imp_sum_[i] = sum;
+    if (i == 0 || sum < imp_min) {
+      imp_min = sum;
+    }
+  }
+
+  if (has_shot_ && tick - shot_tick_ < params_.min_gap) {
+    return false;
+  }
+
+  if (win_num_ < params_.window || imp_min < params_.imp_thres) {
+    if (imp_sum_[kFricFirst] < 0.5f * params_.imp_thres &&
+        imp_sum_[kFricSecond] < 0.5f * params_.imp_thres) {
+      // 没有发弹迹象时更新稳态值
+      for (size_t i = 0; i < kFricNum; i++) {
+        base_spd_[i] += params_.base_lpf * (w[i] - base_spd_[i]);
+        base_load_[i] += params_.base_lpf * (load[i] - base_load_[i]);
+      }
+    }
+    return false;
+  }
+
+  has_shot_ = true;
+  shot_tick_ = tick;
+  imp_ = imp_min;
+  shot_cnt_++;
+  report_num_++;
+
+  Shot shot;
+  shot.tick = tick;
+  shot.fric_spd = 0.5f * (base_spd_[kFricFirst] + base_spd_[kFricSecond]);
+  blt_spd_ = spd_ratio_ * shot.fric_spd;
+  if (pending_num_ >= kMaxPending) {
+    popPending();
+  }
+  pending_[pending_num_++] = shot;
+  return true;
+};
+
+/**
+ * @brief       收到裁判系统的发弹数据
+ * @param        tick: 当前时间戳，单位 ms
+ * @param        blt_spd: 裁判系统给出的弹速，单位 m/s
+ */
+void ShotDetector::onRfrShot(uint32_t tick, float blt_spd)
+{
+  expirePending(tick);
+  if (expired_num_ > 0) {
+    // 已超过 match_time 的本地发弹早于等待中的，裁判系统数据迟到，撤销误检，本地检测时已交给使用方
+    float fric_spd = expired_[0].fric_spd;
+    popExpired();
+    false_cnt_--;
+    late_cnt_++;
+    calibrate(fric_spd, blt_spd);
+    return;
+  }
+  if (pending_num_ == 0) {
+    // 本地漏检，补报一发
+    miss_cnt_++;
+    report_num_++;
+    return;
+  }
+
+  float fric_spd = pending_[0].fric_spd;
+  popPending();
+  calibrate(fric_spd, blt_spd);
+};
+
+/**
+ * @brief       取出一发尚未交给使用方的发弹
+ * @retval       有发弹时返回 true
+ * @note        每次调用最多取出一发，包括本地检测到的发弹与本地漏检、由裁判系统补报的发弹
+ */
+bool ShotDetector::fetchShot()
+{
+  if (report_num_ == 0) {
+    return false;
+  }
+  report_num_--;
+  return true;
+};
+
+void ShotDetector::reset()
+{
+  has_base_ = false;
+  has_shot_ = false;
+  pending_num_ = 0;
+  expired_num_ = 0;
+  report_num_ = 0;
+};
+/* Private function definitions ----------------------------------------------*/
+
+void ShotDetector::expirePending(uint32_t tick)
+{
+  while (expired_num_ > 0 && tick - expired_[0].tick > params_.match_time + params_.late_time) {
+    popExpired();
+  }
+  while (pending_num_ > 0 && tick - pending_[0].tick > params_.match_time) {
+    // 裁判系统未发弹，认为是误检，但在 late_time 内仍可与迟到的数据对应
+    false_cnt_++;
+    if (expired_num_ >= kMaxPending) {
+      popExpired();
+    }
+    expired_[expired_num_++] = pending_[0];
+    popPending();
+  }
+};
+
+void ShotDetector::popPending()
+{
+  for (size_t i = 1; i < pending_num_; i++) {
+    pending_[i - 1] = pending_[i];
+  }
+  pending_num_--;
+};
+
+void ShotDetector::popExpired()
+{
+  for (size_t i = 1; i < expired_num_; i++) {
+    expired_[i - 1] = expired_[i];
+  }
+  expired_num_--;
+};
+
+/**
+ * @brief       用对应上的裁判系统弹速修正弹速与转速之比
+ */
+void ShotDetector::calibrate(float fric_spd, float blt_spd)
+{
+  if (blt_spd < params_.min_blt_spd || blt_spd > params_.max_blt_spd || fric_spd <= 0.0f) {
+    return;
+  }
+  float ratio = blt_spd / fric_spd;
+  if (!is_calibrated_) {
+    is_calibrated_ = true;
+    spd_ratio_ = ratio;
+  } else {
+    spd_ratio_ += params_.spd_ratio_lpf * (ratio - spd_ratio_);
+  }
+};
+}  // namespace robot
@@ -0,0 +1,108 @@
+/**
+ *******************************************************************************
+ * @file      :time_optimal_traj.cpp
+ * @brief     : 云台关节时间最优轨迹生成
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "time_optimal_traj.hpp"
+
+#include <cmath>
+/* Private macro -------------------------------------------------------------*/
+
+namespace robot
+{
+/* Private constants ---------------------------------------------------------*/
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported function definitions ---------------------------------------------*/
+
+/**
+ * @brief       以轨迹当前状态为起点，向期望角度规划一个周期
+ * @param        goal_ang: 期望角度，单位 rad
+ * @param        goal_spd: 期望角度的变化率，单位 rad/s
+ * @param        dt: 控制周期，单位 s
+ */
+void TimeOptimalTraj::calc(float goal_ang, float goal_spd, float dt)
+{
+  if (dt <= 0.0f) {
+    return;
+  }
+  float spd_max = params_.spd_max;
+  goal_spd = goal_spd > spd_max ? spd_max : (goal_spd < -spd_max ? -spd_max : goal_spd);
+
+  // 在相对期望角度的误差坐标系下做最速控制
+  float err = wrap(ang_ - goal_ang);
+  float err_spd = spd_ - goal_spd;
+  float acc = fhan(err, err_spd, dt);
+
+  float spd = spd_ + acc * dt;
+  if (spd > spd_max) {
+    spd = spd_max;
+  } else if (spd < -spd_max) {
+    spd = -spd_max;
+  }
+  acc_ = (spd - spd_) / dt;
+  spd_ = spd;
+  ang_ = wrap(ang_ + spd_ * dt);
+};
+
+void TimeOptimalTraj::reset(float ang, float spd)
+{
+  ang_ = wrap(ang);
+  spd_ = spd;
+  acc_ = 0.0f;
+};
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief       离散最速控制综合函数
+ * @param        x1: 位置误差，单位 rad
+ * @param        x2: 速度误差，单位 rad/s
+ * @param        h: 步长，单位 s
+ * @retval      加速度，单位 rad/s^2，绝对值不超过 acc_max
+ */
+float TimeOptimalTraj::fhan(float x1, float x2, float h) const
+{
+  float r = params_.acc_max;
+  float d = r * h;
+  float d0 = h * d;
+  float y = x1 + h * x2;
+  float a0 = sqrtf(d * d + 8.0f * r * fabsf(y));
+  float a = 0.0f;
+  if (fabsf(y) > d0) {
+    a = x2 + 0.5f * (a0 - d) * (y > 0.0f ? 1.0f : -1.0f);
+  } else {
+    a = x2 + y / h;
+  }
+  if (fabsf(a) > d) {
+    return a > 0.0f ? -r : r;
+  }
+  return -r * a / d;
+};
+
+float TimeOptimalTraj::wrap(float ang) const
+{
+  float period = params_.period;
+  if (period <= 0.0f) {
+    return ang;
+  }
+  ang = fmodf(ang, period);
+  if (ang >= period * 0.5f) {
+    ang -= period;
+  } else if (ang < -period * 0.5f) {
+    ang += period;
+  }
+  return ang;
+};
+}  // namespace robot
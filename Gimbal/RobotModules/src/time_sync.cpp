@@ -0,0 +1,117 @@
+/**
+ *******************************************************************************
+ * @file      :time_sync.cpp
+ * @brief     : MCU 与视觉上位机的时钟同步
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "time_sync.hpp"
+/* Private macro -------------------------------------------------------------*/
+
+namespace robot
+{
+/* Private constants ---------------------------------------------------------*/
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported function definitions ---------------------------------------------*/
+
+/**
+ * @brief       生成一次同步请求
+ * @param        mcu_tx_us: 请求发出时的 MCU 时间，单位 us
+ * @retval       请求序号，上位机回复时原样带回
+ */
+uint8_t TimeSync::genRequest(uint32_t mcu_tx_us)
+{
+  seq_++;
+  size_t idx = seq_ % kReqNum;
+  req_seq_[idx] = seq_;
+  req_t1_[idx] = mcu_tx_us;
+  req_pending_[idx] = true;
+  return seq_;
+};
+
+/**
+ * @brief       处理一次同步回复
+ * @param        seq: 回复中带回的请求序号
+ * @param        pc_rx_us: 上位机收到请求的时间，单位 us
+ * @param        pc_tx_us: 上位机发出回复的时间，单位 us
+ * @param        mcu_rx_us: MCU 收到回复的时间，单位 us
+ * @retval       样本有效返回 true，否则返回 false
+ */
+bool TimeSync::onResponse(uint8_t seq, uint32_t pc_rx_us, uint32_t pc_tx_us, uint32_t mcu_rx_us)
+{
+  size_t idx = seq % kReqNum;
+  if (!req_pending_[idx] || req_seq_[idx] != seq) {
+    return false;
+  }
+  req_pending_[idx] = false;
+
+  int32_t mcu_span = (int32_t)(mcu_rx_us - req_t1_[idx]);
+  int32_t pc_span = (int32_t)(pc_tx_us - pc_rx_us);
+  if (mcu_span < 0 || pc_span < 0) {
+    return false;
+  }
+  // 两侧时钟频差会让 rtt 略小于 0，视为 0
+  int32_t rtt = mcu_span - pc_span;
+  if (rtt < 0) {
+    rtt = 0;
+  }
+  if ((uint32_t)rtt > params_.rtt_max) {
+    return false;
+  }
+
+  Sample &sample = win_[win_head_];
+  sample.mcu = req_t1_[idx] + (uint32_t)mcu_span / 2u;
+  sample.pc = pc_rx_us + (uint32_t)pc_span / 2u;
+  sample.rtt = (uint32_t)rtt;
+  win_head_ = (win_head_ + 1) % kWinLen;
+  if (win_cnt_ < kWinLen) {
+    win_cnt_++;
+  }
+  sample_cnt_++;
+
+  // rtt 相同时取较新的样本
+  const Sample *best = &sample;
+  for (size_t i = 0; i < win_cnt_; i++) {
+    if (win_[i].rtt < best->rtt) {
+      best = &win_[i];
+    }
+  }
+  ref_mcu_ = best->mcu;
+  ref_pc_ = best->pc;
+  ref_rtt_ = best->rtt;
+  last_sample_ = mcu_rx_us;
+  is_synced_ = true;
+  return true;
+};
+
+void TimeSync::reset()
+{
+  for (size_t i = 0; i < kReqNum; i++) {
+    req_pending_[i] = false;
+  }
+  win_head_ = 0;
+  win_cnt_ = 0;
+  is_synced_ = false;
+};
+
+/**
+ * @brief       是否处于同步状态
+ * @param        mcu_us: 当前 MCU 时间，单位 us
+ */
+bool TimeSync::isSynced(uint32_t mcu_us) const
+{
+  return is_synced_ && (uint32_t)(mcu_us - last_sample_) < params_.timeout;
+};
+/* Private function definitions ----------------------------------------------*/
+}  // namespace robot
@@ -0,0 +1,429 @@
+/**
+ *******************************************************************************
+ * @file      :vision_link.cpp
+ * @brief     : 视觉上位机通讯协议 v2
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "vision_link.hpp"
+
+#include <cmath>
+#include <cstring>
+
+#include "sys_time.hpp"
+/* Private macro -------------------------------------------------------------*/
+
+namespace robot
+{
+/* Private constants ---------------------------------------------------------*/
+// MCU -> PC
+const uint8_t kMsgSyncReq = 0x01;
+const uint8_t kMsgPoseBatch = 0x02;
+const uint8_t kMsgStatus = 0x03;
+const uint8_t kMsgBulletSpd = 0x04;
+// PC -> MCU
+const uint8_t kMsgSyncResp = 0x81;
+const uint8_t kMsgTarget = 0x82;
+
+const size_t kSyncRespLen = 9;
+const size_t kTargetLen = 9;
+const size_t kTargetDistLen = 11;  ///< 带目标距离的目标消息长度
+const size_t kTargetVtmLen = 15;   ///< 带图传坐标的目标消息长度
+
+const float kAngRes = 1e-4f;    ///< 目标角度分辨率，单位 rad
+const float kQuatRes = 32767.0f;  ///< 四元数量化系数
+const float kBltSpdRes = 100.0f;  ///< 弹速量化系数，0.01 m/s
+const float kDistRes = 1e-3f;     ///< 目标距离分辨率，单位 m
+/* Private types -------------------------------------------------------------*/
+
+/** 按消息格式依次写入数据，超出缓冲区时置位 is_overflow 并停止写入 */
+class MsgWriter
+{
+ public:
+  MsgWriter(uint8_t *buf, size_t size) : buf_(buf), size_(size) {};
+
+  void beginMsg(uint8_t type)
+  {
+    put<uint8_t>(type);
+    len_pos_ = len_;
+    put<uint8_t>(0);
+  }
+  void endMsg()
+  {
+    if (!is_overflow_) {
+      buf_[len_pos_] = (uint8_t)(len_ - len_pos_ - 1);
+    }
+  }
+  template <typename T>
+  void put(T val)
+  {
+    if (len_ + sizeof(T) > size_) {
+      is_overflow_ = true;
+      return;
+    }
+    memcpy(buf_ + len_, &val, sizeof(T));
+    len_ += sizeof(T);
+  }
+
+  size_t len() const { return len_; }
+  bool isOverflow() const { return is_overflow_; }
+
+ private:
+  uint8_t *buf_ = nullptr;
+  size_t size_ = 0;
+  size_t len_ = 0;
+  size_t len_pos_ = 0;
+  bool is_overflow_ = false;
+};
+/* Private variables ---------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+
+static uint16_t CalcCrc16(const uint8_t *data, size_t len)
+{
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (uint8_t b = 0; b < 8; b++) {
+      crc = (crc & 0x8000u) ? (uint16_t)((crc << 1) ^ 0x1021u) : (uint16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+/**
+ * @brief       COBS 编码
+ * @retval       编码后的长度，不含帧尾；dst 空间不足时返回 0
+ */
+static size_t CobsEncode(const uint8_t *src, size_t len, uint8_t *dst, size_t dst_size)
+{
+  if (dst_size == 0) {
+    return 0;
+  }
+  size_t code_pos = 0;
+  size_t out = 1;
+  uint8_t code = 1;
+  for (size_t i = 0; i < len; i++) {
+    if (src[i] != 0) {
+      if (out >= dst_size) {
+        return 0;
+      }
+      dst[out++] = src[i];
+      code++;
+    }
+    if (src[i] == 0 || code == 0xFF) {
+      if (out >= dst_size) {
+        return 0;
+      }
+      dst[code_pos] = code;
+      code_pos = out++;
+      code = 1;
+    }
+  }
+  dst[code_pos] = code;
+  return out;
+}
+
+/**
+ * @brief       COBS 解码
+ * @retval       解码后的长度；数据格式错误或 dst 空间不足时返回 0
+ */
+static size_t CobsDecode(const uint8_t *src, size_t len, uint8_t *dst, size_t dst_size)
+{
+  size_t out = 0;
+  size_t i = 0;
+  while (i < len) {
+    uint8_t code = src[i++];
+    if (code == 0 || i + code - 1 > len) {
+      return 0;
+    }
+    for (uint8_t j = 1; j < code; j++) {
+      if (out >= dst_size) {
+        return 0;
+      }
+      dst[out++] = src[i++];
+    }
+    if (code != 0xFF && i < len) {
+      if (out >= dst_size) {
+        return 0;
+      }
+      dst[out++] = 0;
+    }
+  }
+  return out;
+}
+
+template <typename T>
+static T ReadLe(const uint8_t *data)
+{
+  T val;
+  memcpy(&val, data, sizeof(T));
+  return val;
+}
+
+static int16_t QuantQuat(float val)
+{
+  val = val > 1.0f ? 1.0f : (val < -1.0f ? -1.0f : val);
+  return (int16_t)lroundf(val * kQuatRes);
+}
+
+static uint16_t QuantBltSpd(float spd)
+{
+  spd = spd < 0.0f ? 0.0f : spd;
+  return (uint16_t)lroundf(spd * kBltSpdRes);
+}
+/* Exported function definitions ---------------------------------------------*/
+
+bool VisionLink::decode(size_t len, const uint8_t *data, uint32_t /*rx_id*/)
+{
+  if (data == nullptr) {
+    return false;
+  }
+  uint32_t rx_us = GetSysTimeUs();
+
+  bool is_decoded = false;
+  for (size_t i = 0; i < len; i++) {
+    uint8_t byte = data[i];
+    if (byte != 0) {
+      if (rx_len_ < kMaxEncLen) {
+        rx_buf_[rx_len_++] = byte;
+      } else {
+        is_rx_overflow_ = true;
+      }
+      continue;
+    }
+
+    // 帧尾
+    if (is_rx_overflow_) {
+      stats_.rx_err_cnt++;
+    } else if (rx_len_ > 0 && decodeFrame(rx_buf_, rx_len_, rx_us)) {
+      is_decoded = true;
+    }
+    rx_len_ = 0;
+    is_rx_overflow_ = false;
+  }
+
+  if (is_decoded) {
+    oc_.update();
+  }
+  return is_decoded;
+};
+
+bool VisionLink::encode(size_t &len, uint8_t *data)
+{
+  if (data == nullptr) {
+    return false;
+  }
+
+  uint8_t frame[kMaxFrameLen];
+  MsgWriter writer(frame, kMaxFrameLen - 2);
+  writer.put<uint8_t>(kVersion);
+  writer.put<uint8_t>(tx_seq_);
+
+  if (pose_cnt_ > 0) {
+    uint16_t period = pose_cnt_ > 1 ? (uint16_t)((pose_t1_ - pose_t0_) / (pose_cnt_ - 1)) : 0;
+    writer.beginMsg(kMsgPoseBatch);
+    writer.put<uint32_t>(pose_t0_);
+    writer.put<uint16_t>(period);
+    writer.put<uint8_t>((uint8_t)pose_cnt_);
+    for (size_t i = 0; i < pose_cnt_; i++) {
+      for (size_t j = 0; j < 4; j++) {
+        writer.put<int16_t>(pose_q_[i][j]);
+      }
+    }
+    writer.endMsg();
+  }
+
+  writer.beginMsg(kMsgStatus);
+  writer.put<uint8_t>(status_.work_state);
+  writer.put<uint8_t>(status_.target_color);
+  writer.put<uint16_t>(QuantBltSpd(status_.blt_spd));
+  writer.endMsg();
+
+  if (is_blt_spd_updated_) {
+    writer.beginMsg(kMsgBulletSpd);
+    writer.put<uint8_t>((uint8_t)blt_spd_cnt_);
+    for (size_t i = 0; i < blt_spd_cnt_; i++) {
+      writer.put<uint16_t>(QuantBltSpd(blt_spd_hist_[i]));
+    }
+    writer.endMsg();
+  }
+
+  // 同步请求放在最后，尽量缩短 t1 与实际发出的间隔
+  bool has_sync_req = tx_frame_since_sync_ + 1 >= cfg_.sync_interval;
+  uint32_t t1 = GetSysTimeUs();
+  if (has_sync_req) {
+    writer.beginMsg(kMsgSyncReq);
+    writer.put<uint8_t>(0);
+    writer.put<uint32_t>(t1);
+    writer.endMsg();
+  }
+
+  if (writer.isOverflow()) {
+    return false;
+  }
+  size_t frame_len = writer.len();
+  if (has_sync_req) {
+    // 序号在确认可以发出后再生成，避免 TimeSync 等待一个未发出的请求
+    frame[frame_len - 5] = time_sync_.genRequest(t1);
+  }
+  uint16_t crc = CalcCrc16(frame, frame_len);
+  memcpy(frame + frame_len, &crc, sizeof(crc));
+  frame_len += sizeof(crc);
+
+  size_t enc_len = CobsEncode(frame, frame_len, data, len > 0 ? len - 1 : 0);
+  if (enc_len == 0) {
+    return false;
+  }
+  data[enc_len++] = 0x00;
+  len = enc_len;
+
+  tx_seq_++;
+  stats_.tx_frame_cnt++;
+  tx_frame_since_sync_ = has_sync_req ? 0 : tx_frame_since_sync_ + 1;
+  pose_cnt_ = 0;
+  is_blt_spd_updated_ = false;
+  return true;
+};
+
+/**
+ * @brief       记录一个控制周期的云台位姿，随下一帧发出
+ * @param        time_us: 位姿对应的 MCU 时间，单位 us
+ * @param        roll: 单位 rad
+ * @param        pitch: 单位 rad
+ * @param        yaw: 单位 rad
+ * @note        按 ZYX 欧拉角转换为四元数；缓存满时（上位机长时间未发送）丢弃旧样本重新打包
+ */
+void VisionLink::addPose(uint32_t time_us, float roll, float pitch, float yaw)
+{
+  if (pose_cnt_ >= kMaxPoseBatch) {
+    pose_cnt_ = 0;
+  }
+  if (pose_cnt_ == 0) {
+    pose_t0_ = time_us;
+  }
+  pose_t1_ = time_us;
+
+  float cr = cosf(roll * 0.5f), sr = sinf(roll * 0.5f);
+  float cp = cosf(pitch * 0.5f), sp = sinf(pitch * 0.5f);
+  float cy = cosf(yaw * 0.5f), sy = sinf(yaw * 0.5f);
+  int16_t *q = pose_q_[pose_cnt_];
+  q[0] = QuantQuat(cr * cp * cy + sr * sp * sy);
+  q[1] = QuantQuat(sr * cp * cy - cr * sp * sy);
+  q[2] = QuantQuat(cr * sp * cy + sr * cp * sy);
+  q[3] = QuantQuat(cr * cp * sy - sr * sp * cy);
+  pose_cnt_++;
+};
+
+void VisionLink::addBulletSpd(float blt_spd)
+{
+  if (blt_spd_cnt_ < kBulletSpdHistLen) {
+    blt_spd_cnt_++;
+  } else {
+    memmove(blt_spd_hist_, blt_spd_hist_ + 1, sizeof(float) * (kBulletSpdHistLen - 1));
+  }
+  blt_spd_hist_[blt_spd_cnt_ - 1] = blt_spd;
+  is_blt_spd_updated_ = true;
+};
+
+bool VisionLink::isSynced() const { return time_sync_.isSynced(GetSysTimeUs()); };
+
+bool VisionLink::getTarget(Target *target, uint32_t *capture_us) const
+{
+  if (target == nullptr || capture_us == nullptr || !has_target_ || !isSynced()) {
+    return false;
+  }
+  *target = target_;
+  *capture_us = time_sync_.toMcuTime(target_.exposure);
+  return true;
+};
+
+bool VisionLink::isTargetInView() const
+{
+  return isTargetDetected() && fabsf(target_.yaw) < cfg_.hfov * 0.5f &&
+         fabsf(target_.pitch) < cfg_.vfov * 0.5f;
+};
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief       解码一帧
+ * @param        enc: 不含帧尾的 COBS 编码数据
+ * @param        enc_len: 编码数据长度
+ * @param        rx_us: 收到数据的 MCU 时间，单位 us
+ * @retval       帧格式、版本与校验均正确时返回 true
+ */
+bool VisionLink::decodeFrame(const uint8_t *enc, size_t enc_len, uint32_t rx_us)
+{
+  uint8_t frame[kMaxFrameLen];
+  size_t len = CobsDecode(enc, enc_len, frame, kMaxFrameLen);
+  if (len < 4) {
+    stats_.rx_err_cnt++;
+    return false;
+  }
+  if (CalcCrc16(frame, len - 2) != ReadLe<uint16_t>(frame + len - 2)) {
+    stats_.rx_err_cnt++;
+    return false;
+  }
+  if (frame[0] != kVersion) {
+    stats_.rx_ver_err_cnt++;
+    return false;
+  }
+
+  uint8_t seq = frame[1];
+  if (has_rx_seq_) {
+    stats_.rx_lost_cnt += (uint8_t)(seq - last_rx_seq_ - 1);
+  }
+  last_rx_seq_ = seq;
+  has_rx_seq_ = true;
+  stats_.rx_frame_cnt++;
+
+  size_t pos = 2;
+  size_t end = len - 2;
+  while (pos + 2 <= end) {
+    uint8_t type = frame[pos];
+    uint8_t msg_len = frame[pos + 1];
+    pos += 2;
+    if (pos + msg_len > end) {
+      stats_.rx_err_cnt++;
+      break;
+    }
+    decodeMsg(type, frame + pos, msg_len, rx_us);
+    pos += msg_len;
+  }
+  return true;
+};
+
+/**
+ * @brief       解码一条消息
+ * @note        未知类型直接跳过；消息长度大于已知格式时只解析已知字段，便于日后追加字段
+ */
+void VisionLink::decodeMsg(uint8_t type, const uint8_t *payload, size_t len, uint32_t rx_us)
+{
+  if (type == kMsgSyncResp && len >= kSyncRespLen) {
+    uint8_t sync_seq = payload[0];
+    uint32_t t2 = ReadLe<uint32_t>(payload + 1);
+    uint32_t t3 = ReadLe<uint32_t>(payload + 5);
+    time_sync_.onResponse(sync_seq, t2, t3, rx_us);
+  } else if (type == kMsgTarget && len >= kTargetLen) {
+    uint8_t flags = payload[0];
+    target_.is_detected = (flags & 0x01u) != 0;
+    target_.shoot_flag = (flags >> 1) & 0x03u;
+    target_.is_high_value = (flags & 0x08u) != 0;
+    target_.exposure = ReadLe<uint32_t>(payload + 1);
+    target_.yaw = ReadLe<int16_t>(payload + 5) * kAngRes;
+    target_.pitch = ReadLe<int16_t>(payload + 7) * kAngRes;
+    target_.dist = len >= kTargetDistLen ? ReadLe<uint16_t>(payload + 9) * kDistRes : 0.0f;
+    target_.vtm_x = len >= kTargetVtmLen ? ReadLe<uint16_t>(payload + 11) : 0;
+    target_.vtm_y = len >= kTargetVtmLen ? ReadLe<uint16_t>(payload + 13) : 0;
+    has_target_ = true;
+  }
+};
+}  // namespace robot
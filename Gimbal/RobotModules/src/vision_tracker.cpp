@@ -0,0 +1,172 @@
+/**
+ *******************************************************************************
+ * @file      :vision_tracker.cpp
+ * @brief     : 视觉目标世界系跟踪与帧间预测
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "vision_tracker.hpp"
+
+#include <cmath>
+/* Private macro -------------------------------------------------------------*/
+
+namespace robot
+{
+/* Private constants ---------------------------------------------------------*/
+const float kPi = 3.14159265358979f;
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static float WrapPi(float ang)
+{
+  ang = fmodf(ang, 2.0f * kPi);
+  if (ang >= kPi) {
+    ang -= 2.0f * kPi;
+  } else if (ang < -kPi) {
+    ang += 2.0f * kPi;
+  }
+  return ang;
+}
+/* Exported function definitions ---------------------------------------------*/
+
+/**
+ * @brief       更新跟踪器并输出当前时刻的目标方向
+ * @param        tick: 当前时间戳，单位 ms
+ * @param        yaw: 视觉给出的目标 yaw，世界系，单位 rad
+ * @param        pitch: 视觉给出的目标 pitch，世界系，单位 rad
+ * @param        is_detected: 视觉是否检测到目标
+ * @param        latency: 当前帧从拍摄到当前时刻的时延，单位 s，小于 0 时使用参数中的固定时延
+ * @note        每个控制周期调用；视觉数据变化时视为收到新帧
+ */
+void VisionTracker::update(uint32_t tick, float yaw, float pitch, bool is_detected, float latency)
+{
+  if (!is_detected) {
+    reset();
+    return;
+  }
+
+  float meas[kAxisNum] = {0.0f};
+  meas[kAxisYaw] = yaw;
+  meas[kAxisPitch] = pitch;
+  bool is_new_frame = !is_tracking_ || meas[kAxisYaw] != last_meas_[kAxisYaw] ||
+                      meas[kAxisPitch] != last_meas_[kAxisPitch];
+
+  if (is_new_frame) {
+    if (latency < 0.0f) {
+      latency = params_.vis_latency;
+    }
+    uint32_t latency_ticks = (uint32_t)(latency * 1000.0f + 0.5f);
+    uint32_t capture_tick = tick > latency_ticks ? tick - latency_ticks : 0;
+
+    bool is_reset = !is_tracking_;
+    if (!is_reset) {
+      float dt = (int32_t)(capture_tick - meas_tick_) * 0.001f;
+      for (size_t i = 0; i < kAxisNum; i++) {
+        predictAxis(axis_[i], dt > 0.0f ? dt : 0.0f);
+        if (fabsf(calcInnov(axis_[i], meas[i], i == kAxisYaw)) > params_.reset_thres) {
+          is_reset = true;
+        }
+      }
+    }
+
+    for (size_t i = 0; i < kAxisNum; i++) {
+      if (is_reset) {
+        initAxis(axis_[i], meas[i]);
+      } else {
+        correctAxis(axis_[i], meas[i], i == kAxisYaw);
+      }
+      last_meas_[i] = meas[i];
+    }
+    meas_tick_ = capture_tick;
+    is_tracking_ = true;
+  }
+
+  // 外推到当前时刻并补偿控制时延
+  float extrap = (int32_t)(tick - meas_tick_) * 0.001f + params_.ctrl_lead;
+  if (extrap > params_.max_extrap) {
+    extrap = params_.max_extrap;
+  } else if (extrap < 0.0f) {
+    extrap = 0.0f;
+  }
+  for (size_t i = 0; i < kAxisNum; i++) {
+    spd_out_[i] = axis_[i].x[1];
+    ang_out_[i] = axis_[i].x[0] + axis_[i].x[1] * extrap;
+  }
+  ang_out_[kAxisYaw] = WrapPi(ang_out_[kAxisYaw]);
+};
+
+void VisionTracker::reset()
+{
+  is_tracking_ = false;
+  for (size_t i = 0; i < kAxisNum; i++) {
+    spd_out_[i] = 0.0f;
+  }
+};
+/* Private function definitions ----------------------------------------------*/
+
+void VisionTracker::initAxis(Axis &axis, float ang)
+{
+  axis.x[0] = ang;
+  axis.x[1] = 0.0f;
+  axis.p[0][0] = params_.r_ang;
+  axis.p[0][1] = 0.0f;
+  axis.p[1][0] = 0.0f;
+  axis.p[1][1] = params_.spd_max * params_.spd_max;
+};
+
+/**
+ * @brief       匀速模型预测
+ * @note        过程噪声 Q = q * [dt^3/3, dt^2/2; dt^2/2, dt]
+ */
+void VisionTracker::predictAxis(Axis &axis, float dt)
+{
+  axis.x[0] += axis.x[1] * dt;
+
+  float p00 = axis.p[0][0], p01 = axis.p[0][1], p11 = axis.p[1][1];
+  float q = params_.q_acc;
+  axis.p[0][0] = p00 + 2.0f * dt * p01 + dt * dt * p11 + q * dt * dt * dt / 3.0f;
+  axis.p[0][1] = p01 + dt * p11 + q * dt * dt * 0.5f;
+  axis.p[1][0] = axis.p[0][1];
+  axis.p[1][1] = p11 + q * dt;
+};
+
+void VisionTracker::correctAxis(Axis &axis, float ang, bool is_periodic)
+{
+  float innov = calcInnov(axis, ang, is_periodic);
+  float s = axis.p[0][0] + params_.r_ang;
+  float k0 = axis.p[0][0] / s;
+  float k1 = axis.p[1][0] / s;
+
+  axis.x[0] += k0 * innov;
+  axis.x[1] += k1 * innov;
+  if (is_periodic) {
+    axis.x[0] = WrapPi(axis.x[0]);
+  }
+  if (axis.x[1] > params_.spd_max) {
+    axis.x[1] = params_.spd_max;
+  } else if (axis.x[1] < -params_.spd_max) {
+    axis.x[1] = -params_.spd_max;
+  }
+
+  float p00 = axis.p[0][0], p01 = axis.p[0][1], p11 = axis.p[1][1];
+  axis.p[0][0] = (1.0f - k0) * p00;
+  axis.p[0][1] = (1.0f - k0) * p01;
+  axis.p[1][0] = axis.p[0][1];
+  axis.p[1][1] = p11 - k1 * p01;
+};
+
+float VisionTracker::calcInnov(const Axis &axis, float ang, bool is_periodic) const
+{
+  float innov = ang - axis.x[0];
+  return is_periodic ? WrapPi(innov) : innov;
+};
+}  // namespace robot
@@ -223,7 +223,7 @@ static void CommAddReceiver(void)
   can2_rx_mgr_ptr->addReceiver(CreateMotorFeed());
 
   HW_ASSERT(vision_rx_mgr_ptr != nullptr, "vision_rx_mgr_ptr is nullptr", vision_rx_mgr_ptr);
-  vision_rx_mgr_ptr->addReceiver(CreateVision());
+  vision_rx_mgr_ptr->addReceiver(CreateVisionLink());
 };
 
 static void CommAddTransmitter(void)
@@ -239,5 +239,5 @@ static void CommAddTransmitter(void)
   can2_tx_mgr_ptr->addTransmitter(CreateMotorFeed());
 
   HW_ASSERT(vision_tx_mgr_ptr != nullptr, "vision_tx_mgr_ptr is nullptr", vision_tx_mgr_ptr);
-  vision_tx_mgr_ptr->addTransmitter(CreateVision());
+  vision_tx_mgr_ptr->addTransmitter(CreateVisionLink());
 };
\ No newline at end of file
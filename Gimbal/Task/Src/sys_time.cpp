@@ -0,0 +1,49 @@
+/**
+ *******************************************************************************
+ * @file      :sys_time.cpp
+ * @brief     : MCU 微秒时间，由 HAL 毫秒计数与 SysTick 计数值合成
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "sys_time.hpp"
+
+// hal
+#include "stm32f4xx_hal.h"
+/* Private macro -------------------------------------------------------------*/
+
+namespace robot
+{
+/* Private constants ---------------------------------------------------------*/
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported function definitions ---------------------------------------------*/
+
+uint32_t GetSysTimeUs(void)
+{
+  uint32_t ms = 0;
+  uint32_t val = 0;
+  // 读取期间被 SysTick 中断打断时重新读取
+  do {
+    ms = HAL_GetTick();
+    val = SysTick->VAL;
+  } while (ms != HAL_GetTick());
+  // SysTick 已回绕但中断尚未处理（在优先级不低于 SysTick 的中断中调用），重新读取计数值并补 1 ms
+  if ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0) {
+    val = SysTick->VAL;
+    ms++;
+  }
+  uint32_t load = SysTick->LOAD + 1u;
+  return ms * 1000u + (load - val) * 1000u / load;
+};
+/* Private function definitions ----------------------------------------------*/
+}  // namespace robot
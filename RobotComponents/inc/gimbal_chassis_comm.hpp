@@ -7,6 +7,12 @@
  *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
  *******************************************************************************
  * @attention :
+ *  1. 每个控制周期各板发送一帧，云台到底盘与底盘到云台各有 kPkgNum 个数据包轮流发送，
+ *     1 kHz 发送时每个包约 333 Hz、最长间隔 3 ms（加入运动数据包前为 500 Hz、2 ms）
+ *  2. 原有数据的源头频率均低于单包频率：遥控器约 70 Hz，图传键鼠约 30 Hz，裁判系统热量 50 Hz、
+ *     射击数据每发一次；发弹计数 is_new_bullet_shot 为 2 位，3 ms 内不会发射 4 发，不会混叠；
+ *     单包频率降低只使这些数据平均多滞后约 0.5 ms，可由 rxPkgCnt 统计各包的实际接收频率
+ *  3. 运动数据序号由发送端在发送运动数据包时自增，保存在本对象的数据中
  *******************************************************************************
  *  Copyright (c) 2024 Hello World Team, Zhejiang University.
  *  All Rights Reserved.
@@ -68,6 +74,11 @@ class GimbalChassisComm : public hello_world::comm::Receiver, public hello_world
       CtrlMode ctrl_mode = CtrlMode::Manual;  ///< 云台模块控制模式（工作状态为 kPwrStateWorking 时有效）
 
       GimbalWorkingMode working_mode = GimbalWorkingMode::Normal;  ///< 云台模块的工作模式（工作状态为 kPwrStateWorking 时有效）
+
+      float chassis_yaw_spd_ref = 0.0f;  ///< 底盘的期望偏航角速度，单位 rad/s
+      float chassis_yaw_spd_fdb = 0.0f;  ///< 底盘的当前偏航角速度(IMU)，单位 rad/s
+      float chassis_yaw_acc_ref = 0.0f;  ///< 底盘期望偏航角速度的变化率，单位 rad/s^2
+      uint8_t chassis_motion_seq = 0;    ///< 底盘运动数据序号，发送端每发送一次运动数据包自增，接收端据此判断数据是否更新
     } cp;
 
     // gimbal to chassis
@@ -78,6 +89,11 @@ class GimbalChassisComm : public hello_world::comm::Receiver, public hello_world
       float pitch_fdb = 0.0f;  ///< 云台的当前俯仰角度(关节空间)
       float yaw_ref = 0.0f;    ///< 云台的期望偏航角度(关节空间)
       float pitch_ref = 0.0f;  ///< 云台的期望俯仰角度(关节空间)
+
+      float yaw_spd_fdb = 0.0f;  ///< 云台的当前偏航角速度(世界坐标系)，单位 rad/s
+      float yaw_spd_ref = 0.0f;  ///< 云台的期望偏航角速度(世界坐标系)，单位 rad/s
+      uint8_t motion_seq = 0;    ///< 云台运动数据序号，发送端每发送一次运动数据包自增，接收端据此判断数据是否更新
+      float yaw_tor_headroom = 1.0f;  ///< 云台偏航电机的力矩余量，值域 [0, 1]，1 表示完全未使用
     } gp;
   };
 // unique_gimbal_chassis_comm.gimbal_data().gp.gimbal_pwr_state = (uint8_t)gc_comm.gimbal_data().gp.pwr_state;
@@ -237,6 +253,8 @@ class GimbalChassisComm : public hello_world::comm::Receiver, public hello_world
   //ScopeData& scope_data() { return scope_data_; }
 
   bool isOffline() { return oc_.isOffline(); }
+  /** 各类型数据包的接收次数，pkg_type 从 1 开始 */
+  uint32_t rxPkgCnt(uint8_t pkg_type) const { return pkg_type <= kPkgNum ? rx_pkg_cnt_[pkg_type] : 0; }
   void setOfflineThreshold(uint32_t threshold) { oc_.set_offline_tick_thres(threshold); }
   void setTxId(uint32_t tx_id) { tx_id_ = tx_id; };
   void setRxId(uint32_t rx_id) { rx_id_ = rx_id; };
@@ -247,6 +265,8 @@ class GimbalChassisComm : public hello_world::comm::Receiver, public hello_world
   void encodeC2G(uint8_t tx_data[8]);
   void decodeC2G(const uint8_t rx_data[8]);
 
+  static const uint8_t kPkgNum = 3;  ///< 每个方向轮流发送的数据包数量
+
   CodePart code_part_ = CodePart::Chassis;  ///< 代码所在部分，云台还是底盘，决定编解码方式
   size_t g2c_seq_ = 0;
 
@@ -261,6 +281,7 @@ class GimbalChassisComm : public hello_world::comm::Receiver, public hello_world
   uint32_t tx_id_ = 0x111;             ///< 发送的CAN消息ID
   uint32_t transmit_success_cnt_ = 0;  ///< 发送成功次数
   uint32_t receive_success_cnt_ = 0;   
+  uint32_t rx_pkg_cnt_[kPkgNum + 1] = {0};  ///< 各类型数据包的接收次数，下标为包类型
 
   // 所有数据
   MainBoardData main_board_data_;
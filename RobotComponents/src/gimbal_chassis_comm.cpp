@@ -65,6 +65,20 @@ struct __attribute__((packed)) C2GPkg2 {
 };
 static_assert(sizeof(C2GPkg2) <= 8, "C2GPkg2 size error");
 
+struct __attribute__((packed)) C2GPkg3 {
+  uint8_t pkg_type;
+  // chassis motion
+  uint8_t chassis_motion_seq;    ///< 底盘运动数据序号
+  int16_t chassis_yaw_spd_ref;   ///< [-32.767, 32.767] rad/s 精确到小数点后 3 位
+  int16_t chassis_yaw_spd_fdb;   ///< [-32.767, 32.767] rad/s 精确到小数点后 3 位
+  int16_t chassis_yaw_acc_ref;   ///< [-327.67, 327.67] rad/s^2 精确到小数点后 2 位
+
+  static void encode(GimbalChassisComm &gc_comm, uint8_t *tx_data);
+
+  static void decode(GimbalChassisComm &gc_comm, const uint8_t *rx_data);
+};
+static_assert(sizeof(C2GPkg3) <= 8, "C2GPkg3 size error");
+
 struct __attribute__((packed)) G2CPkg1 {
   uint8_t pkg_type;
   // robot
@@ -107,6 +121,20 @@ struct __attribute__((packed)) G2CPkg2 {
   static void decode(GimbalChassisComm &gc_comm, const uint8_t *rx_data);
 };
 static_assert(sizeof(G2CPkg2) <= 8, "Gimbal2ChassisPkg size error");
+
+struct __attribute__((packed)) G2CPkg3 {
+  uint8_t pkg_type;
+  // gimbal motion
+  uint8_t gimbal_motion_seq;   ///< 云台运动数据序号
+  int16_t gimbal_yaw_spd_fdb;  ///< [-32.767, 32.767] rad/s 精确到小数点后 3 位
+  int16_t gimbal_yaw_spd_ref;  ///< [-32.767, 32.767] rad/s 精确到小数点后 3 位
+  uint8_t gimbal_yaw_tor_headroom;  ///< [0, 1] 精确到 1/255
+
+  static void encode(GimbalChassisComm &gc_comm, uint8_t *tx_data);
+
+  static void decode(GimbalChassisComm &gc_comm, const uint8_t *rx_data);
+};
+static_assert(sizeof(G2CPkg3) <= 8, "Gimbal2ChassisPkg size error");
 /* Private variables ---------------------------------------------------------*/
 /* External variables --------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
@@ -148,43 +176,62 @@ bool GimbalChassisComm::encode(size_t& len, uint8_t* data)
 
 void GimbalChassisComm::encodeG2C(uint8_t tx_data[8])
 {
-  if (g2c_seq_ % 2 == 0) {
+  if (g2c_seq_ % kPkgNum == 0) {
     G2CPkg1::encode(*this, tx_data);
     tx_data[0] = 1;
-  } else {
+  } else if (g2c_seq_ % kPkgNum == 1) {
     G2CPkg2::encode(*this, tx_data);
     tx_data[0] = 2;
+  } else {
+    // 序号每发送一次运动数据包自增一次，接收端据此判断数据是否更新
+    gimbal_data_.gp.motion_seq++;
+    G2CPkg3::encode(*this, tx_data);
+    tx_data[0] = 3;
   }
   g2c_seq_++;
 };
 
 void GimbalChassisComm::decodeG2C(const uint8_t rx_data[8])
 {
+  if (rx_data[0] <= kPkgNum) {
+    rx_pkg_cnt_[rx_data[0]]++;
+  }
   if (rx_data[0] == 1) {
     G2CPkg1::decode(*this, rx_data);
 
   } else if (rx_data[0] == 2) {
     G2CPkg2::decode(*this, rx_data);
+  } else if (rx_data[0] == 3) {
+    G2CPkg3::decode(*this, rx_data);
   }
 }
 
 void GimbalChassisComm::encodeC2G(uint8_t tx_data[8])
 {
-  if (g2c_seq_ % 2 == 0) {
+  if (g2c_seq_ % kPkgNum == 0) {
     C2GPkg1::encode(*this, tx_data);
     tx_data[0] = 1;
-  } else {
+  } else if (g2c_seq_ % kPkgNum == 1) {
     C2GPkg2::encode(*this, tx_data);
     tx_data[0] = 2;
+  } else {
+    gimbal_data_.cp.chassis_motion_seq++;
+    C2GPkg3::encode(*this, tx_data);
+    tx_data[0] = 3;
   }
   g2c_seq_++;
 };
 void GimbalChassisComm::decodeC2G(const uint8_t rx_data[8])
 {
+  if (rx_data[0] <= kPkgNum) {
+    rx_pkg_cnt_[rx_data[0]]++;
+  }
   if (rx_data[0] == 1) {
     C2GPkg1::decode(*this, rx_data);
   } else if (rx_data[0] == 2) {
     C2GPkg2::decode(*this, rx_data);
+  } else if (rx_data[0] == 3) {
+    C2GPkg3::decode(*this, rx_data);
   }
   receive_success_cnt_++;
 };
@@ -254,6 +301,26 @@ void C2GPkg2::decode(GimbalChassisComm &gc_comm, const uint8_t *rx_data)
   gc_comm.referee_data().cp.is_new_bullet_shot = pkg_ptr->rfr_is_new_bullet_shot;
 };
 
+void C2GPkg3::encode(GimbalChassisComm &gc_comm, uint8_t *tx_data)
+{
+  C2GPkg3 *pkg_ptr = (C2GPkg3 *)tx_data;
+  // chassis motion
+  pkg_ptr->chassis_motion_seq = gc_comm.gimbal_data().cp.chassis_motion_seq;
+  pkg_ptr->chassis_yaw_spd_ref = hello_world::Bound(gc_comm.gimbal_data().cp.chassis_yaw_spd_ref, -32.767f, 32.767f) * 1000;
+  pkg_ptr->chassis_yaw_spd_fdb = hello_world::Bound(gc_comm.gimbal_data().cp.chassis_yaw_spd_fdb, -32.767f, 32.767f) * 1000;
+  pkg_ptr->chassis_yaw_acc_ref = hello_world::Bound(gc_comm.gimbal_data().cp.chassis_yaw_acc_ref, -327.67f, 327.67f) * 100;
+};
+
+void C2GPkg3::decode(GimbalChassisComm &gc_comm, const uint8_t *rx_data)
+{
+  C2GPkg3 *pkg_ptr = (C2GPkg3 *)rx_data;
+  // chassis motion
+  gc_comm.gimbal_data().cp.chassis_motion_seq = pkg_ptr->chassis_motion_seq;
+  gc_comm.gimbal_data().cp.chassis_yaw_spd_ref = pkg_ptr->chassis_yaw_spd_ref / 1000.0f;
+  gc_comm.gimbal_data().cp.chassis_yaw_spd_fdb = pkg_ptr->chassis_yaw_spd_fdb / 1000.0f;
+  gc_comm.gimbal_data().cp.chassis_yaw_acc_ref = pkg_ptr->chassis_yaw_acc_ref / 100.0f;
+};
+
 void G2CPkg1::encode(GimbalChassisComm &gc_comm, uint8_t *tx_data)
 {
   G2CPkg1 *pkg_ptr = (G2CPkg1 *)tx_data;
@@ -314,4 +381,24 @@ void G2CPkg2::decode(GimbalChassisComm &gc_comm, const uint8_t *rx_data)
   gc_comm.shooter_data().gp.feed_ang_fdb = pkg_ptr->shooter_feed_ang_fdb * M_PI / 127.0f;
 };
 
-}  // namespace robot
\ No newline at end of file
+void G2CPkg3::encode(GimbalChassisComm &gc_comm, uint8_t *tx_data)
+{
+  G2CPkg3 *pkg_ptr = (G2CPkg3 *)tx_data;
+  // gimbal motion
+  pkg_ptr->gimbal_motion_seq = gc_comm.gimbal_data().gp.motion_seq;
+  pkg_ptr->gimbal_yaw_spd_fdb = hello_world::Bound(gc_comm.gimbal_data().gp.yaw_spd_fdb, -32.767f, 32.767f) * 1000;
+  pkg_ptr->gimbal_yaw_spd_ref = hello_world::Bound(gc_comm.gimbal_data().gp.yaw_spd_ref, -32.767f, 32.767f) * 1000;
+  pkg_ptr->gimbal_yaw_tor_headroom = hello_world::Bound(gc_comm.gimbal_data().gp.yaw_tor_headroom, 0.0f, 1.0f) * 255;
+};
+
+void G2CPkg3::decode(GimbalChassisComm &gc_comm, const uint8_t *rx_data)
+{
+  G2CPkg3 *pkg_ptr = (G2CPkg3 *)rx_data;
+  // gimbal motion
+  gc_comm.gimbal_data().gp.motion_seq = pkg_ptr->gimbal_motion_seq;
+  gc_comm.gimbal_data().gp.yaw_spd_fdb = pkg_ptr->gimbal_yaw_spd_fdb / 1000.0f;
+  gc_comm.gimbal_data().gp.yaw_spd_ref = pkg_ptr->gimbal_yaw_spd_ref / 1000.0f;
+  gc_comm.gimbal_data().gp.yaw_tor_headroom = pkg_ptr->gimbal_yaw_tor_headroom / 255.0f;
+};
+
+}  // namespace robot
@@ -0,0 +1,179 @@
+/**
+ *******************************************************************************
+ * @file      :feed_handback_sim.cpp
+ * @brief     : 拨盘在 Feed 与 FeedProfile 之间交接的主机端仿真，检查交接时的电流跳变与卡弹回退
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 拨盘模型 J * dd(ang) = kt * curr - 库仑摩擦 - 粘滞摩擦 - 弹丸阻力，控制周期 1 ms，
+ *     参数与 Gimbal/Instance/src/ins_feed.cpp 中的 kFeedProfileParams 一致
+ *  2. Feed 按 ins_pid.cpp 中的 kPidParamsFeed_1 串级比例控制（角度环 51.9、输出 20 rad/s，速度环 5.1），
+ *     按固定间隔把期望角度前移一发（最多领先拨盘一发半）；堵转检测与 ins_feed.cpp 一致
+ *     （角度差 0.65 rad 持续 100 ms），堵转后期望角度退回拨盘所在的上一发位置，100 ms 后重新前移
+ *  3. 卡弹工况中部分弹丸在半发处卡死，拨盘在此处停死，只有回退超过 0.15 rad 才能松开，FeedProfile 的短促反转松不开，
+ *     需交给 Feed 的堵转回退
+ *  4. 交接跳变为到位交还后第一个周期 Feed 的输出电流与交还前 FeedProfile 输出电流之差，
+ *     Feed 堵转回退引起的交还不计入；要求 FeedProfile 接管期间 Feed 未回退；
+ *     同时给出按旧做法（以检测到拨弹时的角度加一发为目标）与 Feed 期望角度的最大偏差作对比
+ *  5. 编译运行：tools/host/run.sh feed_handback_sim
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "feed_profile.hpp"
+/* Private constants ---------------------------------------------------------*/
+const float kPi = 3.14159265f;
+const float kStepAng = kPi / 5.0f;   ///< 每发拨盘转角，单位 rad
+const float kCoulomb = 0.15f;        ///< 库仑摩擦力矩，单位 N·m
+const float kViscous = 0.01f;        ///< 粘滞摩擦系数，单位 N·m/(rad/s)
+const float kJamFree = 0.15f;        ///< 卡死弹丸松开所需的回退角度，单位 rad
+const float kAngKp = 51.9f;          ///< Feed 角度环比例系数
+const float kAngOutMax = 20.0f;      ///< Feed 角度环输出限幅，单位 rad/s
+const float kSpdKp = 5.1f;           ///< Feed 速度环比例系数，单位 A/(rad/s)
+const float kStuckAngDiff = 0.65f;   ///< Feed 堵转检测角度差，单位 rad
+const int kStuckTime = 100;          ///< Feed 堵转检测时间，单位 ms
+const int kBackTime = 100;           ///< Feed 堵转回退后重新拨弹的等待时间，单位 ms
+const int kSimTicks = 20000;         ///< 仿真时长，单位 ms
+const float kMaxJump = 2.0f;         ///< 交接跳变上限，单位 A
+
+const robot::FeedProfile::Params kProfileParams = {
+    .step_ang = kStepAng,
+    .inertia = 0.03f,
+    .kt = 4.5f,
+    .curr_max = 10.0f,
+    .acc_ratio = 0.7f,
+    .jerk_max = 2e5f,
+    .spd_max = 20.0f,
+    .kp = 60.0f,
+    .kd = 2.0f,
+    .idle_spd = 3.0f,
+    .settle_err = 0.03f,
+    .settle_time = 20,
+    .handback_curr = 1.0f,
+    .jam_err = 0.08f,
+    .jam_curr = 8.0f,
+    .jam_time = 6,
+    .rev_curr = 6.0f,
+    .rev_time = 8,
+    .max_retry = 2,
+};
+/* Private types -------------------------------------------------------------*/
+
+struct Case {
+  const char *name;
+  int interval;     ///< Feed 拨弹间隔，单位 ms
+  float jam_prob;   ///< 每发卡死的概率
+};
+
+struct Result {
+  int slots;            ///< 拨过的弹丸数
+  int handbacks;        ///< 交还次数
+  int backoffs;         ///< Feed 堵转回退次数
+  float max_jump;       ///< 最大交接跳变，单位 A
+  float legacy_mismatch;  ///< 交还时旧做法的目标与 Feed 期望角度的最大偏差，单位 rad
+  int fight_ms;         ///< FeedProfile 接管期间 Feed 已回退的时长，单位 ms
+};
+/* Private function definitions ----------------------------------------------*/
+
+static float bound(float x, float lim) { return x > lim ? lim : (x < -lim ? -lim : x); }
+
+static Result run(const Case &c)
+{
+  robot::FeedProfile profile(kProfileParams);
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<float> uni(0.0f, 1.0f);
+
+  float ang = 0.0f, spd = 0.0f, curr = 0.0f, ref = 0.0f, last_prof_curr = 0.0f;
+  float jam_at = 1e9f, legacy_goal = 0.0f, step_ref = 0.0f;
+  bool is_jam_hit = false, was_active = false;
+  int last_trig = -c.interval, stuck_ms = 0, resume_tick = -1;
+  Result res = {0, 0, 0, 0.0f, 0.0f, 0};
+  for (int k = 0; k < kSimTicks; k++) {
+    // Feed：按间隔拨弹，堵转后退回上一发并等待
+    if (resume_tick >= 0 && k >= resume_tick) {
+      ref += kStepAng;
+      resume_tick = -1;
+    } else if (resume_tick < 0 && k - last_trig >= c.interval && ref - ang < 1.5f * kStepAng) {
+      ref += kStepAng;
+      last_trig = k;
+      if (uni(rng) < c.jam_prob) {
+        jam_at = ang + 0.5f * kStepAng;
+      }
+    }
+    stuck_ms = ref - ang > kStuckAngDiff ? stuck_ms + 1 : 0;
+    if (stuck_ms >= kStuckTime && resume_tick < 0) {
+      ref = kStepAng * floorf(ang / kStepAng);
+      resume_tick = k + kBackTime;
+      stuck_ms = 0;
+      res.backoffs++;
+    }
+    float feed_curr = bound(kSpdKp * (bound(kAngKp * (ref - ang), kAngOutMax) - spd), kProfileParams.curr_max);
+
+    bool is_active = profile.update(k, ang, spd, curr, ref, feed_curr);
+    if (profile.isStepStarted()) {
+      legacy_goal = ang + kStepAng;
+      step_ref = ref;
+    }
+    float cmd = is_active ? profile.getCurrRef() : feed_curr;
+    if (is_active && ref < step_ref - 0.5f * kStepAng) {
+      res.fight_ms++;
+    }
+    if (was_active && !is_active) {
+      res.handbacks++;
+      if (ref >= step_ref - 0.5f * kStepAng) {
+        // 到位交还，Feed 回退时的交还本就要换成 Feed 的回退电流，不计入
+        res.max_jump = fmaxf(res.max_jump, fabsf(feed_curr - last_prof_curr));
+        res.legacy_mismatch = fmaxf(res.legacy_mismatch, fabsf(ref - legacy_goal));
+      }
+    }
+    was_active = is_active;
+    last_prof_curr = cmd;
+
+    // 拨盘模型
+    float load = kCoulomb * (spd > 0.0f ? 1.0f : (spd < 0.0f ? -1.0f : 0.0f)) + kViscous * spd;
+    spd += (kProfileParams.kt * cmd - load) / kProfileParams.inertia * 0.001f;
+    ang += spd * 0.001f;
+    if (ang > jam_at) {
+      // 撞上卡死的弹丸，停在该处
+      is_jam_hit = true;
+      ang = jam_at;
+      spd = 0.0f;
+    }
+    if (is_jam_hit && ang < jam_at - kJamFree) {
+      is_jam_hit = false;
+      jam_at = 1e9f;
+    }
+    curr = cmd;
+  }
+  res.slots = (int)(ang / kStepAng + 0.5f);
+  return res;
+}
+/* Exported function definitions ---------------------------------------------*/
+
+int main()
+{
+  const Case cases[] = {
+      {"interval 100 ms", 100, 0.0f},
+      {"interval 60 ms", 60, 0.0f},
+      {"interval 100 ms, 5% jams", 100, 0.05f},
+  };
+  int fail = 0;
+  for (const Case &c : cases) {
+    Result r = run(c);
+    bool ok = r.max_jump < kMaxJump && r.fight_ms == 0;
+    fail += ok ? 0 : 1;
+    printf("%-26s: slots %3d, handbacks %3d, feed backoffs %2d | handback jump %5.2f A | "
+           "legacy goal vs feed ref %5.3f rad %s\n",
+           c.name, r.slots, r.handbacks, r.backoffs, r.max_jump, r.legacy_mismatch, ok ? "ok" : "FAIL");
+  }
+  printf("feed_handback_sim: %s\n", fail == 0 ? "pass" : "FAIL");
+  return fail == 0 ? 0 : 1;
+}
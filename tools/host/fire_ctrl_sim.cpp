@@ -0,0 +1,121 @@
+/**
+ *******************************************************************************
+ * @file      :fire_ctrl_sim.cpp
+ * @brief     : 自瞄射击决策的主机端仿真，对比按命中概率选择拨弹时机与视觉允许即拨弹的命中率
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 视觉始终允许射击，yaw 瞄准误差为 2 Hz 正弦晃动加 3 mrad 的固定偏差，pitch 误差为 2 mrad，
+ *     目标距离 4 m，弹速 23.7 m/s，拨弹间隔不短于 50 ms，仿真 60 s
+ *  2. 弹丸在拨弹后 feed_delay 出膛，出膛时的瞄准误差叠加 4 mrad 的弹道散布，落在小装甲板
+ *     （半宽 65 mm、半高 55 mm）内计为命中；FireCtrl 参数与 ins_feed.cpp 中 kFireCtrlParams 一致
+ *  3. 对比每个晃动幅值下不经 FireCtrl（视觉允许即拨弹）与经 FireCtrl 的每发命中数与每秒命中数：
+ *     晃动大时每发命中数应明显提高，每秒命中数的损失应不超过 15%
+ *  4. 编译运行：tools/host/run.sh fire_ctrl_sim
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "fire_ctrl.hpp"
+/* Private constants ---------------------------------------------------------*/
+const float kPi = 3.14159265f;
+const float kWobbleFreq = 2.0f;     ///< 瞄准晃动频率，单位 Hz
+const float kYawBias = 0.003f;      ///< yaw 瞄准的固定偏差，单位 rad
+const float kPitchErr = 0.002f;     ///< pitch 瞄准误差，单位 rad
+const float kDisp = 0.004f;         ///< 弹道散布的角度标准差，单位 rad
+const float kDist = 4.0f;           ///< 目标距离，单位 m
+const float kBltSpd = 23.7f;        ///< 弹速，单位 m/s
+const int kMinInterval = 50;        ///< 最短拨弹间隔，单位 ms
+const int kSimTicks = 60000;        ///< 仿真时长，单位 ms
+const float kMaxRateLoss = 0.15f;   ///< 每秒命中数的最大损失比例
+
+const robot::FireCtrl::Params kParams = {
+    .feed_delay = 0.03f,
+    .disp_std = 0.004f,
+    .tgt_spd_std = 0.05f,
+    .armor_half_w = 0.065f,
+    .armor_half_h = 0.055f,
+    .default_dist = 4.0f,
+    .min_blt_spd = 15.0f,
+    .p_min = 0.3f,
+    .p_good = 0.7f,
+    .look_ahead = 0.01f,
+    .max_wait = 60,
+};
+/* Private types -------------------------------------------------------------*/
+
+struct Result {
+  int shots;  ///< 发弹数
+  int hits;   ///< 命中数
+};
+/* Private function definitions ----------------------------------------------*/
+
+/** t 时刻的 yaw 瞄准误差，单位 rad */
+static float yawErr(float amp, float t) { return amp * sinf(2.0f * kPi * kWobbleFreq * t) + kYawBias; }
+
+/**
+ * @brief       运行一次仿真
+ * @param        amp: yaw 瞄准晃动幅值，单位 rad
+ * @param        is_gated: 是否经 FireCtrl 选择拨弹时机
+ */
+static Result run(float amp, bool is_gated)
+{
+  robot::FireCtrl fire_ctrl(kParams);
+  std::mt19937 rng(1);
+  std::normal_distribution<float> noise(0.0f, 1.0f);
+  Result res = {0, 0};
+  int last_shot = -kMinInterval;
+  for (int k = 0; k < kSimTicks; k++) {
+    float t = k * 1e-3f;
+    robot::FireCtrl::Input input;
+    input.is_permitted = true;
+    input.aim_err[robot::FireCtrl::kAxisPitch] = kPitchErr;
+    input.aim_err[robot::FireCtrl::kAxisYaw] = yawErr(amp, t);
+    input.err_spd[robot::FireCtrl::kAxisYaw] = (yawErr(amp, t + 1e-3f) - yawErr(amp, t)) / 1e-3f;
+    input.dist = kDist;
+    input.blt_spd = kBltSpd;
+    bool is_allowed = fire_ctrl.update(k, input);
+    if ((is_allowed || !is_gated) && k - last_shot >= kMinInterval) {
+      last_shot = k;
+      res.shots++;
+      float yaw = yawErr(amp, t + kParams.feed_delay) + kDisp * noise(rng);
+      float pitch = kPitchErr + kDisp * noise(rng);
+      if (fabsf(yaw) < kParams.armor_half_w / kDist && fabsf(pitch) < kParams.armor_half_h / kDist) {
+        res.hits++;
+      }
+    }
+  }
+  return res;
+}
+/* Exported function definitions ---------------------------------------------*/
+
+int main()
+{
+  const float amps[] = {0.01f, 0.02f, 0.04f};
+  bool ok = true;
+  for (float amp : amps) {
+    Result open = run(amp, false);
+    Result gated = run(amp, true);
+    float open_ratio = (float)open.hits / open.shots;
+    float gated_ratio = (float)gated.hits / gated.shots;
+    float rate_loss = 1.0f - (float)gated.hits / open.hits;
+    // 晃动小于装甲板半角时无需等待，晃动越大每发命中数的提高应越明显
+    bool case_ok = rate_loss < kMaxRateLoss && gated_ratio >= open_ratio - 0.01f &&
+                   (amp < 0.02f || gated_ratio > open_ratio + 0.1f);
+    printf("wobble %2.0f mrad: ungated %4d shots %.2f hits/blt %5.2f hits/s | gated %4d shots %.2f hits/blt "
+           "%5.2f hits/s | hits/s %+4.0f%% %s\n",
+           amp * 1e3f, open.shots, open_ratio, open.hits * 1e3f / kSimTicks, gated.shots, gated_ratio,
+           gated.hits * 1e3f / kSimTicks, -rate_loss * 100.0f, case_ok ? "ok" : "FAIL");
+    ok = ok && case_ok;
+  }
+  printf("fire_ctrl_sim: %s\n", ok ? "pass" : "FAIL");
+  return ok ? 0 : 1;
+}
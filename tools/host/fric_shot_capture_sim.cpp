@@ -0,0 +1,262 @@
+/**
+ *******************************************************************************
+ * @file      :fric_shot_capture_sim.cpp
+ * @brief     : 摩擦轮前馈脉冲的主机端仿真：先实测脉冲形状，再以实测形状注入，对比掉速
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 摩擦轮模型与 shot_detector_sim.cpp 一致：两个摩擦轮，纯比例速度环（201.5），转速按 1 rpm 量化，
+ *     电流反馈带噪声；弹丸在拨弹后 25 ms 接触摩擦轮 2 ms，15% 为空拨；实测时按 300 ms 间隔单发，
+ *     注入时按 100 ms 间隔连发
+ *  2. 发弹确认与 Robot 一致：ShotDetector 本地检测，下一周期 fetchShot 后调用 FricShotFfd::onShotConfirmed
+ *  3. 实测：capture_on_start 为 true，与 ins_fric.cpp 的出厂配置一致，检查此时从不接管电机输入；
+ *     实测结果与无噪声单发响应比较峰值位置与归一化形状的均方根误差，空拨不应计入
+ *  4. 注入：按 fric_shot_ffd.hpp 的方法从实测结果截取 12 个点、末端 5 个点线性衰减到 0 作为 shape，
+ *     以峰值位置确定 delay，对比不补偿与补偿后（幅值自适应收敛后）每发的最大掉速，
+ *     并检查交还时电机输入的最大跳变；不衰减时末端约为峰值的 0.8，交还时跳变约 8000
+ *  5. 编译运行：tools/host/run.sh fric_shot_capture_sim
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "fric_shot_ffd.hpp"
+#include "shot_detector.hpp"
+/* Private constants ---------------------------------------------------------*/
+const double kInertia = 2e-4;        ///< 摩擦轮转动惯量，单位 kg·m^2
+const double kKt = 0.0156;           ///< 3508 去减速箱力矩常数，单位 N·m/A
+const double kRawPerCurr = 819.2;    ///< 电机原始输入与电流之比，单位 1/A
+const double kSpdRef = 650.0;        ///< 摩擦轮期望转速，单位 rad/s
+const double kSpdKp = 201.5;         ///< 摩擦轮速度环比例系数，单位 电机原始输入/(rad/s)
+const double kBaseRaw = 800.0;       ///< 维持期望转速的稳态输入，单位 电机原始输入
+const double kRpmRes = 0.10472;      ///< 转速反馈分辨率，单位 rad/s
+const double kCurrNoise = 0.05;      ///< 电流反馈噪声标准差，单位 A
+const double kShotEnergy[2] = {0.46, 0.40};  ///< 每发每个摩擦轮损失的能量，单位 J
+const int kContactDelay = 25;        ///< 拨弹到弹丸接触摩擦轮的时延，单位 ms
+const int kContactTime = 2;          ///< 弹丸与摩擦轮的接触时长，单位 ms
+const int kCaptureInterval = 300;    ///< 实测时的拨弹间隔，摩擦轮在两发之间回到稳态，单位 ms
+const int kFeedInterval = 100;       ///< 注入时的拨弹间隔，单位 ms
+const double kEmptyProb = 0.15;      ///< 空拨概率
+const int kSimTicks = 40000;         ///< 仿真时长，单位 ms
+const int kWarmupTicks = 3000;       ///< 摩擦轮起转时长，单位 ms
+const int kStatTicks = 20000;        ///< 注入时从该时刻起统计掉速（幅值已收敛），单位 ms
+const size_t kShapeLen = 12;         ///< 截取的 shape 点数
+const size_t kShapePrePeak = 2;      ///< shape 中峰值的下标
+const size_t kShapeTaper = 5;        ///< shape 末端线性衰减到 0 的点数
+const float kMaxShapeRms = 0.05f;    ///< 实测形状的均方根误差上限
+const float kMinDipCut = 0.25f;      ///< 注入后掉速需降低的最小比例
+const float kMaxJump = 200.0f;       ///< 交还时电机输入跳变的上限，单位 电机原始输入
+
+const float kInitShape[kShapeLen] = {
+    0.35f, 0.80f, 1.00f, 0.95f, 0.80f, 0.62f, 0.46f, 0.33f, 0.22f, 0.14f, 0.08f, 0.04f,
+};
+const robot::FricShotFfd::Params kFfdParams = {
+    .shape = kInitShape,
+    .shape_len = kShapeLen,
+    .delay = 22,
+    .amp_init = 3000.0f,
+    .amp_max = 10000.0f,
+    .adapt_gain = 800.0f,
+    .kp = 201.50f,
+    .raw_per_curr = 819.2f,
+    .out_max = 16384.0f,
+    .base_lpf = 0.05f,
+    .min_spd = 300.0f,
+    .obs_time = 25,
+    .confirm_time = 40,
+    .capture_on_start = true,
+};
+const robot::ShotDetector::Params kDetectorParams = {
+    .inertia_per_kt = 0.0128f,
+    .window = 5,
+    .imp_thres = 0.02f,
+    .base_lpf = 0.02f,
+    .min_spd = 300.0f,
+    .min_gap = 20,
+    .match_time = 150,
+    .late_time = 350,
+    .spd_ratio_init = 0.0366f,
+    .spd_ratio_lpf = 0.05f,
+    .min_blt_spd = 20.0f,
+    .max_blt_spd = 28.0f,
+};
+/* Private types -------------------------------------------------------------*/
+
+struct Result {
+  int pellets;           ///< 实际发出的弹丸数
+  int active_ticks;      ///< 接管电机输入的周期数
+  float dip;             ///< 统计期间每发最大掉速的平均值，单位 rad/s
+  float max_jump;        ///< 交还时电机输入的最大跳变，单位 电机原始输入
+};
+/* Private function definitions ----------------------------------------------*/
+
+/** Fric 的速度环输出 */
+static double fricRaw(double dir, double w)
+{
+  double raw = dir * (kBaseRaw + kSpdKp * (kSpdRef - dir * w));
+  return fmax(fmin(raw, 16384.0), -16384.0);
+}
+
+/**
+ * @brief       运行摩擦轮模型
+ * @param        ffd: 前馈模块，为 nullptr 时不补偿
+ * @param        interval: 拨弹间隔，单位 ms
+ * @param        seed: 随机数种子
+ */
+static Result run(robot::FricShotFfd *ffd, int interval, unsigned seed)
+{
+  robot::ShotDetector detector(kDetectorParams);
+  std::mt19937 rng(seed);
+  std::normal_distribution<double> noise(0.0, 1.0);
+  std::uniform_real_distribution<double> uni(0.0, 1.0);
+
+  const double dirs[2] = {1.0, -1.0};
+  const double visc = kKt * kBaseRaw / kRawPerCurr / kSpdRef;
+  double w[2] = {0.0, 0.0}, curr[2] = {0.0, 0.0}, last_input[2] = {0.0, 0.0};
+  bool was_active = false;
+  int contact = -1, shot_num = 0;
+  double dip_sum = 0.0, dip = 0.0;
+  Result res = {0, 0, 0.0f, 0.0f};
+  for (int k = 0; k < kSimTicks; k++) {
+    while (detector.fetchShot()) {
+      if (ffd != nullptr) {
+        ffd->onShotConfirmed();
+      }
+    }
+    if (k > kWarmupTicks && k % interval == 0) {
+      if (ffd != nullptr) {
+        ffd->trigger(k);
+      }
+      if (uni(rng) > kEmptyProb) {
+        contact = k + kContactDelay;
+        res.pellets++;
+        if (k >= kStatTicks) {
+          dip_sum += dip;
+          shot_num++;
+        }
+        dip = 0.0;
+      }
+    }
+
+    float spd_fdb[2], curr_fdb[2];
+    for (size_t i = 0; i < 2; i++) {
+      spd_fdb[i] = (float)(std::round(w[i] / kRpmRes) * kRpmRes);
+      curr_fdb[i] = (float)(curr[i] + kCurrNoise * noise(rng));
+    }
+    detector.update(k, spd_fdb, curr_fdb);
+
+    double input[2] = {fricRaw(dirs[0], w[0]), fricRaw(dirs[1], w[1])};
+    bool is_active = ffd != nullptr && ffd->update(k, spd_fdb, curr_fdb);
+    if (is_active) {
+      res.active_ticks++;
+      input[0] = ffd->getInput(robot::FricShotFfd::kFricFirst);
+      input[1] = ffd->getInput(robot::FricShotFfd::kFricSecond);
+    } else if (was_active) {
+      for (size_t i = 0; i < 2; i++) {
+        res.max_jump = fmaxf(res.max_jump, (float)fabs(input[i] - last_input[i]));
+      }
+    }
+    was_active = is_active;
+
+    bool is_contact = contact >= 0 && k >= contact && k < contact + kContactTime;
+    for (size_t i = 0; i < 2; i++) {
+      last_input[i] = input[i];
+      curr[i] = input[i] / kRawPerCurr;
+      double tor = kKt * curr[i] - visc * w[i];
+      if (is_contact) {
+        tor -= dirs[i] * kShotEnergy[i] / (fabs(w[i]) * kContactTime * 0.001);
+      }
+      w[i] += tor / kInertia * 0.001;
+      dip = fmax(dip, kSpdRef - dirs[i] * w[i]);
+    }
+  }
+  res.dip = shot_num > 0 ? (float)(dip_sum / shot_num) : 0.0f;
+  return res;
+}
+
+/** 无噪声单发的电流响应（相对稳态、两轮平均、按峰值归一化），下标为拨弹后的周期数 */
+static size_t idealResponse(float shape[robot::FricShotFfd::kCaptureLen])
+{
+  const double dirs[2] = {1.0, -1.0};
+  const double visc = kKt * kBaseRaw / kRawPerCurr / kSpdRef;
+  double w[2] = {kSpdRef, -kSpdRef};
+  double base[2] = {0.0, 0.0};
+  for (size_t i = 0; i < 2; i++) {
+    base[i] = dirs[i] * fricRaw(dirs[i], w[i]);
+  }
+  // 电流反馈为上一周期的输入，shape[0] 为拨弹前一周期
+  size_t peak = 0;
+  shape[0] = 0.0f;
+  for (size_t k = 0; k + 1 < robot::FricShotFfd::kCaptureLen; k++) {
+    bool is_contact = (int)k >= kContactDelay && (int)k < kContactDelay + kContactTime;
+    shape[k + 1] = 0.0f;
+    for (size_t i = 0; i < 2; i++) {
+      double raw = fricRaw(dirs[i], w[i]);
+      shape[k + 1] += (float)(0.5 * (dirs[i] * raw - base[i]));
+      double tor = kKt * raw / kRawPerCurr - visc * w[i];
+      if (is_contact) {
+        tor -= dirs[i] * kShotEnergy[i] / (fabs(w[i]) * kContactTime * 0.001);
+      }
+      w[i] += tor / kInertia * 0.001;
+    }
+    peak = shape[k + 1] > shape[peak] ? k + 1 : peak;
+  }
+  float scale = 1.0f / shape[peak];
+  for (size_t k = 0; k < robot::FricShotFfd::kCaptureLen; k++) {
+    shape[k] *= scale;
+  }
+  return peak;
+}
+/* Exported function definitions ---------------------------------------------*/
+
+int main()
+{
+  const size_t kLen = robot::FricShotFfd::kCaptureLen;
+  float ideal[kLen], captured[kLen];
+  size_t ideal_peak = idealResponse(ideal);
+
+  // 实测
+  robot::FricShotFfd capture_ffd(kFfdParams);
+  Result cap = run(&capture_ffd, kCaptureInterval, 1);
+  size_t peak = capture_ffd.getCapture(captured);
+  double err_sq = 0.0;
+  for (size_t k = 0; k < kLen; k++) {
+    err_sq += (captured[k] - ideal[k]) * (captured[k] - ideal[k]);
+  }
+  float shape_rms = (float)sqrt(err_sq / kLen);
+  printf("capture   : pellets %3d captured %3u | peak %2zu (ideal %2zu) shape rms err %.3f | active ticks %d\n",
+         cap.pellets, capture_ffd.getCaptureCnt(), peak, ideal_peak, shape_rms, cap.active_ticks);
+
+  // 按实测结果截取 shape 与 delay 后注入
+  float shape[kShapeLen];
+  for (size_t i = 0; i < kShapeLen; i++) {
+    size_t k = peak + i - kShapePrePeak;
+    float taper = fminf(1.0f, (float)(kShapeLen - 1 - i) / kShapeTaper);
+    shape[i] = k < kLen ? captured[k] * taper : 0.0f;
+  }
+  robot::FricShotFfd::Params inject_params = kFfdParams;
+  inject_params.shape = shape;
+  inject_params.delay = peak - kShapePrePeak;
+  inject_params.capture_on_start = false;
+  robot::FricShotFfd inject_ffd(inject_params);
+  Result none = run(nullptr, kFeedInterval, 2);
+  Result inject = run(&inject_ffd, kFeedInterval, 2);
+  printf("inject    : delay %2u | dip without ffd %5.2f rad/s, with ffd %5.2f rad/s (amp %.0f, %.0f) | "
+         "handback jump %.0f\n",
+         inject_params.delay, none.dip, inject.dip, inject_ffd.getAmp(robot::FricShotFfd::kFricFirst),
+         inject_ffd.getAmp(robot::FricShotFfd::kFricSecond), inject.max_jump);
+
+  // 空拨未确认，实测发数不多于弹丸数；弹丸间隔大于 kCaptureLen，每发都应计入
+  bool ok = cap.active_ticks == 0 && capture_ffd.getCaptureCnt() == (uint32_t)cap.pellets && peak == ideal_peak &&
+            shape_rms < kMaxShapeRms && inject.dip < (1.0f - kMinDipCut) * none.dip && inject.max_jump < kMaxJump;
+  printf("fric_shot_capture_sim: %s\n", ok ? "pass" : "FAIL");
+  return ok ? 0 : 1;
+}
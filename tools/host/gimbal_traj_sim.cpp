@@ -0,0 +1,132 @@
+/**
+ *******************************************************************************
+ * @file      :gimbal_traj_sim.cpp
+ * @brief     : yaw 关节大角度跳变（180° 转头、视觉换目标）的主机端仿真，对比直接阶跃与 TimeOptimalTraj
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 关节模型 J * dd(ang) = tor - 库仑摩擦 - 粘滞摩擦，力矩滞后一个控制周期生效，控制周期 1 ms
+ *  2. 控制器为 Gimbal/Instance/src/ins_pid.cpp 中 yaw 的串级 PID（角度环 kp 20.5、kd 5、输出 20 rad/s，
+ *     速度环 kp 1.86、输出 6.9 N·m），轨迹参数与 ins_filter.cpp 中 kTrajParamsYaw 一致；
+ *     使用轨迹时与 Gimbal::calcJointTorRef 相同，加入 J * 轨迹加速度与速度环 kp * 轨迹角速度的力矩前馈
+ *  3. 调整时间为误差最后一次进入 0.01 rad 以内的时刻，超调为越过目标的最大角度
+ *  4. 编译运行：tools/host/run.sh gimbal_traj_sim
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <cmath>
+#include <cstdio>
+
+#include "time_optimal_traj.hpp"
+/* Private constants ---------------------------------------------------------*/
+const float kPi = 3.14159265f;
+const float kDt = 0.001f;          ///< 控制周期，单位 s
+const float kInertia = 0.05f;      ///< yaw 关节转动惯量，单位 kg·m^2
+const float kCoulomb = 0.08f;      ///< 库仑摩擦力矩，单位 N·m
+const float kViscous = 0.01f;      ///< 粘滞摩擦系数，单位 N·m/(rad/s)
+const float kAngKp = 20.5f;        ///< 角度环比例系数
+const float kAngKd = 5.0f;         ///< 角度环微分系数（按周期差分）
+const float kAngOutMax = 20.0f;    ///< 角度环输出限幅，单位 rad/s
+const float kSpdKp = 1.86f;        ///< 速度环比例系数，单位 N·m/(rad/s)
+const float kTorMax = 6.9f;        ///< 输出力矩限幅，单位 N·m
+const float kSettleBand = 0.01f;   ///< 调整时间的误差带，单位 rad
+const int kSimTicks = 3000;        ///< 仿真时长，单位 ms
+
+const robot::TimeOptimalTraj::Params kTrajParams = {
+    .acc_max = 100.0f,
+    .spd_max = 15.0f,
+    .period = 2 * kPi,
+};
+/* Private types -------------------------------------------------------------*/
+
+struct Case {
+  const char *name;
+  float goal;         ///< 目标角度，单位 rad
+  int retarget_tick;  ///< 目标移动的时刻，单位 ms，小于 0 时不移动
+  float retarget;     ///< 移动后的目标角度，单位 rad
+};
+
+struct Result {
+  int settle_ms;    ///< 调整时间，单位 ms
+  float overshoot;  ///< 超调，单位 rad
+};
+/* Private function definitions ----------------------------------------------*/
+
+static float wrap(float a)
+{
+  a = fmodf(a, 2 * kPi);
+  if (a >= kPi) {
+    a -= 2 * kPi;
+  } else if (a < -kPi) {
+    a += 2 * kPi;
+  }
+  return a;
+}
+
+static float bound(float x, float lim) { return x > lim ? lim : (x < -lim ? -lim : x); }
+
+static Result run(const Case &c, bool use_traj)
+{
+  robot::TimeOptimalTraj traj(kTrajParams);
+  traj.reset(0.0f, 0.0f);
+  float ang = 0.0f, spd = 0.0f, tor_applied = 0.0f, last_err = 0.0f;
+  Result res = {-1, 0.0f};
+  int last_out = 0;
+  for (int k = 0; k < kSimTicks; k++) {
+    float goal = (c.retarget_tick >= 0 && k >= c.retarget_tick) ? c.retarget : c.goal;
+    float ref = goal, ffd = 0.0f;
+    if (use_traj) {
+      traj.calc(goal, 0.0f, kDt);
+      ref = traj.getAng();
+      ffd = kInertia * traj.getAcc() + kSpdKp * traj.getSpd();
+    }
+    float err = wrap(ref - ang);
+    float spd_ref = bound(kAngKp * err + kAngKd * (err - last_err), kAngOutMax);
+    last_err = err;
+    float tor = bound(kSpdKp * (spd_ref - spd) + ffd, kTorMax);
+
+    float fric = kCoulomb * (spd > 0.0f ? 1.0f : (spd < 0.0f ? -1.0f : 0.0f)) + kViscous * spd;
+    spd += (tor_applied - fric) / kInertia * kDt;
+    ang += spd * kDt;
+    tor_applied = tor;
+
+    float goal_err = wrap(goal - ang);
+    if (c.retarget_tick < 0 || k >= c.retarget_tick) {
+      // 越过目标为超调，目标方向由最终目标相对起点确定
+      float dir = wrap(goal) >= 0.0f ? 1.0f : -1.0f;
+      res.overshoot = fmaxf(res.overshoot, -dir * goal_err);
+    }
+    if (fabsf(goal_err) > kSettleBand) {
+      last_out = k + 1;
+    }
+  }
+  res.settle_ms = last_out;
+  return res;
+}
+/* Exported function definitions ---------------------------------------------*/
+
+int main()
+{
+  const Case cases[] = {
+      {"turn 180 deg", kPi - 0.001f, -1, 0.0f},
+      {"retarget 1 rad", 1.0f, -1, 0.0f},
+      {"retarget 1 -> 2 rad @80ms", 1.0f, 80, 2.0f},
+  };
+  int fail = 0;
+  for (const Case &c : cases) {
+    Result step = run(c, false);
+    Result traj = run(c, true);
+    // 轨迹需比直接阶跃更快收敛，且超调不超过误差带
+    bool ok = traj.settle_ms < step.settle_ms && traj.overshoot < kSettleBand;
+    fail += ok ? 0 : 1;
+    printf("%-30s step: settle %4d ms, overshoot %6.3f rad | traj: settle %4d ms, overshoot %6.4f rad %s\n", c.name,
+           step.settle_ms, step.overshoot, traj.settle_ms, traj.overshoot, ok ? "ok" : "FAIL");
+  }
+  printf("gimbal_traj_sim: %s\n", fail == 0 ? "pass" : "FAIL");
+  return fail == 0 ? 0 : 1;
+}
@@ -0,0 +1,128 @@
+/**
+ *******************************************************************************
+ * @file      :heat_sched_sim.cpp
+ * @brief     : 枪管热量调度的主机端仿真，对比固定拨弹限制与 HeatSched 在裁判系统数据滞后时的发弹
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 热量上限 100，每秒冷却 20，按 10 Hz 结算；裁判系统热量滞后 60 ms 到达，发弹事件滞后 40 ms 到达
+ *  2. 持续按住射击，Feed 自身的热量检查按裁判系统热量加热量余量不超过上限建模，
+ *     与 Robot 一致：固定限制为余量 3 发、间隔 50 ms，调度时取 HeatSched 的余量与间隔；
+ *     HeatSched 参数与 ins_feed.cpp 中 kHeatSchedParams 一致
+ *  3. 每 10 s 中有 1 s 视觉给出高价值目标，统计这 4 个窗口内的发弹数、总发弹数、峰值热量与超限时间：
+ *     调度后高价值窗口内的发弹数应更多，持续射速不应明显下降，且不超限
+ *  4. 编译运行：tools/host/run.sh heat_sched_sim
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <cstdio>
+#include <deque>
+
+#include "heat_sched.hpp"
+/* Private constants ---------------------------------------------------------*/
+const float kHeatLimit = 100.0f;  ///< 热量上限
+const float kCoolingPs = 20.0f;   ///< 每秒冷却值
+const int kCoolPeriod = 100;      ///< 裁判系统结算周期，单位 ms
+const int kRfrLag = 60;           ///< 裁判系统热量到达云台的时延，单位 ms
+const int kShotLag = 40;          ///< 发弹事件到达云台的时延，单位 ms
+const float kFixedSafeBlt = 3.0f; ///< 固定拨弹限制的热量余量，单位 发
+const uint32_t kFixedInterval = 50;  ///< 固定拨弹限制的间隔，单位 ms
+const int kSimTicks = 40000;      ///< 仿真时长，单位 ms
+
+const robot::HeatSched::Params kParams = {
+    .heat_per_blt = 10.0f,
+    .safe_blt = 3.0f,
+    .reserve_blt = 3.0f,
+    .min_interval = 50,
+    .max_interval = 500,
+};
+/* Private types -------------------------------------------------------------*/
+
+struct Result {
+  int shots;       ///< 总发弹数
+  int hv_shots;    ///< 高价值目标窗口内的发弹数
+  float max_heat;  ///< 峰值热量
+  float over;      ///< 超限的热量与时间之积，单位 热量·s
+};
+
+struct RfrHeat {
+  int tick;    ///< 到达云台的时间戳，单位 ms
+  float heat;  ///< 裁判系统热量
+};
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief       运行一次仿真
+ * @param        is_sched: 是否按 HeatSched 设置拨弹限制
+ */
+static Result run(bool is_sched)
+{
+  robot::HeatSched sched(kParams);
+  std::deque<RfrHeat> rfr_queue;
+  std::deque<int> shot_queue;
+  float heat = 0.0f, rfr_heat = 0.0f;
+  int last_shot = -(int)kParams.max_interval;
+  Result res = {0, 0, 0.0f, 0.0f};
+  for (int k = 0; k < kSimTicks; k++) {
+    if (k % kCoolPeriod == 0) {
+      heat -= kCoolingPs * kCoolPeriod * 0.001f;
+      heat = heat < 0.0f ? 0.0f : heat;
+      rfr_queue.push_back({k + kRfrLag, heat});
+    }
+    while (!rfr_queue.empty() && rfr_queue.front().tick <= k) {
+      rfr_heat = rfr_queue.front().heat;
+      rfr_queue.pop_front();
+    }
+    bool is_high_value = k % 10000 >= 5000 && k % 10000 < 6000;
+
+    float safe_blt = kFixedSafeBlt;
+    uint32_t interval = kFixedInterval;
+    if (is_sched) {
+      sched.updateRfrData(true, rfr_heat, kHeatLimit, kCoolingPs);
+      while (!shot_queue.empty() && shot_queue.front() <= k) {
+        sched.onShot();
+        shot_queue.pop_front();
+      }
+      sched.update(k, is_high_value);
+      safe_blt = sched.getSafeNumBlt();
+      interval = sched.getTriggerInterval();
+    }
+
+    if (k - last_shot >= (int)interval && rfr_heat + safe_blt * kParams.heat_per_blt <= kHeatLimit) {
+      last_shot = k;
+      res.shots++;
+      res.hv_shots += is_high_value ? 1 : 0;
+      heat += kParams.heat_per_blt;
+      shot_queue.push_back(k + kShotLag);
+    }
+    if (heat > kHeatLimit) {
+      res.over += (heat - kHeatLimit) * 0.001f;
+    }
+    res.max_heat = heat > res.max_heat ? heat : res.max_heat;
+  }
+  return res;
+}
+
+static void print(const char *name, const Result &r)
+{
+  printf("%-6s: shots %3d (%.2f/s) | high-value window shots %2d | max heat %3.0f | over limit %.1f heat*s\n",
+         name, r.shots, r.shots * 1000.0f / kSimTicks, r.hv_shots, r.max_heat, r.over);
+}
+/* Exported function definitions ---------------------------------------------*/
+
+int main()
+{
+  Result fixed = run(false);
+  Result sched = run(true);
+  print("fixed", fixed);
+  print("sched", sched);
+  bool ok = sched.hv_shots > fixed.hv_shots && sched.shots >= 0.95f * fixed.shots && sched.over == 0.0f &&
+            sched.max_heat <= kHeatLimit;
+  printf("heat_sched_sim: %s\n", ok ? "pass" : "FAIL");
+  return ok ? 0 : 1;
+}
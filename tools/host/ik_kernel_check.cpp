@@ -0,0 +1,167 @@
+/**
+ *******************************************************************************
+ * @file      :ik_kernel_check.cpp
+ * @brief     : OmniIkKernel 与通用全向轮逆解的主机端容差比对
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 参考解按 ChassisIkSolver 的全向轮逆解逐轮计算（双精度）：先将图传坐标系下的运动向量旋转
+ *     -theta_i2r 到底盘坐标系，轮心速度 = v + w x p，轮子转速 = 轮心速度在轮子速度方向上的投影 / 半径
+ *  2. 轮组几何与 Chassis/Instance/Src/ins_chassis_iksolver.cpp 中 InitChassisIkSolver 的配置一致，
+ *     修改其中的轮组参数时需同步修改本文件的 kWheels
+ *  3. 同时检查正解、力分配与加权电流分配与逆解雅可比矩阵的一致性
+ *  4. 编译运行：tools/host/run.sh ik_kernel_check
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "omni_ik_kernel.hpp"
+/* Private constants ---------------------------------------------------------*/
+const double kPi = 3.14159265358979323846;
+const float kWheelRadius = 77.86 * 0.001;   ///< 与 ins_chassis_iksolver.cpp 一致 [m]
+const float kWheel2Center = 216.91 * 0.001;  ///< 与 ins_chassis_iksolver.cpp 一致 [m]
+const double kWheelBase = kWheel2Center * sqrt(2.0);
+const double kWheelTrack = kWheel2Center * sqrt(2.0);
+
+/** 绝对误差容限，float 与 double 的舍入差异，单位与被比较量一致 */
+const double kAbsTol = 2e-4;
+/** 相对误差容限 */
+const double kRelTol = 2e-5;
+const int kCaseNum = 20000;
+/* Private types -------------------------------------------------------------*/
+
+struct WheelCfg {
+  double theta_vel_fdb;  ///< 轮子速度方向，单位 rad
+  double px;             ///< 轮子位置，前方为正，单位 m
+  double py;             ///< 轮子位置，左方为正，单位 m
+};
+/* Private variables ---------------------------------------------------------*/
+
+/** 左前，左后，右后，右前，与 InitChassisIkSolver 一致 */
+const WheelCfg kWheels[robot::OmniIkKernel::kWheelNum] = {
+    {-kPi / 4, kWheelTrack / 2, kWheelBase / 2},
+    {kPi / 4, -kWheelTrack / 2, kWheelBase / 2},
+    {kPi * 3 / 4, -kWheelTrack / 2, -kWheelBase / 2},
+    {-kPi * 3 / 4, kWheelTrack / 2, -kWheelBase / 2},
+};
+
+constexpr robot::OmniIkKernel kKernel = robot::OmniIkKernel({
+    .wheel_radius = kWheelRadius,
+    .wheel2center = kWheel2Center,
+});
+
+double max_err = 0.0;
+int fail_cnt = 0;
+/* Private function prototypes -----------------------------------------------*/
+
+static void RefIk(const double twist_i[3], double theta_i2r, double rot_spds[4])
+{
+  double c = cos(theta_i2r), s = sin(theta_i2r);
+  double vx = c * twist_i[0] + s * twist_i[1];
+  double vy = -s * twist_i[0] + c * twist_i[1];
+  double w = twist_i[2];
+  for (size_t i = 0; i < 4; i++) {
+    double wx = vx - w * kWheels[i].py;
+    double wy = vy + w * kWheels[i].px;
+    rot_spds[i] = (wx * cos(kWheels[i].theta_vel_fdb) + wy * sin(kWheels[i].theta_vel_fdb)) / kWheelRadius;
+  }
+}
+
+static void Check(const char *name, double val, double ref)
+{
+  double err = fabs(val - ref);
+  if (err > max_err) {
+    max_err = err;
+  }
+  if (err > kAbsTol + kRelTol * fabs(ref)) {
+    if (fail_cnt < 10) {
+      printf("  %s: got %.7f, expected %.7f\n", name, val, ref);
+    }
+    fail_cnt++;
+  }
+}
+
+int main()
+{
+  std::mt19937 rng(20240601);
+  std::uniform_real_distribution<double> lin(-4.0, 4.0);
+  std::uniform_real_distribution<double> ang(-12.0, 12.0);
+  std::uniform_real_distribution<double> theta(-2.0 * kPi, 2.0 * kPi);
+  std::uniform_real_distribution<double> weight(0.05, 1.0);
+
+  for (int k = 0; k < kCaseNum; k++) {
+    double twist_d[3] = {lin(rng), lin(rng), ang(rng)};
+    float twist[3] = {(float)twist_d[0], (float)twist_d[1], (float)twist_d[2]};
+    double th = theta(rng);
+
+    // 逆解：图传坐标系与底盘坐标系任务放在同一批
+    float spds_i[4], spds_r[4];
+    robot::OmniIkKernel::IkJob jobs[2] = {
+        {twist, robot::OmniIkKernel::Frame::kImage, spds_i},
+        {twist, robot::OmniIkKernel::Frame::kRobot, spds_r},
+    };
+    kKernel.solve(jobs, 2, (float)th);
+    double ref_i[4], ref_r[4];
+    RefIk(twist_d, th, ref_i);
+    RefIk(twist_d, 0.0, ref_r);
+    for (size_t i = 0; i < 4; i++) {
+      Check("ik image", spds_i[i], ref_i[i]);
+      Check("ik robot", spds_r[i], ref_r[i]);
+    }
+
+    // 正解：四轮转速一致时应精确还原
+    float twist_fk[3];
+    kKernel.fkSolve(spds_r, twist_fk);
+    float w_all[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    float w_three[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    w_three[k % 4] = 0.0f;
+    float twist_wls[3], twist_three[3];
+    kKernel.fkSolveWls(spds_r, w_all, twist_wls);
+    kKernel.fkSolveWls(spds_r, w_three, twist_three);
+    for (size_t r = 0; r < 3; r++) {
+      Check("fk", twist_fk[r], twist_d[r]);
+      Check("fk wls", twist_wls[r], twist_d[r]);
+      Check("fk three wheels", twist_three[r], twist_d[r]);
+    }
+
+    // 力分配：J^T * out 应还原广义力
+    float wrench[3] = {(float)(lin(rng) * 20.0), (float)(lin(rng) * 20.0), (float)(lin(rng) * 5.0)};
+    float wheel[4];
+    kKernel.wrenchToWheel(wrench, wheel);
+    const auto &jac = kKernel.jacobian();
+    for (size_t r = 0; r < 3; r++) {
+      double sum = 0.0;
+      for (size_t i = 0; i < 4; i++) {
+        sum += (double)jac[i][r] * wheel[i];
+      }
+      Check("wrench", sum, wrench[r]);
+    }
+
+    // 加权电流分配：保持 J^T * I 不变
+    float cur_in[4], weights[4], cur_out[4];
+    for (size_t i = 0; i < 4; i++) {
+      cur_in[i] = (float)(lin(rng) * 3.0);
+      weights[i] = (float)weight(rng);
+    }
+    kKernel.allocateWls(cur_in, weights, cur_out);
+    for (size_t r = 0; r < 3; r++) {
+      double sum_in = 0.0, sum_out = 0.0;
+      for (size_t i = 0; i < 4; i++) {
+        sum_in += (double)jac[i][r] * cur_in[i];
+        sum_out += (double)jac[i][r] * cur_out[i];
+      }
+      Check("wls alloc", sum_out, sum_in);
+    }
+  }
+
+  printf("ik_kernel_check: %d cases, max abs err %.3e, %d out of tolerance\n", kCaseNum, max_err, fail_cnt);
+  return fail_cnt == 0 ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+/**
+ *******************************************************************************
+ * @file      :joint_fusion_sim.cpp
+ * @brief     : 云台 yaw 关节融合的主机端仿真，检查底盘陀螺仪刻度误差下的世界系 yaw 误差与刻度系数估计
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 底盘前 2 s 静止，之后以 8 ± 2 rad/s（3 rad/s 正弦）小陀螺；yaw 关节相对底盘做 0.5 rad/s 的正弦运动；
+ *     IMU 与编码器之间有 20 mrad 的安装偏差
+ *  2. 噪声：IMU 角度 3 mrad，编码器角速度 0.3 rad/s，IMU 角速度 0.05 rad/s，底盘陀螺仪 0.01 rad/s；
+ *     底盘陀螺仪另有刻度误差
+ *  3. 参数与 ins_filter.cpp 中 kFusionParamsYaw 一致，对比 scale_tau 为 0（不估计刻度系数）与 5 s，
+ *     统计 12 s 之后世界系 yaw 的最大误差：估计刻度系数后误差应与刻度误差无关，刻度系数应收敛到 1 / (1 + 刻度误差)
+ *  4. 编译运行：tools/host/run.sh joint_fusion_sim
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "joint_fdb_fusion.hpp"
+/* Private constants ---------------------------------------------------------*/
+const float kPeriod = 6.2831853f;
+const float kDt = 0.001f;          ///< 控制周期，单位 s
+const float kSpinStart = 2.0f;     ///< 开始小陀螺的时刻，单位 s
+const float kStatStart = 12.0f;    ///< 开始统计误差的时刻，单位 s
+const int kSimTicks = 20000;       ///< 仿真时长，单位 ms
+const float kMountErr = 0.02f;     ///< IMU 与编码器之间的安装偏差，单位 rad
+const float kMaxErr = 0.005f;      ///< 估计刻度系数后世界系 yaw 的最大误差上限，单位 rad
+const float kMaxScaleErr = 0.002f; ///< 刻度系数估计的误差上限
+
+const robot::JointFdbFusion::Params kParams = {
+    .ang_tau = 0.5f,
+    .spd_tau = 0.0f,
+    .period = kPeriod,
+    .scale_tau = 5.0f,
+    .scale_min_spd = 3.0f,
+    .scale_max_err = 0.1f,
+};
+/* Private types -------------------------------------------------------------*/
+
+struct Result {
+  float max_err;  ///< 统计期间世界系 yaw 的最大误差，单位 rad
+  float scale;    ///< 刻度系数估计值
+};
+/* Private function definitions ----------------------------------------------*/
+
+/**
+ * @brief       运行一次仿真
+ * @param        scale_tau: 刻度系数估计的遗忘时间常数，单位 s
+ * @param        scale_err: 底盘陀螺仪的刻度误差
+ */
+static Result run(float scale_tau, float scale_err)
+{
+  robot::JointFdbFusion::Params params = kParams;
+  params.scale_tau = scale_tau;
+  robot::JointFdbFusion fusion(params);
+  std::mt19937 rng(3);
+  std::normal_distribution<float> imu_ang_noise(0.0f, 0.003f), motor_spd_noise(0.0f, 0.3f),
+      imu_spd_noise(0.0f, 0.05f), base_spd_noise(0.0f, 0.01f);
+
+  float chassis = 0.0f, joint = 0.0f;
+  Result res = {0.0f, 0.0f};
+  for (int k = 0; k < kSimTicks; k++) {
+    float t = k * kDt;
+    float chassis_spd = t < kSpinStart ? 0.0f : 8.0f + 2.0f * sinf(3.0f * t);
+    float joint_spd = 0.5f * sinf(5.0f * t);
+    chassis += chassis_spd * kDt;
+    joint += joint_spd * kDt;
+    float world = chassis + joint + kMountErr;
+    float imu_ang = remainderf(world + imu_ang_noise(rng), kPeriod);
+    fusion.update(joint, joint_spd + motor_spd_noise(rng), imu_ang, chassis_spd + joint_spd + imu_spd_noise(rng),
+                  (1.0f + scale_err) * chassis_spd + base_spd_noise(rng), kDt);
+    if (t > kStatStart) {
+      res.max_err = fmaxf(res.max_err, fabsf(remainderf(fusion.getAng() - world, kPeriod)));
+    }
+  }
+  res.scale = fusion.getBaseScale();
+  return res;
+}
+/* Exported function definitions ---------------------------------------------*/
+
+int main()
+{
+  const float scale_errs[] = {0.0f, 0.03f, -0.05f, 0.08f};
+  bool ok = true;
+  for (float scale_err : scale_errs) {
+    Result off = run(0.0f, scale_err);
+    Result on = run(kParams.scale_tau, scale_err);
+    bool case_ok = on.max_err < kMaxErr && fabsf(on.scale - 1.0f / (1.0f + scale_err)) < kMaxScaleErr;
+    printf("gyro scale err %+3.0f%%: max world-yaw err %6.1f mrad without estimate, %4.1f mrad with (scale %.4f) %s\n",
+           scale_err * 100.0f, off.max_err * 1e3f, on.max_err * 1e3f, on.scale, case_ok ? "ok" : "FAIL");
+    ok = ok && case_ok;
+  }
+  printf("joint_fusion_sim: %s\n", ok ? "pass" : "FAIL");
+  return ok ? 0 : 1;
+}
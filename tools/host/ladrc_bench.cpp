@@ -0,0 +1,230 @@
+/**
+ *******************************************************************************
+ * @file      :ladrc_bench.cpp
+ * @brief     : Ladrc 在关节刚体模型上的主机端稳态误差与阶跃测试
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 关节模型 J * dd(ang) = tor + tor_dist，控制周期 1 ms，力矩零阶保持，模型按 0.1 ms 积分，
+ *     角速度反馈为真实角速度（IMU）
+ *  2. 参数与 Gimbal/Instance/src/ins_adrc.cpp 中的 pitch 一致，扰动为常值重力力矩，
+ *     ffd 为对其的补偿（准确、偏大 20%、为 0），检查保持与阶跃后的稳态误差
+ *  3. 同时给出观测器使用含 ffd 总力矩的旧写法的稳态误差作对比，理论值为 -b0 * ffd / wc^2
+ *  4. 扰动抑制：yaw 关节 J = 0.05 kg·m^2，力矩滞后一个控制周期生效，角速度反馈带 0.02 rad/s 的噪声，
+ *     保持 0 rad；扰动为小陀螺带来的 0.3 N·m 拖曳力矩加 0.1 N·m、3 Hz 的波动，以及每 100 ms 一次
+ *     1.5 N·m、5 ms 的发射后坐力矩；对比 ins_pid.cpp 中 yaw 的串级 PID（角度环 kp 20.5、kd 5，
+ *     速度环 kp 1.86）与 ins_adrc.cpp 中 yaw 的 Ladrc，两者均无 ffd，统计 0.5 s 之后的最大与均方根误差
+ *  5. 编译运行：tools/host/run.sh ladrc_bench
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "ladrc.hpp"
+/* Private constants ---------------------------------------------------------*/
+const float kDt = 0.001f;           ///< 控制周期，单位 s
+const int kSubSteps = 10;           ///< 每个控制周期的模型积分步数
+const float kInertia = 0.02f;       ///< 关节转动惯量，单位 kg·m^2，b0 = 1 / J
+const float kDistTor = -1.0f;       ///< 常值扰动力矩，单位 N·m
+const float kStepAng = 0.2f;        ///< 阶跃幅值，单位 rad
+const int kSettleTicks = 1000;      ///< 保持与阶跃后各运行的周期数
+const float kSsErrTol = 1e-3f;      ///< 稳态误差容限，单位 rad
+const float kOvershootTol = 0.15f;  ///< 阶跃超调容限，相对阶跃幅值
+
+const float kPi = 3.14159265f;
+const float kYawInertia = 0.05f;    ///< yaw 关节转动惯量，单位 kg·m^2
+const float kSpinDrag = 0.3f;       ///< 小陀螺拖曳力矩，单位 N·m
+const float kRippleTor = 0.1f;      ///< 拖曳力矩波动幅值，单位 N·m
+const float kRippleFreq = 3.0f;     ///< 拖曳力矩波动频率，单位 Hz
+const float kRecoilTor = 1.5f;      ///< 发射后坐力矩，单位 N·m
+const int kRecoilTicks = 5;         ///< 发射后坐力矩持续时间，单位 ms
+const int kRecoilPeriod = 100;      ///< 发射间隔，单位 ms
+const float kGyroNoise = 0.02f;     ///< 角速度反馈噪声标准差，单位 rad/s
+const int kDistTicks = 3000;        ///< 扰动抑制仿真时长，单位 ms
+const int kDistStatTicks = 500;     ///< 开始统计误差的时刻，单位 ms
+const float kAngKp = 20.5f;         ///< yaw 角度环比例系数
+const float kAngKd = 5.0f;          ///< yaw 角度环微分系数（按周期差分）
+const float kAngOutMax = 20.0f;     ///< yaw 角度环输出限幅，单位 rad/s
+const float kSpdKp = 1.86f;         ///< yaw 速度环比例系数，单位 N·m/(rad/s)
+const float kMaxDistErr = 5e-3f;    ///< Ladrc 扰动抑制的最大误差容限，单位 rad
+
+const robot::Ladrc::Params kParams = {
+    .b0 = 50.0f,
+    .wc = 30.0f,
+    .wo = 120.0f,
+    .out_max = 6.9f,
+    .period = 0.0f,
+};
+const robot::Ladrc::Params kParamsYaw = {
+    .b0 = 20.0f,
+    .wc = 30.0f,
+    .wo = 120.0f,
+    .out_max = 6.9f,
+    .period = 2 * kPi,
+};
+/* Private types -------------------------------------------------------------*/
+
+/** 观测器使用含 ffd 总力矩的旧写法，仅用于对比 */
+class LegacyLadrc
+{
+ public:
+  float calc(float ang_ref, float spd_ref, float ang_fdb, float spd_fdb, float ffd, float dt)
+  {
+    if (!is_inited_) {
+      z1_ = spd_fdb;
+      is_inited_ = true;
+    }
+    float wo = kParams.wo;
+    float e = spd_fdb - z1_;
+    z1_ += (z2_ + kParams.b0 * u_ + 2.0f * wo * e) * dt;
+    z2_ += wo * wo * e * dt;
+    float wc = kParams.wc;
+    float u = (wc * wc * (ang_ref - ang_fdb) + 2.0f * wc * (spd_ref - z1_) - z2_) / kParams.b0 + ffd;
+    u_ = fmaxf(fminf(u, kParams.out_max), -kParams.out_max);
+    return u_;
+  }
+
+ private:
+  bool is_inited_ = false;
+  float z1_ = 0.0f;
+  float z2_ = 0.0f;
+  float u_ = 0.0f;
+};
+
+struct Result {
+  float hold_err;   ///< 保持 0 rad 时的稳态误差，单位 rad
+  float step_err;   ///< 阶跃后的稳态误差，单位 rad
+  float overshoot;  ///< 阶跃超调，相对阶跃幅值
+};
+
+struct DistResult {
+  float max_err;  ///< 最大误差，单位 rad
+  float rms_err;  ///< 均方根误差，单位 rad
+};
+
+/** ins_pid.cpp 中 yaw 的串级 PID，积分与微分滤波均未启用 */
+class CascadePid
+{
+ public:
+  float calc(float ang_ref, float ang_fdb, float spd_fdb)
+  {
+    float err = ang_ref - ang_fdb;
+    float spd_ref = fmaxf(fminf(kAngKp * err + kAngKd * (err - last_err_), kAngOutMax), -kAngOutMax);
+    last_err_ = err;
+    return fmaxf(fminf(kSpdKp * (spd_ref - spd_fdb), kParamsYaw.out_max), -kParamsYaw.out_max);
+  }
+
+ private:
+  float last_err_ = 0.0f;
+};
+/* Private function definitions ----------------------------------------------*/
+
+template <typename Ctrl, typename CalcFn>
+static Result run(Ctrl &ctrl, CalcFn calc, float ffd)
+{
+  double ang = 0.0, spd = 0.0;
+  Result res = {0.0f, 0.0f, 0.0f};
+  float max_ang = 0.0f;
+  for (int k = 0; k < 2 * kSettleTicks; k++) {
+    float ang_ref = k < kSettleTicks ? 0.0f : kStepAng;
+    float tor = calc(ctrl, ang_ref, (float)ang, (float)spd, ffd);
+    for (int s = 0; s < kSubSteps; s++) {
+      double acc = (tor + kDistTor) / kInertia;
+      spd += acc * kDt / kSubSteps;
+      ang += spd * kDt / kSubSteps;
+    }
+    if (k == kSettleTicks - 1) {
+      res.hold_err = -(float)ang;
+    }
+    if (k >= kSettleTicks && ang > max_ang) {
+      max_ang = (float)ang;
+    }
+  }
+  res.step_err = kStepAng - (float)ang;
+  res.overshoot = (max_ang - kStepAng) / kStepAng;
+  return res;
+}
+
+static Result runLadrc(float ffd)
+{
+  robot::Ladrc ladrc(kParams);
+  return run(ladrc, [](robot::Ladrc &c, float ref, float ang, float spd, float f) {
+    return c.calc(ref, 0.0f, 0.0f, ang, spd, f, kDt);
+  }, ffd);
+}
+
+static Result runLegacy(float ffd)
+{
+  LegacyLadrc ladrc;
+  return run(ladrc, [](LegacyLadrc &c, float ref, float ang, float spd, float f) {
+    return c.calc(ref, 0.0f, ang, spd, f, kDt);
+  }, ffd);
+}
+
+/** yaw 关节在小陀螺拖曳与发射后坐力矩下保持 0 rad */
+template <typename Ctrl, typename CalcFn>
+static DistResult runDist(Ctrl &ctrl, CalcFn calc)
+{
+  std::mt19937 rng(1);
+  std::normal_distribution<float> noise(0.0f, kGyroNoise);
+  double ang = 0.0, spd = 0.0;
+  float tor_applied = 0.0f, err_sq = 0.0f;
+  DistResult res = {0.0f, 0.0f};
+  for (int k = 0; k < kDistTicks; k++) {
+    float tor = calc(ctrl, (float)ang, (float)spd + noise(rng));
+    float dist = -kSpinDrag - kRippleTor * sinf(2 * kPi * kRippleFreq * k * kDt);
+    if (k % kRecoilPeriod < kRecoilTicks) {
+      dist += kRecoilTor;
+    }
+    for (int s = 0; s < kSubSteps; s++) {
+      spd += (tor_applied + dist) / kYawInertia * kDt / kSubSteps;
+      ang += spd * kDt / kSubSteps;
+    }
+    tor_applied = tor;
+    if (k >= kDistStatTicks) {
+      res.max_err = fmaxf(res.max_err, fabsf((float)ang));
+      err_sq += (float)(ang * ang);
+    }
+  }
+  res.rms_err = sqrtf(err_sq / (kDistTicks - kDistStatTicks));
+  return res;
+}
+/* Exported function definitions ---------------------------------------------*/
+
+int main()
+{
+  const float ffds[] = {-kDistTor, -1.2f * kDistTor, 0.0f};
+  const char *names[] = {"exact", "+20%", "none"};
+  int fail = 0;
+  printf("b0 %.0f, wc %.0f, wo %.0f, disturbance %.2f N*m\n", kParams.b0, kParams.wc, kParams.wo, kDistTor);
+  for (int i = 0; i < 3; i++) {
+    Result r = runLadrc(ffds[i]);
+    Result l = runLegacy(ffds[i]);
+    bool ok = fabsf(r.hold_err) < kSsErrTol && fabsf(r.step_err) < kSsErrTol && r.overshoot < kOvershootTol;
+    fail += ok ? 0 : 1;
+    printf("ffd %-5s: hold err %8.3f mrad, step err %8.3f mrad, overshoot %5.1f%% | "
+           "legacy hold err %8.3f mrad (theory %8.3f) %s\n",
+           names[i], 1e3f * r.hold_err, 1e3f * r.step_err, 100.0f * r.overshoot, 1e3f * l.hold_err,
+           -1e3f * kParams.b0 * ffds[i] / (kParams.wc * kParams.wc), ok ? "ok" : "FAIL");
+  }
+
+  CascadePid pid;
+  DistResult p = runDist(pid, [](CascadePid &c, float ang, float spd) { return c.calc(0.0f, ang, spd); });
+  robot::Ladrc ladrc(kParamsYaw);
+  DistResult a = runDist(ladrc, [](robot::Ladrc &c, float ang, float spd) {
+    return c.calc(0.0f, 0.0f, 0.0f, ang, spd, 0.0f, kDt);
+  });
+  bool ok = a.max_err < p.max_err && a.rms_err < p.rms_err && a.max_err < kMaxDistErr;
+  fail += ok ? 0 : 1;
+  printf("yaw spin drag + recoil: cascade pid max %5.2f mrad rms %5.2f mrad | ladrc max %5.2f mrad rms %5.2f mrad %s\n",
+         1e3f * p.max_err, 1e3f * p.rms_err, 1e3f * a.max_err, 1e3f * a.rms_err, ok ? "ok" : "FAIL");
+  printf("ladrc_bench: %s\n", fail == 0 ? "pass" : "FAIL");
+  return fail == 0 ? 0 : 1;
+}
@@ -0,0 +1,259 @@
+/**
+ *******************************************************************************
+ * @file      :pwr_limiter_sim.cpp
+ * @brief     : 底盘急加速的主机端仿真，对比速度域与电流域功率限制的超功率与加速时间
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 底盘为刚体：整车质量、绕 Z 轴转动惯量、转子惯量、粘滞与库仑摩擦取 ins_pid.cpp 中 kWheelFfdParams 的值，
+ *     轮子力矩 = k_tau * 电流，经 OmniIkKernel 的雅可比合成为广义力；电流滞后一个控制周期生效，控制周期 1 ms
+ *  2. 控制链与 Chassis 一致：期望轮速阶跃 → WheelFfd 前馈（按未限制的期望轮速计算）→ 速度域限制 →
+ *     轮速 PID（纯比例 2.1，加前馈，限幅 20 A）→ 电流域限制 → 限幅；两种限制器只启用其一
+ *  3. 速度域限制器位于 HW-Components，不在本仓库，此处按其接口 updateWheelModel(期望轮速, 轮速反馈, 前馈) 建模：
+ *     按 ins_pwr_limiter.cpp 中的模型参数（kp 2.15）预测电流 kp * s * (期望轮速 - 轮速反馈) + 前馈，
+ *     取使预测功率不超过预算的最大公共系数 s，前馈不参与缩放；电流域使用 CurrentPwrLimiter 本身
+ *  4. 实际功率按 ins_pwr_limiter.cpp 的功率模型、以实际生效的电流计算；裁判系统功率上限 60 W，
+ *     缓冲能量上限 60 J，电容离线，运行时参数与 Chassis::updatePwrLimiterRuntimeParams 的非小陀螺分支一致
+ *  5. 统计阶跃后 1 s 内实际功率超出功率预算的峰值与均方根（未超出按 0 计）、缓冲能量最小值，
+ *     以及底盘速度到达目标 90% 的时间：轮速 PID 与速度域模型一致时两者都应守住预算、加速时间相当；
+ *     轮速 PID 改为 kp 4.0 而模型未同步更新时，速度域的预测偏低，电流域仍应守住预算
+ *  6. 编译运行：tools/host/run.sh pwr_limiter_sim
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <cmath>
+#include <cstdio>
+
+#include "current_pwr_limiter.hpp"
+#include "omni_ik_kernel.hpp"
+#include "wheel_ffd.hpp"
+/* Private constants ---------------------------------------------------------*/
+const size_t kWheelNum = robot::OmniIkKernel::kWheelNum;
+const size_t kDof = robot::OmniIkKernel::kDof;
+const float kDt = 0.001f;            ///< 控制周期，单位 s
+const int kStepTick = 100;           ///< 阶跃时刻，单位 ms
+const int kStatTicks = 1000;         ///< 阶跃后统计的时长，单位 ms
+const int kSimTicks = 2000;          ///< 仿真时长，单位 ms
+const float kModelKp = 2.15f;        ///< 速度域限制器模型中的 PID 比例系数，与 ins_pwr_limiter.cpp 一致
+const float kOutLimit = 20.0f;       ///< 轮电机电流限幅，单位 A
+const float kRfrPwrLimit = 60.0f;    ///< 裁判系统功率上限，单位 W
+const float kBufferMax = 60.0f;      ///< 缓冲能量上限，单位 J
+const float kSpdReachRatio = 0.9f;   ///< 到达目标的速度比例
+const float kMaxSlowdown = 1.1f;     ///< 电流域加速时间相对速度域的上限
+const float kMaxOver = 10.0f;        ///< 电流域超出功率预算的峰值上限，单位 W
+
+constexpr robot::OmniIkKernel kKernel = robot::OmniIkKernel({
+    .wheel_radius = 77.86f * 0.001f,
+    .wheel2center = 216.91f * 0.001f,
+});
+const robot::WheelFfd::Params kFfdParams = {
+    .k_tau = 0.3f,
+    .mass = 19.0f,
+    .inertia_z = 0.6f,
+    .rotor_inertia = 0.004f,
+    .visc = 0.01f,
+    .coulomb = 0.3f,
+    .coulomb_spd_band = 2.0f,
+    .acc_filter = 0.2f,
+    .max_ffd = 10.0f,
+    .gravity_curr_per_spd = 2.3f,
+};
+const robot::CurrentPwrLimiter::Params kCurParams = {
+    .k_t = 0.285f,
+    .k_r = 0.11f,
+    .k_w = 0.15f,
+    .p_bias = 2.6f,
+    .out_limit = 20.0f,
+};
+/* Private types -------------------------------------------------------------*/
+
+enum class Domain {
+  kSpeed,
+  kCurrent,
+};
+
+struct Case {
+  const char *name;
+  float twist[kDof];  ///< 阶跃后的期望底盘运动向量 {v_x, v_y, w}，单位 m/s, rad/s
+  float buffer;       ///< 初始缓冲能量，单位 J
+  float kp;           ///< 轮速 PID 比例系数，单位 A/(rad/s)
+};
+
+struct Result {
+  float peak_over;   ///< 超出功率预算的峰值，单位 W
+  float rms_over;    ///< 超出功率预算的均方根，单位 W
+  float min_buffer;  ///< 缓冲能量最小值，单位 J
+  int reach_ms;      ///< 到达目标 90% 的时间，单位 ms，未到达时为 -1
+};
+/* Private function definitions ----------------------------------------------*/
+
+static float bound(float x, float lim) { return x > lim ? lim : (x < -lim ? -lim : x); }
+
+/** 与 ins_pwr_limiter.cpp 一致的功率模型 */
+static float calcPwr(const float cur[kWheelNum], const float spd[kWheelNum])
+{
+  float p = kCurParams.p_bias;
+  for (size_t i = 0; i < kWheelNum; i++) {
+    p += kCurParams.k_t * cur[i] * spd[i] + kCurParams.k_r * cur[i] * cur[i] + kCurParams.k_w * fabsf(spd[i]);
+  }
+  return p;
+}
+
+/** 速度域限制器模型：缩放速度误差，返回限制后的期望轮速 */
+static void limitSpeed(float budget, const float spd_ref[kWheelNum], const float spd_fdb[kWheelNum],
+                       const float ffd[kWheelNum], float spd_ref_limited[kWheelNum])
+{
+  auto predict = [&](float s) {
+    float cur[kWheelNum];
+    for (size_t i = 0; i < kWheelNum; i++) {
+      cur[i] = bound(kModelKp * s * (spd_ref[i] - spd_fdb[i]) + ffd[i], kOutLimit);
+    }
+    return calcPwr(cur, spd_fdb);
+  };
+  float scale = 1.0f;
+  if (predict(1.0f) > budget) {
+    float lo = 0.0f, hi = 1.0f;
+    for (int it = 0; it < 20; it++) {
+      float mid = 0.5f * (lo + hi);
+      (predict(mid) > budget ? hi : lo) = mid;
+    }
+    scale = lo;
+  }
+  for (size_t i = 0; i < kWheelNum; i++) {
+    spd_ref_limited[i] = spd_fdb[i] + scale * (spd_ref[i] - spd_fdb[i]);
+  }
+}
+
+static Result run(const Case &c, Domain domain)
+{
+  robot::WheelFfd ffd_calc(kFfdParams);
+  robot::CurrentPwrLimiter cur_limiter(kCurParams);
+
+  // 广义质量对角阵：整车质量与转动惯量，加上转子惯量经 J^T J 折算的部分
+  const float(&jac)[kWheelNum][kDof] = kKernel.jacobian();
+  float mass[kDof] = {kFfdParams.mass, kFfdParams.mass, kFfdParams.inertia_z};
+  for (size_t d = 0; d < kDof; d++) {
+    for (size_t i = 0; i < kWheelNum; i++) {
+      mass[d] += kFfdParams.rotor_inertia * jac[i][d] * jac[i][d];
+    }
+  }
+  float target[kWheelNum];
+  kKernel.solveInRobotFrame(c.twist, target);
+  float target_norm = 0.0f;
+  for (size_t i = 0; i < kWheelNum; i++) {
+    target_norm += target[i] * target[i];
+  }
+
+  float twist[kDof] = {0.0f}, cur_applied[kWheelNum] = {0.0f};
+  float buffer = c.buffer;
+  double over_sq = 0.0;
+  Result res = {0.0f, 0.0f, buffer, -1};
+  for (int k = 0; k < kSimTicks; k++) {
+    float spd_fdb[kWheelNum], spd_ref[kWheelNum], ffd[kWheelNum];
+    kKernel.solveInRobotFrame(twist, spd_fdb);
+    for (size_t i = 0; i < kWheelNum; i++) {
+      spd_ref[i] = k >= kStepTick ? target[i] : 0.0f;
+    }
+    ffd_calc.calc(kKernel, spd_ref, kDt, ffd);
+
+    hello_world::power_limiter::PowerLimiterRuntimeParams runtime_params = {
+        .p_ref_max = 100.0f + kRfrPwrLimit,
+        .p_referee_max = kRfrPwrLimit,
+        .p_ref_min = 0.8f * kRfrPwrLimit,
+        .remaining_energy = buffer,
+        .energy_converge = 10.0f,
+        .p_slope = 2.0f,
+        .danger_energy = 5.0f,
+    };
+    float budget = cur_limiter.calcPwrBudget(runtime_params);
+
+    float spd_ref_limited[kWheelNum], cur_ref[kWheelNum];
+    if (domain == Domain::kSpeed) {
+      limitSpeed(budget, spd_ref, spd_fdb, ffd, spd_ref_limited);
+    } else {
+      for (size_t i = 0; i < kWheelNum; i++) {
+        spd_ref_limited[i] = spd_ref[i];
+      }
+    }
+    for (size_t i = 0; i < kWheelNum; i++) {
+      cur_ref[i] = bound(c.kp * (spd_ref_limited[i] - spd_fdb[i]) + ffd[i], kOutLimit);
+    }
+    float scale = domain == Domain::kCurrent ? cur_limiter.calc(runtime_params, cur_ref, spd_fdb, kWheelNum) : 1.0f;
+
+    // 实际功率由上一周期下发、本周期生效的电流产生
+    float pwr = calcPwr(cur_applied, spd_fdb);
+    buffer = fminf(buffer - (pwr - kRfrPwrLimit) * kDt, kBufferMax);
+    if (k >= kStepTick && k < kStepTick + kStatTicks) {
+      float over = fmaxf(pwr - budget, 0.0f);
+      res.peak_over = fmaxf(res.peak_over, over);
+      over_sq += over * over;
+      res.min_buffer = fminf(res.min_buffer, buffer);
+    }
+
+    float wheel_tor[kWheelNum], gen_force[kDof] = {0.0f};
+    for (size_t i = 0; i < kWheelNum; i++) {
+      float fric = kFfdParams.visc * spd_fdb[i] + kFfdParams.coulomb * bound(spd_fdb[i] / kFfdParams.coulomb_spd_band, 1.0f);
+      wheel_tor[i] = kFfdParams.k_tau * (cur_applied[i] - fric);
+      for (size_t d = 0; d < kDof; d++) {
+        gen_force[d] += jac[i][d] * wheel_tor[i];
+      }
+      cur_applied[i] = bound(cur_ref[i] * scale, kOutLimit);
+    }
+    for (size_t d = 0; d < kDof; d++) {
+      twist[d] += gen_force[d] / mass[d] * kDt;
+    }
+
+    float proj = 0.0f;
+    for (size_t i = 0; i < kWheelNum; i++) {
+      proj += spd_fdb[i] * target[i];
+    }
+    if (res.reach_ms < 0 && k >= kStepTick && proj >= kSpdReachRatio * target_norm) {
+      res.reach_ms = k - kStepTick;
+    }
+  }
+  res.rms_over = (float)sqrt(over_sq / kStatTicks);
+  return res;
+}
+
+static void print(const char *name, const Result &r)
+{
+  printf("  %-8s: over budget peak %6.1f W rms %5.1f W | min buffer %5.1f J | 90%% speed in %4d ms\n", name,
+         r.peak_over, r.rms_over, r.min_buffer, r.reach_ms);
+}
+/* Exported function definitions ---------------------------------------------*/
+
+int main()
+{
+  const Case cases[] = {
+      {"forward 0 -> 3 m/s, buffer 60 J", {3.0f, 0.0f, 0.0f}, 60.0f, 2.1f},
+      {"forward 0 -> 3 m/s, buffer 20 J", {3.0f, 0.0f, 0.0f}, 20.0f, 2.1f},
+      {"diagonal 0 -> 2 m/s + spin 4 rad/s", {1.4f, 1.4f, 4.0f}, 60.0f, 2.1f},
+      {"spin 0 -> 8 rad/s", {0.0f, 0.0f, 8.0f}, 60.0f, 2.1f},
+      {"forward 0 -> 3 m/s, pid kp 4.0", {3.0f, 0.0f, 0.0f}, 60.0f, 4.0f},
+      {"spin 0 -> 8 rad/s, pid kp 4.0", {0.0f, 0.0f, 8.0f}, 60.0f, 4.0f},
+  };
+  bool ok = true;
+  for (const Case &c : cases) {
+    Result spd = run(c, Domain::kSpeed);
+    Result cur = run(c, Domain::kCurrent);
+    // PID 偏离速度域模型时速度域超功率，其加速时间不可作为比较基准
+    bool is_model_match = fabsf(c.kp - kModelKp) < 0.1f;
+    bool case_ok = cur.peak_over < kMaxOver && cur.reach_ms >= 0;
+    if (is_model_match) {
+      case_ok = case_ok && cur.reach_ms <= kMaxSlowdown * spd.reach_ms;
+    } else {
+      case_ok = case_ok && cur.rms_over < spd.rms_over;
+    }
+    printf("%s %s\n", c.name, case_ok ? "ok" : "FAIL");
+    print("speed", spd);
+    print("current", cur);
+    ok = ok && case_ok;
+  }
+  printf("pwr_limiter_sim: %s\n", ok ? "pass" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+#!/bin/sh
+# 在主机上编译并运行 tools/host 下的检查与仿真程序
+# 用法：tools/host/run.sh [程序名 ...]，不带参数时运行 ALL 中的全部
+# vision_link_host 需要 python3 与 pty，由 tools/vision_pc_sim.py 启动，不在 ALL 中
+set -e
+HOST_DIR=$(cd "$(dirname "$0")" && pwd)
+ROOT=$(cd "$HOST_DIR/../.." && pwd)
+OUT=${HOST_BUILD_DIR:-"$HOST_DIR/build"}
+CXX=${CXX:-g++}
+CXXFLAGS="-std=c++17 -O2 -Wall -Wextra -I$HOST_DIR/stub"
+mkdir -p "$OUT"
+
+build() {
+  name=$1
+  shift
+  case $name in
+    ik_kernel_check)
+      $CXX $CXXFLAGS -I"$ROOT/Chassis/RobotModules/inc" "$HOST_DIR/ik_kernel_check.cpp" \
+        "$ROOT/Chassis/RobotModules/src/omni_ik_kernel.cpp" -o "$OUT/$name" -lm
+      ;;
+    gimbal_traj_sim)
+      $CXX $CXXFLAGS -I"$ROOT/Gimbal/RobotModules/inc" "$HOST_DIR/gimbal_traj_sim.cpp" \
+        "$ROOT/Gimbal/RobotModules/src/time_optimal_traj.cpp" -o "$OUT/$name" -lm
+      ;;
+    vision_tracker_sim)
+      $CXX $CXXFLAGS -I"$ROOT/Gimbal/RobotModules/inc" "$HOST_DIR/vision_tracker_sim.cpp" \
+        "$ROOT/Gimbal/RobotModules/src/vision_tracker.cpp" -o "$OUT/$name" -lm
+      ;;
+    feed_handback_sim)
+      $CXX $CXXFLAGS -I"$ROOT/Gimbal/RobotModules/inc" "$HOST_DIR/feed_handback_sim.cpp" \
+        "$ROOT/Gimbal/RobotModules/src/feed_profile.cpp" -o "$OUT/$name" -lm
+      ;;
+    shot_detector_sim)
+      $CXX $CXXFLAGS -I"$ROOT/Gimbal/RobotModules/inc" "$HOST_DIR/shot_detector_sim.cpp" \
+        "$ROOT/Gimbal/RobotModules/src/shot_detector.cpp" -o "$OUT/$name" -lm
+      ;;
+    fric_shot_capture_sim)
+      $CXX $CXXFLAGS -I"$ROOT/Gimbal/RobotModules/inc" "$HOST_DIR/fric_shot_capture_sim.cpp" \
+        "$ROOT/Gimbal/RobotModules/src/fric_shot_ffd.cpp" "$ROOT/Gimbal/RobotModules/src/shot_detector.cpp" \
+        -o "$OUT/$name" -lm
+      ;;
+    fire_ctrl_sim)
+      $CXX $CXXFLAGS -I"$ROOT/Gimbal/RobotModules/inc" "$HOST_DIR/fire_ctrl_sim.cpp" \
+        "$ROOT/Gimbal/RobotModules/src/fire_ctrl.cpp" -o "$OUT/$name" -lm
+      ;;
+    heat_sched_sim)
+      $CXX $CXXFLAGS -I"$ROOT/Gimbal/RobotModules/inc" "$HOST_DIR/heat_sched_sim.cpp" \
+        "$ROOT/Gimbal/RobotModules/src/heat_sched.cpp" -o "$OUT/$name" -lm
+      ;;
+    joint_fusion_sim)
+      $CXX $CXXFLAGS -I"$ROOT/Gimbal/RobotModules/inc" "$HOST_DIR/joint_fusion_sim.cpp" \
+        "$ROOT/Gimbal/RobotModules/src/joint_fdb_fusion.cpp" -o "$OUT/$name" -lm
+      ;;
+    pwr_limiter_sim)
+      $CXX $CXXFLAGS -I"$ROOT/Chassis/RobotModules/inc" "$HOST_DIR/pwr_limiter_sim.cpp" \
+        "$ROOT/Chassis/RobotModules/src/current_pwr_limiter.cpp" "$ROOT/Chassis/RobotModules/src/wheel_ffd.cpp" \
+        "$ROOT/Chassis/RobotModules/src/omni_ik_kernel.cpp" -o "$OUT/$name" -lm
+      ;;
+    theta_pred_sim)
+      $CXX $CXXFLAGS "$HOST_DIR/theta_pred_sim.cpp" -o "$OUT/$name" -lm
+      ;;
+    traction_sim)
+      $CXX $CXXFLAGS -I"$ROOT/Chassis/RobotModules/inc" "$HOST_DIR/traction_sim.cpp" \
+        "$ROOT/Chassis/RobotModules/src/traction_ctrl.cpp" "$ROOT/Chassis/RobotModules/src/current_pwr_limiter.cpp" \
+        "$ROOT/Chassis/RobotModules/src/wheel_ffd.cpp" "$ROOT/Chassis/RobotModules/src/omni_ik_kernel.cpp" \
+        -o "$OUT/$name" -lm
+      ;;
+    ladrc_bench)
+      $CXX $CXXFLAGS -I"$ROOT/Gimbal/RobotModules/inc" "$HOST_DIR/ladrc_bench.cpp" \
+        "$ROOT/Gimbal/RobotModules/src/ladrc.cpp" -o "$OUT/$name" -lm
+      ;;
+    vision_link_host)
+      $CXX $CXXFLAGS -I"$ROOT/Gimbal/RobotModules/inc" "$HOST_DIR/vision_link_host.cpp" \
+        "$ROOT/Gimbal/RobotModules/src/vision_link.cpp" "$ROOT/Gimbal/RobotModules/src/time_sync.cpp" \
+        "$ROOT/Gimbal/RobotModules/src/pose_history.cpp" -o "$OUT/$name" -lm
+      ;;
+    *)
+      echo "unknown program: $name" >&2
+      exit 1
+      ;;
+  esac
+}
+
+ALL="ik_kernel_check ladrc_bench gimbal_traj_sim vision_tracker_sim feed_handback_sim shot_detector_sim fric_shot_capture_sim fire_ctrl_sim heat_sched_sim joint_fusion_sim pwr_limiter_sim theta_pred_sim traction_sim"
+for name in ${*:-$ALL}; do
+  build "$name"
+  case $name in
+    vision_link_host)
+      python3 "$ROOT/tools/vision_pc_sim.py" --exec "$OUT/$name"
+      ;;
+    *)
+      "$OUT/$name"
+      ;;
+  esac
+done
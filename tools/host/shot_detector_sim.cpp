@@ -0,0 +1,161 @@
+/**
+ *******************************************************************************
+ * @file      :shot_detector_sim.cpp
+ * @brief     : 摩擦轮发弹的主机端仿真，检查 ShotDetector 的本地检测与迟到裁判系统数据的对应
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 两个摩擦轮 J * dw = kt * curr - 粘滞摩擦 - 弹丸负载，控制周期 1 ms；速度环按 ins_pid.cpp 中
+ *     kPidParamsFric_1 为纯比例（201.5），另加维持 650 rad/s 的稳态电流；转速反馈按 1 rpm 量化，
+ *     电流反馈带 0.05 A 的噪声
+ *  2. 每 1 s 中的前 0.5 s 按 50 ms 间隔拨弹，15% 为空拨；弹丸在拨弹后 25 ms 接触摩擦轮 2 ms，
+ *     每个摩擦轮损失约 0.45 J
+ *  3. 裁判系统发弹数据在接触后 40~70 ms 到达，其中 10% 因底盘转发堵塞迟到 200~400 ms，超过 match_time
+ *  4. 对比 late_time 为 0（迟到数据先计误检、再补报一发的旧做法）与 ins_fric.cpp 中 kShotDetectorParams 的结果：
+ *     交给拨盘与热量预测的发数应与实际弹丸数一致，且没有误检与漏检
+ *  5. 编译运行：tools/host/run.sh shot_detector_sim
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "shot_detector.hpp"
+/* Private constants ---------------------------------------------------------*/
+const double kInertia = 2e-4;        ///< 摩擦轮转动惯量，单位 kg·m^2
+const double kKt = 0.0156;           ///< 3508 去减速箱力矩常数，单位 N·m/A
+const double kRawPerCurr = 819.2;    ///< 电机原始输入与电流之比，单位 1/A
+const double kSpdRef = 650.0;        ///< 摩擦轮期望转速，单位 rad/s
+const double kSpdKp = 201.5;         ///< 摩擦轮速度环比例系数，单位 电机原始输入/(rad/s)
+const double kBaseRaw = 800.0;       ///< 维持期望转速的稳态输入，单位 电机原始输入
+const double kRpmRes = 0.10472;      ///< 转速反馈分辨率，单位 rad/s
+const double kCurrNoise = 0.05;      ///< 电流反馈噪声标准差，单位 A
+const double kShotEnergy[2] = {0.46, 0.40};  ///< 每发每个摩擦轮损失的能量，单位 J
+const int kContactDelay = 25;        ///< 拨弹到弹丸接触摩擦轮的时延，单位 ms
+const int kContactTime = 2;          ///< 弹丸与摩擦轮的接触时长，单位 ms
+const int kFeedInterval = 50;        ///< 拨弹间隔，单位 ms
+const double kEmptyProb = 0.15;      ///< 空拨概率
+const double kLateProb = 0.1;        ///< 裁判系统数据迟到的概率
+const double kBltRatio = 0.0366;     ///< 弹速与摩擦轮转速之比，单位 m/rad
+const int kSimTicks = 30000;         ///< 仿真时长，单位 ms
+const int kWarmupTicks = 3000;       ///< 摩擦轮起转时长，单位 ms
+
+const robot::ShotDetector::Params kParams = {
+    .inertia_per_kt = 0.0128f,
+    .window = 5,
+    .imp_thres = 0.02f,
+    .base_lpf = 0.02f,
+    .min_spd = 300.0f,
+    .min_gap = 20,
+    .match_time = 150,
+    .late_time = 350,
+    .spd_ratio_init = 0.0366f,
+    .spd_ratio_lpf = 0.05f,
+    .min_blt_spd = 20.0f,
+    .max_blt_spd = 28.0f,
+};
+/* Private types -------------------------------------------------------------*/
+
+struct RfrEvent {
+  int tick;       ///< 到达云台的时间戳，单位 ms
+  float blt_spd;  ///< 弹速，单位 m/s
+};
+
+struct Result {
+  int pellets;        ///< 实际发出的弹丸数
+  int reported;       ///< 交给拨盘与热量预测的发数
+  uint32_t detected;  ///< 本地检测到的发数
+  uint32_t miss;      ///< 漏检（补报）数
+  uint32_t false_cnt; ///< 误检数
+  uint32_t late;      ///< 迟到后撤销误检的发数
+  float blt_err;      ///< 最后一发弹速估计的误差，单位 m/s
+};
+/* Private function definitions ----------------------------------------------*/
+
+static Result run(uint32_t late_time)
+{
+  robot::ShotDetector::Params params = kParams;
+  params.late_time = late_time;
+  robot::ShotDetector detector(params);
+  std::mt19937 rng(1);
+  std::normal_distribution<double> noise(0.0, 1.0);
+  std::uniform_real_distribution<double> uni(0.0, 1.0);
+
+  const double dirs[2] = {1.0, -1.0};
+  const double visc = kKt * kBaseRaw / kRawPerCurr / kSpdRef;
+  double w[2] = {0.0, 0.0}, curr[2] = {0.0, 0.0};
+  std::vector<int> contacts;
+  std::vector<RfrEvent> rfr_events;
+  Result res = {0, 0, 0, 0, 0, 0, 0.0f};
+  float last_blt_spd = 0.0f;
+  for (int k = 0; k < kSimTicks; k++) {
+    if (k > kWarmupTicks && k % kFeedInterval == 0 && (k / 500) % 2 == 0 && uni(rng) > kEmptyProb) {
+      contacts.push_back(k + kContactDelay);
+      res.pellets++;
+    }
+    for (const RfrEvent &e : rfr_events) {
+      if (e.tick == k) {
+        detector.onRfrShot(k, e.blt_spd);
+      }
+    }
+    while (detector.fetchShot()) {
+      res.reported++;
+    }
+
+    float spd_fdb[2], curr_fdb[2];
+    for (size_t i = 0; i < 2; i++) {
+      spd_fdb[i] = (float)(std::round(w[i] / kRpmRes) * kRpmRes);
+      curr_fdb[i] = (float)(curr[i] + kCurrNoise * noise(rng));
+    }
+    detector.update(k, spd_fdb, curr_fdb);
+
+    bool is_contact = !contacts.empty() && k >= contacts.back() && k < contacts.back() + kContactTime;
+    if (is_contact && k == contacts.back()) {
+      last_blt_spd = (float)(kBltRatio * fabs(w[0]));
+      int lag = uni(rng) < kLateProb ? 200 + (int)(200 * uni(rng)) : 40 + (int)(30 * uni(rng));
+      rfr_events.push_back({k + lag, last_blt_spd});
+    }
+    for (size_t i = 0; i < 2; i++) {
+      double raw = dirs[i] * (kBaseRaw + kSpdKp * (kSpdRef - dirs[i] * w[i]));
+      raw = fmax(fmin(raw, 16384.0), -16384.0);
+      curr[i] = raw / kRawPerCurr;
+      double tor = kKt * curr[i] - visc * w[i];
+      if (is_contact) {
+        tor -= dirs[i] * kShotEnergy[i] / (fabs(w[i]) * kContactTime * 0.001);
+      }
+      w[i] += tor / kInertia * 0.001;
+    }
+  }
+  res.detected = detector.getShotCnt();
+  res.miss = detector.getMissCnt();
+  res.false_cnt = detector.getFalseCnt();
+  res.late = detector.getLateCnt();
+  res.blt_err = detector.getBltSpd() - last_blt_spd;
+  return res;
+}
+
+static void print(const char *name, const Result &r)
+{
+  printf("%-22s: pellets %3d reported %3d | detected %3u miss %2u false %2u late %2u | blt spd err %5.2f m/s\n",
+         name, r.pellets, r.reported, r.detected, r.miss, r.false_cnt, r.late, r.blt_err);
+}
+/* Exported function definitions ---------------------------------------------*/
+
+int main()
+{
+  Result legacy = run(0);
+  Result late = run(kParams.late_time);
+  print("late_time 0 (legacy)", legacy);
+  print("late_time 350 ms", late);
+  bool ok = late.reported == late.pellets && late.false_cnt == 0 && late.miss == 0 &&
+            late.detected == (uint32_t)late.pellets && fabsf(late.blt_err) < 0.3f;
+  printf("shot_detector_sim: %s\n", ok ? "pass" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,27 @@
+/**
+ *******************************************************************************
+ * @file      :arm_math.h
+ * @brief     : 主机端检查程序使用的 CMSIS-DSP 替身，只提供用到的函数
+ *******************************************************************************
+ */
+#ifndef HOST_STUB_ARM_MATH_H_
+#define HOST_STUB_ARM_MATH_H_
+
+#include <math.h>
+
+#ifndef PI
+#define PI 3.14159265358979f
+#endif
+
+/** 输入单位为度，与 CMSIS-DSP 一致 */
+static inline void arm_sin_cos_f32(float theta, float *p_sin_val, float *p_cos_val)
+{
+  float rad = theta * PI / 180.0f;
+  *p_sin_val = sinf(rad);
+  *p_cos_val = cosf(rad);
+}
+
+static inline float arm_sin_f32(float x) { return sinf(x); }
+static inline float arm_cos_f32(float x) { return cosf(x); }
+
+#endif /* HOST_STUB_ARM_MATH_H_ */
@@ -0,0 +1,29 @@
+/**
+ *******************************************************************************
+ * @file      :offline_checker.hpp
+ * @brief     : 主机端检查程序使用的 HW-Components 离线检测器替身，只提供用到的接口
+ *******************************************************************************
+ */
+#ifndef HOST_STUB_OFFLINE_CHECKER_HPP_
+#define HOST_STUB_OFFLINE_CHECKER_HPP_
+
+#include <cstdint>
+
+namespace hello_world
+{
+/** 主机端不计时，update 后即视为在线 */
+class OfflineChecker
+{
+ public:
+  explicit OfflineChecker(uint32_t /* offline_tick_thres */) {}
+
+  void update() { is_updated_ = true; }
+  bool isOffline() const { return !is_updated_; }
+  void set_offline_tick_thres(uint32_t /* offline_tick_thres */) {}
+
+ private:
+  bool is_updated_ = false;
+};
+}  // namespace hello_world
+
+#endif /* HOST_STUB_OFFLINE_CHECKER_HPP_ */
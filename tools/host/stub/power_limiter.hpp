@@ -0,0 +1,27 @@
+/**
+ *******************************************************************************
+ * @file      :power_limiter.hpp
+ * @brief     : 主机端检查程序使用的 HW-Components 功率限制器替身，只提供运行时参数
+ *******************************************************************************
+ */
+#ifndef HOST_STUB_POWER_LIMITER_HPP_
+#define HOST_STUB_POWER_LIMITER_HPP_
+
+namespace hello_world
+{
+namespace power_limiter
+{
+/** 字段与 Chassis::updatePwrLimiterRuntimeParams 中的用法一致 */
+struct PowerLimiterRuntimeParams {
+  float p_ref_max;         ///< 功率预算上限，单位 W
+  float p_referee_max;     ///< 裁判系统功率上限，单位 W
+  float p_ref_min;         ///< 功率预算下限，单位 W
+  float remaining_energy;  ///< 剩余缓冲能量，单位 J
+  float energy_converge;   ///< 缓冲能量的收敛值，单位 J
+  float p_slope;           ///< 缓冲能量偏差对应的预算调整斜率，单位 W/J
+  float danger_energy;     ///< 缓冲能量危险值，单位 J
+};
+}  // namespace power_limiter
+}  // namespace hello_world
+
+#endif /* HOST_STUB_POWER_LIMITER_HPP_ */
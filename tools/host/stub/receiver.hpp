@@ -0,0 +1,32 @@
+/**
+ *******************************************************************************
+ * @file      :receiver.hpp
+ * @brief     : 主机端检查程序使用的 HW-Components 接收方接口替身
+ *******************************************************************************
+ */
+#ifndef HOST_STUB_RECEIVER_HPP_
+#define HOST_STUB_RECEIVER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hello_world
+{
+namespace comm
+{
+class Receiver
+{
+ public:
+  typedef std::vector<uint32_t> RxIds;
+
+  virtual ~Receiver() = default;
+
+  virtual uint32_t rxId(void) const = 0;
+  virtual const RxIds &rxIds(void) const = 0;
+  virtual bool decode(size_t len, const uint8_t *data, uint32_t rx_id) = 0;
+};
+}  // namespace comm
+}  // namespace hello_world
+
+#endif /* HOST_STUB_RECEIVER_HPP_ */
@@ -0,0 +1,31 @@
+/**
+ *******************************************************************************
+ * @file      :transmitter.hpp
+ * @brief     : 主机端检查程序使用的 HW-Components 发送方接口替身
+ *******************************************************************************
+ */
+#ifndef HOST_STUB_TRANSMITTER_HPP_
+#define HOST_STUB_TRANSMITTER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hello_world
+{
+namespace comm
+{
+/** 主机端由调用方直接调用 encode 并写出，setNeedToTransmit 不起作用 */
+class Transmitter
+{
+ public:
+  virtual ~Transmitter() = default;
+
+  virtual uint32_t txId(void) const = 0;
+  virtual bool encode(size_t &len, uint8_t *data) = 0;
+  virtual void txSuccessCb(void) {}
+  void setNeedToTransmit(void) {}
+};
+}  // namespace comm
+}  // namespace hello_world
+
+#endif /* HOST_STUB_TRANSMITTER_HPP_ */
@@ -0,0 +1,191 @@
+/**
+ *******************************************************************************
+ * @file      :theta_pred_sim.cpp
+ * @brief     : 小陀螺平移时 theta_i2r 预测的主机端仿真，对比按采样值与按预测值旋转指令的平移方向误差
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 底盘以 13 rad/s（ins_fsm.cpp 中 normal_rot_spd）小陀螺，云台保持世界系朝向，图传坐标系下指令为前进 2 m/s；
+ *     模型按 0.1 ms 积分，轮速按运动学跟踪指令，指令发送后 kActDelay 生效并保持一个控制周期
+ *  2. YAW 电机每 1 ms 采样一次，编码器 8192 线量化，经 CAN 延迟 kCanDelay 到达，控制周期开始时读取最新一帧；
+ *     采样时刻相对控制周期的相位未知，结果为 5 个相位的平均；每秒有一次 kOutage 的反馈中断
+ *  3. ThetaPred 与 Chassis::updateThetaI2rPred 逐行一致（主机端无法编译 Chassis），calcWheelSpeedRef 中
+ *     坡面重力分量按 -w * theta_pred_latency 旋转，另给出其方向误差
+ *  4. 预测只计入反馈到达后经过的控制周期数，其余时延须由 theta_pred_latency 给出，理想值约为
+ *     发送到生效（1.5 ms）+ 指令保持的平均（0.5 ms）+ 反馈 CAN 时延（0.2 ms）+ 读取前的平均等待（0.5 ms）；
+ *     扫描 theta_pred_latency，统计平移方向的平均误差、每米平移的横向漂移、反馈中断期间的最大方向误差，
+ *     以及预测实际使用的最大总时延；反馈中断时预测与采样值相当，不应更差
+ *  5. 总时延上限 20 ms 不会触发：反馈超过 kYawFdbTimeout（3 ms）未变化即视为更新，数据年龄随之清零，
+ *     实际使用的总时延不超过 kYawFdbTimeout + theta_pred_latency + 1 ms；上限只在该超时被改大时起保护作用
+ *  6. 编译运行：tools/host/run.sh theta_pred_sim
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+/* Private constants ---------------------------------------------------------*/
+const float kPi = 3.14159265f;
+const int kSubSteps = 10;            ///< 每个控制周期的积分步数
+const float kSpinSpd = 13.0f;        ///< 小陀螺转速，单位 rad/s
+const float kCmdSpd = 2.0f;          ///< 图传坐标系下的平移指令，单位 m/s
+const float kActDelay = 0.0015f;     ///< 轮电机指令从发送到生效的时延，单位 s
+const float kCanDelay = 0.0002f;     ///< YAW 电机反馈的 CAN 时延，单位 s
+const float kSamplePhases[] = {0.1f, 0.3f, 0.5f, 0.7f, 0.9f};  ///< YAW 电机采样时刻相对控制周期的相位，单位 控制周期
+const float kEncoderRes = 2 * kPi / 8192;  ///< 编码器分辨率，单位 rad
+const int kOutage = 30;              ///< 每秒一次的反馈中断时长，单位 ms
+const int kOutageStart = 500;        ///< 反馈中断在每秒中的起始时刻，单位 ms
+const int kSimTicks = 3000;          ///< 仿真时长，单位 ms
+const float kCfgLatency = 0.0027f;   ///< ins_fsm.cpp 中的 theta_pred_latency，单位 s
+const float kMaxLatency = 0.02f;     ///< Chassis::updateThetaI2rPred 中总时延的上限，单位 s
+const uint32_t kYawFdbTimeout = 3;   ///< 与 Chassis::updateThetaI2rPred 一致，单位 ms
+/* Private types -------------------------------------------------------------*/
+
+/** 与 Chassis::updateThetaI2rPred 一致 */
+class ThetaPred
+{
+ public:
+  explicit ThetaPred(float cfg_latency) : cfg_latency_(cfg_latency) {}
+
+  float update(uint32_t work_tick, float theta_i2r)
+  {
+    uint32_t dt_tick = work_tick - yaw_fdb_tick_;
+    if (theta_i2r != last_yaw_fdb_ang_ || dt_tick > kYawFdbTimeout) {
+      if (dt_tick > 0 && dt_tick <= 10) {
+        float spd = angleNorm(theta_i2r - last_yaw_fdb_ang_) / (dt_tick * 0.001f);
+        theta_i2r_spd_ = 0.5f * theta_i2r_spd_ + 0.5f * spd;
+      } else {
+        theta_i2r_spd_ = 0.0f;
+      }
+      last_yaw_fdb_ang_ = theta_i2r;
+      yaw_fdb_tick_ = work_tick;
+    }
+    float latency = (work_tick - yaw_fdb_tick_) * 0.001f + cfg_latency_;
+    latency_ = fmaxf(fminf(latency, kMaxLatency), 0.0f);
+    return angleNorm(theta_i2r + theta_i2r_spd_ * latency_);
+  }
+
+  float getLatency() const { return latency_; }
+
+  static float angleNorm(float a) { return remainderf(a, 2 * kPi); }
+
+ private:
+  float cfg_latency_;
+  uint32_t yaw_fdb_tick_ = 0;
+  float last_yaw_fdb_ang_ = 0.0f;
+  float theta_i2r_spd_ = 0.0f;
+  float latency_ = 0.0f;
+};
+
+struct Result {
+  float mean_err;     ///< 平移方向的平均误差，单位 rad
+  float drift;        ///< 每米平移的横向漂移，单位 m/m
+  float outage_err;   ///< 反馈中断期间的最大方向误差，单位 rad
+  float max_latency;  ///< 预测使用的最大总时延，单位 s
+};
+/* Private function definitions ----------------------------------------------*/
+
+static bool isOutage(int tick) { return tick % 1000 >= kOutageStart && tick % 1000 < kOutageStart + kOutage; }
+
+/**
+ * @brief       运行一次仿真
+ * @param        cfg_latency: theta_pred_latency，单位 s，小于 0 时直接使用采样值
+ * @param        phase: YAW 电机采样时刻相对控制周期的相位，单位 控制周期
+ */
+static Result runPhase(float cfg_latency, float phase)
+{
+  ThetaPred pred(cfg_latency < 0.0f ? 0.0f : cfg_latency);
+  const double dt = 0.001 / kSubSteps;
+  double x = 0.0, y = 0.0;
+  float theta_i2r = 0.0f, err_sum = 0.0f;
+  std::vector<float> theta_cmds(kSimTicks, 0.0f);
+  int err_num = 0;
+  Result res = {0.0f, 0.0f, 0.0f, 0.0f};
+  for (int k = 0; k < kSimTicks; k++) {
+    // 控制周期开始时读取最新一帧 YAW 电机反馈：采样于 n + phase，到达于其后 kCanDelay
+    double now = k * 0.001;
+    int n = (int)floor((now - kCanDelay) / 0.001 - phase);
+    if (n >= 0 && !isOutage(n)) {
+      double sample_time = (n + phase) * 0.001;
+      theta_i2r = (float)(round(ThetaPred::angleNorm((float)(kSpinSpd * sample_time)) / kEncoderRes) * kEncoderRes);
+    }
+    theta_cmds[k] = cfg_latency < 0.0f ? theta_i2r : pred.update(k, theta_i2r);
+    res.max_latency = fmaxf(res.max_latency, pred.getLatency());
+
+    // 第 j 个控制周期的指令在 j + kActDelay 生效，保持到下一条指令生效
+    for (int s = 0; s < kSubSteps; s++) {
+      double t = now + s * dt;
+      int j = (int)floor((t - kActDelay) / 0.001 + 1e-6);
+      float used = j >= 0 ? theta_cmds[j] : 0.0f;
+      // 底盘坐标系下的速度为指令旋转 -used，世界系下再旋转底盘朝向 kSpinSpd * t
+      double dir = kSpinSpd * t - used;
+      x += kCmdSpd * cos(dir) * dt;
+      y += kCmdSpd * sin(dir) * dt;
+      float err = ThetaPred::angleNorm((float)dir);
+      if (isOutage(k)) {
+        res.outage_err = fmaxf(res.outage_err, fabsf(err));
+      } else {
+        err_sum += err;
+        err_num++;
+      }
+    }
+  }
+  res.mean_err = err_sum / err_num;
+  res.drift = (float)(y / sqrt(x * x + y * y));
+  return res;
+}
+
+/** 各采样相位的平均误差与漂移取平均，中断误差与时延取最大 */
+static Result run(float cfg_latency)
+{
+  Result res = {0.0f, 0.0f, 0.0f, 0.0f};
+  size_t num = sizeof(kSamplePhases) / sizeof(kSamplePhases[0]);
+  for (float phase : kSamplePhases) {
+    Result r = runPhase(cfg_latency, phase);
+    res.mean_err += r.mean_err / num;
+    res.drift += r.drift / num;
+    res.outage_err = fmaxf(res.outage_err, r.outage_err);
+    res.max_latency = fmaxf(res.max_latency, r.max_latency);
+  }
+  return res;
+}
+/* Exported function definitions ---------------------------------------------*/
+
+int main()
+{
+  const float latencies[] = {-1.0f, 0.0f, 0.0015f, 0.002f, kCfgLatency, 0.0035f, 0.005f};
+  Result sampled = run(-1.0f);
+  Result cfg = run(kCfgLatency);
+  for (float latency : latencies) {
+    Result r = run(latency);
+    char name[32];
+    if (latency < 0.0f) {
+      snprintf(name, sizeof(name), "sampled theta");
+    } else {
+      snprintf(name, sizeof(name), "predicted, %.1f ms", latency * 1e3f);
+    }
+    printf("%-20s: mean heading err %+6.1f mrad | drift %+5.0f mm/m | outage max err %5.0f mrad | "
+           "max latency used %4.1f ms\n",
+           name, r.mean_err * 1e3f, r.drift * 1e3f, r.outage_err * 1e3f, r.max_latency * 1e3f);
+  }
+  // 坡面重力分量：IMU 在控制周期内采样，数据年龄可忽略，平均时延为发送到生效与半个控制周期
+  float gravity_delay = kActDelay + 0.0005f;
+  printf("gravity vector angle err at %.0f rad/s: %.1f mrad unrotated, %+.1f mrad rotated by %.1f ms\n", kSpinSpd,
+         kSpinSpd * gravity_delay * 1e3f, kSpinSpd * (gravity_delay - kCfgLatency) * 1e3f, kCfgLatency * 1e3f);
+
+  // 发送到生效、指令保持半个控制周期、反馈 CAN 时延、读取前的平均等待半个控制周期
+  float ideal = kActDelay + 0.0005f + kCanDelay + 0.0005f;
+  bool ok = fabsf(cfg.mean_err) < 0.2f * fabsf(sampled.mean_err) &&
+            fabsf(cfg.mean_err) <= kSpinSpd * fabsf(ideal - kCfgLatency) + 0.002f &&
+            cfg.outage_err <= 1.01f * sampled.outage_err &&
+            cfg.max_latency <= kYawFdbTimeout * 0.001f + kCfgLatency + 0.001f;
+  printf("theta_pred_sim: %s\n", ok ? "pass" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,312 @@
+/**
+ *******************************************************************************
+ * @file      :traction_sim.cpp
+ * @brief     : 全向轮底盘随机打滑的主机端仿真，对比有无 TractionCtrl 电流重分配时的路径偏差与单位功率加速度
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 底盘为平地上的刚体，质量、转动惯量、转子惯量与摩擦取 ins_pid.cpp 中 kWheelFfdParams 的值；
+ *     各轮沿驱动方向的地面摩擦力为 mu * N * tanh(滑移速度 / kSlipSpd)，N 为静态轮压，不计载荷转移；
+ *     转子与车体分别积分，每个控制周期积分 kSubSteps 步
+ *  2. 摩擦随机：各轮的 mu 在 [0.6, 0.8] 内随机，每个轮子按平均每秒 kDropRate 次随机发生摩擦骤降
+ *     （过障碍、轮子离地），持续 50 ~ 150 ms，期间 mu 降为 0.02 ~ 0.15；同一随机种子下两种控制经历相同的摩擦，
+ *     结果为 kSeedNum 个随机种子的平均
+ *  3. 控制链与 Chassis 一致：期望轮速 → WheelFfd 前馈 → 轮速 PID（纯比例 2.1，加前馈）→ TractionCtrl →
+ *     电流域功率限制（裁判系统功率上限 60 W，缓冲能量上限 60 J）→ 限幅 20 A；电流滞后一个控制周期生效；
+ *     轮速反馈按转子 1 rpm 量化，底盘运动向量由轮速正解；TractionCtrl 参数与 ins_traction_ctrl.cpp 一致
+ *  4. IMU 输入为底盘坐标系下的线加速度（已扣除重力）与 yaw 角速度，另加高斯噪声，
+ *     即 Chassis::calcTractionCurrentRef 中 acc_x/acc_y 加重力分量之后应得到的量；
+ *     HW-Components 中 Imu::acc_x()/acc_y() 的单位与重力符号未在本仓库中核实，见 traction_ctrl.hpp
+ *  5. 指令为世界系（图传坐标系）下反复冲刺：前进 3 m/s 保持 1 s，停止 1 s；朝向由跟随环保持，
+ *     按 normal_rot_spd * Bound(1.48 * 朝向误差, ±1) 建模，不计微分项；起步电流超出地面附着，各轮 mu 不同时即会偏航
+ *  6. 统计每个冲刺周期的横向位移、朝向误差最大值、前进距离，以及每次起步后 600 ms 内的
+ *     速度增量与电功率积分之比（单位功率加速度，(m/s^2)/kW）；对比只判定打滑与按判定重新分配电流：
+ *     重新分配后横向位移与朝向误差应更小，单位功率加速度与前进距离不应更低，
+ *     打滑结束 kFalseWindow 之后仍判定为打滑的时间占比应低于 kMaxFalseRatio
+ *  7. 编译运行：tools/host/run.sh traction_sim
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "current_pwr_limiter.hpp"
+#include "omni_ik_kernel.hpp"
+#include "traction_ctrl.hpp"
+#include "wheel_ffd.hpp"
+/* Private constants ---------------------------------------------------------*/
+const size_t kWheelNum = robot::OmniIkKernel::kWheelNum;
+const size_t kDof = robot::OmniIkKernel::kDof;
+const float kDt = 0.001f;             ///< 控制周期，单位 s
+const int kSubSteps = 20;             ///< 每个控制周期的积分步数
+const float kGravity = 9.8f;          ///< 重力加速度，单位 m/s^2
+const float kWheelRadius = 77.86f * 0.001f;  ///< 轮子半径，单位 m
+const float kSlipSpd = 0.02f;         ///< 摩擦力达到 tanh(1) * mu * N 的滑移速度，单位 m/s
+const float kDropRate = 1.0f;         ///< 每个轮子每秒摩擦骤降的平均次数
+const float kSpdRes = 2 * 3.14159265f / 60.0f / 19.2f;  ///< 轮速反馈分辨率（转子 1 rpm），单位 rad/s
+const float kImuAccNoise = 0.1f;      ///< IMU 加速度噪声标准差，单位 m/s^2
+const float kImuGyroNoise = 0.005f;   ///< IMU 角速度噪声标准差，单位 rad/s
+const float kKp = 2.1f;               ///< 轮速 PID 比例系数，单位 A/(rad/s)
+const float kOutLimit = 20.0f;        ///< 轮电机电流限幅，单位 A
+const float kRfrPwrLimit = 60.0f;     ///< 裁判系统功率上限，单位 W
+const float kBufferMax = 60.0f;       ///< 缓冲能量上限，单位 J
+const float kNormalRotSpd = 13.0f;    ///< ins_fsm.cpp 中的 normal_rot_spd，单位 rad/s
+const float kFollowKp = 1.48f;        ///< 跟随环比例系数，与 ins_pid.cpp 一致，单位 1/rad
+const float kSlipSpdTrue = 0.1f;      ///< 统计真实打滑的滑移速度阈值，单位 m/s
+const float kSprintSpd = 3.0f;        ///< 冲刺速度，单位 m/s
+const int kSprintPeriod = 2000;       ///< 冲刺周期，单位 ms，前一半前进，后一半停止
+const int kAccWindow = 600;           ///< 起步后统计单位功率加速度的时长，单位 ms
+const int kSimTicks = 20000;          ///< 仿真时长，单位 ms
+const unsigned kSeedNum = 8;          ///< 随机种子数
+const int kFalseWindow = 100;         ///< 打滑结束后仍允许判定为打滑的时长，单位 ms，覆盖滤波与保持时间
+const float kMaxFalseRatio = 0.01f;   ///< 误判时间占比上限
+
+constexpr robot::OmniIkKernel kKernel = robot::OmniIkKernel({
+    .wheel_radius = kWheelRadius,
+    .wheel2center = 216.91f * 0.001f,
+});
+const robot::WheelFfd::Params kFfdParams = {
+    .k_tau = 0.3f,
+    .mass = 19.0f,
+    .inertia_z = 0.6f,
+    .rotor_inertia = 0.004f,
+    .visc = 0.01f,
+    .coulomb = 0.3f,
+    .coulomb_spd_band = 2.0f,
+    .acc_filter = 0.2f,
+    .max_ffd = 10.0f,
+    .gravity_curr_per_spd = 2.3f,
+};
+const robot::CurrentPwrLimiter::Params kCurParams = {
+    .k_t = 0.285f,
+    .k_r = 0.11f,
+    .k_w = 0.15f,
+    .p_bias = 2.6f,
+    .out_limit = 20.0f,
+};
+const robot::TractionCtrl::Params kTractionParams = {
+    .imu_pos_x = 0.0f,
+    .imu_pos_y = 0.0f,
+    .residual_filter = 0.05f,
+    .slip_enter_thres = 60.0f,
+    .slip_exit_thres = 25.0f,
+    .slip_hold_ticks = 50,
+    .slip_weight = 0.3f,
+    .slip_cur_limit = 4.0f,
+};
+/* Private types -------------------------------------------------------------*/
+
+struct Result {
+  float sprint_dev;  ///< 每个冲刺周期内世界系横向位移的平均绝对值，单位 m
+  float max_yaw;     ///< 朝向误差的最大值，单位 rad
+  float acc_per_kw;  ///< 起步阶段的速度增量与电能之比，单位 (m/s^2)/kW
+  float dist;        ///< 前进距离，单位 m
+  float slip_ratio;  ///< 有轮子滑移速度超过 kSlipSpdTrue 的时间占比
+  float det_ratio;   ///< 有轮子被判定为打滑的时间占比
+  float false_ratio; ///< 判定为打滑而此前 kFalseWindow 内没有轮子打滑的时间占比
+};
+/* Private function definitions ----------------------------------------------*/
+
+static float bound(float x, float lim) { return x > lim ? lim : (x < -lim ? -lim : x); }
+
+/** 与 ins_pwr_limiter.cpp 一致的功率模型 */
+static float calcPwr(const float cur[kWheelNum], const float spd[kWheelNum])
+{
+  float p = kCurParams.p_bias;
+  for (size_t i = 0; i < kWheelNum; i++) {
+    p += kCurParams.k_t * cur[i] * spd[i] + kCurParams.k_r * cur[i] * cur[i] + kCurParams.k_w * fabsf(spd[i]);
+  }
+  return p;
+}
+
+/**
+ * @brief       运行一次仿真
+ * @param        use_traction: 是否按 TractionCtrl 重新分配电流，不启用时仍运行打滑判定以统计误判
+ * @param        drop_rate: 每个轮子每秒摩擦骤降的平均次数，为 0 时只有各轮 mu 不同
+ * @param        seed: 摩擦与噪声的随机种子
+ */
+static Result run(bool use_traction, float drop_rate, unsigned seed)
+{
+  robot::WheelFfd ffd_calc(kFfdParams);
+  robot::CurrentPwrLimiter cur_limiter(kCurParams);
+  robot::TractionCtrl traction(kTractionParams);
+  std::mt19937 fric_rng(seed), noise_rng(seed + 1000);
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+  std::normal_distribution<float> acc_noise(0.0f, kImuAccNoise), gyro_noise(0.0f, kImuGyroNoise);
+
+  const float(&jac)[kWheelNum][kDof] = kKernel.jacobian();
+  const float normal = kFfdParams.mass * kGravity / kWheelNum;
+  float mu_base[kWheelNum], mu_drop[kWheelNum] = {0.0f};
+  int drop_end[kWheelNum] = {0};
+  for (size_t i = 0; i < kWheelNum; i++) {
+    mu_base[i] = 0.6f + 0.2f * unit(fric_rng);
+  }
+
+  // 车体状态：世界系位置、速度、朝向与角速度；转子状态：轮速
+  double px = 0.0, py = 0.0, yaw = 0.0, sprint_py = 0.0;
+  float vx = 0.0f, vy = 0.0f, w = 0.0f, acc_w[2] = {0.0f};
+  float wheel_spd[kWheelNum] = {0.0f}, cur_applied[kWheelNum] = {0.0f};
+  float buffer = kBufferMax;
+  double dev_sum = 0.0, dv_sum = 0.0, energy = 0.0;
+  int last_slip_tick = -kFalseWindow, slip_ticks = 0, det_ticks = 0, false_ticks = 0;
+  Result res = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+  for (int k = 0; k < kSimTicks; k++) {
+    // 摩擦骤降事件，随机数与控制无关，两种控制经历相同的摩擦
+    for (size_t i = 0; i < kWheelNum; i++) {
+      float p_start = unit(fric_rng), dur = unit(fric_rng), depth = unit(fric_rng);
+      if (k >= drop_end[i] && p_start < drop_rate * kDt) {
+        drop_end[i] = k + 50 + (int)(100 * dur);
+        mu_drop[i] = 0.02f + 0.13f * depth;
+      }
+    }
+
+    // 反馈：量化后的轮速、正解的底盘运动向量、底盘坐标系下的 IMU 加速度
+    float spd_fdb[kWheelNum], twist_fdb[kDof];
+    for (size_t i = 0; i < kWheelNum; i++) {
+      spd_fdb[i] = roundf(wheel_spd[i] / kSpdRes) * kSpdRes;
+    }
+    kKernel.fkSolve(spd_fdb, twist_fdb);
+    float c = cosf((float)yaw), s = sinf((float)yaw);
+    float imu_acc[2] = {
+        c * acc_w[0] + s * acc_w[1] + acc_noise(noise_rng),
+        -s * acc_w[0] + c * acc_w[1] + acc_noise(noise_rng),
+    };
+    float imu_gyro = w + gyro_noise(noise_rng);
+
+    // 控制链：平移指令在世界系（图传坐标系）下，朝向由跟随环保持
+    int sprint_tick = k % kSprintPeriod;
+    float v_ref = sprint_tick < kSprintPeriod / 2 ? kSprintSpd : 0.0f;
+    float twist_ref[kDof] = {c * v_ref, -s * v_ref, kNormalRotSpd * bound(-kFollowKp * (float)yaw, 1.0f)};
+    float spd_ref[kWheelNum], ffd[kWheelNum], cur_ref[kWheelNum];
+    kKernel.solveInRobotFrame(twist_ref, spd_ref);
+    ffd_calc.calc(kKernel, spd_ref, kDt, ffd);
+    for (size_t i = 0; i < kWheelNum; i++) {
+      cur_ref[i] = bound(kKp * (spd_ref[i] - spd_fdb[i]) + ffd[i], kOutLimit);
+    }
+    traction.update(kKernel, spd_fdb, twist_fdb, imu_acc, imu_gyro, kDt);
+    if (use_traction) {
+      traction.allocate(kKernel, cur_ref);
+    }
+    hello_world::power_limiter::PowerLimiterRuntimeParams runtime_params = {
+        .p_ref_max = 100.0f + kRfrPwrLimit,
+        .p_referee_max = kRfrPwrLimit,
+        .p_ref_min = 0.8f * kRfrPwrLimit,
+        .remaining_energy = buffer,
+        .energy_converge = 10.0f,
+        .p_slope = 2.0f,
+        .danger_energy = 5.0f,
+    };
+    float scale = cur_limiter.calc(runtime_params, cur_ref, spd_fdb, kWheelNum);
+
+    // 实际功率由上一周期下发、本周期生效的电流产生
+    float pwr = calcPwr(cur_applied, wheel_spd);
+    buffer = fminf(buffer - (pwr - kRfrPwrLimit) * kDt, kBufferMax);
+    float v_fwd_start = c * vx + s * vy;
+
+    // 车体与转子
+    const float sub_dt = kDt / kSubSteps;
+    bool is_slip = false;
+    for (int n = 0; n < kSubSteps; n++) {
+      float cb = cosf((float)yaw), sb = sinf((float)yaw);
+      float twist_b[kDof] = {cb * vx + sb * vy, -sb * vx + cb * vy, w};
+      float gen_force[kDof] = {0.0f};
+      for (size_t i = 0; i < kWheelNum; i++) {
+        float ground_spd = jac[i][0] * twist_b[0] + jac[i][1] * twist_b[1] + jac[i][2] * twist_b[2];
+        float mu = k < drop_end[i] ? mu_drop[i] : mu_base[i];
+        float slip_spd = (wheel_spd[i] - ground_spd) * kWheelRadius;
+        float fric_force = mu * normal * tanhf(slip_spd / kSlipSpd);
+        is_slip = is_slip || fabsf(slip_spd) > kSlipSpdTrue;
+        float loss = kFfdParams.visc * wheel_spd[i] +
+                     kFfdParams.coulomb * bound(wheel_spd[i] / kFfdParams.coulomb_spd_band, 1.0f);
+        float tor = kFfdParams.k_tau * (cur_applied[i] - loss) - fric_force * kWheelRadius;
+        wheel_spd[i] += tor / kFfdParams.rotor_inertia * sub_dt;
+        // 轮上驱动力 F 在底盘广义力中的分量为 J^T * (F * r)
+        for (size_t d = 0; d < kDof; d++) {
+          gen_force[d] += jac[i][d] * fric_force * kWheelRadius;
+        }
+      }
+      acc_w[0] = (cb * gen_force[0] - sb * gen_force[1]) / kFfdParams.mass;
+      acc_w[1] = (sb * gen_force[0] + cb * gen_force[1]) / kFfdParams.mass;
+      vx += acc_w[0] * sub_dt;
+      vy += acc_w[1] * sub_dt;
+      w += gen_force[2] / kFfdParams.inertia_z * sub_dt;
+      px += vx * sub_dt;
+      py += vy * sub_dt;
+      yaw += w * sub_dt;
+    }
+    for (size_t i = 0; i < kWheelNum; i++) {
+      cur_applied[i] = bound(cur_ref[i] * scale, kOutLimit);
+    }
+
+    last_slip_tick = is_slip ? k : last_slip_tick;
+    slip_ticks += is_slip ? 1 : 0;
+    det_ticks += traction.isAnySlipping() ? 1 : 0;
+    false_ticks += traction.isAnySlipping() && k - last_slip_tick > kFalseWindow ? 1 : 0;
+    if (sprint_tick < kAccWindow) {
+      dv_sum += (cosf((float)yaw) * vx + sinf((float)yaw) * vy) - v_fwd_start;
+      energy += pwr * kDt;
+    }
+    if (sprint_tick == kSprintPeriod - 1) {
+      dev_sum += fabs(py - sprint_py);
+      sprint_py = py;
+    }
+    res.max_yaw = fmaxf(res.max_yaw, fabsf((float)yaw));
+  }
+  res.sprint_dev = (float)(dev_sum / (kSimTicks / kSprintPeriod));
+  res.acc_per_kw = (float)(dv_sum / energy * 1e3);
+  res.dist = (float)px;
+  res.slip_ratio = (float)slip_ticks / kSimTicks;
+  res.det_ratio = (float)det_ticks / kSimTicks;
+  res.false_ratio = (float)false_ticks / kSimTicks;
+  return res;
+}
+
+/** 各随机种子取平均，朝向误差取最大 */
+static Result runSeeds(bool use_traction, float drop_rate)
+{
+  Result res = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+  for (unsigned seed = 1; seed <= kSeedNum; seed++) {
+    Result r = run(use_traction, drop_rate, seed);
+    res.sprint_dev += r.sprint_dev / kSeedNum;
+    res.max_yaw = fmaxf(res.max_yaw, r.max_yaw);
+    res.acc_per_kw += r.acc_per_kw / kSeedNum;
+    res.dist += r.dist / kSeedNum;
+    res.slip_ratio += r.slip_ratio / kSeedNum;
+    res.det_ratio += r.det_ratio / kSeedNum;
+    res.false_ratio += r.false_ratio / kSeedNum;
+  }
+  return res;
+}
+
+static void print(const char *name, const Result &r)
+{
+  printf("  %-10s: lateral drift %5.1f mm/sprint | max yaw err %5.1f mrad | distance %5.1f m | "
+         "acc per power %5.1f (m/s^2)/kW | slipping %4.1f%% detected %4.1f%% false %4.1f%%\n",
+         name, r.sprint_dev * 1e3f, r.max_yaw * 1e3f, r.dist, r.acc_per_kw, r.slip_ratio * 100.0f,
+         r.det_ratio * 100.0f, r.false_ratio * 100.0f);
+}
+/* Exported function definitions ---------------------------------------------*/
+
+int main()
+{
+  const float drop_rates[] = {0.0f, kDropRate};
+  bool ok = true;
+  for (float drop_rate : drop_rates) {
+    Result off = runSeeds(false, drop_rate);
+    Result on = runSeeds(true, drop_rate);
+    bool case_ok = on.sprint_dev < off.sprint_dev && on.max_yaw < off.max_yaw && on.acc_per_kw >= off.acc_per_kw &&
+                   on.dist >= off.dist && on.false_ratio < kMaxFalseRatio && off.false_ratio < kMaxFalseRatio;
+    printf("friction drops %.1f per wheel per s %s\n", drop_rate, case_ok ? "ok" : "FAIL");
+    print("no realloc", off);
+    print("realloc", on);
+    ok = ok && case_ok;
+  }
+  printf("traction_sim: %s\n", ok ? "pass" : "FAIL");
+  return ok ? 0 : 1;
+}
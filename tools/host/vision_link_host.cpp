@@ -0,0 +1,195 @@
+/**
+ *******************************************************************************
+ * @file      :vision_link_host.cpp
+ * @brief     : 主机端运行 VisionLink 与 PoseHistory 的 MCU 替身，经 pty 与 tools/vision_pc_sim.py 对接
+ * @history   :
+ *  Version     Date            Author          Note
+ *  V0.9.0      yyyy-mm-dd      <author>        1. <note>
+ *******************************************************************************
+ * @attention :
+ *  1. 由 vision_pc_sim.py 启动，pty 路径为最后一个参数；按 1 kHz 控制周期运行，与 Robot 的用法一致：
+ *     每周期记录云台位姿（PoseHistory 与 VisionLink::addPose），每 5 个周期编码发出一帧，
+ *     每 100 ms 更新状态，每 500 ms 追加一发弹速
+ *  2. MCU 时间 GetSysTimeUs 由主机单调时钟加上偏置与 50 ppm 的频偏给出；上位机替身使用同一单调时钟，
+ *     因此真实的时钟偏差已知，可直接检查 TimeSync 的估计
+ *  3. 云台 yaw 以 0.8 rad、0.5 Hz 往复转动，上位机替身给出世界系中 yaw 为 0.3 rad 的静止目标（默认参数）；
+ *     收到新目标时按拍摄时刻查位姿还原世界系方向，同时给出按到达时刻减固定时延 14 ms 查位姿的结果作对比
+ *  4. 通过条件：已同步，时钟偏差估计误差不超过参考样本往返时延的一半（链路不对称时的理论上界），
+ *     收到的帧无校验、版本错误，按拍摄时刻还原的目标方向均方根误差小于 kMaxRms 且小于固定时延的结果
+ *  5. 编译运行：tools/host/run.sh vision_link_host，即编译后运行
+ *     tools/vision_pc_sim.py --exec tools/host/build/vision_link_host，可在其后追加上位机替身的参数
+ *******************************************************************************
+ *  Copyright (c) 2024 Hello World Team, Zhejiang University.
+ *  All Rights Reserved.
+ *******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+#include "pose_history.hpp"
+#include "sys_time.hpp"
+#include "vision_link.hpp"
+/* Private constants ---------------------------------------------------------*/
+const float kPi = 3.14159265f;
+const int kRunTicks = 8000;            ///< 运行时长，单位 ms
+const int kWarmupTicks = 2000;         ///< 不计入统计的起始时长，单位 ms
+const int64_t kMcuOffset = 987654321;  ///< MCU 时间相对主机单调时钟的偏置，单位 us
+const double kMcuSkew = 50e-6;         ///< MCU 时钟相对主机单调时钟的频偏
+const float kYawAmp = 0.8f;            ///< 云台 yaw 往复幅值，单位 rad
+const float kYawFreq = 0.5f;           ///< 云台 yaw 往复频率，单位 Hz
+const float kTargetYaw = 0.3f;         ///< 世界系中目标的 yaw，与 vision_pc_sim.py 默认值一致，单位 rad
+const uint32_t kFixedLatency = 14000;  ///< 对比用的固定时延，单位 us
+const float kMaxRms = 0.003f;          ///< 按拍摄时刻还原的目标方向均方根误差上限，单位 rad
+const int kMinTargets = 100;           ///< 参与统计的最少目标数
+
+const robot::VisionLink::Config kLinkConfig = {
+    .sync = {
+        .rtt_max = 3000,
+        .timeout = 1000000,
+    },
+    .sync_interval = 20,
+    .hfov = 0.785f,
+    .vfov = 0.6183f,
+};
+const robot::PoseHistory::Params kPoseHistoryParams = {
+    .max_extrap = 2000,
+};
+/* Private types -------------------------------------------------------------*/
+
+struct ErrStat {
+  int num = 0;
+  double err_sq = 0.0;
+  float max_err = 0.0f;
+
+  void add(float err)
+  {
+    num++;
+    err_sq += err * err;
+    max_err = fmaxf(max_err, fabsf(err));
+  }
+  float rms() const { return num > 0 ? (float)sqrt(err_sq / num) : 0.0f; }
+};
+/* Private function definitions ----------------------------------------------*/
+
+static int64_t hostUs()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+static uint32_t mcuUs(int64_t host_us) { return (uint32_t)(int64_t)(host_us * (1.0 + kMcuSkew) + kMcuOffset); }
+
+static float wrap(float a) { return atan2f(sinf(a), cosf(a)); }
+
+static int openPty(const char *path)
+{
+  int fd = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK);
+  if (fd < 0) {
+    return fd;
+  }
+  termios attr;
+  tcgetattr(fd, &attr);
+  cfmakeraw(&attr);
+  tcsetattr(fd, TCSANOW, &attr);
+  return fd;
+}
+/* Exported function definitions ---------------------------------------------*/
+
+namespace robot
+{
+uint32_t GetSysTimeUs(void) { return mcuUs(hostUs()); }
+}  // namespace robot
+
+int main(int argc, char **argv)
+{
+  if (argc < 2) {
+    fprintf(stderr, "usage: tools/vision_pc_sim.py --exec %s\n", argv[0]);
+    return 2;
+  }
+  int fd = openPty(argv[argc - 1]);
+  if (fd < 0) {
+    perror(argv[argc - 1]);
+    return 2;
+  }
+
+  robot::VisionLink link(kLinkConfig);
+  robot::PoseHistory pose_history(kPoseHistoryParams);
+  ErrStat stamped, fixed;
+  uint32_t last_exposure = 0;
+  bool has_target = false;
+  int64_t start = hostUs();
+  for (int k = 0; k < kRunTicks; k++) {
+    std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::microseconds(start + k * 1000)));
+    float t = k * 0.001f;
+
+    robot::PoseHistory::Pose pose;
+    pose.yaw = wrap(kYawAmp * sinf(2 * kPi * kYawFreq * t));
+    uint32_t now = robot::GetSysTimeUs();
+    pose_history.push(now, pose);
+    link.addPose(now, pose.roll, pose.pitch, pose.yaw);
+
+    if (k % 100 == 0) {
+      robot::VisionLink::Status status;
+      status.work_state = 1;
+      status.target_color = 2;
+      status.blt_spd = 23.7f;
+      link.setStatus(status);
+    }
+    if (k % 500 == 0) {
+      link.addBulletSpd(23.5f + 0.01f * (k / 500));
+    }
+    if (k % 5 == 2) {
+      uint8_t buf[robot::VisionLink::kMaxEncLen];
+      size_t len = sizeof(buf);
+      if (link.encode(len, buf) && write(fd, buf, len) == (ssize_t)len) {
+        link.txSuccessCb();
+      }
+    }
+
+    uint8_t rx_buf[64];
+    ssize_t rx_len = 0;
+    while ((rx_len = read(fd, rx_buf, sizeof(rx_buf))) > 0) {
+      link.decode(rx_len, rx_buf, 0);
+    }
+
+    robot::VisionLink::Target target;
+    uint32_t capture_us = 0;
+    if (!link.getTarget(&target, &capture_us) || (has_target && target.exposure == last_exposure)) {
+      continue;
+    }
+    has_target = true;
+    last_exposure = target.exposure;
+    robot::PoseHistory::Pose at_capture, at_fixed;
+    if (k < kWarmupTicks || !target.is_detected || !pose_history.lookup(capture_us, &at_capture) ||
+        !pose_history.lookup(robot::GetSysTimeUs() - kFixedLatency, &at_fixed)) {
+      continue;
+    }
+    stamped.add(wrap(at_capture.yaw + target.yaw - kTargetYaw));
+    fixed.add(wrap(at_fixed.yaw + target.yaw - kTargetYaw));
+  }
+  close(fd);
+
+  int64_t host_now = hostUs();
+  int32_t true_offset = (int32_t)((uint32_t)host_now - mcuUs(host_now));
+  int32_t offset_err = link.getTimeSync().getOffset() - true_offset;
+  const robot::VisionLink::LinkStats &stats = link.getLinkStats();
+  printf("mcu: rx %u lost %u err %u ver %u tx %u | rtt %u us, offset err %d us\n", stats.rx_frame_cnt,
+         stats.rx_lost_cnt, stats.rx_err_cnt, stats.rx_ver_err_cnt, stats.tx_frame_cnt,
+         link.getTimeSync().getRtt(), offset_err);
+  printf("mcu: targets %d | capture stamp: rms %5.2f max %5.2f mrad | fixed %u ms: rms %5.2f max %5.2f mrad\n",
+         stamped.num, 1e3f * stamped.rms(), 1e3f * stamped.max_err, kFixedLatency / 1000, 1e3f * fixed.rms(),
+         1e3f * fixed.max_err);
+  bool ok = link.isSynced() && (uint32_t)abs(offset_err) <= link.getTimeSync().getRtt() / 2 && stats.rx_err_cnt == 0 &&
+            stats.rx_ver_err_cnt == 0 && stamped.num >= kMinTargets && stamped.rms() < kMaxRms &&
+            stamped.rms() < fixed.rms();
+  printf("vision_link_host: %s\n", ok ? "pass" : "FAIL");
+  return ok ? 0 : 1;
+}
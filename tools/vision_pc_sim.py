@@ -0,0 +1,329 @@
+#!/usr/bin/env python3
+"""Vision PC stand-in speaking the gimbal vision protocol v2.
+
+Protocol (see Gimbal/RobotModules/inc/vision_link.hpp):
+    COBS(ver | seq | msg ... | crc16) | 0x00,  msg = type(u8) | len(u8) | payload
+
+The stand-in answers time-sync requests, decodes the MCU pose batches, status and
+bullet speed history, and streams simulated targets stamped with the exposure time.
+Targets are given relative to the gimbal pose at exposure, which the stand-in looks
+up from the received pose stream using its own estimate of the MCU clock.
+
+Usage:
+    # create a pty and print its path, e.g. for socat or a host build of the link
+    tools/vision_pc_sim.py
+    # spawn a host program with the pty path as its last argument, e.g. the host build of
+    # VisionLink + PoseHistory that checks time sync and pose lookup (tools/host/run.sh vision_link_host)
+    tools/vision_pc_sim.py --exec tools/host/build/vision_link_host
+    # talk to a real board
+    tools/vision_pc_sim.py --device /dev/ttyUSB0 --baud 921600
+"""
+
+import argparse
+import math
+import os
+import pty
+import random
+import select
+import struct
+import subprocess
+import sys
+import termios
+import threading
+import time
+import tty
+
+VERSION = 2
+
+MSG_SYNC_REQ = 0x01
+MSG_POSE_BATCH = 0x02
+MSG_STATUS = 0x03
+MSG_BULLET_SPD = 0x04
+MSG_SYNC_RESP = 0x81
+MSG_TARGET = 0x82
+
+BAUD_RATES = {
+    115200: termios.B115200,
+    230400: termios.B230400,
+    460800: getattr(termios, "B460800", termios.B230400),
+    921600: getattr(termios, "B921600", termios.B230400),
+}
+
+
+def crc16(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def cobs_encode(data):
+    out = bytearray([0])
+    code_pos, code = 0, 1
+    for byte in data:
+        if byte:
+            out.append(byte)
+            code += 1
+        if not byte or code == 0xFF:
+            out[code_pos] = code
+            code_pos, code = len(out), 1
+            out.append(0)
+    out[code_pos] = code
+    return bytes(out)
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(data):
+            return None
+        out += data[i:i + code - 1]
+        i += code - 1
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def now_us():
+    return (time.monotonic_ns() // 1000) & 0xFFFFFFFF
+
+
+def wrap_pi(ang):
+    return math.atan2(math.sin(ang), math.cos(ang))
+
+
+def quat_to_euler(qw, qx, qy, qz):
+    roll = math.atan2(2 * (qw * qx + qy * qz), 1 - 2 * (qx * qx + qy * qy))
+    pitch = math.asin(max(-1.0, min(1.0, 2 * (qw * qy - qz * qx))))
+    yaw = math.atan2(2 * (qw * qz + qx * qy), 1 - 2 * (qy * qy + qz * qz))
+    return roll, pitch, yaw
+
+
+class Link:
+    def __init__(self, fd, loss):
+        self.fd = fd
+        self.loss = loss
+        self.tx_seq = 0
+        self.rx_buf = bytearray()
+        self.lock = threading.Lock()
+        self.last_rx_seq = None
+        self.stats = {"rx": 0, "lost": 0, "err": 0, "ver": 0, "tx": 0, "tx_drop": 0, "sync": 0}
+
+    def send(self, msgs):
+        body = bytearray([VERSION, self.tx_seq])
+        for msg_type, payload in msgs:
+            body += bytes([msg_type, len(payload)]) + payload
+        body += struct.pack("<H", crc16(body))
+        self.tx_seq = (self.tx_seq + 1) & 0xFF
+        if random.random() < self.loss:
+            self.stats["tx_drop"] += 1
+            return
+        with self.lock:
+            os.write(self.fd, cobs_encode(body) + b"\x00")
+        self.stats["tx"] += 1
+
+    def feed(self, data):
+        """Returns a list of (seq, [(type, payload), ...]) for complete frames."""
+        frames = []
+        for byte in data:
+            if byte:
+                self.rx_buf.append(byte)
+                continue
+            raw, self.rx_buf = bytes(self.rx_buf), bytearray()
+            if not raw:
+                continue
+            frame = cobs_decode(raw)
+            if frame is None or len(frame) < 4 or crc16(frame[:-2]) != struct.unpack("<H", frame[-2:])[0]:
+                self.stats["err"] += 1
+                continue
+            if frame[0] != VERSION:
+                self.stats["ver"] += 1
+                continue
+            seq = frame[1]
+            if self.last_rx_seq is not None:
+                self.stats["lost"] += (seq - self.last_rx_seq - 1) & 0xFF
+            self.last_rx_seq = seq
+            self.stats["rx"] += 1
+            msgs, pos, end = [], 2, len(frame) - 2
+            while pos + 2 <= end:
+                msg_type, msg_len = frame[pos], frame[pos + 1]
+                pos += 2
+                if pos + msg_len > end:
+                    self.stats["err"] += 1
+                    break
+                msgs.append((msg_type, frame[pos:pos + msg_len]))
+                pos += msg_len
+            frames.append((seq, msgs))
+        return frames
+
+
+class VisionPc:
+    def __init__(self, link, args):
+        self.link = link
+        self.args = args
+        self.poses = []  # (mcu_us, roll, pitch, yaw)
+        self.mcu_offset = None  # pc_us - mcu_us, from the min-delay sync request
+        self.min_delay = None
+        self.status = None
+        self.blt_spd_hist = []
+        self.running = True
+
+    def on_frame(self, msgs, rx_us):
+        for msg_type, payload in msgs:
+            if msg_type == MSG_SYNC_REQ and len(payload) >= 5:
+                sync_seq, t1 = struct.unpack_from("<BI", payload)
+                self.update_offset(t1, rx_us)
+                time.sleep(random.uniform(0.0, self.args.reply_jitter))
+                self.link.send([(MSG_SYNC_RESP, struct.pack("<BII", sync_seq, rx_us, now_us()))])
+                self.link.stats["sync"] += 1
+            elif msg_type == MSG_POSE_BATCH and len(payload) >= 7:
+                t0, period, n = struct.unpack_from("<IHB", payload)
+                for i in range(n):
+                    if 7 + 8 * (i + 1) > len(payload):
+                        break
+                    q = [v / 32767.0 for v in struct.unpack_from("<4h", payload, 7 + 8 * i)]
+                    self.poses.append(((t0 + i * period) & 0xFFFFFFFF,) + quat_to_euler(*q))
+                del self.poses[:-400]
+            elif msg_type == MSG_STATUS and len(payload) >= 4:
+                work_state, color, spd = struct.unpack_from("<BBH", payload)
+                self.status = (work_state, color, spd / 100.0)
+            elif msg_type == MSG_BULLET_SPD and len(payload) >= 1:
+                n = payload[0]
+                self.blt_spd_hist = [v / 100.0 for v in struct.unpack_from("<%dH" % n, payload, 1)]
+
+    def update_offset(self, t1, rx_us):
+        # one-way estimate: the request with the least transit delay is closest to the true offset,
+        # the bound is relaxed slowly to follow clock drift
+        offset = (rx_us - t1) & 0xFFFFFFFF
+        offset = offset - (1 << 32) if offset >= (1 << 31) else offset
+        if self.mcu_offset is None or offset <= self.min_delay:
+            self.mcu_offset = offset
+            self.min_delay = offset
+        else:
+            self.min_delay += 50
+
+    def pose_at(self, pc_us):
+        if self.mcu_offset is None or len(self.poses) < 2:
+            return None
+        mcu_us = (pc_us - self.mcu_offset) & 0xFFFFFFFF
+        poses = list(self.poses)
+        for (ta, ra, pa, ya), (tb, rb, pb, yb) in zip(reversed(poses[:-1]), reversed(poses[1:])):
+            da = (mcu_us - ta) & 0xFFFFFFFF
+            span = (tb - ta) & 0xFFFFFFFF
+            if da < (1 << 31) and span and da <= span:
+                k = da / span
+                return pa + k * (pb - pa), wrap_pi(ya + k * wrap_pi(yb - ya))
+        t_last = poses[-1][0]
+        if ((mcu_us - t_last) & 0xFFFFFFFF) < 5000:
+            return poses[-1][2], poses[-1][3]
+        return None
+
+    def target_loop(self):
+        period = 1.0 / self.args.fps
+        while self.running:
+            exposure = now_us()
+            t = time.monotonic()
+            tgt_yaw = self.args.target_yaw + self.args.target_amp * math.sin(2 * math.pi * self.args.target_freq * t)
+            delay = random.uniform(self.args.proc_min, self.args.proc_max)
+            threading.Timer(delay, self.solve, args=(exposure, tgt_yaw)).start()
+            time.sleep(period)
+
+    def solve(self, exposure, tgt_yaw):
+        # solved after the processing delay, when the poses around the exposure have arrived
+        pose = self.pose_at(exposure)
+        if pose is None:
+            return
+        rel_yaw = wrap_pi(tgt_yaw - pose[1])
+        rel_pitch = self.args.target_pitch - pose[0]
+        flags = 0x01 | (self.args.shoot_flag << 1) | (0x08 if self.args.high_value else 0)
+        payload = struct.pack("<BIhhH", flags, exposure, int(round(rel_yaw * 1e4)), int(round(rel_pitch * 1e4)),
+                              int(round(self.args.target_dist * 1e3)))
+        self.link.send([(MSG_TARGET, payload)])
+
+    def report(self):
+        s = self.link.stats
+        print("rx %d lost %d err %d ver %d | tx %d drop %d | sync %d | status %s | blt %s" %
+              (s["rx"], s["lost"], s["err"], s["ver"], s["tx"], s["tx_drop"], s["sync"], self.status,
+               self.blt_spd_hist), flush=True)
+
+
+def open_device(path, baud):
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+    tty.setraw(fd)
+    attrs = termios.tcgetattr(fd)
+    attrs[4] = attrs[5] = BAUD_RATES.get(baud, termios.B115200)
+    termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--device", help="serial device to open instead of creating a pty")
+    parser.add_argument("--baud", type=int, default=921600)
+    parser.add_argument("--exec", dest="exec_cmd", help="host program to spawn with the pty path appended")
+    parser.add_argument("--duration", type=float, default=0.0, help="seconds to run, 0 runs until interrupted")
+    parser.add_argument("--fps", type=float, default=100.0, help="simulated camera frame rate")
+    parser.add_argument("--proc-min", type=float, default=0.008, help="minimum processing delay, s")
+    parser.add_argument("--proc-max", type=float, default=0.020, help="maximum processing delay, s")
+    parser.add_argument("--reply-jitter", type=float, default=0.0003, help="sync reply jitter, s")
+    parser.add_argument("--loss", type=float, default=0.0, help="probability of dropping an outgoing frame")
+    parser.add_argument("--target-yaw", type=float, default=0.3, help="world target yaw, rad")
+    parser.add_argument("--target-pitch", type=float, default=0.0, help="world target pitch, rad")
+    parser.add_argument("--target-dist", type=float, default=4.0, help="target distance, m")
+    parser.add_argument("--target-amp", type=float, default=0.0, help="target yaw oscillation amplitude, rad")
+    parser.add_argument("--target-freq", type=float, default=0.5, help="target yaw oscillation frequency, Hz")
+    parser.add_argument("--shoot-flag", type=int, default=0, help="shoot flag sent with each target")
+    parser.add_argument("--high-value", action="store_true", help="mark the target as high value")
+    args = parser.parse_args()
+
+    proc = None
+    if args.device:
+        fd = open_device(args.device, args.baud)
+    else:
+        fd, slave = pty.openpty()
+        tty.setraw(fd)
+        slave_path = os.ttyname(slave)
+        print("pty: %s" % slave_path, flush=True)
+        if args.exec_cmd:
+            proc = subprocess.Popen(args.exec_cmd.split() + [slave_path])
+
+    link = Link(fd, args.loss)
+    pc = VisionPc(link, args)
+    threading.Thread(target=pc.target_loop, daemon=True).start()
+
+    start = last_report = time.monotonic()
+    try:
+        while True:
+            if proc is not None and proc.poll() is not None:
+                break
+            if args.duration and time.monotonic() - start > args.duration:
+                break
+            ready, _, _ = select.select([fd], [], [], 0.05)
+            if ready:
+                try:
+                    data = os.read(fd, 256)
+                except OSError:
+                    break
+                rx_us = now_us()
+                for _, msgs in link.feed(data):
+                    pc.on_frame(msgs, rx_us)
+            if time.monotonic() - last_report > 1.0:
+                pc.report()
+                last_report = time.monotonic()
+    except KeyboardInterrupt:
+        pass
+    pc.running = False
+    pc.report()
+    if proc is not None:
+        proc.wait()
+        return proc.returncode
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())